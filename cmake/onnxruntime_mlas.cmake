@@ -5,11 +5,19 @@ set(mlas_common_srcs
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/platform.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/threading.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/sgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/quantize.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/convolve.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/winograd.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/convtranspose.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/im2col.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/normalize.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/pooling.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/activate.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/logistic.cpp
   ${ONNXRUNTIME_ROOT}/core/mlas/lib/tanh.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/erf.cpp
+  ${ONNXRUNTIME_ROOT}/core/mlas/lib/softmax.cpp
 )
 
 if (MSVC)
@@ -65,7 +73,11 @@ if (MSVC)
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/cvtfp16a.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/LogisticKernelFma3.asm
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/amd64/TanhKernelFma3.asm
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx2.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx512bw.cpp
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx512vnni.cpp
     )
+    set(mlas_avx512vnni_supported TRUE)
 
   endif()
 
@@ -139,6 +151,7 @@ else()
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/SgemmKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/LogisticKernelFma3.S
       ${ONNXRUNTIME_ROOT}/core/mlas/lib/x86_64/TanhKernelFma3.S
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx2.cpp
     )
     set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
 
@@ -147,11 +160,31 @@ else()
     )
     set_source_files_properties(${mlas_platform_srcs_avx512f} PROPERTIES COMPILE_FLAGS "-mavx512f")
 
+    set(mlas_platform_srcs_avx512bw
+      ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx512bw.cpp
+    )
+    set_source_files_properties(${mlas_platform_srcs_avx512bw} PROPERTIES COMPILE_FLAGS "-mavx512bw")
+
+    # Older compilers don't support the AVX512 vector neural network
+    # instructions. The platform dispatch then falls back to the AVX512BW
+    # kernel on processors that have them.
+    check_cxx_compiler_flag(-mavx512vnni HAS_AVX512VNNI)
+
+    if (HAS_AVX512VNNI)
+      set(mlas_platform_srcs_avx512vnni
+        ${ONNXRUNTIME_ROOT}/core/mlas/lib/qgemm_kernel_avx512vnni.cpp
+      )
+      set_source_files_properties(${mlas_platform_srcs_avx512vnni} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512vnni")
+      set(mlas_avx512vnni_supported TRUE)
+    endif()
+
     set(mlas_platform_srcs
       ${mlas_platform_srcs_sse2}
       ${mlas_platform_srcs_avx}
       ${mlas_platform_srcs_avx2}
       ${mlas_platform_srcs_avx512f}
+      ${mlas_platform_srcs_avx512bw}
+      ${mlas_platform_srcs_avx512vnni}
     )
 
   endif()
@@ -161,3 +194,7 @@ endif()
 add_library(onnxruntime_mlas STATIC ${mlas_common_srcs} ${mlas_platform_srcs})
 target_include_directories(onnxruntime_mlas PRIVATE ${ONNXRUNTIME_ROOT}/core/mlas/inc ${ONNXRUNTIME_ROOT}/core/mlas/lib)
 set_target_properties(onnxruntime_mlas PROPERTIES FOLDER "ONNXRuntime")
+
+if (mlas_avx512vnni_supported)
+  target_compile_definitions(onnxruntime_mlas PRIVATE MLAS_AVX512VNNI_SUPPORTED)
+endif()
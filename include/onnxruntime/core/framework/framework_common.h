@@ -5,6 +5,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 #include "run_options.h"
 
@@ -20,4 +21,14 @@ using InputDefList = std::vector<const onnxruntime::NodeArg*>;
 using OutputDefList = std::vector<const onnxruntime::NodeArg*>;
 
 using NameMLValMap = std::unordered_map<std::string, MLValue>;
+
+// (min, max) of the values observed for each tensor, keyed by tensor name.
+using TensorRangeMap = std::unordered_map<std::string, std::pair<float, float>>;
+
+// In-memory format of the constant weights of MatMul, Gemm and Conv, see SessionOptions::weight_compression.
+enum class WeightCompressionFormat {
+  None,
+  Float16,  // IEEE half precision
+  Int8,     // int8 with a symmetric scale per output channel
+};
 }  // namespace onnxruntime
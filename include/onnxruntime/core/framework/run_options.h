@@ -14,6 +14,7 @@
 struct OrtRunOptions {
   unsigned run_log_verbosity_level = 0;  ///< applies to a particular Run() invocation
   std::string run_tag;                   ///< to identify logs generated by a particular Run() invocation
+  std::string stream_id;                 ///< persistent state to use if the session has state bindings
 
   /// set to 'true' to terminate any currently executing Run() calls that are using this
   /// OrtRunOptions instance. the individual calls will exit gracefully and return an error status.
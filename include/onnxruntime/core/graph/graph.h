@@ -503,7 +503,7 @@ class Graph {
   const std::vector<const NodeArg*>& GetOutputs() const noexcept { return graph_outputs_; }
 
   /** Returns true if a Node output is a Graph output. */
-  bool IsNodeOutputsInGraphOutputs(const Node& node) {
+  bool IsNodeOutputsInGraphOutputs(const Node& node) const {
     for (auto output_def : node.OutputDefs()) {
       if (std::find(GetOutputs().cbegin(), GetOutputs().cend(), output_def) != GetOutputs().cend()) {
         return true;
@@ -917,7 +917,8 @@ class Graph {
   ONNX_NAMESPACE::GraphProto* graph_proto_;
 
   InitializedTensorSet name_to_initial_tensor_;
-  std::vector<int> removed_initializer_indexes_;
+  // initializers removed from the graph that ToGraphProto still has to remove from the GraphProto
+  std::unordered_set<const ONNX_NAMESPACE::TensorProto*> removed_initializers_;
 
   Type graph_type_ = Type::Main;
 
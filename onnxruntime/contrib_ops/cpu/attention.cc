@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/attention.h"
+#include "core/mlas/inc/mlas.h"
+#include <cmath>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    Attention,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    Attention<float>);
+
+// Minimum number of multiply-adds of the attention before the heads are spread across threads.
+static constexpr int64_t kAttentionParallelMinOps = 64 * 1024;
+
+template <>
+Status Attention<float>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weight = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* mask = context->Input<Tensor>(3);
+
+  const auto& input_shape = input->Shape();
+  if (input_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "input must have 3 dimensions, got ", input_shape);
+  }
+  const int64_t batch_size = input_shape[0];
+  const int64_t sequence_length = input_shape[1];
+  const int64_t hidden_size = input_shape[2];
+
+  if (hidden_size % num_heads_ != 0) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "hidden_size ", hidden_size,
+                           " must be a multiple of num_heads ", num_heads_);
+  }
+  const int64_t head_size = hidden_size / num_heads_;
+
+  const auto& weight_shape = weight->Shape();
+  if (weight_shape.NumDimensions() != 2 || weight_shape[0] != hidden_size || weight_shape[1] != 3 * hidden_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "weight must have shape {", hidden_size, ",",
+                           3 * hidden_size, "}, got ", weight_shape);
+  }
+  if (bias->Shape().Size() != 3 * hidden_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "bias must have ", 3 * hidden_size, " elements, got ",
+                           bias->Shape());
+  }
+
+  // The mask broadcasts to (batch_size, 1, sequence_length, sequence_length): it has one row shared by all query
+  // positions or one row per query position, shared by the batch or given for each batch item.
+  const float* mask_data = nullptr;
+  int64_t mask_row_count = 0;
+  int64_t mask_batch_stride = 0;
+  if (mask != nullptr) {
+    const auto& mask_shape = mask->Shape();
+    const auto mask_rank = mask_shape.NumDimensions();
+    // dimension i of the mask shape left padded with ones to rank 4
+    const auto mask_dim = [&mask_shape, mask_rank](size_t i) -> int64_t {
+      return i + mask_rank < 4 ? 1 : mask_shape[i + mask_rank - 4];
+    };
+    if (mask_rank < 1 || mask_rank > 4 || (mask_dim(0) != 1 && mask_dim(0) != batch_size) || mask_dim(1) != 1 ||
+        (mask_dim(2) != 1 && mask_dim(2) != sequence_length) || mask_dim(3) != sequence_length) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "mask must broadcast to {", batch_size, ",1,",
+                             sequence_length, ",", sequence_length, "}, got ", mask_shape);
+    }
+    mask_data = mask->template Data<float>();
+    mask_row_count = mask_dim(2);
+    mask_batch_stride = mask_dim(0) == 1 ? 0 : mask_row_count * sequence_length;
+  }
+
+  Tensor* output = context->Output(0, input_shape);
+  if (input_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // Q, K and V are computed by one GEMM into a [batch_size * sequence_length, 3 * hidden_size] matrix, with the
+  // bias added by the epilogue.
+  const int64_t qkv_ld = 3 * hidden_size;
+  auto qkv_data = alloc->Alloc(sizeof(float) * batch_size * sequence_length * qkv_ld);
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(alloc));
+  auto* qkv = static_cast<float*>(qkv_buffer.get());
+
+  MLAS_SGEMM_EPILOGUE qkv_epilogue{MlasSgemmColumnBias, bias->template Data<float>(), 0, nullptr};
+  MlasSgemm(CblasNoTrans, CblasNoTrans,
+            static_cast<size_t>(batch_size * sequence_length), static_cast<size_t>(qkv_ld),
+            static_cast<size_t>(hidden_size), 1.0f,
+            input->template Data<float>(), static_cast<size_t>(hidden_size),
+            weight->template Data<float>(), static_cast<size_t>(qkv_ld), 0.0f,
+            qkv, static_cast<size_t>(qkv_ld), &qkv_epilogue);
+
+  // Each head has its own [sequence_length, sequence_length] matrix of scores.
+  const int64_t head_count = batch_size * num_heads_;
+  const int64_t scores_size = sequence_length * sequence_length;
+  auto scores_data = alloc->Alloc(sizeof(float) * head_count * scores_size);
+  BufferUniquePtr scores_buffer(scores_data, BufferDeleter(alloc));
+  auto* scores = static_cast<float*>(scores_buffer.get());
+
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(head_size));
+  float* output_data = output->template MutableData<float>();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (head_count * scores_size * head_size >= kAttentionParallelMinOps)
+#endif
+  for (int64_t i = 0; i < head_count; i++) {
+    const int64_t b = i / num_heads_;
+    const int64_t n = i % num_heads_;
+
+    // The head is a column block of the Q, K and V matrices, so it is read with the leading dimension of the
+    // concatenated matrix instead of being transposed to a contiguous buffer.
+    const float* q = qkv + b * sequence_length * qkv_ld + n * head_size;
+    const float* k = q + hidden_size;
+    const float* v = q + 2 * hidden_size;
+    float* head_scores = scores + i * scores_size;
+
+    // scores = Q * K' / sqrt(head_size) + mask, with the mask added by the epilogue.
+    MLAS_SGEMM_EPILOGUE scores_epilogue{MlasSgemmNoBias, nullptr, 0, nullptr};
+    if (mask_data != nullptr) {
+      scores_epilogue.BiasKind = mask_row_count == 1 ? MlasSgemmColumnBias : MlasSgemmMatrixBias;
+      scores_epilogue.Bias = mask_data + b * mask_batch_stride;
+      scores_epilogue.ldbias = static_cast<size_t>(sequence_length);
+    }
+    MlasSgemm(CblasNoTrans, CblasTrans,
+              static_cast<size_t>(sequence_length), static_cast<size_t>(sequence_length),
+              static_cast<size_t>(head_size), alpha,
+              q, static_cast<size_t>(qkv_ld),
+              k, static_cast<size_t>(qkv_ld), 0.0f,
+              head_scores, static_cast<size_t>(sequence_length), &scores_epilogue);
+
+    MlasComputeSoftmax(head_scores, head_scores, static_cast<size_t>(sequence_length),
+                       static_cast<size_t>(sequence_length));
+
+    // The head output is written to its column block of the output, which concatenates the heads.
+    MlasSgemm(CblasNoTrans, CblasNoTrans,
+              static_cast<size_t>(sequence_length), static_cast<size_t>(head_size),
+              static_cast<size_t>(sequence_length), 1.0f,
+              head_scores, static_cast<size_t>(sequence_length),
+              v, static_cast<size_t>(qkv_ld), 0.0f,
+              output_data + b * sequence_length * hidden_size + n * head_size, static_cast<size_t>(hidden_size));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Computes multi-head self attention in a single kernel instead of the MatMul, Reshape, Transpose, MatMul, Div,
+// Add, Softmax, MatMul, Transpose and Reshape chain exported by frameworks. The query, key and value projections
+// are computed by one GEMM, and the heads are read in place from its output instead of being transposed.
+template <typename T>
+class Attention final : public OpKernel {
+ public:
+  explicit Attention(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(info.GetAttr<int64_t>("num_heads", &num_heads_).IsOK() && num_heads_ > 0,
+                "num_heads must be a positive integer");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t num_heads_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
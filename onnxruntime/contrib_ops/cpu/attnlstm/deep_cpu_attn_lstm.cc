@@ -15,6 +15,9 @@ namespace contrib {
 
 using ::onnxruntime::contrib::rnn::detail::UniDirectionalAttnLstm;
 using ::onnxruntime::rnn::detail::Allocate;
+using ::onnxruntime::rnn::detail::ChooseRnnParallelism;
+using ::onnxruntime::rnn::detail::ExecuteLambdaInParallel;
+using ::onnxruntime::rnn::detail::RnnParallelism;
 
 extern template class BahdanauAttention<float>;
 
@@ -272,8 +275,24 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[5],
         clip_, ttp_);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    // the steps of a direction run on a single thread, so the directions are the only work that can be split
+    const RnnParallelism parallelism = ChooseRnnParallelism(num_directions_, seq_length, batch_size, hidden_size_, 4,
+                                                            1, 1,
+                                                            static_cast<int>(std::thread::hardware_concurrency()));
+    if (parallelism.concurrent_directions) {
+      // each direction has its own attention mechanism and writes to separate parts of the outputs
+      auto compute_direction = [&](int direction) {
+        if (direction == 0)
+          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+        else
+          bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+      };
+
+      ExecuteLambdaInParallel("Processing directions", compute_direction, num_directions_, 1, ttp_, logger);
+    } else {
+      fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+      bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    }
 
   } else {
     auto fam = std::make_unique<BahdanauAttention<T>>(
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/compressed_conv.h"
+#include "core/util/math.h"
+#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+#include <algorithm>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    CompressedConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<MLFloat16>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    CompressedConv<float>);
+
+template <typename T>
+Status CompressedConv<T>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = context->Input<Tensor>(1);
+  const Tensor* W_scale = context->Input<Tensor>(2);
+  const Tensor* B = context->Input<Tensor>(3);
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = W->Shape()[0];
+  ORT_RETURN_IF_ERROR(ValidateInputShape(X, W));
+
+  const bool W_is_float16 = W->DataType() == DataTypeImpl::GetType<MLFloat16>();
+  if (W_scale != nullptr) {
+    ORT_RETURN_IF_NOT(W_scale->Shape().NumDimensions() == 1 && W_scale->Shape().Size() == M,
+                      "w_scale must be a 1-D tensor with the number of output channels of W");
+  }
+  ORT_RETURN_IF_NOT(W_is_float16 || W_scale != nullptr, "w_scale is required if W is int8");
+
+  std::vector<int64_t> kernel_shape;
+  ORT_RETURN_IF_ERROR(ComputeKernelShape(W->Shape(), kernel_shape));
+
+  std::vector<int64_t> pads(pads_);
+  if (pads.empty()) {
+    pads.resize(kernel_shape.size() * 2, 0);
+  }
+  std::vector<int64_t> dilations(dilations_);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  std::vector<int64_t> strides(strides_);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  std::vector<int64_t> Y_dims;
+  Y_dims.insert(Y_dims.begin(), {N, M});
+  TensorShape input_shape = X->Shape().Slice(2);
+  ORT_RETURN_IF_ERROR(InferOutputShape(input_shape, kernel_shape, strides, dilations, &pads, &Y_dims));
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(2);
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+  const int64_t X_offset = C / group_ * input_image_size;
+  const int64_t Y_offset = Y->Shape().Size() / Y->Shape()[0] / group_;
+  const int64_t W_offset = W->Shape().Size() / group_;
+  const int64_t kernel_dim = C / group_ * kernel_size;
+  const int64_t col_buffer_size = kernel_dim * output_image_size;
+
+  // a pointwise convolution reads the input image directly
+  const bool is_pointwise =
+      kernel_size == 1 &&
+      std::all_of(strides.begin(), strides.end(), [](int64_t stride) { return stride == 1; }) &&
+      std::all_of(pads.begin(), pads.end(), [](int64_t pad) { return pad == 0; });
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  auto col_data = is_pointwise ? nullptr : alloc->Alloc(sizeof(float) * col_buffer_size);
+  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
+  float* col_buffer_data = static_cast<float*>(col_buffer.get());
+
+  const float* Xdata = X->template Data<float>();
+  float* Ydata = Y->template MutableData<float>();
+  const auto* Wdata = static_cast<const uint8_t*>(W->DataRaw());
+  const size_t W_element_size = W_is_float16 ? sizeof(MLFloat16) : sizeof(int8_t);
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+
+  for (int image_id = 0; image_id < N; ++image_id) {
+    for (int group_id = 0; group_id < group_; ++group_id) {
+      const float* gemm_input = Xdata + group_id * X_offset;
+
+      if (!is_pointwise) {
+        MlasIm2col(Xdata + group_id * X_offset,
+                   col_buffer_data,
+                   kernel_shape.size(),
+                   static_cast<size_t>(C / group_),
+                   input_shape.GetDims().data(),
+                   kernel_shape.data(),
+                   dilations.data(),
+                   pads.data(),
+                   strides.data(),
+                   output_shape.GetDims().data(),
+                   0.0f);
+        gemm_input = col_buffer_data;
+      }
+
+      MLAS_COMPRESSED_MATRIX compressed_w;
+      compressed_w.Format = W_is_float16 ? MlasCompressedFloat16 : MlasCompressedInt8;
+      compressed_w.Data = Wdata + group_id * W_offset * W_element_size;
+      compressed_w.ld = static_cast<size_t>(kernel_dim);
+      compressed_w.Scale = W_scale != nullptr ? W_scale->template Data<float>() + group_id * (M / group_) : nullptr;
+
+      MlasSgemm(CblasNoTrans,
+                static_cast<size_t>(M / group_),
+                static_cast<size_t>(output_image_size),
+                static_cast<size_t>(kernel_dim),
+                1.0f,
+                &compressed_w,
+                gemm_input,
+                static_cast<size_t>(output_image_size),
+                0.0f,
+                Ydata + group_id * Y_offset,
+                static_cast<size_t>(output_image_size));
+    }
+
+    if (B != nullptr) {
+      MlasActivation(&activation, Ydata, B->template Data<float>(), static_cast<size_t>(M), Ydata,
+                     static_cast<size_t>(output_image_size), static_cast<size_t>(output_image_size));
+    }
+
+    Xdata += X_offset * group_;
+    Ydata += Y_offset * group_;
+  }
+
+  return Status::OK();
+}
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/nn/conv_base.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Convolution with a filter stored as float16 or int8. The filter is expanded to float tile by tile while MLAS
+// packs it, so a Conv with constant weights keeps only the compressed weights in memory.
+template <typename T>
+class CompressedConv final : public OpKernel, public ConvBase {
+ public:
+  CompressedConv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+}  // namespace contrib
+}  // namespace onnxruntime
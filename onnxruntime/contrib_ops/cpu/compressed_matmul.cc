@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/compressed_matmul.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/mlas/inc/mlas.h"
+#include <algorithm>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    CompressedMatMul,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<MLFloat16>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    CompressedMatMul<float>);
+
+template <typename T>
+Status CompressedMatMul<T>::Compute(OpKernelContext* ctx) const {
+  auto a = ctx->Input<Tensor>(0);
+  auto b = ctx->Input<Tensor>(1);
+  ORT_ENFORCE(a != nullptr && b != nullptr);
+  ORT_RETURN_IF_NOT(b->Shape().NumDimensions() == 2, "B must be a 2-D tensor");
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  if (M == 0 || N == 0) {
+    return Status::OK();
+  }
+
+  const bool b_is_float16 = b->DataType() == DataTypeImpl::GetType<MLFloat16>();
+
+  const float* b_scale_data = nullptr;
+  auto b_scale = ctx->Input<Tensor>(2);
+  if (b_scale != nullptr) {
+    ORT_RETURN_IF_NOT(b_scale->Shape().NumDimensions() == 1 && b_scale->Shape().Size() == helper.N(),
+                      "b_scale must be a 1-D tensor with the number of columns of B");
+    b_scale_data = b_scale->template Data<float>();
+  }
+  ORT_RETURN_IF_NOT(b_is_float16 || b_scale_data != nullptr, "b_scale is required if B is int8");
+
+  const float* bias_data = nullptr;
+  auto bias = ctx->Input<Tensor>(3);
+  if (bias != nullptr) {
+    ORT_RETURN_IF_NOT(bias->Shape().NumDimensions() == 1 && bias->Shape().Size() == helper.N(),
+                      "bias must be a 1-D tensor with the number of columns of B");
+    bias_data = bias->template Data<float>();
+  }
+
+  MLAS_COMPRESSED_MATRIX compressed_b;
+  compressed_b.Format = b_is_float16 ? MlasCompressedFloat16 : MlasCompressedInt8;
+  compressed_b.Data = b->DataRaw();
+  compressed_b.ld = N;
+  compressed_b.Scale = b_scale_data;
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    float* y_data = y->template MutableData<float>() + helper.OutputOffsets()[i];
+
+    // the bias is accumulated into by the GEMM
+    float beta = 0.0f;
+    if (bias_data != nullptr) {
+      for (size_t m = 0; m < M; m++) {
+        std::copy(bias_data, bias_data + N, y_data + m * N);
+      }
+      beta = 1.0f;
+    }
+
+    MlasSgemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, a->template Data<float>() + helper.LeftOffsets()[i], K,
+              &compressed_b, beta, y_data, N);
+  }
+
+  return Status::OK();
+}
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Multiplies a float A by a B stored as float16 or int8. B is expanded to float tile by tile while MLAS packs it,
+// so a MatMul or Gemm with constant weights keeps only the compressed weights in memory.
+template <typename T>
+class CompressedMatMul final : public OpKernel {
+ public:
+  CompressedMatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+};
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/dynamic_quantize_matmul.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
+#include <cmath>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    DynamicQuantizeMatMul,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    DynamicQuantizeMatMul<float>);
+
+template <typename T>
+void DynamicQuantizeMatMul<T>::PrePackB(const OpKernelInfo& info) {
+  const Tensor* b;
+  if (!info.TryGetConstantInput(1, &b) || b->Shape().NumDimensions() != 2)
+    return;
+
+  const Tensor* b_zero_point = nullptr;
+  if (info.GetInputCount() > 3 && info.node().InputDefs()[3]->Exists() &&
+      (!info.TryGetConstantInput(3, &b_zero_point) || b_zero_point->Shape().Size() != 1))
+    return;
+
+  const size_t K = static_cast<size_t>(b->Shape()[0]);
+  const size_t N = static_cast<size_t>(b->Shape()[1]);
+  packed_b_.resize(MlasQgemmPackBSize(N, K));
+
+  if (b->DataType() == DataTypeImpl::GetType<int8_t>()) {
+    const int8_t b_offset = b_zero_point != nullptr ? *b_zero_point->template Data<int8_t>() : 0;
+    MlasQgemmPackB(N, K, b->template Data<int8_t>(), N, b_offset, packed_b_.data());
+  } else {
+    const uint8_t b_offset = b_zero_point != nullptr ? *b_zero_point->template Data<uint8_t>() : 0;
+    MlasQgemmPackB(N, K, b->template Data<uint8_t>(), N, b_offset, packed_b_.data());
+  }
+}
+
+template <typename T>
+Status DynamicQuantizeMatMul<T>::Compute(OpKernelContext* ctx) const {
+  auto a = ctx->Input<Tensor>(0);
+  auto b = ctx->Input<Tensor>(1);
+  ORT_ENFORCE(a != nullptr && b != nullptr);
+  ORT_RETURN_IF_NOT(b->Shape().NumDimensions() == 2, "B must be a 2-D tensor");
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  auto b_scale = ctx->Input<Tensor>(2);
+  const int64_t b_scale_size = b_scale->Shape().Size();
+  ORT_RETURN_IF_NOT(b_scale_size == 1 || (b_scale->Shape().NumDimensions() == 1 && b_scale_size == helper.N()),
+                    "b_scale must be a scalar or a 1-D tensor with the number of columns of B");
+  const float* b_scale_data = b_scale->template Data<float>();
+
+  const bool b_is_signed = b->DataType() == DataTypeImpl::GetType<int8_t>();
+  int32_t b_offset = 0;
+  auto b_zero_point = ctx->Input<Tensor>(3);
+  if (b_zero_point != nullptr) {
+    ORT_RETURN_IF_NOT(b_zero_point->Shape().Size() == 1, "b_zero_point must be a scalar");
+    b_offset = b_is_signed ? static_cast<int32_t>(*b_zero_point->template Data<int8_t>())
+                           : static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
+  }
+
+  const float* bias_data = nullptr;
+  auto bias = ctx->Input<Tensor>(4);
+  if (bias != nullptr) {
+    ORT_RETURN_IF_NOT(bias->Shape().NumDimensions() == 1 && bias->Shape().Size() == helper.N(),
+                      "bias must be a 1-D tensor with the number of columns of B");
+    bias_data = bias->template Data<float>();
+  }
+
+  // Quantize A to uint8 using its range extended to include zero, so that zero is exactly representable.
+  const float* a_data = a->template Data<float>();
+  const size_t a_size = static_cast<size_t>(a->Shape().Size());
+  float a_min = 0.0f;
+  float a_max = 0.0f;
+  if (a_size > 0) {
+    ConstEigenVectorArrayMap<float> a_values(a_data, static_cast<ptrdiff_t>(a_size));
+    a_min = std::min(a_min, a_values.minCoeff());
+    a_max = std::max(a_max, a_values.maxCoeff());
+  }
+
+  float a_scale = (a_max - a_min) / 255.0f;
+  uint8_t a_zero_point = 0;
+  if (a_scale > 0.0f) {
+    a_zero_point = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, std::nearbyint(-a_min / a_scale))));
+  } else {
+    // A is all zeros
+    a_scale = 1.0f;
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto quantized_a_data = alloc->Alloc(sizeof(uint8_t) * a_size);
+  BufferUniquePtr quantized_a_buffer(quantized_a_data, BufferDeleter(alloc));
+  auto* quantized_a = static_cast<uint8_t*>(quantized_a_buffer.get());
+
+  MlasQuantizeLinear(a_data, quantized_a, 1, 1, a_size, &a_scale, &a_zero_point);
+
+  // one scratch matrix for the 32-bit result is reused for every matrix of the batch
+  auto gemm_output_data = alloc->Alloc(sizeof(int32_t) * M * N);
+  BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
+  auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    const uint8_t* a_matrix = quantized_a + helper.LeftOffsets()[i];
+
+    if (!packed_b_.empty()) {
+      MlasQgemmPackedB(M, N, K, a_matrix, K, a_zero_point, packed_b_.data(), gemm_output, N, nullptr);
+    } else if (b_is_signed) {
+      MlasQgemm(M, N, K, a_matrix, K, a_zero_point, b->template Data<int8_t>() + helper.RightOffsets()[i], N,
+                static_cast<int8_t>(b_offset), gemm_output, N, nullptr);
+    } else {
+      MlasQgemm(M, N, K, a_matrix, K, a_zero_point, b->template Data<uint8_t>() + helper.RightOffsets()[i], N,
+                static_cast<uint8_t>(b_offset), gemm_output, N, nullptr);
+    }
+
+    // scale the integer result back to float and add the bias
+    float* y_data = y->template MutableData<float>() + helper.OutputOffsets()[i];
+    for (size_t m = 0; m < M; m++) {
+      const int32_t* gemm_row = gemm_output + m * N;
+      float* y_row = y_data + m * N;
+      for (size_t n = 0; n < N; n++) {
+        const float scale = a_scale * b_scale_data[b_scale_size == 1 ? 0 : n];
+        y_row[n] = static_cast<float>(gemm_row[n]) * scale + (bias_data != nullptr ? bias_data[n] : 0.0f);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Multiplies a float A by an 8-bit quantized B. A is quantized to uint8 on every call using its own range, so a
+// float MatMul or Gemm with constant weights can run on the integer GEMM without calibration data.
+template <typename T>
+class DynamicQuantizeMatMul final : public OpKernel {
+ public:
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    PrePackB(info);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // packs a constant 2D B with a constant zero point for MlasQgemmPackedB
+  void PrePackB(const OpKernelInfo& info);
+
+  std::vector<uint8_t> packed_b_;
+};
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cpu/rnn/deep_cpu_gru.h"
+#include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LSTM and GRU with the weights quantized to int8 once, and the activations quantized to uint8 as the
+// matrix multiplications use them. The inputs, outputs and attributes are those of the ONNX operators.
+class DynamicQuantizeLSTM final : public DeepCpuLstmOp {
+ public:
+  DynamicQuantizeLSTM(const OpKernelInfo& info) : DeepCpuLstmOp(info, true) {}
+};
+
+class DynamicQuantizeGRU final : public DeepCpuGruOp {
+ public:
+  DynamicQuantizeGRU(const OpKernelInfo& info) : DeepCpuGruOp(info, true) {}
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embedding_bag.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    EmbeddingBag,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag<float>);
+
+// Minimum number of accumulated elements before the bags are spread across threads.
+static constexpr int64_t kEmbeddingBagParallelMinElements = 64 * 1024;
+
+template <typename T>
+Status EmbeddingBag<T>::Compute(OpKernelContext* context) const {
+  const Tensor* indices = context->Input<Tensor>(1);
+  if (indices->DataType() == DataTypeImpl::GetType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename T>
+template <typename Tind>
+Status EmbeddingBag<T>::ComputeImpl(OpKernelContext* context) const {
+  const Tensor* weight = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+  const Tensor* offsets = context->Input<Tensor>(2);
+  const Tensor* per_sample_weights = context->Input<Tensor>(3);
+
+  const TensorShape& weight_shape = weight->Shape();
+  const TensorShape& indices_shape = indices->Shape();
+  if (weight_shape.NumDimensions() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "weight must be 2-D, got ", weight_shape);
+  }
+  const int64_t num_embeddings = weight_shape[0];
+  const int64_t embedding_dim = weight_shape[1];
+  const int64_t num_indices = indices_shape.Size();
+
+  // A 2-D indices tensor holds one fixed size bag per row. A 1-D indices tensor is split into bags by offsets.
+  int64_t num_bags = 0;
+  int64_t bag_size = 0;
+  const Tind* offsets_data = nullptr;
+  if (indices_shape.NumDimensions() == 2) {
+    if (offsets != nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "offsets must not be provided when indices is 2-D");
+    }
+    num_bags = indices_shape[0];
+    bag_size = indices_shape[1];
+  } else if (indices_shape.NumDimensions() == 1) {
+    if (offsets == nullptr || offsets->Shape().NumDimensions() != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "1-D indices require a 1-D offsets tensor");
+    }
+    num_bags = offsets->Shape()[0];
+    offsets_data = offsets->template Data<Tind>();
+    for (int64_t b = 0; b < num_bags; ++b) {
+      const int64_t end = b + 1 < num_bags ? static_cast<int64_t>(offsets_data[b + 1]) : num_indices;
+      if (offsets_data[b] < 0 || offsets_data[b] > end || end > num_indices) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "offsets must be non-decreasing and within [0, ", num_indices, "]");
+      }
+    }
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices must be 1-D or 2-D, got ", indices_shape);
+  }
+
+  const T* weights_data = nullptr;
+  if (per_sample_weights != nullptr) {
+    if (mean_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "per_sample_weights are only supported with mode 'sum'");
+    }
+    if (per_sample_weights->Shape() != indices_shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "per_sample_weights must have the shape of indices");
+    }
+    weights_data = per_sample_weights->template Data<T>();
+  }
+
+  const Tind* indices_data = indices->template Data<Tind>();
+  if (!GatherIndicesInRange(indices_data, num_indices, num_embeddings)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=",
+                           FindInvalidGatherIndex(indices_data, num_indices, num_embeddings),
+                           " data_dim=", num_embeddings);
+  }
+
+  Tensor* output = context->Output(0, TensorShape({num_bags, embedding_dim}));
+  const T* table = weight->template Data<T>();
+  T* output_data = output->template MutableData<T>();
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (num_indices * embedding_dim >= kEmbeddingBagParallelMinElements)
+#endif
+  for (int64_t b = 0; b < num_bags; ++b) {
+    int64_t begin;
+    int64_t end;
+    if (offsets_data != nullptr) {
+      begin = offsets_data[b];
+      end = b + 1 < num_bags ? static_cast<int64_t>(offsets_data[b + 1]) : num_indices;
+    } else {
+      begin = b * bag_size;
+      end = begin + bag_size;
+    }
+
+    auto bag = EigenVectorArrayMap<T>(output_data + b * embedding_dim, embedding_dim);
+    bag.setZero();
+
+    for (int64_t i = begin; i < end; ++i) {
+      if (i + kGatherPrefetchDistance < end) {
+        PrefetchGatherRow(table + indices_data[i + kGatherPrefetchDistance] * embedding_dim);
+      }
+      auto row = ConstEigenVectorArrayMap<T>(table + indices_data[i] * embedding_dim, embedding_dim);
+      if (weights_data != nullptr) {
+        bag += row * weights_data[i];
+      } else {
+        bag += row;
+      }
+    }
+
+    if (mean_ && end > begin) {
+      bag /= static_cast<T>(end - begin);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
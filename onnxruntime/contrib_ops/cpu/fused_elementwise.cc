@@ -0,0 +1,301 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    FusedElementwise,
+    1,
+    float,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise<float>);
+
+// Number of elements evaluated by each pass over the program. The scratch registers of a block stay in the L1 cache.
+static constexpr int64_t kFusedElementwiseBlockSize = 256;
+
+// Number of elements evaluated by each task, which allocates its own scratch registers.
+static constexpr int64_t kFusedElementwiseTaskSize = 64 * kFusedElementwiseBlockSize;
+
+namespace {
+using OperatorFunc = FusedElementwise<float>::OperatorFunc;
+using Array = EigenVectorArrayMap<float>;
+using ConstArray = ConstEigenVectorArrayMap<float>;
+
+// The Eigen array expressions are vectorized. The transcendental functions without a fast Eigen implementation are
+// computed by MLAS.
+#define FUSED_ELEMENTWISE_UNARY_OPERATOR(name, expression)                                         \
+  void Compute##name(const float* x, const float*, float* z, int64_t n, float alpha, float beta) { \
+    ORT_UNUSED_PARAMETER(alpha);                                                                   \
+    ORT_UNUSED_PARAMETER(beta);                                                                    \
+    ConstArray X(x, n);                                                                            \
+    Array(z, n) = expression;                                                                      \
+  }
+
+#define FUSED_ELEMENTWISE_BINARY_OPERATOR(name, expression)                               \
+  void Compute##name(const float* x, const float* y, float* z, int64_t n, float, float) { \
+    ConstArray X(x, n);                                                                   \
+    ConstArray Y(y, n);                                                                   \
+    Array(z, n) = expression;                                                             \
+  }
+
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Abs, X.abs())
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Ceil, X.ceil())
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Clip, X.max(alpha).min(beta))
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Exp, X.exp())
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Floor, X.floor())
+FUSED_ELEMENTWISE_UNARY_OPERATOR(LeakyRelu, (X >= 0.0f).select(X, alpha * X))
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Log, X.log())
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Neg, -X)
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Reciprocal, X.inverse())
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Relu, X.max(0.0f))
+FUSED_ELEMENTWISE_UNARY_OPERATOR(Sqrt, X.sqrt())
+
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Add, X + Y)
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Div, X / Y)
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Max, X.max(Y))
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Min, X.min(Y))
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Mul, X * Y)
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Pow, Eigen::pow(X, Y))
+FUSED_ELEMENTWISE_BINARY_OPERATOR(Sub, X - Y)
+
+#undef FUSED_ELEMENTWISE_UNARY_OPERATOR
+#undef FUSED_ELEMENTWISE_BINARY_OPERATOR
+
+void ComputeErf(const float* x, const float*, float* z, int64_t n, float, float) {
+  MlasComputeErf(x, z, static_cast<size_t>(n));
+}
+
+void ComputeGelu(const float* x, const float*, float* z, int64_t n, float, float) {
+  MlasComputeGelu(x, z, static_cast<size_t>(n));
+}
+
+void ComputeSigmoid(const float* x, const float*, float* z, int64_t n, float, float) {
+  MlasComputeLogistic(x, z, static_cast<size_t>(n));
+}
+
+void ComputeTanh(const float* x, const float*, float* z, int64_t n, float, float) {
+  MlasComputeTanh(x, z, static_cast<size_t>(n));
+}
+
+struct OperatorEntry {
+  OperatorFunc func;
+  bool is_binary;
+};
+
+// The operators the fusion may put in a program, keyed by the ONNX operator name.
+const std::unordered_map<std::string, OperatorEntry>& OperatorTable() {
+  static const std::unordered_map<std::string, OperatorEntry> table = {
+      {"Abs", {ComputeAbs, false}},
+      {"Ceil", {ComputeCeil, false}},
+      {"Clip", {ComputeClip, false}},
+      {"Erf", {ComputeErf, false}},
+      {"Exp", {ComputeExp, false}},
+      {"Floor", {ComputeFloor, false}},
+      {"Gelu", {ComputeGelu, false}},
+      {"LeakyRelu", {ComputeLeakyRelu, false}},
+      {"Log", {ComputeLog, false}},
+      {"Neg", {ComputeNeg, false}},
+      {"Reciprocal", {ComputeReciprocal, false}},
+      {"Relu", {ComputeRelu, false}},
+      {"Sigmoid", {ComputeSigmoid, false}},
+      {"Sqrt", {ComputeSqrt, false}},
+      {"Tanh", {ComputeTanh, false}},
+      {"Add", {ComputeAdd, true}},
+      {"Div", {ComputeDiv, true}},
+      {"Max", {ComputeMax, true}},
+      {"Min", {ComputeMin, true}},
+      {"Mul", {ComputeMul, true}},
+      {"Pow", {ComputePow, true}},
+      {"Sub", {ComputeSub, true}},
+  };
+  return table;
+}
+}  // namespace
+
+template <>
+FusedElementwise<float>::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(), "ops must not be empty");
+  ORT_ENFORCE(info.GetAttrs<int64_t>("operands", operands).IsOK() && operands.size() == 2 * ops.size(),
+              "operands must have two values for each of the ", ops.size(), " instructions");
+  const auto alphas = info.GetAttrsOrDefault<float>("alphas", std::vector<float>(ops.size(), 0.0f));
+  const auto betas = info.GetAttrsOrDefault<float>("betas", std::vector<float>(ops.size(), 0.0f));
+  ORT_ENFORCE(alphas.size() == ops.size() && betas.size() == ops.size(),
+              "alphas and betas must have one value for each of the ", ops.size(), " instructions");
+
+  input_count_ = static_cast<int64_t>(info.GetInputCount());
+  const auto instruction_count = static_cast<int64_t>(ops.size());
+
+  // The register of a result is released after its last use, so later results can reuse it.
+  std::vector<int64_t> last_use(ops.size(), -1);
+  for (int64_t i = 0; i < instruction_count; i++) {
+    auto it = OperatorTable().find(ops[i]);
+    ORT_ENFORCE(it != OperatorTable().end(), "Unsupported operator ", ops[i], " in instruction ", i);
+    const int64_t operand_count = it->second.is_binary ? 2 : 1;
+    for (int64_t j = 0; j < 2; j++) {
+      const int64_t operand = operands[2 * i + j];
+      if (j < operand_count) {
+        ORT_ENFORCE(operand >= 0 && operand < input_count_ + i, "Operand ", j, " of instruction ", i,
+                    " must refer to an input or an earlier instruction, got ", operand);
+        if (operand >= input_count_) {
+          last_use[operand - input_count_] = i;
+        }
+      } else {
+        ORT_ENFORCE(operand == -1, "Operand ", j, " of the unary instruction ", i, " must be -1, got ", operand);
+      }
+    }
+    program_.push_back({it->second.func, {operands[2 * i], operands[2 * i + 1]}, alphas[i], betas[i], -1});
+  }
+
+  register_count_ = 0;
+  std::vector<int64_t> free_registers;
+  for (int64_t i = 0; i < instruction_count; i++) {
+    Instruction& instruction = program_[i];
+    for (int64_t j = 0; j < 2; j++) {
+      const int64_t operand = instruction.operands[j];
+      if (operand >= input_count_ && last_use[operand - input_count_] == i &&
+          (j == 0 || operand != instruction.operands[0])) {
+        free_registers.push_back(program_[operand - input_count_].result_register);
+      }
+    }
+    if (i == instruction_count - 1) {
+      break;
+    }
+    if (free_registers.empty()) {
+      instruction.result_register = register_count_++;
+    } else {
+      instruction.result_register = free_registers.back();
+      free_registers.pop_back();
+    }
+  }
+}
+
+template <>
+void FusedElementwise<float>::EvaluateRange(const std::vector<const float*>& inputs,
+                                            const std::vector<int64_t>& input_sizes, float* output, int64_t start,
+                                            int64_t count) const {
+  // The registers are followed by one block for each input, used when the block of the input wraps around its end.
+  std::vector<float> scratch(static_cast<size_t>((register_count_ + input_count_) * kFusedElementwiseBlockSize));
+  std::vector<const float*> values(static_cast<size_t>(input_count_) + program_.size());
+
+  for (int64_t i = 0; i < input_count_; i++) {
+    if (input_sizes[i] == 1) {
+      float* block = scratch.data() + (register_count_ + i) * kFusedElementwiseBlockSize;
+      std::fill_n(block, kFusedElementwiseBlockSize, *inputs[i]);
+      values[i] = block;
+    }
+  }
+
+  for (int64_t block_start = start; block_start < start + count; block_start += kFusedElementwiseBlockSize) {
+    const int64_t n = std::min(kFusedElementwiseBlockSize, start + count - block_start);
+
+    // An input smaller than the output repeats with the period of its size.
+    for (int64_t i = 0; i < input_count_; i++) {
+      const int64_t size = input_sizes[i];
+      const int64_t offset = block_start % size;
+      if (size == 1) {
+        continue;
+      }
+      if (offset + n <= size) {
+        values[i] = inputs[i] + offset;
+        continue;
+      }
+      float* block = scratch.data() + (register_count_ + i) * kFusedElementwiseBlockSize;
+      for (int64_t j = 0, k = offset; j < n; k = 0) {
+        const int64_t run = std::min(n - j, size - k);
+        std::copy_n(inputs[i] + k, run, block + j);
+        j += run;
+      }
+      values[i] = block;
+    }
+
+    for (size_t i = 0; i < program_.size(); i++) {
+      const Instruction& instruction = program_[i];
+      float* result = instruction.result_register < 0
+                          ? output + block_start
+                          : scratch.data() + instruction.result_register * kFusedElementwiseBlockSize;
+      instruction.func(values[instruction.operands[0]],
+                       instruction.operands[1] >= 0 ? values[instruction.operands[1]] : nullptr,
+                       result, n, instruction.alpha, instruction.beta);
+      values[input_count_ + i] = result;
+    }
+  }
+}
+
+template <>
+Status FusedElementwise<float>::Compute(OpKernelContext* context) const {
+  // The output has the broadcast shape of the inputs.
+  std::vector<const Tensor*> input_tensors(static_cast<size_t>(input_count_));
+  size_t rank = 0;
+  for (int64_t i = 0; i < input_count_; i++) {
+    input_tensors[i] = context->Input<Tensor>(static_cast<int>(i));
+    rank = std::max(rank, input_tensors[i]->Shape().NumDimensions());
+  }
+  std::vector<int64_t> output_dims(rank, 1);
+  for (const Tensor* input : input_tensors) {
+    const auto& dims = input->Shape().GetDims();
+    for (size_t j = 0; j < dims.size(); j++) {
+      int64_t& output_dim = output_dims[rank - dims.size() + j];
+      if (dims[j] != 1) {
+        if (output_dim != 1 && output_dim != dims[j]) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The input shapes can't be broadcast, got ",
+                                 input->Shape());
+        }
+        output_dim = dims[j];
+      }
+    }
+  }
+  TensorShape output_shape(output_dims);
+
+  // Each input is read with the period of its size, so it must be a scalar or broadcast from the trailing
+  // dimensions of the output.
+  std::vector<const float*> inputs(static_cast<size_t>(input_count_));
+  std::vector<int64_t> input_sizes(static_cast<size_t>(input_count_));
+  for (int64_t i = 0; i < input_count_; i++) {
+    const auto& input_shape = input_tensors[i]->Shape();
+    const auto& dims = input_shape.GetDims();
+    size_t first = 0;
+    while (first < dims.size() && dims[first] == 1) {
+      first++;
+    }
+    for (size_t j = first; j < dims.size(); j++) {
+      if (dims[j] != output_dims[rank - dims.size() + j]) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", i, " with shape ", input_shape,
+                               " is not broadcast from the trailing dimensions of the output shape ", output_shape);
+      }
+    }
+    inputs[i] = input_tensors[i]->template Data<float>();
+    input_sizes[i] = input_shape.Size();
+  }
+
+  Tensor* Y = context->Output(0, output_shape);
+  const int64_t output_size = output_shape.Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+  float* output = Y->template MutableData<float>();
+
+  const int64_t task_count = (output_size + kFusedElementwiseTaskSize - 1) / kFusedElementwiseTaskSize;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (task_count > 1)
+#endif
+  for (int64_t task = 0; task < task_count; task++) {
+    const int64_t start = task * kFusedElementwiseTaskSize;
+    EvaluateRange(inputs, input_sizes, output, start, std::min(kFusedElementwiseTaskSize, output_size - start));
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Evaluates a program of elementwise operators fused from the graph. The program is compiled when the kernel is
+// created: each instruction is bound to a vectorized operator from a table and its result to a scratch register of
+// one block. The output is then computed block by block, so the intermediate results stay in the cache.
+template <typename T>
+class FusedElementwise final : public OpKernel {
+ public:
+  // Computes z = op(x, y) for n elements. y is nullptr for unary operators.
+  using OperatorFunc = void (*)(const T* x, const T* y, T* z, int64_t n, float alpha, float beta);
+
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  struct Instruction {
+    OperatorFunc func;
+    int64_t operands[2];  // value indices: the inputs and then the instruction results; -1 if unused
+    float alpha;
+    float beta;
+    int64_t result_register;  // -1 for the last instruction, which writes to the output
+  };
+
+  void EvaluateRange(const std::vector<const T*>& inputs, const std::vector<int64_t>& input_sizes, T* output,
+                     int64_t start, int64_t count) const;
+
+  std::vector<Instruction> program_;
+  int64_t input_count_;
+  int64_t register_count_;
+};
+
+// The kernel registration creates the kernel, so the specialized constructor must be declared before it.
+template <>
+FusedElementwise<float>::FusedElementwise(const OpKernelInfo& info);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "contrib_ops/cpu/gather_nd.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
 
 namespace onnxruntime {
 namespace contrib     {
@@ -95,14 +96,13 @@ Status GatherND::Compute(OpKernelContext* context) const {
 }
 
 Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy,
-           p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+  const uint8_t* input_base = p.input_base;
+  const uint64_t* element_offsets = p.element_offsets.data();
+  const uint64_t element_bytes = p.element_bytes;
+  GatherRows(static_cast<int64_t>(p.element_offsets.size()), static_cast<size_t>(p.bytes_to_copy), p.output_base,
+             [input_base, element_offsets, element_bytes](int64_t i) {
+               return input_base + element_offsets[i] * element_bytes;
+             });
   return Status::OK();
 }
 
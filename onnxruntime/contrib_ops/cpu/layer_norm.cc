@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/layer_norm.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    LayerNormalization,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    LayerNorm<float>);
+
+template <>
+Status LayerNorm<float>::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* scale = context->Input<Tensor>(1);
+  const Tensor* B = context->Input<Tensor>(2);
+
+  const TensorShape& x_shape = X->Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
+  const int64_t row_count = x_shape.SizeToDimension(axis);
+  const int64_t row_size = x_shape.SizeFromDimension(axis);
+
+  if (scale->Shape().Size() != row_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "scale must have ", row_size,
+                           " elements to match the normalized dimensions of X, got ", scale->Shape());
+  }
+  if (B != nullptr && B->Shape().Size() != row_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "B must have ", row_size,
+                           " elements to match the normalized dimensions of X, got ", B->Shape());
+  }
+
+  Tensor* Y = context->Output(0, x_shape);
+
+  MlasLayerNormalization(X->template Data<float>(),
+                         Y->template MutableData<float>(),
+                         static_cast<size_t>(row_count),
+                         static_cast<size_t>(row_size),
+                         scale->template Data<float>(),
+                         B != nullptr ? B->template Data<float>() : nullptr,
+                         epsilon_);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -8,11 +8,14 @@
 
 #include "contrib_ops/cpu/matmul_integer.h"
 #include "core/providers/cpu/math/matmul_helper.h"
-#include "core/util/gemmlowp_common_wrapper.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+template<>
+void MatMulInteger<uint8_t, uint8_t, int32_t>::PrePackB(const OpKernelInfo& info);
+
 // only register this operator if low precision computation is enabled.
 ONNX_OPERATOR_KERNEL_EX(
     MatMulInteger,
@@ -21,26 +24,31 @@ ONNX_OPERATOR_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger<uint8_t, uint8_t, int32_t>);
 
-Status GemmlowpMultiply(const uint8_t* lhs_data, const uint8_t* rhs_data,
-                        int32_t* result_data, const int lhs_offset, const int rhs_offset,
-                        int m, int n, int k) {
-  const std::tuple<> empty_pipeline = {};
-  // TODO exp ColMajor order for rhs and result. That may be faster
-  const auto matOrder = gemmlowp::MapOrder::RowMajor;
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> lhs(lhs_data, m, k);
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> rhs(rhs_data, k, n);
-  gemmlowp::MatrixMap<std::int32_t, matOrder> result(result_data, m, n);
-
-  gemmlowp::GemmContext gemm_context;
-  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::int32_t,
-                                   gemmlowp::DefaultL8R8BitDepthParams>(
-      &gemm_context, lhs, rhs, &result, -lhs_offset, -rhs_offset, empty_pipeline);
+template<>
+void MatMulInteger<uint8_t, uint8_t, int32_t>::PrePackB(const OpKernelInfo& info) {
+  const Tensor* b;
+  if (!info.TryGetConstantInput(1, &b) || b->Shape().NumDimensions() != 2)
+    return;
 
-  return Status::OK();
+  const Tensor* b_zero_point = nullptr;
+  if (has_b_zero_point_ && (!info.TryGetConstantInput(3, &b_zero_point) || b_zero_point->Shape().Size() != 1))
+    return;
+
+  const size_t K = static_cast<size_t>(b->Shape()[0]);
+  const size_t N = static_cast<size_t>(b->Shape()[1]);
+  packed_b_.resize(MlasQgemmPackBSize(N, K));
+
+  if (b->DataType() == DataTypeImpl::GetType<int8_t>()) {
+    const int8_t b_offset = b_zero_point != nullptr ? *b_zero_point->template Data<int8_t>() : 0;
+    MlasQgemmPackB(N, K, b->template Data<int8_t>(), N, b_offset, packed_b_.data());
+  } else {
+    const uint8_t b_offset = b_zero_point != nullptr ? *b_zero_point->template Data<uint8_t>() : 0;
+    MlasQgemmPackB(N, K, b->template Data<uint8_t>(), N, b_offset, packed_b_.data());
+  }
 }
 
 template<>
@@ -53,36 +61,47 @@ Status MatMulInteger<uint8_t, uint8_t, int32_t>::Compute(OpKernelContext* ctx) c
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
+  const bool b_is_signed = b->DataType() == DataTypeImpl::GetType<int8_t>();
+
   // validate zero points
-  int32_t a_offset = 0;
+  uint8_t a_offset = 0;
   int32_t b_offset = 0;
   if (has_a_zero_point_) {
     auto a_zero_point = ctx->Input<Tensor>(2);
     ORT_ENFORCE(a_zero_point->Shape().NumDimensions() == 0 || 
         (a_zero_point->Shape().NumDimensions() == 1 && a_zero_point->Shape().GetDims().size() == 1), 
         "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
-    a_offset = static_cast<int32_t>(*a_zero_point->template Data<uint8_t>());
+    a_offset = *a_zero_point->template Data<uint8_t>();
   }
   if (has_b_zero_point_) {
     auto b_zero_point = ctx->Input<Tensor>(3);
     ORT_ENFORCE(b_zero_point->Shape().NumDimensions() == 0 || 
         (b_zero_point->Shape().NumDimensions() == 1 && b_zero_point->Shape().GetDims().size() == 1),
         "Currently only scalar zero_point is supported. TODO: add per channel zero point support.");
-    b_offset = static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
+    b_offset = b_is_signed ? static_cast<int32_t>(*b_zero_point->template Data<int8_t>())
+                           : static_cast<int32_t>(*b_zero_point->template Data<uint8_t>());
   }
 
-  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiply(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                     b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                     y->template MutableData<int32_t>() + helper.OutputOffsets()[i],
-                     a_offset,
-                     b_offset,
-                     static_cast<int>(helper.M()),
-                     static_cast<int>(helper.N()),
-                     static_cast<int>(helper.K()));
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    const uint8_t* a_data = a->template Data<uint8_t>() + helper.LeftOffsets()[i];
+    int32_t* y_data = y->template MutableData<int32_t>() + helper.OutputOffsets()[i];
+
+    if (!packed_b_.empty()) {
+      MlasQgemmPackedB(M, N, K, a_data, K, a_offset, packed_b_.data(), y_data, N, nullptr);
+    } else if (b_is_signed) {
+      MlasQgemm(M, N, K, a_data, K, a_offset, b->template Data<int8_t>() + helper.RightOffsets()[i], N,
+                static_cast<int8_t>(b_offset), y_data, N, nullptr);
+    } else {
+      MlasQgemm(M, N, K, a_data, K, a_offset, b->template Data<uint8_t>() + helper.RightOffsets()[i], N,
+                static_cast<uint8_t>(b_offset), y_data, N, nullptr);
+    }
   }
 
   return Status::OK();
 }
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
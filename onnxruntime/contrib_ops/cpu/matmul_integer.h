@@ -22,13 +22,18 @@ class MatMulInteger final : public OpKernel {
     if (info.GetInputCount() > 3) {
       has_b_zero_point_ = true;
     }
+    PrePackB(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  // packs a constant 2D B with a constant zero point for MlasQgemmPackedB
+  void PrePackB(const OpKernelInfo& info);
+
   bool has_a_zero_point_;
   bool has_b_zero_point_;
+  std::vector<uint8_t> packed_b_;
 };
 }  // namespace contrib
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
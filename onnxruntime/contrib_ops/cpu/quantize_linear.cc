@@ -4,6 +4,7 @@
 #include "contrib_ops/cpu/quantize_linear.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
 #include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -45,43 +46,26 @@ Status DequantizeLinear<T>::Compute(OpKernelContext* ctx) const {
   const auto& zero_point_shape = x_zero_point.Shape();
   const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
 
-  size_t stride = 0;
   const auto& broadcastDim = x_shape[axis];
 
   if (has_axis_) {
     // if an axis was specified, ensure the scale and zero point are compatible
     ORT_ENFORCE(scale_shape.NumDimensions() == 1 && scale_shape.Size() == broadcastDim, "x_scale must be 1D tensor with size ", broadcastDim);
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 1 && zero_point_shape.Size() == broadcastDim, "x_zero_point must be 1D tensor with size ", broadcastDim);
-    stride = 1;
   } else {
     // if no axis, enforce that scale and zero point are scalars
     ORT_ENFORCE(scale_shape.NumDimensions() == 0, "x_scale must be a scalar if no axis is provided");
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 0, "x_zero_point must be a scalar if no axis is provided");
   }
 
-  size_t N = x_shape.SizeToDimension(axis);
-  const T* zero_point = x_zero_point.template Data<T>();
-  const float* scale = x_scale.template Data<float>();
-  size_t block_size = x_shape.SizeFromDimension(axis + 1);
-  const T* input = x.template Data<T>();
-  float* output = y.template MutableData<float>();
+  // Without an axis the scale and zero point apply to the whole tensor, so
+  // process it as a single block.
+  const size_t N = has_axis_ ? static_cast<size_t>(x_shape.SizeToDimension(axis)) : 1;
+  const size_t channel_count = has_axis_ ? static_cast<size_t>(broadcastDim) : 1;
+  const size_t block_size = static_cast<size_t>(has_axis_ ? x_shape.SizeFromDimension(axis + 1) : x_shape.Size());
 
-  for (size_t n = 0; n < N; n++) {
-    const float* current_scale = scale;
-    const T* current_zero_point = zero_point;
-
-    for (size_t bd = 0; bd < static_cast<size_t>(broadcastDim); bd++) {
-      auto zp = static_cast<const int>(*current_zero_point);
-      auto sc = *current_scale;
-
-      for (size_t bs = 0; bs < block_size; bs++) {
-        *output++ = static_cast<float>(static_cast<const int>(*input++) - zp) * sc;
-      }
-
-      current_scale += stride;
-      current_zero_point += stride;
-    }
-  }
+  MlasDequantizeLinear(x.template Data<T>(), y.template MutableData<float>(), N, channel_count, block_size,
+                       x_scale.template Data<float>(), x_zero_point.template Data<T>());
 
   return Status::OK();
 }
@@ -94,20 +78,14 @@ ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
         .TypeConstraint("axis", DataTypeImpl::GetType<int64_t>())
         .TypeConstraint("x", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("y_scale", DataTypeImpl::GetTensorType<float>())
-        .TypeConstraint("y_zero_point", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("y", DataTypeImpl::GetTensorType<uint8_t>()),
+        .TypeConstraint("y_zero_point", std::vector<MLDataType>{DataTypeImpl::GetTensorType<uint8_t>(),
+                                                                DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("y", std::vector<MLDataType>{DataTypeImpl::GetTensorType<uint8_t>(),
+                                                     DataTypeImpl::GetTensorType<int8_t>()}),
     QuantizeLinear<float>);
 
-// clamp doesn't exist in the version of <algorithm> that we're using, so
-// make a local one.
-static float clamp(float v, float lo, float hi) {
-  if (v < lo) return lo;
-  if (v > hi) return hi;
-  return v;
-}
-
 template <>
-// formula is Y = X / Scale + ZeroPoint
+// formula is Y = X / Scale + ZeroPoint, rounding halfway cases to even
 Status QuantizeLinear<float>::Compute(OpKernelContext* ctx) const {
   auto& x = *ctx->Input<Tensor>(0);
   auto& y_scale = *ctx->Input<Tensor>(1);
@@ -119,42 +97,32 @@ Status QuantizeLinear<float>::Compute(OpKernelContext* ctx) const {
   const auto& zero_point_shape = y_zero_point.Shape();
   const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
 
-  size_t stride = 0;
   const auto& broadcastDim = x_shape[axis];
 
   if (has_axis_) {
     // if an axis was specified, ensure the scale and zero point are compatible
     ORT_ENFORCE(scale_shape.NumDimensions() == 1 && scale_shape.Size() == broadcastDim, "x_scale must be 1D tensor with size ", broadcastDim);
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 1 && zero_point_shape.Size() == broadcastDim, "x_zero_point must be 1D tensor with size ", broadcastDim);
-    stride = 1;
   } else {
     // if no axis, enforce that scale and zero point are scalars
     ORT_ENFORCE(scale_shape.NumDimensions() == 0, "x_scale must be a scalar if no axis is provided");
     ORT_ENFORCE(zero_point_shape.NumDimensions() == 0, "x_zero_point must be a scalar if no axis is provided");
   }
 
-  size_t N = x_shape.SizeToDimension(axis);
-  const uint8_t* zero_point = y_zero_point.template Data<uint8_t>();
-  const float* scale = y_scale.template Data<float>();
-  size_t block_size = x_shape.SizeFromDimension(axis + 1);
+  // Without an axis the scale and zero point apply to the whole tensor, so
+  // process it as a single block.
+  const size_t N = has_axis_ ? static_cast<size_t>(x_shape.SizeToDimension(axis)) : 1;
+  const size_t channel_count = has_axis_ ? static_cast<size_t>(broadcastDim) : 1;
+  const size_t block_size = static_cast<size_t>(has_axis_ ? x_shape.SizeFromDimension(axis + 1) : x_shape.Size());
   const float* input = x.template Data<float>();
-  uint8_t* output = y.template MutableData<uint8_t>();
-
-  for (size_t n = 0; n < N; n++) {
-    const float* current_scale = scale;
-    const uint8_t* current_zero_point = zero_point;
-
-    for (size_t bd = 0; bd < static_cast<size_t>(broadcastDim); bd++) {
-      float zp = *current_zero_point;
-      auto sc = *current_scale;
-
-      for (size_t bs = 0; bs < block_size; bs++) {
-        *output++ = static_cast<uint8_t>(clamp(std::round(static_cast<float>(*input++) / sc) + zp, 0.0f, float(UINT8_MAX)));
-      }
+  const float* scale = y_scale.template Data<float>();
 
-      current_scale += stride;
-      current_zero_point += stride;
-    }
+  if (y_zero_point.DataType() == DataTypeImpl::GetType<int8_t>()) {
+    MlasQuantizeLinear(input, y.template MutableData<int8_t>(), N, channel_count, block_size,
+                       scale, y_zero_point.template Data<int8_t>());
+  } else {
+    MlasQuantizeLinear(input, y.template MutableData<uint8_t>(), N, channel_count, block_size,
+                       scale, y_zero_point.template Data<uint8_t>());
   }
 
   return Status::OK();
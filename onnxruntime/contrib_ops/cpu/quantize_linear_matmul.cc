@@ -8,11 +8,14 @@
 
 #include "contrib_ops/cpu/quantize_linear_matmul.h"
 #include "core/providers/cpu/math/matmul_helper.h"
-#include "core/util/gemmlowp_common_wrapper.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 namespace contrib {
 
+template<>
+void QLinearMatMul<uint8_t, uint8_t, uint8_t>::PrePackB(const OpKernelInfo& info);
+
 // only register this operator if low precision computation is enabled. 
 ONNX_OPERATOR_KERNEL_EX(
     QLinearMatMul,
@@ -21,34 +24,10 @@ ONNX_OPERATOR_KERNEL_EX(
     kCpuExecutionProvider,
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())
-        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<uint8_t>()),
     QLinearMatMul<uint8_t, uint8_t, uint8_t>);
 
-Status GemmlowpMultiply(const uint8_t* lhs_data, const uint8_t* rhs_data, uint8_t* result_data,
-                        const int lhs_offset, const int rhs_offset, const int result_offset,
-                        int m, int n, int k, int32_t int_multiplier, int32_t right_shift) {
-  gemmlowp::OutputStageQuantizeDownInt32ByFixedPoint quantize_down_stage;
-  quantize_down_stage.result_offset_after_shift = result_offset;
-  quantize_down_stage.result_fixedpoint_multiplier = int_multiplier;
-  quantize_down_stage.result_shift = right_shift;
-  gemmlowp::OutputStageSaturatingCastToUint8 saturating_cast_stage;
-  const auto& output_pipeline = std::make_tuple(quantize_down_stage, saturating_cast_stage);
-
-  // TODO exp ColMajor order for rhs and result. That may be faster
-  const auto matOrder = gemmlowp::MapOrder::RowMajor;
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> lhs(lhs_data, m, k);
-  gemmlowp::MatrixMap<const std::uint8_t, matOrder> rhs(rhs_data, k, n);
-  gemmlowp::MatrixMap<std::uint8_t, matOrder> result(result_data, m, n);
-
-  gemmlowp::GemmContext gemm_context;
-  gemmlowp::GemmWithOutputPipeline<std::uint8_t, std::uint8_t,
-                                   gemmlowp::DefaultL8R8BitDepthParams>(
-      &gemm_context, lhs, rhs, &result, -lhs_offset, -rhs_offset, output_pipeline);
-
-  return Status::OK();
-}
-
 void QuantizeMultiplier(float fp_multiplier, std::int32_t* integer_multiplier, int* right_shift) {
   uint32_t* fp_as_bits = reinterpret_cast<uint32_t*>(&fp_multiplier);
   auto current_exponent = (*fp_as_bits >> 23);
@@ -75,6 +54,25 @@ void ScaleAndZeropointPairValidationHelper(const Tensor* scale, const Tensor* ze
       "zeropoint must be a scalar");
 }
 
+template<>
+void QLinearMatMul<uint8_t, uint8_t, uint8_t>::PrePackB(const OpKernelInfo& info) {
+  const Tensor* b;
+  const Tensor* b_zero_point;
+  if (!info.TryGetConstantInput(3, &b) || b->Shape().NumDimensions() != 2 ||
+      !info.TryGetConstantInput(5, &b_zero_point) || b_zero_point->Shape().Size() != 1)
+    return;
+
+  const size_t K = static_cast<size_t>(b->Shape()[0]);
+  const size_t N = static_cast<size_t>(b->Shape()[1]);
+  packed_b_.resize(MlasQgemmPackBSize(N, K));
+
+  if (b->DataType() == DataTypeImpl::GetType<int8_t>()) {
+    MlasQgemmPackB(N, K, b->template Data<int8_t>(), N, *b_zero_point->template Data<int8_t>(), packed_b_.data());
+  } else {
+    MlasQgemmPackB(N, K, b->template Data<uint8_t>(), N, *b_zero_point->template Data<uint8_t>(), packed_b_.data());
+  }
+}
+
 template<>
 Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) const {
   auto a = ctx->Input<Tensor>(0);
@@ -105,18 +103,40 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   int right_shift;
   QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
 
-  for (int i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiply(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                     b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                     y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                     *a_zero_point->template Data<uint8_t>(),
-                     *b_zero_point->template Data<uint8_t>(),
-                     *y_zero_point->template Data<uint8_t>(),
-                     static_cast<int>(helper.M()),
-                     static_cast<int>(helper.N()),
-                     static_cast<int>(helper.K()),
-                     integer_multiplier,
-                     right_shift);
+  MLAS_QGEMM_REQUANTIZE_PARAMETERS requantize;
+  requantize.Bias = nullptr;
+  requantize.Multiplier = integer_multiplier;
+  requantize.Shift = right_shift;
+  requantize.ZeroPoint = *y_zero_point->template Data<uint8_t>();
+
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const uint8_t a_offset = *a_zero_point->template Data<uint8_t>();
+  const bool b_is_signed = b->DataType() == DataTypeImpl::GetType<int8_t>();
+
+  // MLAS requantizes each slice of the 32-bit result into y as soon as it is complete, so one scratch matrix is
+  // reused for every matrix of the batch
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  auto gemm_output_data = alloc->Alloc(sizeof(int32_t) * M * N);
+  BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
+  auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
+
+  for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
+    const uint8_t* a_data = a->template Data<uint8_t>() + helper.LeftOffsets()[i];
+    requantize.Output = y->template MutableData<uint8_t>() + helper.OutputOffsets()[i];
+    requantize.ldo = N;
+
+    if (!packed_b_.empty()) {
+      MlasQgemmPackedB(M, N, K, a_data, K, a_offset, packed_b_.data(), gemm_output, N, &requantize);
+    } else if (b_is_signed) {
+      MlasQgemm(M, N, K, a_data, K, a_offset, b->template Data<int8_t>() + helper.RightOffsets()[i], N,
+                *b_zero_point->template Data<int8_t>(), gemm_output, N, &requantize);
+    } else {
+      MlasQgemm(M, N, K, a_data, K, a_offset, b->template Data<uint8_t>() + helper.RightOffsets()[i], N,
+                *b_zero_point->template Data<uint8_t>(), gemm_output, N, &requantize);
+    }
   }
 
   return Status::OK();
@@ -14,10 +14,16 @@ template <typename T1, typename T2, typename T3>
 class QLinearMatMul final : public OpKernel {
  public:
   QLinearMatMul(const OpKernelInfo& info) : OpKernel(info) {
+    PrePackB(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
-  
+
+ private:
+  // packs a constant 2D B with a constant zero point for MlasQgemmPackedB
+  void PrePackB(const OpKernelInfo& info);
+
+  std::vector<uint8_t> packed_b_;
 };
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/calibration_recorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "core/framework/ml_value.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+void CalibrationRecorder::Record(const std::string& name, const MLValue& value) {
+  if (!value.IsAllocated() || !value.IsTensor()) {
+    return;
+  }
+
+  const auto& tensor = value.Get<Tensor>();
+  if (tensor.DataType() != DataTypeImpl::GetType<float>() || strcmp(tensor.Location().name, CPU) != 0 ||
+      tensor.Shape().Size() <= 0) {
+    return;
+  }
+
+  // find the range of this value before taking the lock so concurrent kernels don't serialize on it
+  const float* data = tensor.template Data<float>();
+  const auto minmax = std::minmax_element(data, data + tensor.Shape().Size());
+  const float min_value = *minmax.first;
+  const float max_value = *minmax.second;
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto entry = ranges_.find(name);
+  if (entry == ranges_.end()) {
+    ranges_.emplace(name, std::make_pair(min_value, max_value));
+  } else {
+    entry->second.first = std::min(entry->second.first, min_value);
+    entry->second.second = std::max(entry->second.second, max_value);
+  }
+}
+
+void CalibrationRecorder::RecordOutputs(const OpKernel& kernel, OpKernelContextInternal& context) {
+  const auto& output_defs = kernel.Node().OutputDefs();
+  for (int output_index = 0; output_index < context.OutputCount(); ++output_index) {
+    const MLValue* value = context.GetOutputMLValue(output_index);
+    if (value != nullptr && output_defs[output_index]->Exists()) {
+      Record(output_defs[output_index]->Name(), *value);
+    }
+  }
+}
+
+TensorRangeMap CalibrationRecorder::GetRanges() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return ranges_;
+}
+
+void CalibrationRecorder::Reset() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  ranges_.clear();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/common/common.h"
+#include "core/framework/framework_common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class OpKernel;
+class OpKernelContextInternal;
+
+/**
+Records the range of the values of every float tensor seen while a session runs in calibration mode.
+The ranges are accumulated across Run calls and are used to choose the quantization parameters of
+the activations for static quantization. Record may be called concurrently by the parallel executor.
+*/
+class CalibrationRecorder {
+ public:
+  CalibrationRecorder() = default;
+
+  /**
+  Widen the range of the named tensor with the values of 'value'.
+  Values that are not float tensors in CPU memory are ignored.
+  */
+  void Record(const std::string& name, const MLValue& value);
+
+  /** Record the outputs of a kernel once it has computed them. */
+  void RecordOutputs(const OpKernel& kernel, OpKernelContextInternal& context);
+
+  /** Get a copy of the ranges recorded so far. */
+  TensorRangeMap GetRanges() const;
+
+  /** Drop all the recorded ranges. */
+  void Reset();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CalibrationRecorder);
+
+  mutable OrtMutex mutex_;
+  TensorRangeMap ranges_;
+};
+
+}  // namespace onnxruntime
@@ -15,6 +15,7 @@
 #endif
 
 #include "core/framework/allocation_planner.h"
+#include "core/framework/calibration_recorder.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -187,6 +188,11 @@ void ParallelExecutor::RunNodeAsyncInternal(size_t p_node_index,
     if (!status.IsOK()) {
       ORT_THROW("Compute failed for node: ", graph_viewer->GetNode(node_index)->Name());
     }
+
+    if (session_state.GetCalibrationRecorder() != nullptr) {
+      session_state.GetCalibrationRecorder()->RecordOutputs(*p_op_kernel, op_kernel_context);
+    }
+
     if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      p_op_kernel->Node().Name() + "_kernel_time",
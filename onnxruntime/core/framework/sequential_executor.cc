@@ -9,6 +9,7 @@
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/calibration_recorder.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
@@ -114,6 +115,10 @@ Status SequentialExecutor::Execute(const SessionState& session_state,
     }
     ORT_RETURN_IF_ERROR(p_op_kernel->Compute(&op_kernel_context));
 
+    if (session_state.GetCalibrationRecorder() != nullptr) {
+      session_state.GetCalibrationRecorder()->RecordOutputs(*p_op_kernel, op_kernel_context);
+    }
+
     if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      p_op_kernel->Node().Name() + "_kernel_time",
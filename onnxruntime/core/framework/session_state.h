@@ -31,6 +31,7 @@
 
 namespace onnxruntime {
 
+class CalibrationRecorder;
 class ExecutionProviders;
 class KernelDef;
 class OpKernel;
@@ -116,6 +117,14 @@ class SessionState {
   */
   profiling::Profiler& Profiler() const;
 
+  /**
+  Set the recorder of the tensor ranges for calibration. The executors record the outputs of every node into
+  it when it is set. nullptr, the default, disables recording.
+  */
+  void SetCalibrationRecorder(CalibrationRecorder* recorder) { calibration_recorder_ = recorder; }
+
+  CalibrationRecorder* GetCalibrationRecorder() const { return calibration_recorder_; }
+
   /**
   Get cached memory pattern based on input shapes
   */
@@ -208,6 +217,7 @@ class SessionState {
 
   const logging::Logger* logger_ = nullptr;
   profiling::Profiler* profiler_;
+  CalibrationRecorder* calibration_recorder_ = nullptr;  // owned by InferenceSession
 
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
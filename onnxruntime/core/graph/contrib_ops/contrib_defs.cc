@@ -220,6 +220,110 @@ void convPoolShapeInference(
   }
 }
 
+// Attributes, inputs and outputs shared by the DynamicQuantizeLSTM and DynamicQuantizeGRU schemas. Both take
+// the inputs and attributes of the ONNX operator they quantize.
+std::function<void(OpSchema&)> DynamicQuantizeRnnDocGenerator() {
+  return [](OpSchema& schema) {
+    schema.Attr(
+        "direction",
+        "Specify if the RNN is forward, reverse, or bidirectional. Must be one of "
+        "forward (default), reverse, or bidirectional.",
+        AttributeProto::STRING,
+        std::string("forward"));
+    schema.Attr("hidden_size", "Number of neurons in the hidden layer", AttributeProto::INT, OPTIONAL);
+    schema.Attr(
+        "activation_alpha",
+        "Optional scaling values used by some activation functions, in the order of the activations.",
+        AttributeProto::FLOATS,
+        OPTIONAL);
+    schema.Attr(
+        "activation_beta",
+        "Optional scaling values used by some activation functions, in the order of the activations.",
+        AttributeProto::FLOATS,
+        OPTIONAL);
+    schema.Attr(
+        "clip",
+        "Cell clip threshold. Clipping bounds the elements of a tensor in the range of "
+        "[-threshold, +threshold] and is applied to the input of activations. No clip if not specified.",
+        AttributeProto::FLOAT,
+        OPTIONAL);
+    schema.Input(
+        0,
+        "X",
+        "The input sequences packed (and potentially padded) into one 3-D tensor "
+        "with the shape of `[seq_length, batch_size, input_size]`.",
+        "T");
+    schema.Input(
+        4,
+        "sequence_lens",
+        "Optional tensor specifying lengths of the sequences in a batch. "
+        "If not specified - assumed all sequences in the batch to have "
+        "length `seq_length`. It has shape `[batch_size]`.",
+        "T1",
+        OpSchema::Optional);
+    schema.Input(
+        5,
+        "initial_h",
+        "Optional initial value of the hidden. If not specified - assumed "
+        "to be 0. It has shape `[num_directions, batch_size, hidden_size]`.",
+        "T",
+        OpSchema::Optional);
+    schema.Output(
+        0,
+        "Y",
+        "A tensor that concats all the intermediate output values of the hidden. "
+        "It has shape `[seq_length, num_directions, batch_size, hidden_size]`. ",
+        "T",
+        OpSchema::Optional);
+    schema.Output(
+        1,
+        "Y_h",
+        "The last output value of the hidden. It has shape `[num_directions, batch_size, hidden_size]`.",
+        "T",
+        OpSchema::Optional);
+    schema.TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.");
+    schema.TypeConstraint("T1", {"tensor(int32)"}, "Constrain seq_lens to integer tensor.");
+    schema.TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+      ONNX_NAMESPACE::TensorShapeProto::Dimension num_directions, seq_length, batch_size, hidden_size;
+
+      const auto direction = getAttribute(ctx, "direction", "forward");
+      if (direction == "forward" || direction == "reverse") {
+        num_directions.set_dim_value(1);
+      } else if (direction == "bidirectional") {
+        num_directions.set_dim_value(2);
+      }
+
+      const auto hidden_size_value = getAttribute(ctx, "hidden_size", -1);
+      if (hidden_size_value > 0) {
+        hidden_size.set_dim_value(hidden_size_value);
+      }
+
+      if (hasInputShape(ctx, 0)) {
+        auto& x_shape = getInputShape(ctx, 0);
+        if (x_shape.dim_size() != 3) {
+          fail_shape_inference("First input tensor must have rank 3");
+        }
+        seq_length = x_shape.dim(0);
+        batch_size = x_shape.dim(1);
+      }
+
+      const size_t num_outputs = ctx.getNumOutputs();
+      for (size_t i = 0; i < num_outputs; ++i) {
+        propagateElemTypeFromInputToOutput(ctx, 0, i);
+      }
+
+      // Y is [seq_length, num_directions, batch_size, hidden_size], and the last hidden (and cell) state
+      // [num_directions, batch_size, hidden_size]
+      if (num_outputs > 0) {
+        updateOutputShape(ctx, 0, {seq_length, num_directions, batch_size, hidden_size});
+      }
+      for (size_t i = 1; i < num_outputs; ++i) {
+        updateOutputShape(ctx, i, {num_directions, batch_size, hidden_size});
+      }
+    });
+  };
+}
+
 void RegisterContribSchemas() {
 
   // ONNX exp ops(Affine, Crop, ParametricSoftplus, ImageScaler) old version history maintainance
@@ -393,7 +497,9 @@ Sample echo operator.)DOC");
       .SinceVersion(1)
       .SetDoc(R"DOC(
 The fused convolution operator schema is the same as Conv besides it includes an attribute
-activation.)DOC")
+activation and an optional input Z. Z has the shape of the output and is added to the
+convolution before the activation is applied, which fuses the residual Add that follows
+a Conv.)DOC")
       .Attr(
           "auto_pad",
           "",
@@ -440,6 +546,7 @@ activation.)DOC")
           "",
           "T")
       .Input(2, "B", "", "T", OpSchema::Optional)
+      .Input(3, "Z", "", "T", OpSchema::Optional)
       .Output(
           0,
           "Y",
@@ -702,7 +809,7 @@ activation and leaky_relu_alpha.)DOC")
       .SetDoc(R"DOC(
 The linear quantization operator. It consumes a full precision data, a scale, a zero point and computes the quantized data.
 The quantization formula is y = (x / y_scale) + y_zero_point. For (x / y_scale), it computes the nearest integer value to arg (in floating-point format),
- rounding halfway cases away from zero. Scale and zero point must have same shape. They must be either scalar (per tensor) or 1-D tensor (per 'axis').)DOC")
+ rounding halfway cases to the nearest even integer. Scale and zero point must have same shape. They must be either scalar (per tensor) or 1-D tensor (per 'axis').)DOC")
       .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
         propagateElemTypeFromInputToOutput(ctx, 2, 0);
 
@@ -1070,6 +1177,112 @@ Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-
         matmulShapeInference(ctx, 0, 1);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeMatMul)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Matrix product of a float tensor A and a quantized 2-D matrix B that behaves like numpy.matmul.
+A is quantized to uint8 at runtime with a scale and zero point computed from its range, the product is
+accumulated in 32 bits and the result is scaled back to float as Y = (A_quantized * B) * a_scale * b_scale + bias.)DOC")
+      .Input(0, "A", "N-dimensional matrix A", "T1")
+      .Input(1, "B", "2-dimensional quantized matrix B", "T2")
+      .Input(2, "b_scale",
+             "Scale of input 'B'. It could be a scalar or a 1-D tensor, which means a per-tensor or per-column "
+             "quantization. If it's a 1-D tensor, its number of elements should be equal to the number of columns "
+             "of input 'B'.",
+             "T1")
+      .Input(3, "b_zero_point",
+             "Zero point of input 'B'. It's optional and default value is 0. It must be a scalar.",
+             "T2", OpSchema::Optional)
+      .Input(4, "bias",
+             "1-D bias added to each row of the output. It's optional and its number of elements should be equal "
+             "to the number of columns of input 'B'.",
+             "T1", OpSchema::Optional)
+      .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, scales, bias and output Y to float tensors.")
+      .TypeConstraint("T2", {"tensor(int8)", "tensor(uint8)"}, "Constrain input B data types as 8-bit integer tensor.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        matmulShapeInference(ctx, 0, 1);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(CompressedMatMul)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+Matrix product of a float tensor A and a 2-D matrix B stored in a compressed format that behaves like numpy.matmul.
+B is expanded to float while it is packed for the GEMM, so the float B is never kept in memory. An int8 B is
+multiplied by the scale of its column: Y = A * (B * b_scale) + bias.)DOC")
+      .Input(0, "A", "N-dimensional matrix A", "T1")
+      .Input(1, "B", "2-dimensional compressed matrix B", "T2")
+      .Input(2, "b_scale",
+             "Optional 1-D scale of the columns of input 'B'. Its number of elements should be equal to the number of "
+             "columns of input 'B'. It's required if 'B' is int8.",
+             "T1", OpSchema::Optional)
+      .Input(3, "bias",
+             "1-D bias added to each row of the output. It's optional and its number of elements should be equal "
+             "to the number of columns of input 'B'.",
+             "T1", OpSchema::Optional)
+      .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input A, scale, bias and output Y to float tensors.")
+      .TypeConstraint("T2", {"tensor(float16)", "tensor(int8)"}, "Constrain input B to the compressed formats.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        matmulShapeInference(ctx, 0, 1);
+      });
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(CompressedConv)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(R"DOC(
+The convolution operator of a float input tensor and a filter stored in a compressed format. The filter is expanded
+to float while it is packed for the GEMM, so the float filter is never kept in memory. An int8 filter is multiplied
+by the scale of its output channel. The attributes are the same as Conv.)DOC")
+      .Input(0, "X", "Input data tensor from previous layer; has size (N x C x H x W) for the 2D image.", "T1")
+      .Input(1, "W",
+             "The compressed weight tensor that will be used in the convolutions; has size (M x C/group x kH x kW), "
+             "where M is the number of feature maps.",
+             "T2")
+      .Input(2, "w_scale",
+             "Optional 1-D scale of the output channels of input 'W'. Its number of elements should be equal to M. "
+             "It's required if 'W' is int8.",
+             "T1", OpSchema::Optional)
+      .Input(3, "B", "Optional 1D bias to be added to the convolution, has size of M.", "T1", OpSchema::Optional)
+      .Output(0, "Y", "Output data tensor that contains the result of the convolution.", "T1")
+      .TypeConstraint("T1", {"tensor(float)"}, "Constrain input X, scale, bias and output Y to float tensors.")
+      .TypeConstraint("T2", {"tensor(float16)", "tensor(int8)"}, "Constrain input W to the compressed formats.")
+      .Attr(
+          "auto_pad",
+          auto_pad_doc,
+          AttributeProto::STRING,
+          std::string("NOTSET"))
+      .Attr(
+          "kernel_shape",
+          "The shape of the convolution kernel. If not present, should be inferred from input 'W'.",
+          AttributeProto::INTS,
+          OPTIONAL)
+      .Attr(
+          "dilations",
+          "dilation value along each axis of the filter. If not present, the dilation defaults to 1 along each axis.",
+          AttributeProto::INTS,
+          OPTIONAL)
+      .Attr(
+          "strides", "Stride along each axis. If not present, the stride defaults to 1 along each axis.", AttributeProto::INTS, OPTIONAL)
+      .Attr("pads",
+            "Padding for the beginning and ending along each axis, it can take any value greater than or equal to 0. "
+            "`pads` format should be as follow [x1_begin, x2_begin...x1_end, x2_end,...]. If not present, the padding "
+            "defaults to 0 along start and end of each axis.",
+            AttributeProto::INTS, OPTIONAL)
+      .Attr(
+          "group",
+          "number of groups input channels and output channels are divided into. default is 1.",
+          AttributeProto::INT,
+          static_cast<int64_t>(1))
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        convPoolShapeInference(ctx, true, false, 0, 1);
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ReduceSumInteger)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1304,6 +1517,293 @@ Example 4:
           "Constrain to tensor(float).")
       .SetDoc(R"DOC(The WordConvEmbedding takes in a batch of sequence words and embed each word to a vector.)DOC");
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(EmbeddingBag)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "mode",
+          "Reduction applied to the rows of each bag. One of 'sum' or 'mean'.",
+          AttributeProto::STRING,
+          std::string("sum"))
+      .Input(0, "weight", "Embedding table of shape (num_embeddings, embedding_dim).", "T")
+      .Input(
+          1,
+          "indices",
+          "Rows of the embedding table to look up. Either 2-D of shape (num_bags, bag_size) where each row "
+          "is a bag, or 1-D of shape (num_indices) split into bags by offsets.",
+          "Tind")
+      .Input(
+          2,
+          "offsets",
+          "1-D tensor of shape (num_bags) with the position in indices where each bag starts. "
+          "Required when indices is 1-D and must not be given when indices is 2-D.",
+          "Tind",
+          OpSchema::Optional)
+      .Input(
+          3,
+          "per_sample_weights",
+          "Weight of each index, with the same shape as indices. Only supported with mode 'sum'.",
+          "T",
+          OpSchema::Optional)
+      .Output(0, "output", "Pooled embeddings of shape (num_bags, embedding_dim).", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain to float tensors.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices and offsets to integer types.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasNInputShapes(ctx, 2)) {
+          return;
+        }
+        auto& weight_shape = getInputShape(ctx, 0);
+        auto& indices_shape = getInputShape(ctx, 1);
+        if (weight_shape.dim_size() != 2) {
+          fail_shape_inference("weight must be 2-D");
+        }
+        if (indices_shape.dim_size() == 2) {
+          updateOutputShape(ctx, 0, {indices_shape.dim(0), weight_shape.dim(1)});
+        } else if (indices_shape.dim_size() == 1) {
+          if (hasInputShape(ctx, 2)) {
+            auto& offsets_shape = getInputShape(ctx, 2);
+            if (offsets_shape.dim_size() != 1) {
+              fail_shape_inference("offsets must be 1-D");
+            }
+            updateOutputShape(ctx, 0, {offsets_shape.dim(0), weight_shape.dim(1)});
+          }
+        } else {
+          fail_shape_inference("indices must be 1-D or 2-D");
+        }
+      })
+      .SetDoc(R"DOC(
+Computes sums or means of bags of embeddings without materializing the intermediate embeddings.
+This is equivalent to Gather(weight, indices) followed by ReduceSum/ReduceMean over each bag.
+Example:
+  weight  = [[1,1],[2,2],[3,3]]
+  indices = [0,2,1,1,2]
+  offsets = [0,2]
+  mode    = 'sum'
+  output  = [[4,4],[7,7]]
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(Gelu)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Input(0, "X", "Input data tensor.", "T")
+      .Output(0, "Y", "Output data tensor with the same shape as X.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput)
+      .SetDoc(R"DOC(
+Gaussian error linear unit, computed elementwise as
+  Y = 0.5 * X * (1 + Erf(X / Sqrt(2)))
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(LayerNormalization)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "axis",
+          "The first normalization dimension. The input is normalized over the dimensions from axis to the last one. "
+          "Negative values count from the back.",
+          AttributeProto::INT,
+          static_cast<int64_t>(-1))
+      .Attr("epsilon", "The value added to the variance to avoid dividing by zero.", AttributeProto::FLOAT, 1e-5f)
+      .Input(0, "X", "Input data tensor.", "T")
+      .Input(1, "scale", "Scale tensor with the shape of the normalized dimensions of X.", "T")
+      .Input(2, "B", "Bias tensor with the shape of the normalized dimensions of X.", "T", OpSchema::Optional)
+      .Output(0, "Y", "Output data tensor with the same shape as X.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput)
+      .SetDoc(R"DOC(
+Normalizes the input over the dimensions from axis to the last one and applies an elementwise affine:
+  Y = (X - Mean(X)) / Sqrt(Variance(X) + epsilon) * scale + B
+where the mean and population variance are computed over the normalized dimensions.
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(Attention)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("num_heads", "Number of attention heads. hidden_size must be a multiple of it.", AttributeProto::INT)
+      .Input(0, "input", "Input tensor with shape (batch_size, sequence_length, hidden_size).", "T")
+      .Input(
+          1,
+          "weight",
+          "The query, key and value weights concatenated along the last dimension, "
+          "with shape (hidden_size, 3 * hidden_size).",
+          "T")
+      .Input(2, "bias", "The query, key and value biases concatenated, with shape (3 * hidden_size).", "T")
+      .Input(
+          3,
+          "mask",
+          "Additive attention mask that broadcasts to (batch_size, 1, sequence_length, sequence_length). The "
+          "batch dimension may be 1, and the query dimension may be 1 to share one row of the mask by all query "
+          "positions. It is added to the attention scores of every head before the softmax.",
+          "T",
+          OpSchema::Optional)
+      .Output(0, "output", "Output tensor with shape (batch_size, sequence_length, hidden_size).", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput)
+      .SetDoc(R"DOC(
+Multi-head scaled dot product self attention. With Q, K and V the heads of input * weight + bias,
+each head computes
+  Softmax(Q * Transpose(K) / Sqrt(head_size) + mask) * V
+and the heads are concatenated along the last dimension of the output.
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "ops",
+          "The operator of each instruction of the program, in evaluation order. Unary operators are Abs, Ceil, "
+          "Clip, Erf, Exp, Floor, Gelu, LeakyRelu, Log, Neg, Reciprocal, Relu, Sigmoid, Sqrt and Tanh. Binary "
+          "operators are Add, Div, Max, Min, Mul, Pow and Sub.",
+          AttributeProto::STRINGS)
+      .Attr(
+          "operands",
+          "Two operands for each instruction. Operand i refers to input i if i is less than the number of inputs, "
+          "and otherwise to the result of instruction i minus the number of inputs, which must be an earlier "
+          "instruction. The second operand of a unary operator is -1.",
+          AttributeProto::INTS)
+      .Attr(
+          "alphas",
+          "A parameter for each instruction: the alpha of LeakyRelu and the min of Clip. Defaults to zeros.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Attr(
+          "betas",
+          "A parameter for each instruction: the max of Clip. Defaults to zeros.",
+          AttributeProto::FLOATS,
+          OPTIONAL)
+      .Input(
+          0,
+          "inputs",
+          "The inputs of the program. Each input has the shape of the output, is a scalar or is broadcast "
+          "from the trailing dimensions of the output.",
+          "T",
+          OpSchema::Variadic)
+      .Output(0, "Y", "The result of the last instruction.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain to float tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        for (int i = 0; i < static_cast<int>(ctx.getNumInputs()); i++) {
+          if (!hasInputShape(ctx, i)) {
+            return;
+          }
+          ONNX_NAMESPACE::TensorShapeProto broadcast_shape;
+          bidirectionalBroadcastShapeInference(output_shape, getInputShape(ctx, i), broadcast_shape);
+          output_shape = broadcast_shape;
+        }
+        *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape() = output_shape;
+      })
+      .SetDoc(R"DOC(
+Evaluates a chain of elementwise operators, fused from the graph, as a program over the broadcast inputs.
+The program is evaluated in blocks that stay in the cache, so the intermediate results never travel
+through memory.
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeLSTM)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "activations",
+          "A list of 3 (or 6 if bidirectional) activation functions for input, output, forget, cell, "
+          "and hidden. The activation functions must be one of the activation functions of LSTM.",
+          AttributeProto::STRINGS,
+          OPTIONAL)
+      .Attr("input_forget", "Couple the input and forget gates if 1.", AttributeProto::INT, static_cast<int64_t>(0))
+      .Input(
+          1,
+          "W",
+          "The weight tensor for the gates. Concatenation of `W[iofc]` and `WB[iofc]` (if bidirectional) "
+          "along dimension 0. The tensor has shape `[num_directions, 4*hidden_size, input_size]`.",
+          "T")
+      .Input(
+          2,
+          "R",
+          "The recurrence weight tensor. Concatenation of `R[iofc]` and `RB[iofc]` (if bidirectional) "
+          "along dimension 0. This tensor has shape `[num_directions, 4*hidden_size, hidden_size]`.",
+          "T")
+      .Input(
+          3,
+          "B",
+          "The bias tensor for input gate. Concatenation of `[Wb[iofc], Rb[iofc]]`, and `[WBb[iofc], RBb[iofc]]` "
+          "(if bidirectional) along dimension 0. This tensor has shape `[num_directions, 8*hidden_size]`. "
+          "Optional: If not specified - assumed to be 0.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          6,
+          "initial_c",
+          "Optional initial value of the cell. If not specified - assumed to be 0. "
+          "It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .Input(
+          7,
+          "P",
+          "The weight tensor for peepholes. Concatenation of `P[iof]` and `PB[iof]` (if bidirectional) "
+          "along dimension 0. It has shape `[num_directions, 3*hidden_size]`. Optional: If not specified - "
+          "assumed to be 0.",
+          "T",
+          OpSchema::Optional)
+      .Output(
+          2,
+          "Y_c",
+          "The last output value of the cell. It has shape `[num_directions, batch_size, hidden_size]`.",
+          "T",
+          OpSchema::Optional)
+      .FillUsing(DynamicQuantizeRnnDocGenerator())
+      .SetDoc(R"DOC(
+LSTM that runs its matrix multiplications in 8 bit integers. The inputs, outputs and attributes are those of the
+ONNX LSTM operator. W and R are quantized to int8 with a scale per output column, once when they are constant
+initializers. The input sequence and the hidden state of each step are quantized to uint8 with a scale and zero
+point per row as they are multiplied, the products are accumulated in int32 and dequantized before the gates
+are computed in float. This trades a small loss of accuracy for faster recurrent GEMMs.
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicQuantizeGRU)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr(
+          "activations",
+          "A list of 2 (or 4 if bidirectional) activation functions for update, reset, and hidden gates. "
+          "The activation functions must be one of the activation functions of GRU.",
+          AttributeProto::STRINGS,
+          OPTIONAL)
+      .Attr(
+          "linear_before_reset",
+          "When computing the output of the hidden gate, apply the linear transformation before multiplying by "
+          "the output of the reset gate.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .Input(
+          1,
+          "W",
+          "The weight tensor for the gates. Concatenation of `W[zrh]` and `WB[zrh]` (if bidirectional) "
+          "along dimension 0. This tensor has shape `[num_directions, 3*hidden_size, input_size]`.",
+          "T")
+      .Input(
+          2,
+          "R",
+          "The recurrence weight tensor. Concatenation of `R[zrh]` and `RB[zrh]` (if bidirectional) "
+          "along dimension 0. This tensor has shape `[num_directions, 3*hidden_size, hidden_size]`.",
+          "T")
+      .Input(
+          3,
+          "B",
+          "The bias tensor for the gates. Concatenation of `[Wb[zrh], Rb[zrh]]` and `[WBb[zrh], RBb[zrh]]` "
+          "(if bidirectional) along dimension 0. This tensor has shape `[num_directions, 6*hidden_size]`. "
+          "Optional: If not specified - assumed to be 0",
+          "T",
+          OpSchema::Optional)
+      .FillUsing(DynamicQuantizeRnnDocGenerator())
+      .SetDoc(R"DOC(
+GRU that runs its matrix multiplications in 8 bit integers. The inputs, outputs and attributes are those of the
+ONNX GRU operator. W and R are quantized to int8 with a scale per output column, once when they are constant
+initializers. The input sequence and the left hand side of each recurrent GEMM are quantized to uint8 with a
+scale and zero point per row as they are multiplied, the products are accumulated in int32 and dequantized
+before the gates are computed in float.
+)DOC");
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ROIAlign)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
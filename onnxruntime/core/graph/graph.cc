@@ -10,6 +10,7 @@
 #include <iostream>
 #include <numeric>
 #include <stack>
+#include <unordered_set>
 
 #include "gsl/pointers"
 #include "core/graph/function.h"
@@ -1906,7 +1907,9 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
 void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
   auto iter = name_to_initial_tensor_.find(tensor_name);
   if (name_to_initial_tensor_.end() != iter) {
-    name_to_initial_tensor_.erase(tensor_name);
+    // ToGraphProto removes the initializer from the GraphProto, along with any others removed before it
+    removed_initializers_.insert(iter->second);
+    name_to_initial_tensor_.erase(iter);
     SetGraphProtoSyncNeeded();
     SetGraphResolveNeeded();
   }
@@ -1924,7 +1927,7 @@ bool Graph::GetInitializedTensor(const std::string& tensor_name, const TensorPro
 
 void Graph::CleanAllInitializedTensors() noexcept {
   name_to_initial_tensor_.clear();
-  removed_initializer_indexes_.clear();
+  removed_initializers_.clear();
 
   // Clearing RepeatedPtrFields does not free objects' memory. The memory is retained
   // and can be reused. Need to explicitly release the cleared objects and free the
@@ -2107,37 +2110,41 @@ const GraphProto& Graph::ToGraphProto() {
     p_node->ToProto(*node_proto);
   }
 
-  if (!removed_initializer_indexes_.empty()) {
-    // Move initializers.
-    std::sort(removed_initializer_indexes_.begin(), removed_initializer_indexes_.end());
-    int lastInUseInitializerIndex = graph_proto_->initializer_size() - 1;
-    int start = 0, end = gsl::narrow_cast<int>(removed_initializer_indexes_.size()) - 1;
-    int lastRemovedInitializerIndex = removed_initializer_indexes_[end];
-
-    for (; start <= end; start++) {
-      // Find a lastInUseInitializer.
-      while (start <= end && lastInUseInitializerIndex == lastRemovedInitializerIndex) {
-        graph_proto_->mutable_initializer()->RemoveLast();
-        lastInUseInitializerIndex--;
-        end--;
-        if (start <= end) {
-          lastRemovedInitializerIndex = removed_initializer_indexes_[end];
+  // Remove the initializers that were removed from the graph in a single pass. Swapping the elements of the repeated
+  // field only moves pointers, so the kept initializers stay at the addresses name_to_initial_tensor_ refers to.
+  std::unordered_set<std::string> removed_initializer_names;
+  if (!removed_initializers_.empty()) {
+    auto* initializers = graph_proto_->mutable_initializer();
+    int kept = 0;
+    for (int i = 0; i < initializers->size(); ++i) {
+      const TensorProto& initializer = initializers->Get(i);
+      if (removed_initializers_.count(&initializer) != 0) {
+        // an initializer may have been replaced by a new one with the same name
+        if (name_to_initial_tensor_.find(initializer.name()) == name_to_initial_tensor_.end()) {
+          removed_initializer_names.insert(initializer.name());
         }
-      }
-
-      if (start <= end) {
-        // Copy the <lastInUseInitializerIndex> initializer in use to the <start> slot which is removed.
-        *graph_proto_->mutable_initializer(removed_initializer_indexes_[start]) = graph_proto_->initializer(lastInUseInitializerIndex);
-        graph_proto_->mutable_initializer()->RemoveLast();
-        lastInUseInitializerIndex--;
+      } else {
+        initializers->SwapElements(kept++, i);
       }
     }
-    removed_initializer_indexes_.clear();
+
+    initializers->DeleteSubrange(kept, initializers->size() - kept);
+    removed_initializers_.clear();
   }
 
   // Sync graph inputs/outputs/valueInfo.
   SyncGraphInputsOutputs();
 
+  // an initializer that was listed as a graph input is not an input anymore once it's removed
+  if (!removed_initializer_names.empty()) {
+    auto* inputs = graph_proto_->mutable_input();
+    for (int i = inputs->size() - 1; i >= 0; --i) {
+      if (removed_initializer_names.count(inputs->Get(i).name()) != 0) {
+        inputs->DeleteSubrange(i, 1);
+      }
+    }
+  }
+
   GraphProtoSyncNeeded(false);
 
   return *graph_proto_;
@@ -2196,7 +2203,7 @@ void Graph::CleanUnusedInitializers() {
   }
 
   std::for_each(erase_list.cbegin(), erase_list.cend(),
-                [this](const std::string& name) { name_to_initial_tensor_.erase(name); });
+                [this](const std::string& name) { RemoveInitializedTensor(name); });
 }
 
 GSL_SUPPRESS(es .84)  // warning about ignoring return value from insert(...)
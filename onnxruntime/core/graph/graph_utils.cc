@@ -84,6 +84,16 @@ const ONNX_NAMESPACE::AttributeProto* GetNodeAttribute(
   return iter == attrs.end() ? nullptr : &iter->second;
 }
 
+float GetFloatAttribute(const Node& node, const std::string& attr_name, float default_value) {
+  const auto* attr = GetNodeAttribute(node, attr_name);
+  return attr != nullptr && attr->has_f() ? attr->f() : default_value;
+}
+
+int64_t GetIntAttribute(const Node& node, const std::string& attr_name, int64_t default_value) {
+  const auto* attr = GetNodeAttribute(node, attr_name);
+  return attr != nullptr && attr->has_i() ? attr->i() : default_value;
+}
+
 bool RemoveSingleInSingleOutNode(Graph& graph, Node& node) {
   if (!IsSingleInSingleOutNode(node)) {
     return false;
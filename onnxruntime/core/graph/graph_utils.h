@@ -23,6 +23,12 @@ bool IsSingleInSingleOutNode(const Node& node);
 /** Return the attribute of a Node with a given name. */
 const ONNX_NAMESPACE::AttributeProto* GetNodeAttribute(const Node& node, const std::string& attr_name);
 
+/** Return the value of a float attribute of a node, or default_value if the node doesn't have it. */
+float GetFloatAttribute(const Node& node, const std::string& attr_name, float default_value);
+
+/** Return the value of an int attribute of a node, or default_value if the node doesn't have it. */
+int64_t GetIntAttribute(const Node& node, const std::string& attr_name, int64_t default_value);
+
 /** Retrieve the values for a repeated attribute of a node and place them to the values vector. */
 template <typename T>
 bool GetRepeatedNodeAttributeValues(const Node& node,
@@ -53,6 +53,7 @@ enum MLAS_ACTIVATION_KIND {
     MlasLeakyReluActivation,
     MlasTanhActivation,
     MlasLogisticActivation,
+    MlasGeluActivation,
 };
 
 struct MLAS_ACTIVATION {
@@ -94,18 +95,379 @@ MlasSgemm(
     size_t ldc
     );
 
+//
+// Single precision matrix/matrix multiply routine with an epilogue.
+//
+// The epilogue adds a bias to matrix C and then applies an activation. It is
+// applied to each tile of matrix C as soon as the tile is complete, while the
+// tile is still in the cache, instead of in separate passes over matrix C.
+// The bias is broadcast from a single value, from one value per row or per
+// column of matrix C, or is a full matrix with the shape of matrix C and the
+// first dimension ldbias. The activation is optional.
+//
+
+enum MLAS_SGEMM_BIAS_KIND {
+    MlasSgemmNoBias,
+    MlasSgemmScalarBias,
+    MlasSgemmRowBias,
+    MlasSgemmColumnBias,
+    MlasSgemmMatrixBias,
+};
+
+struct MLAS_SGEMM_EPILOGUE {
+    MLAS_SGEMM_BIAS_KIND BiasKind;
+    const float* Bias;
+    size_t ldbias;
+    const MLAS_ACTIVATION* Activation;
+};
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    );
+
+//
+// Single precision matrix/matrix multiply routines with one matrix stored in
+// a compressed format.
+//
+// The compressed elements are expanded to single precision while the matrix
+// is copied to the packed buffers of the SGEMM kernels, so the full precision
+// matrix is never materialized. Each element is multiplied by the scale of its
+// channel: the channel is the column of matrix B or the row of matrix A, that
+// is, the dimension of matrix C that the compressed matrix contributes to. The
+// scale is optional and defaults to one.
+//
+
+enum MLAS_COMPRESSED_FORMAT {
+    MlasCompressedFloat16,
+    MlasCompressedInt8,
+};
+
+struct MLAS_COMPRESSED_MATRIX {
+    MLAS_COMPRESSED_FORMAT Format;
+    const void* Data;
+    size_t ld;
+    const float* Scale;
+};
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_COMPRESSED_MATRIX* B,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_COMPRESSED_MATRIX* A,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
+//
+// Quantized integer matrix/matrix multiply routines.
+//
+// The routines compute C = (A - offa) * (B - offb) with 32-bit accumulation.
+// When requantize parameters are supplied, the 32-bit result is additionally
+// converted to the 8-bit output as:
+//
+//     Output = Saturate(ZeroPoint +
+//         RoundingRightShift(RoundingDoublingHighMultiply(C + Bias, Multiplier), Shift))
+//
+// where Bias supplies an optional value per row of matrix C. A negative Shift
+// is applied as a left shift before the multiply.
+//
+
+struct MLAS_QGEMM_REQUANTIZE_PARAMETERS {
+    const int32_t* Bias;
+    int32_t Multiplier;
+    int32_t Shift;
+    uint8_t ZeroPoint;
+    uint8_t* Output;
+    size_t ldo;
+};
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize
+    );
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize
+    );
+
+//
+// Routines to pack matrix B once for use by multiple QGEMM operations.
+//
+
+size_t
+MLASCALL
+MlasQgemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasQgemmPackedB(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize
+    );
+
+//
+// Quantization and dequantization routines.
+//
+// The tensor is viewed as [BatchCount, ChannelCount, BlockSize] where each
+// channel has its own scale and zero point, so per-tensor quantization uses a
+// BatchCount and ChannelCount of one. Quantization rounds halfway cases to the
+// nearest even value and saturates to the range of the output type.
+//
+
+void
+MLASCALL
+MlasQuantizeLinear(
+    const float* Input,
+    uint8_t* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const uint8_t* ZeroPoint
+    );
+
+void
+MLASCALL
+MlasQuantizeLinear(
+    const float* Input,
+    int8_t* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const int8_t* ZeroPoint
+    );
+
+void
+MLASCALL
+MlasDequantizeLinear(
+    const uint8_t* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const uint8_t* ZeroPoint
+    );
+
+void
+MLASCALL
+MlasDequantizeLinear(
+    const int8_t* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const int8_t* ZeroPoint
+    );
+
+//
+// Image to column routines.
+//
+// MlasIm2col expands a CHW image with any number of spatial dimensions into
+// the [Channels x KernelSize x OutputSize] column matrix multiplied by a GEMM
+// to compute a convolution. MlasIm2colNhwc expands an HWC image into the
+// [OutputSize x KernelSize x Channels] column matrix. Elements read from the
+// padding are set to PaddingValue, which is the zero point of a quantized
+// image. Padding supplies the leading padding of each spatial dimension
+// followed by the trailing padding in the ONNX order; only the leading
+// padding is used because the output shape is supplied.
+//
+
+void
+MLASCALL
+MlasIm2col(
+    const float* Input,
+    float* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    float PaddingValue
+    );
+
+void
+MLASCALL
+MlasIm2col(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    uint8_t PaddingValue
+    );
+
+void
+MLASCALL
+MlasIm2colNhwc(
+    const float* Input,
+    float* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    float PaddingValue
+    );
+
+void
+MLASCALL
+MlasIm2colNhwc(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    uint8_t PaddingValue
+    );
+
 //
 // Convolution routines.
 //
+// The output is computed as Activation(Convolution + Beta * Output + Bias), so
+// a residual tensor can be added by copying it to the output buffer and
+// passing a nonzero Beta. The residual is accumulated by the GEMM and the
+// bias and activation are applied to each output tile while it is still in
+// the cache.
+//
+// If AllowWinograd is true, MlasConvPrepare may select the Winograd algorithm
+// for 3x3 convolutions with unit stride and dilation. The filter passed to
+// MlasConv must then be the filter transformed by MlasConvWinogradTransformFilter.
+// The transformed filter only depends on the filter, the channel and group
+// counts and the Winograd tile size, so it can be computed once and reused
+// for every input shape that selects the same tile size.
+//
+// MlasConvSelectAlgorithm replaces the algorithm selected by MlasConvPrepare
+// with a specific algorithm and thread count, for callers that time the
+// candidates instead of relying on the heuristics. It fails if the algorithm
+// cannot compute the convolution.
+//
 
 enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
     const MLAS_ACTIVATION* Activation;
+    float Beta;
     size_t Dimensions;
     size_t BatchCount;
     size_t GroupCount;
@@ -129,6 +491,13 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileSize;
+            size_t TileCountHeight;
+            size_t TileCountWidth;
+            size_t TileRowsPerBlock;
+            size_t ThreadCount;
+        } Winograd;
     } u;
 };
 
@@ -148,6 +517,17 @@ MlasConvPrepare(
     const int64_t* OutputShape,
     size_t FilterCount,
     const MLAS_ACTIVATION* Activation,
+    float Beta,
+    bool AllowWinograd,
+    size_t* WorkingBufferSize
+    );
+
+bool
+MLASCALL
+MlasConvSelectAlgorithm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_ALGORITHM Algorithm,
+    size_t ThreadCount,
     size_t* WorkingBufferSize
     );
 
@@ -162,6 +542,173 @@ MlasConv(
     float* Output
     );
 
+size_t
+MLASCALL
+MlasConvWinogradFilterSize(
+    const MLAS_CONV_PARAMETERS* Parameters
+    );
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    );
+
+//
+// Convolution transpose routines.
+//
+// Only two dimensional convolution transposes are supported. The filter has
+// the ONNX layout [InputChannels x OutputChannels x KernelHeight x
+// KernelWidth] per group and must be packed with MlasConvTransposePackFilter
+// before calling MlasConvTranspose. The packed filter only depends on the
+// filter and the channel and group counts, so it can be computed once and
+// reused for every input shape.
+//
+
+struct MLAS_CONV_TRANSPOSE_PARAMETERS {
+    size_t BatchCount;
+    size_t GroupCount;
+    size_t InputChannels;
+    size_t InputShape[2];
+    size_t KernelShape[2];
+    size_t DilationShape[2];
+    size_t Padding[4];
+    size_t StrideShape[2];
+    size_t OutputChannels;
+    size_t OutputShape[2];
+    size_t InputSize;
+    size_t OutputSize;
+    size_t KernelSize;
+    bool Upsample2x2;
+    size_t ChannelsPerBlock;
+    size_t ColumnsPerSegment;
+    size_t BlockCount;
+    size_t ThreadCount;
+};
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t OutputChannels,
+    size_t* WorkingBufferSize
+    );
+
+void
+MLASCALL
+MlasConvTransposePackFilter(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    );
+
+//
+// Normalization routines.
+//
+// The tensors are viewed as [BatchCount, ChannelCount, PlaneSize] where the
+// spatial dimensions of each channel are flattened into a plane.
+//
+// MlasBatchNormalization computes Output = Input * Scale + Shift with one
+// scale and shift per channel, so the mean, variance, epsilon and affine of
+// an inference batch normalization are folded into Scale and Shift by the
+// caller. MlasInstanceNormalization normalizes each plane by its own mean
+// and variance and applies the per-channel affine in the same pass.
+// MlasComputeChannelMoments computes the mean and population variance of
+// each channel across the batch and its planes.
+//
+// MlasLayerNormalization normalizes each row of a [RowCount, RowSize] matrix
+// by its own mean and variance and applies the per-element Scale and
+// optional Bias shared by all rows.
+//
+// MlasLocalResponseNormalization computes Output = Input * (Bias + Alpha /
+// Size * SquareSum) ^ -Beta, where SquareSum is the sum of the squares of the
+// Size channels centered on each element.
+//
+
+void
+MLASCALL
+MlasBatchNormalization(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    const float* Scale,
+    const float* Shift
+    );
+
+void
+MLASCALL
+MlasInstanceNormalization(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    const float* Scale,
+    const float* Bias,
+    float Epsilon
+    );
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const float* Scale,
+    const float* Bias,
+    float Epsilon
+    );
+
+void
+MLASCALL
+MlasComputeChannelMoments(
+    const float* Input,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    float* Mean,
+    float* Variance
+    );
+
+void
+MLASCALL
+MlasLocalResponseNormalization(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    size_t Size,
+    float Alpha,
+    float Beta,
+    float Bias
+    );
+
 //
 // Pooling routines.
 //
@@ -206,6 +753,36 @@ MlasComputeTanh(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeGelu(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+//
+// MlasComputeSoftmax computes the softmax of each row of a matrix with N rows
+// and D columns. The output may be the same buffer as the input.
+//
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D
+    );
+
 //
 // Half-precision floating-point routines.
 //
@@ -218,3 +795,19 @@ MlasConvertHalfToFloatBuffer(
     float* Destination,
     size_t Count
     );
+
+//
+// Platform query routines.
+//
+
+const char*
+MLASCALL
+MlasGetPlatformName(
+    void
+    );
+
+size_t
+MLASCALL
+MlasGetMaximumThreadCount(
+    void
+    );
@@ -436,5 +436,23 @@ Return Value:
 
             break;
         }
+
+        case MlasGeluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Input, Bias, M, Output, N, ldc);
+            }
+
+            if (N == ldc) {
+                MlasComputeGelu(Output, Output, M * N);
+            } else {
+                while (M-- > 0) {
+                    MlasComputeGelu(Output, Output, N);
+                    Output += ldc;
+                }
+            }
+
+            break;
+        }
     }
 }
@@ -571,7 +571,7 @@ Return Value:
         //
 
         size_t CountK;
-        float beta = 0.0f;
+        float beta = Parameters->Beta;
         float* SegmentOutput = Output + SegmentStartN + n;
 
         for (size_t k = 0; k < K; k += CountK) {
@@ -718,8 +718,8 @@ Return Value:
         //
 
         MlasSgemmOperation(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
-            OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb, 0.0f,
-            output, OutputSize);
+            OutputSize, K, 1.0f, filter, K, input, Parameters->u.GemmDirect.ldb,
+            Parameters->Beta, output, OutputSize);
 
         //
         // Apply the activation with optional bias.
@@ -866,14 +866,17 @@ Arguments:
 
     Input - Supplies the input tensor.
 
-    Filter - Supplies the filter tensor.
+    Filter - Supplies the filter tensor, or the transformed filter if the
+        Winograd algorithm was selected.
 
     Bias - Optionally supplies the bias vector.
 
     WorkingBuffer - Supplies a working buffer sized to the number of elements
         returned by MlasConvPrepare.
 
-    Output - Supplies the output tensor.
+    Output - Supplies the output tensor. If the Beta of the parameters is
+        nonzero, also supplies the residual tensor that is accumulated into
+        the output.
 
 Return Value:
 
@@ -887,13 +890,15 @@ Return Value:
 
     const size_t InputGroupSize = Parameters->InputChannels * Parameters->InputSize;
     const size_t OutputGroupSize = FilterCount * OutputSize;
-    const size_t FilterGroupSize = FilterCount * K;
 
     const size_t BatchCount = Parameters->BatchCount;
     const size_t GroupCount = Parameters->GroupCount;
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    const size_t FilterGroupSize = (Algorithm == MlasConvAlgorithmWinograd) ?
+        MlasConvWinogradFilterSize(Parameters) / GroupCount : FilterCount * K;
+
 #if defined(MLAS_HAS_THREADING_SUPPORT)
 
     //
@@ -951,8 +956,8 @@ Return Value:
                     //
 
                     MlasSgemm(CblasNoTrans, Parameters->u.GemmDirect.TransB, FilterCount,
-                        OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb, 0.0f,
-                        Output, OutputSize);
+                        OutputSize, K, 1.0f, filter, K, Input, Parameters->u.GemmDirect.ldb,
+                        Parameters->Beta, Output, OutputSize);
 
                     //
                     // Apply the activation with optional bias.
@@ -978,7 +983,7 @@ Return Value:
                     }
 
                     MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f, filter,
-                        K, WorkingBuffer, OutputSize, 0.0f, Output, OutputSize);
+                        K, WorkingBuffer, OutputSize, Parameters->Beta, Output, OutputSize);
 
                     //
                     // Apply the activation with optional bias.
@@ -1005,6 +1010,18 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Compute the tiles of the output in the Winograd domain
+                    // with the transformed filter.
+                    //
+
+                    MlasConvWinograd(Parameters, Input, filter, bias, WorkingBuffer, Output);
+
+                    break;
+                }
             }
 
             //
@@ -1022,6 +1039,174 @@ Return Value:
     }
 }
 
+bool
+MlasConvPrepareGemmDirect(
+    MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the convolution can be computed by
+    invoking the GEMM directly with the input tensor and if so, computes the
+    parameters of the GEMM.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+Return Value:
+
+    Returns true if the GEMM direct algorithm was selected, else false.
+
+--*/
+{
+    const size_t Dimensions = Parameters->Dimensions;
+
+    bool AllDilationsAreOne = true;
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+
+        if (Parameters->StrideShape[dim] != 1 || Parameters->Padding[dim] != 0 ||
+            Parameters->Padding[dim + Dimensions] != 0) {
+            return false;
+        }
+
+        AllDilationsAreOne &= (Parameters->DilationShape[dim] == 1);
+    }
+
+    //
+    // Detect a pointwise convolution.
+    //
+
+    if (Parameters->K == Parameters->InputChannels) {
+
+        Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
+        Parameters->u.GemmDirect.TransB = CblasNoTrans;
+        Parameters->u.GemmDirect.ldb = Parameters->OutputSize;
+
+        return true;
+    }
+
+    if (Dimensions == 2 && AllDilationsAreOne && Parameters->InputChannels == 1) {
+
+        //
+        // Detect convolutions where the kernel is using the entire input
+        // width or height.
+        //
+
+        if (Parameters->KernelShape[1] == Parameters->InputShape[1]) {
+
+            Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
+            Parameters->u.GemmDirect.TransB = CblasTrans;
+            Parameters->u.GemmDirect.ldb = Parameters->InputShape[1];
+
+            return true;
+        }
+
+        if (Parameters->KernelShape[0] == Parameters->InputShape[0] &&
+            Parameters->KernelShape[1] == 1) {
+
+            Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
+            Parameters->u.GemmDirect.TransB = CblasNoTrans;
+            Parameters->u.GemmDirect.ldb = Parameters->InputShape[1];
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+MlasConvPrepareExpandThenGemmSegmented(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t ThreadCount,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the parameters for the expand then GEMM algorithm
+    that slices the N dimension across threads.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    ThreadCount - Supplies the number of threads to slice the N dimension
+        across, or zero to derive the thread count from the complexity.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputSize = Parameters->OutputSize;
+
+    //
+    // Unless supplied, compute the number of target threads given the
+    // complexity of the convolution operation. Small requests should run
+    // using the single threaded path.
+    //
+
+    int32_t TargetThreadCount;
+
+    if (ThreadCount == 0) {
+
+        double Complexity = double(Parameters->FilterCount) * double(OutputSize) *
+            double(Parameters->K);
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        }
+
+    } else {
+        TargetThreadCount = int32_t(ThreadCount);
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Compute the thread stride for slicing the N dimension.
+    //
+
+    size_t StrideN = OutputSize / TargetThreadCount;
+
+    if ((StrideN * TargetThreadCount) != OutputSize) {
+        StrideN++;
+    }
+
+    if (TargetThreadCount > 1) {
+
+        StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        if (StrideN >= OutputSize) {
+            TargetThreadCount = 1;
+        } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
+            TargetThreadCount--;
+        }
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
+    Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+
+    *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+}
+
 void
 MLASCALL
 MlasConvPrepare(
@@ -1038,6 +1223,8 @@ MlasConvPrepare(
     const int64_t* OutputShape,
     size_t FilterCount,
     const MLAS_ACTIVATION* Activation,
+    float Beta,
+    bool AllowWinograd,
     size_t* WorkingBufferSize
     )
 /*++
@@ -1079,6 +1266,14 @@ Arguments:
     Activation - Supplies the parameters for the activation to apply to the
         convolution output.
 
+    Beta - Supplies the scalar multiplier of the existing contents of the
+        output tensor, which are accumulated into the convolution output
+        before the bias and activation are applied.
+
+    AllowWinograd - Supplies true if the Winograd algorithm may be selected,
+        in which case the filter must be transformed with
+        MlasConvWinogradTransformFilter before calling MlasConv.
+
     WorkingBufferSize - Receives the number of elements to allocate for the
         working buffer for intermediate results.
 
@@ -1093,6 +1288,7 @@ Return Value:
     //
 
     Parameters->Activation = Activation;
+    Parameters->Beta = Beta;
     Parameters->Dimensions = Dimensions;
     Parameters->BatchCount = BatchCount;
     Parameters->GroupCount = GroupCount;
@@ -1103,10 +1299,6 @@ Return Value:
     size_t OutputSize = 1;
     size_t K = InputChannels;
 
-    bool AllStridesAreOne = true;
-    bool AllDilationsAreOne = true;
-    bool AllPaddingIsZero = true;
-
     for (size_t dim = 0; dim < Dimensions; dim++) {
 
         Parameters->InputShape[dim] = size_t(InputShape[dim]);
@@ -1120,10 +1312,6 @@ Return Value:
         InputSize *= Parameters->InputShape[dim];
         OutputSize *= Parameters->OutputShape[dim];
         K *= Parameters->KernelShape[dim];
-
-        AllStridesAreOne &= (Parameters->StrideShape[dim] == 1);
-        AllDilationsAreOne &= (Parameters->DilationShape[dim] == 1);
-        AllPaddingIsZero &= (Parameters->Padding[dim] == 0 && Parameters->Padding[dim + Dimensions] == 0);
     }
 
     Parameters->InputSize = InputSize;
@@ -1136,47 +1324,16 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
-    if (AllStridesAreOne && AllPaddingIsZero) {
-
-        //
-        // Detect a pointwise convolution.
-        //
-
-        if (K == InputChannels) {
-
-            Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
-            Parameters->u.GemmDirect.TransB = CblasNoTrans;
-            Parameters->u.GemmDirect.ldb = OutputSize;
-
-            return;
-        }
-
-        if (Dimensions == 2 && AllDilationsAreOne && InputChannels == 1) {
-
-            //
-            // Detect convolutions where the kernel is using the entire input
-            // width or height.
-            //
-
-            if (Parameters->KernelShape[1] == Parameters->InputShape[1]) {
-
-                Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
-                Parameters->u.GemmDirect.TransB = CblasTrans;
-                Parameters->u.GemmDirect.ldb = Parameters->InputShape[1];
-
-                return;
-            }
-
-            if (Parameters->KernelShape[0] == Parameters->InputShape[0] &&
-                Parameters->KernelShape[1] == 1) {
+    if (MlasConvPrepareGemmDirect(Parameters)) {
+        return;
+    }
 
-                Parameters->Algorithm = MlasConvAlgorithmGemmDirect;
-                Parameters->u.GemmDirect.TransB = CblasNoTrans;
-                Parameters->u.GemmDirect.ldb = Parameters->InputShape[1];
+    //
+    // Detect 3x3 convolutions that benefit from the Winograd algorithm.
+    //
 
-                return;
-            }
-        }
+    if (AllowWinograd && MlasConvWinogradPrepare(Parameters, 0, WorkingBufferSize)) {
+        return;
     }
 
     if (FilterCount > OutputSize) {
@@ -1196,50 +1353,105 @@ Return Value:
         // Segment the operation across multiple threads by slicing the N
         // dimension (see MlasSgemmTryMultithread).
         //
-        // Compute the number of target threads given the complexity of the
-        // convolution operation. Small requests should run using the single
-        // threaded path.
-        //
 
-        int32_t TargetThreadCount;
-        double Complexity = double(FilterCount) * double(OutputSize) * double(K);
+        MlasConvPrepareExpandThenGemmSegmented(Parameters, 0, WorkingBufferSize);
+    }
+}
 
-        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
-            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
-        } else {
-            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
-        }
+bool
+MLASCALL
+MlasConvSelectAlgorithm(
+    MLAS_CONV_PARAMETERS* Parameters,
+    MLAS_CONV_ALGORITHM Algorithm,
+    size_t ThreadCount,
+    size_t* WorkingBufferSize
+    )
+/*++
 
-        int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+Routine Description:
 
-        if (TargetThreadCount >= MaximumThreadCount) {
-            TargetThreadCount = MaximumThreadCount;
-        }
+    This routine replaces the algorithm selected by MlasConvPrepare, for
+    callers that measure the algorithms instead of relying on the heuristics.
 
-        //
-        // Compute the thread stride for slicing the N dimension.
-        //
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvPrepare.
+
+    Algorithm - Supplies the algorithm to use.
+
+    ThreadCount - Supplies the number of threads that the algorithm splits
+        the convolution across. This must be zero for the GEMM direct and
+        expand then GEMM algorithms, which rely on the threading of the GEMM,
+        and must be nonzero for the other algorithms.
 
-        size_t StrideN = OutputSize / TargetThreadCount;
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
 
-        if ((StrideN * TargetThreadCount) != OutputSize) {
-            StrideN++;
+    Returns true if the algorithm can compute the convolution with the thread
+    count, else false and the parameters are unchanged.
+
+--*/
+{
+    if (ThreadCount > size_t(MlasPlatform.GetMaximumThreadCount())) {
+        return false;
+    }
+
+    MLAS_CONV_PARAMETERS SelectedParameters = *Parameters;
+    size_t SelectedWorkingBufferSize = 0;
+
+    switch (Algorithm) {
+
+        case MlasConvAlgorithmGemmDirect:
+        {
+            if (ThreadCount != 0 || !MlasConvPrepareGemmDirect(&SelectedParameters)) {
+                return false;
+            }
+
+            break;
         }
 
-        if (TargetThreadCount > 1) {
+        case MlasConvAlgorithmExpandThenGemm:
+        {
+            if (ThreadCount != 0) {
+                return false;
+            }
+
+            SelectedParameters.Algorithm = MlasConvAlgorithmExpandThenGemm;
+            SelectedWorkingBufferSize = Parameters->OutputSize * Parameters->K;
 
-            StrideN = (StrideN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+            break;
+        }
 
-            if (StrideN >= OutputSize) {
-                TargetThreadCount = 1;
-            } else if (StrideN * (TargetThreadCount - 1) >= OutputSize) {
-                TargetThreadCount--;
+        case MlasConvAlgorithmExpandThenGemmSegmented:
+        {
+            if (ThreadCount == 0) {
+                return false;
             }
+
+            MlasConvPrepareExpandThenGemmSegmented(&SelectedParameters, ThreadCount,
+                &SelectedWorkingBufferSize);
+
+            break;
         }
 
-        Parameters->Algorithm = MlasConvAlgorithmExpandThenGemmSegmented;
-        Parameters->u.ExpandThenGemmSegmented.ThreadStrideN = StrideN;
+        case MlasConvAlgorithmWinograd:
+        {
+            if (ThreadCount == 0 || !MlasConvWinogradPrepare(&SelectedParameters,
+                ThreadCount, &SelectedWorkingBufferSize)) {
+                return false;
+            }
+
+            break;
+        }
 
-        *WorkingBufferSize = TargetThreadCount * MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD;
+        default:
+            return false;
     }
+
+    *Parameters = SelectedParameters;
+    *WorkingBufferSize = SelectedWorkingBufferSize;
+
+    return true;
 }
@@ -0,0 +1,777 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    convtranspose.cpp
+
+Abstract:
+
+    This module implements the two dimensional convolution transpose
+    operation.
+
+    For each image and group, the packed filter [FilterSize x InputChannels]
+    (FilterSize = OutputChannels * KernelHeight * KernelWidth) is multiplied
+    by the input [InputChannels x InputSize] to produce a column matrix that
+    is scattered and accumulated into the output image (col2im).
+
+    The output channels are divided into blocks that are computed
+    independently, because the rows of the column matrix for an output
+    channel only contribute to the plane of that channel. Each block
+    multiplies its rows of the filter by segments of the input columns that
+    are sized so that the column matrix for the segment remains in the cache
+    while it is accumulated into the output.
+
+    A kernel of 2x2 with a stride of 2x2 does not overlap itself, so each
+    output element receives exactly one element of the column matrix. This
+    common upsampling case interleaves the column matrix into the output
+    instead of accumulating it.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of working buffer elements to target per thread. This
+// bounds the number of input columns of a segment.
+//
+
+#define MLAS_CONV_TRANSPOSE_WORKING_BUFFER_SIZE_PER_THREAD  (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
+
+//
+// Define the maximum number of filter rows in a block of output channels.
+//
+
+#define MLAS_CONV_TRANSPOSE_MAXIMUM_BLOCK_ROWS              256
+
+//
+// Define the parameters to execute blocks of output channels of a
+// convolution transpose on worker threads.
+//
+
+struct MLAS_CONV_TRANSPOSE_WORK_BLOCK {
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+};
+
+void
+MlasConvTransposeInitializeOutput(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Bias,
+    float* Output,
+    size_t ChannelCount
+    )
+/*++
+
+Routine Description:
+
+    This routine initializes the planes of a block of output channels with
+    their bias, or with zero if there is no bias.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution transpose operation.
+
+    Bias - Supplies the optional bias vector for the block of channels.
+
+    Output - Supplies the output tensor for the block of channels.
+
+    ChannelCount - Supplies the number of channels in the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t OutputSize = Parameters->OutputSize;
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+
+        const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias != nullptr ? Bias[c] : 0.0f);
+
+        float* output = Output + c * OutputSize;
+        size_t n = OutputSize;
+
+        while (n >= 4) {
+            MlasStoreFloat32x4(output, BiasVector);
+            output += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+            MlasStoreLaneFloat32x4<0>(output, BiasVector);
+            output += 1;
+            n -= 1;
+        }
+    }
+}
+
+void
+MlasConvTransposeCol2Im(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* ColumnBuffer,
+    float* Output,
+    size_t ChannelCount,
+    size_t StartN,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates a segment of the column matrix for a block of
+    output channels into the output planes of the channels.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution transpose operation.
+
+    ColumnBuffer - Supplies the column matrix of the block of channels for
+        the segment, with a leading dimension of CountN.
+
+    Output - Supplies the output tensor for the block of channels.
+
+    ChannelCount - Supplies the number of channels in the block.
+
+    StartN - Supplies the index of the first input element of the segment.
+
+    CountN - Supplies the number of input elements of the segment.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t KernelHeight = Parameters->KernelShape[0];
+    const size_t KernelWidth = Parameters->KernelShape[1];
+    const size_t DilationHeight = Parameters->DilationShape[0];
+    const size_t DilationWidth = Parameters->DilationShape[1];
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t StrideHeight = Parameters->StrideShape[0];
+    const size_t StrideWidth = Parameters->StrideShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+
+        float* output = Output + c * OutputSize;
+
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+
+            for (size_t kw = 0; kw < KernelWidth; kw++) {
+
+                const float* col = ColumnBuffer;
+                ColumnBuffer += CountN;
+
+                //
+                // Compute the range of input columns that map inside the
+                // output width for this kernel column.
+                //
+
+                const size_t KernelOffsetWidth = kw * DilationWidth;
+
+                size_t iw_begin = 0;
+
+                if (PaddingLeft > KernelOffsetWidth) {
+                    iw_begin = (PaddingLeft - KernelOffsetWidth + StrideWidth - 1) / StrideWidth;
+                }
+
+                size_t iw_end = 0;
+
+                if (OutputWidth + PaddingLeft > KernelOffsetWidth) {
+                    iw_end = (OutputWidth + PaddingLeft - KernelOffsetWidth - 1) / StrideWidth + 1;
+                }
+
+                if (iw_end > InputWidth) {
+                    iw_end = InputWidth;
+                }
+
+                //
+                // Walk the segment one input row at a time.
+                //
+
+                size_t n = StartN;
+                const size_t EndN = StartN + CountN;
+
+                while (n < EndN) {
+
+                    const size_t ih = n / InputWidth;
+                    const size_t RowBegin = n - ih * InputWidth;
+                    size_t RowEnd = InputWidth;
+
+                    if (RowEnd - RowBegin > EndN - n) {
+                        RowEnd = RowBegin + (EndN - n);
+                    }
+
+                    const float* colrow = col + (n - StartN) - RowBegin;
+                    n += RowEnd - RowBegin;
+
+                    //
+                    // Skip the input row if it maps outside the output height.
+                    //
+
+                    const size_t oh = ih * StrideHeight + kh * DilationHeight - PaddingTop;
+
+                    if (oh >= OutputHeight) {
+                        continue;
+                    }
+
+                    const size_t iw_first = (RowBegin > iw_begin) ? RowBegin : iw_begin;
+                    const size_t iw_last = (RowEnd < iw_end) ? RowEnd : iw_end;
+
+                    if (iw_first >= iw_last) {
+                        continue;
+                    }
+
+                    float* outrow = output + oh * OutputWidth;
+                    size_t ow = iw_first * StrideWidth + KernelOffsetWidth - PaddingLeft;
+                    size_t iw = iw_first;
+
+                    if (StrideWidth == 1) {
+
+                        //
+                        // The input and output elements are both contiguous.
+                        //
+
+                        while (iw + 4 <= iw_last) {
+                            MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(&outrow[ow]);
+                            Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(&colrow[iw]));
+                            MlasStoreFloat32x4(&outrow[ow], Vector);
+                            iw += 4;
+                            ow += 4;
+                        }
+                    }
+
+                    while (iw < iw_last) {
+                        outrow[ow] += colrow[iw];
+                        iw += 1;
+                        ow += StrideWidth;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvTransposeUpsample2x2(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* ColumnBuffer,
+    const float* Bias,
+    float* Output,
+    size_t ChannelCount,
+    size_t StartN,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine stores a segment of the column matrix for a block of output
+    channels to the output planes of the channels, for a 2x2 kernel with a
+    2x2 stride that has no dilation or padding and an output twice the size
+    of the input. Each input element produces a 2x2 output block, so the two
+    kernel columns of a kernel row are interleaved into an output row.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution transpose operation.
+
+    ColumnBuffer - Supplies the column matrix of the block of channels for
+        the segment, with a leading dimension of CountN.
+
+    Bias - Supplies the optional bias vector for the block of channels.
+
+    Output - Supplies the output tensor for the block of channels.
+
+    ChannelCount - Supplies the number of channels in the block.
+
+    StartN - Supplies the index of the first input element of the segment.
+
+    CountN - Supplies the number of input elements of the segment.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+
+        const float BiasValue = (Bias != nullptr) ? Bias[c] : 0.0f;
+        const MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(BiasValue);
+
+        for (size_t kh = 0; kh < 2; kh++) {
+
+            const float* col0 = ColumnBuffer + (c * 4 + kh * 2) * CountN;
+            const float* col1 = col0 + CountN;
+
+            size_t n = StartN;
+            const size_t EndN = StartN + CountN;
+
+            while (n < EndN) {
+
+                const size_t ih = n / InputWidth;
+                const size_t RowBegin = n - ih * InputWidth;
+                size_t RowCount = InputWidth - RowBegin;
+
+                if (RowCount > EndN - n) {
+                    RowCount = EndN - n;
+                }
+
+                const float* c0 = col0 + (n - StartN);
+                const float* c1 = col1 + (n - StartN);
+                float* outrow = Output + c * OutputSize + (ih * 2 + kh) * OutputWidth + RowBegin * 2;
+                n += RowCount;
+
+                while (RowCount >= 4) {
+
+                    MLAS_FLOAT32X4 Vector0 = MlasLoadFloat32x4(c0);
+                    MLAS_FLOAT32X4 Vector1 = MlasLoadFloat32x4(c1);
+
+                    MlasStoreFloat32x4(outrow, MlasAddFloat32x4(MlasInterleaveLowFloat32x4(Vector0, Vector1), BiasVector));
+                    MlasStoreFloat32x4(outrow + 4, MlasAddFloat32x4(MlasInterleaveHighFloat32x4(Vector0, Vector1), BiasVector));
+
+                    c0 += 4;
+                    c1 += 4;
+                    outrow += 8;
+                    RowCount -= 4;
+                }
+
+                while (RowCount > 0) {
+
+                    outrow[0] = *c0++ + BiasValue;
+                    outrow[1] = *c1++ + BiasValue;
+
+                    outrow += 2;
+                    RowCount -= 1;
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvTransposeOperation(
+    const MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock,
+    float* WorkingBuffer,
+    size_t Block
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output channels of one image and group
+    of a convolution transpose.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the convolution
+        transpose parameters and buffers.
+
+    WorkingBuffer - Supplies the working buffer of the thread.
+
+    Block - Supplies the index of the block, which enumerates the blocks of
+        output channels of each group of each image.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t OutputChannels = Parameters->OutputChannels;
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t KernelSize = Parameters->KernelSize;
+    const size_t FilterSize = OutputChannels * KernelSize;
+    const size_t ChannelsPerBlock = Parameters->ChannelsPerBlock;
+    const size_t ColumnsPerSegment = Parameters->ColumnsPerSegment;
+
+    const size_t BlockCountPerGroup = (OutputChannels + ChannelsPerBlock - 1) / ChannelsPerBlock;
+    const size_t BatchGroup = Block / BlockCountPerGroup;
+    const size_t Group = BatchGroup % Parameters->GroupCount;
+    const size_t StartChannel = (Block - BatchGroup * BlockCountPerGroup) * ChannelsPerBlock;
+
+    size_t ChannelCount = OutputChannels - StartChannel;
+
+    if (ChannelCount > ChannelsPerBlock) {
+        ChannelCount = ChannelsPerBlock;
+    }
+
+    const float* Input = WorkBlock->Input + BatchGroup * InputChannels * InputSize;
+    const float* Filter = WorkBlock->Filter + (Group * FilterSize + StartChannel * KernelSize) * InputChannels;
+    float* Output = WorkBlock->Output + (BatchGroup * OutputChannels + StartChannel) * OutputSize;
+
+    const float* Bias = WorkBlock->Bias;
+
+    if (Bias != nullptr) {
+        Bias += Group * OutputChannels + StartChannel;
+    }
+
+    if (!Parameters->Upsample2x2) {
+        MlasConvTransposeInitializeOutput(Parameters, Bias, Output, ChannelCount);
+    }
+
+    for (size_t n = 0; n < InputSize; n += ColumnsPerSegment) {
+
+        size_t CountN = InputSize - n;
+
+        if (CountN > ColumnsPerSegment) {
+            CountN = ColumnsPerSegment;
+        }
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, ChannelCount * KernelSize, CountN,
+            InputChannels, 1.0f, Filter, InputChannels, Input + n, InputSize, 0.0f,
+            WorkingBuffer, CountN);
+
+        if (Parameters->Upsample2x2) {
+            MlasConvTransposeUpsample2x2(Parameters, WorkingBuffer, Bias, Output, ChannelCount,
+                n, CountN);
+        } else {
+            MlasConvTransposeCol2Im(Parameters, WorkingBuffer, Output, ChannelCount, n, CountN);
+        }
+    }
+}
+
+void
+MlasConvTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute the blocks of
+    output channels of a convolution transpose assigned to the thread.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_TRANSPOSE_WORK_BLOCK* WorkBlock = (MLAS_CONV_TRANSPOSE_WORK_BLOCK*)Context;
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t ThreadCount = Parameters->ThreadCount;
+    const size_t WorkingBufferSizePerThread = Parameters->ChannelsPerBlock *
+        Parameters->KernelSize * Parameters->ColumnsPerSegment;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + Index * WorkingBufferSizePerThread;
+
+    for (size_t Block = size_t(Index); Block < Parameters->BlockCount; Block += ThreadCount) {
+        MlasConvTransposeOperation(WorkBlock, WorkingBuffer, Block);
+    }
+}
+
+void
+MLASCALL
+MlasConvTransposePrepare(
+    MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    size_t OutputChannels,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine prepares for a two dimensional convolution transpose
+    operation by computing required parameters including the required working
+    buffer size for intermediate results.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution transpose operation.
+
+    BatchCount - Supplies the number of images to process.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    InputShape - Supplies the height and width of the input tensor.
+
+    KernelShape - Supplies the height and width of the kernel.
+
+    DilationShape - Supplies the height and width dilation of the kernel.
+
+    Padding - Supplies the top, left, bottom and right padding that is
+        removed from the output.
+
+    StrideShape - Supplies the height and width stride of the kernel.
+
+    OutputShape - Supplies the height and width of the output tensor.
+
+    OutputChannels - Supplies the number of output channels per group.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Save the convolution transpose parameters.
+    //
+
+    Parameters->BatchCount = BatchCount;
+    Parameters->GroupCount = GroupCount;
+    Parameters->InputChannels = InputChannels;
+    Parameters->OutputChannels = OutputChannels;
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        Parameters->InputShape[dim] = size_t(InputShape[dim]);
+        Parameters->KernelShape[dim] = size_t(KernelShape[dim]);
+        Parameters->DilationShape[dim] = size_t(DilationShape[dim]);
+        Parameters->Padding[dim] = size_t(Padding[dim]);
+        Parameters->Padding[dim + 2] = size_t(Padding[dim + 2]);
+        Parameters->StrideShape[dim] = size_t(StrideShape[dim]);
+        Parameters->OutputShape[dim] = size_t(OutputShape[dim]);
+    }
+
+    const size_t InputSize = Parameters->InputShape[0] * Parameters->InputShape[1];
+    const size_t OutputSize = Parameters->OutputShape[0] * Parameters->OutputShape[1];
+    const size_t KernelSize = Parameters->KernelShape[0] * Parameters->KernelShape[1];
+
+    Parameters->InputSize = InputSize;
+    Parameters->OutputSize = OutputSize;
+    Parameters->KernelSize = KernelSize;
+
+    //
+    // Detect the 2x2 upsampling that stores each output element once.
+    //
+
+    bool Upsample2x2 = true;
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        Upsample2x2 &= (Parameters->KernelShape[dim] == 2 && Parameters->StrideShape[dim] == 2 &&
+            Parameters->DilationShape[dim] == 1 && Parameters->Padding[dim] == 0 &&
+            Parameters->OutputShape[dim] == Parameters->InputShape[dim] * 2);
+    }
+
+    Parameters->Upsample2x2 = Upsample2x2;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // convolution transpose operation. Small requests should run using the
+    // single threaded path.
+    //
+
+    int32_t TargetThreadCount;
+    double Complexity = double(BatchCount) * double(GroupCount) * double(OutputChannels) *
+        double(KernelSize) * double(InputSize) * double(InputChannels);
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Split the output channels of each image and group into enough blocks
+    // to give each thread a block, and bound the rows of the filter that a
+    // block multiplies so that a segment spans enough input columns.
+    //
+
+    const size_t BatchGroupCount = BatchCount * GroupCount;
+    const size_t BlockCountPerGroup =
+        (size_t(TargetThreadCount) + BatchGroupCount - 1) / BatchGroupCount;
+
+    size_t ChannelsPerBlock = (OutputChannels + BlockCountPerGroup - 1) / BlockCountPerGroup;
+
+    if (ChannelsPerBlock * KernelSize > MLAS_CONV_TRANSPOSE_MAXIMUM_BLOCK_ROWS) {
+        ChannelsPerBlock = MLAS_CONV_TRANSPOSE_MAXIMUM_BLOCK_ROWS / KernelSize;
+    }
+
+    if (ChannelsPerBlock == 0) {
+        ChannelsPerBlock = 1;
+    }
+
+    const size_t BlockCount = BatchGroupCount *
+        ((OutputChannels + ChannelsPerBlock - 1) / ChannelsPerBlock);
+
+    if (size_t(TargetThreadCount) > BlockCount) {
+        TargetThreadCount = int32_t(BlockCount);
+    }
+
+    //
+    // Size the segments of input columns to the working buffer budget of a
+    // thread.
+    //
+
+    size_t ColumnsPerSegment = MLAS_CONV_TRANSPOSE_WORKING_BUFFER_SIZE_PER_THREAD /
+        (ChannelsPerBlock * KernelSize);
+
+    if (ColumnsPerSegment > InputSize) {
+        ColumnsPerSegment = InputSize;
+    }
+
+    if (ColumnsPerSegment == 0) {
+        ColumnsPerSegment = 1;
+    }
+
+    Parameters->ChannelsPerBlock = ChannelsPerBlock;
+    Parameters->ColumnsPerSegment = ColumnsPerSegment;
+    Parameters->BlockCount = BlockCount;
+    Parameters->ThreadCount = size_t(TargetThreadCount);
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * ChannelsPerBlock * KernelSize * ColumnsPerSegment;
+}
+
+void
+MLASCALL
+MlasConvTransposePackFilter(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the filter of a convolution transpose for
+    MlasConvTranspose. The filter of each group is transposed from
+    [InputChannels x OutputChannels x KernelHeight x KernelWidth] to
+    [OutputChannels x KernelHeight x KernelWidth x InputChannels], so that
+    a block of output channels multiplies contiguous rows.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvTransposePrepare.
+
+    Filter - Supplies the filter tensor.
+
+    PackedFilter - Supplies the buffer that receives the packed filter, which
+        has as many elements as the filter tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterSize = Parameters->OutputChannels * Parameters->KernelSize;
+
+    for (size_t group = 0; group < Parameters->GroupCount; group++) {
+
+        for (size_t ic = 0; ic < InputChannels; ic++) {
+
+            for (size_t k = 0; k < FilterSize; k++) {
+                PackedFilter[k * InputChannels + ic] = Filter[ic * FilterSize + k];
+            }
+        }
+
+        Filter += InputChannels * FilterSize;
+        PackedFilter += InputChannels * FilterSize;
+    }
+}
+
+void
+MLASCALL
+MlasConvTranspose(
+    const MLAS_CONV_TRANSPOSE_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the two dimensional convolution transpose
+    operation.
+
+Arguments:
+
+    Parameters - Supplies the structure returned by MlasConvTransposePrepare.
+
+    Input - Supplies the input tensor.
+
+    PackedFilter - Supplies the filter packed by MlasConvTransposePackFilter.
+
+    Bias - Supplies the optional bias vector.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvTransposePrepare.
+
+    Output - Supplies the output tensor.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_TRANSPOSE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = PackedFilter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+
+    if (Parameters->ThreadCount == 1) {
+
+        for (size_t Block = 0; Block < Parameters->BlockCount; Block++) {
+            MlasConvTransposeOperation(&WorkBlock, WorkingBuffer, Block);
+        }
+
+        return;
+    }
+
+    MlasExecuteThreaded(MlasConvTransposeThreaded, &WorkBlock,
+        int32_t(Parameters->ThreadCount));
+}
@@ -0,0 +1,340 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    erf.cpp
+
+Abstract:
+
+    This module implements routines to compute the error function and the
+    Gaussian error linear unit (GELU).
+
+    The error function is approximated by an odd polynomial for small inputs
+    and by 1 - exp(-polynomial) for large inputs. The minimax coefficients
+    give results within about one unit in the last place of single precision
+    when computed with fused multiply-add.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants of the error function.
+//
+
+const struct {
+    float UpperAbsRange;
+    float SplitBoundary;
+    float SmallP0;
+    float SmallP1;
+    float SmallP2;
+    float SmallP3;
+    float SmallP4;
+    float SmallP5MinusOne;
+    float BigP0;
+    float BigP1;
+    float BigP2;
+    float BigP3;
+    float BigP4;
+    float BigP5;
+    float BigP6MinusOne;
+    float One;
+    float ExpLog2Reciprocal;
+    float ExpLog2High;
+    float ExpLog2Low;
+    float ExpP0;
+    float ExpP1;
+    float ExpP2;
+    float ExpP3;
+    float ExpP4;
+    float ExpP5;
+    float ExpP6;
+    float ExpRoundingBias;
+    float ExpExponentBias;
+} MlasErfConstants = {
+    3.925f,
+    0.921875f,
+    -5.99104969e-4f,
+    4.99339588e-3f,
+    -2.67667342e-2f,
+    1.12818025e-1f,
+    -3.76124859e-1f,
+    1.28379151e-1f,
+    1.72948930e-5f,
+    -3.83208680e-4f,
+    3.88393435e-3f,
+    -2.42545605e-2f,
+    1.06777847e-1f,
+    6.34846687e-1f,
+    1.28717512e-1f,
+    1.0f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.0f,
+    1.0f,
+    1.25829120e+7f,
+    127.0f,
+};
+
+inline
+MLAS_FLOAT32X4
+MlasErfFloat32x4(
+    MLAS_FLOAT32X4 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function of a vector.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the error function of each element of the input vector.
+
+--*/
+{
+    const MLAS_FLOAT32X4 SignMask = MlasBroadcastFloat32x4(-0.0f);
+
+    MLAS_FLOAT32X4 AbsValue = MlasAndNotFloat32x4(SignMask, Value);
+    AbsValue = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasErfConstants.UpperAbsRange), AbsValue);
+
+    MLAS_FLOAT32X4 SquareValue = MlasMultiplyFloat32x4(AbsValue, AbsValue);
+
+    //
+    // Compute the odd polynomial for small inputs.
+    //
+
+    MLAS_FLOAT32X4 SmallResult;
+    SmallResult = MlasMultiplyAddFloat32x4(SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.SmallP0),
+        MlasBroadcastFloat32x4(MlasErfConstants.SmallP1));
+    SmallResult = MlasMultiplyAddFloat32x4(SmallResult, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.SmallP2));
+    SmallResult = MlasMultiplyAddFloat32x4(SmallResult, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.SmallP3));
+    SmallResult = MlasMultiplyAddFloat32x4(SmallResult, SquareValue, MlasBroadcastFloat32x4(MlasErfConstants.SmallP4));
+    SmallResult = MlasMultiplyAddFloat32x4(SmallResult, SquareValue,
+        MlasBroadcastFloat32x4(MlasErfConstants.SmallP5MinusOne));
+    SmallResult = MlasMultiplyAddFloat32x4(SmallResult, AbsValue, AbsValue);
+
+    //
+    // Compute the exponent of 1 - exp(-polynomial) for large inputs.
+    //
+
+    MLAS_FLOAT32X4 Polynomial;
+    MLAS_FLOAT32X4 PolynomialHigh;
+    Polynomial = MlasMultiplyAddFloat32x4(AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.BigP0),
+        MlasBroadcastFloat32x4(MlasErfConstants.BigP1));
+    PolynomialHigh = MlasMultiplyAddFloat32x4(AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.BigP2),
+        MlasBroadcastFloat32x4(MlasErfConstants.BigP3));
+    Polynomial = MlasMultiplyAddFloat32x4(Polynomial, SquareValue, PolynomialHigh);
+    Polynomial = MlasMultiplyAddFloat32x4(Polynomial, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.BigP4));
+    Polynomial = MlasMultiplyAddFloat32x4(Polynomial, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.BigP5));
+    Polynomial = MlasMultiplyAddFloat32x4(Polynomial, AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.BigP6MinusOne));
+    Polynomial = MlasMultiplyAddFloat32x4(Polynomial, AbsValue, AbsValue);
+
+    //
+    // Compute exp(-Polynomial) as 2^n * exp(r) where r = -Polynomial - n * ln(2)
+    // is reduced to [-ln(2)/2, ln(2)/2]. Adding the rounding bias rounds the
+    // scaled input to an integer held in the low bits of the mantissa, which
+    // are shifted into the exponent field to build 2^n.
+    //
+
+    MLAS_FLOAT32X4 ExpInput = MlasSubtractFloat32x4(MlasZeroFloat32x4(), Polynomial);
+    MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasErfConstants.ExpRoundingBias);
+
+    MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(ExpInput,
+        MlasBroadcastFloat32x4(MlasErfConstants.ExpLog2Reciprocal), RoundingBias);
+    MLAS_FLOAT32X4 Exponent = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    MLAS_FLOAT32X4 Reduced;
+    Reduced = MlasMultiplyAddFloat32x4(Exponent, MlasBroadcastFloat32x4(MlasErfConstants.ExpLog2High), ExpInput);
+    Reduced = MlasMultiplyAddFloat32x4(Exponent, MlasBroadcastFloat32x4(MlasErfConstants.ExpLog2Low), Reduced);
+
+    MLAS_FLOAT32X4 ExpResult;
+    ExpResult = MlasMultiplyAddFloat32x4(Reduced, MlasBroadcastFloat32x4(MlasErfConstants.ExpP0),
+        MlasBroadcastFloat32x4(MlasErfConstants.ExpP1));
+    ExpResult = MlasMultiplyAddFloat32x4(ExpResult, Reduced, MlasBroadcastFloat32x4(MlasErfConstants.ExpP2));
+    ExpResult = MlasMultiplyAddFloat32x4(ExpResult, Reduced, MlasBroadcastFloat32x4(MlasErfConstants.ExpP3));
+    ExpResult = MlasMultiplyAddFloat32x4(ExpResult, Reduced, MlasBroadcastFloat32x4(MlasErfConstants.ExpP4));
+    ExpResult = MlasMultiplyAddFloat32x4(ExpResult, Reduced, MlasBroadcastFloat32x4(MlasErfConstants.ExpP5));
+    ExpResult = MlasMultiplyAddFloat32x4(ExpResult, Reduced, MlasBroadcastFloat32x4(MlasErfConstants.ExpP6));
+
+    Biased = MlasAddFloat32x4(Biased, MlasBroadcastFloat32x4(MlasErfConstants.ExpExponentBias));
+    MLAS_FLOAT32X4 PowerOf2 = MlasReinterpretAsFloat32x4(MlasShiftLeftInt32x4<23>(MlasReinterpretAsInt32x4(Biased)));
+
+    MLAS_FLOAT32X4 BigResult = MlasSubtractFloat32x4(MlasBroadcastFloat32x4(MlasErfConstants.One),
+        MlasMultiplyFloat32x4(ExpResult, PowerOf2));
+
+    //
+    // Select the approximation for each element and restore the sign.
+    //
+
+    MLAS_FLOAT32X4 Result = MlasBlendFloat32x4(SmallResult, BigResult,
+        MlasGreaterThanFloat32x4(AbsValue, MlasBroadcastFloat32x4(MlasErfConstants.SplitBoundary)));
+
+    return MlasOrFloat32x4(Result, MlasAndFloat32x4(Value, SignMask));
+}
+
+inline
+float
+MlasErfFloat(
+    float Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function of a scalar with the same
+    approximation as the vector routine.
+
+Arguments:
+
+    Value - Supplies the input value.
+
+Return Value:
+
+    Returns the error function of the input value.
+
+--*/
+{
+    float AbsValue = (std::min)(std::fabs(Value), MlasErfConstants.UpperAbsRange);
+    float SquareValue = AbsValue * AbsValue;
+    float Result;
+
+    if (AbsValue > MlasErfConstants.SplitBoundary) {
+
+        float Polynomial;
+        Polynomial = AbsValue * MlasErfConstants.BigP0 + MlasErfConstants.BigP1;
+        Polynomial = Polynomial * SquareValue + (AbsValue * MlasErfConstants.BigP2 + MlasErfConstants.BigP3);
+        Polynomial = Polynomial * AbsValue + MlasErfConstants.BigP4;
+        Polynomial = Polynomial * AbsValue + MlasErfConstants.BigP5;
+        Polynomial = Polynomial * AbsValue + MlasErfConstants.BigP6MinusOne;
+        Polynomial = Polynomial * AbsValue + AbsValue;
+
+        Result = MlasErfConstants.One - std::exp(-Polynomial);
+
+    } else {
+
+        Result = SquareValue * MlasErfConstants.SmallP0 + MlasErfConstants.SmallP1;
+        Result = Result * SquareValue + MlasErfConstants.SmallP2;
+        Result = Result * SquareValue + MlasErfConstants.SmallP3;
+        Result = Result * SquareValue + MlasErfConstants.SmallP4;
+        Result = Result * SquareValue + MlasErfConstants.SmallP5MinusOne;
+        Result = Result * AbsValue + AbsValue;
+    }
+
+    return std::copysign(Result, Value);
+}
+
+void
+MLASCALL
+MlasComputeErf(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the error function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasErfFloat32x4(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = MlasErfFloat(*Input++);
+
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasComputeGelu(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the Gaussian error linear unit, which is
+    0.5 * x * (1 + erf(x / sqrt(2))).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float ReciprocalSqrt2 = 0.70710678118654752f;
+
+    MLAS_FLOAT32X4 ReciprocalSqrt2Vector = MlasBroadcastFloat32x4(ReciprocalSqrt2);
+    MLAS_FLOAT32X4 HalfVector = MlasBroadcastFloat32x4(0.5f);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 HalfValue = MlasMultiplyFloat32x4(Value, HalfVector);
+        MLAS_FLOAT32X4 ErfValue = MlasErfFloat32x4(MlasMultiplyFloat32x4(Value, ReciprocalSqrt2Vector));
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(HalfValue, ErfValue, HalfValue));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = *Input++;
+        float HalfValue = Value * 0.5f;
+
+        *Output++ = HalfValue * MlasErfFloat(Value * ReciprocalSqrt2) + HalfValue;
+
+        N -= 1;
+    }
+}
@@ -0,0 +1,724 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    im2col.cpp
+
+Abstract:
+
+    This module implements routines to expand an image into the column matrix
+    of a convolution computed with a GEMM (im2col).
+
+    The column matrix is produced as a sequence of lines: for a CHW image, a
+    line is one output row of one kernel position of one channel, and for an
+    HWC image, a line is all kernel positions of one output element. Each line
+    reads a contiguous or strided run of the image, so the bounds checks are
+    done once per line to split the line into leading padding, the elements
+    read from the image and trailing padding. The lines are partitioned across
+    threads.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of an im2col operation on worker
+// threads.
+//
+
+struct MLAS_IM2COL_WORK_BLOCK {
+    const void* Input;
+    void* Output;
+    const void* PaddingValue;
+    size_t Dimensions;
+    size_t Channels;
+    const int64_t* InputShape;
+    const int64_t* KernelShape;
+    const int64_t* DilationShape;
+    const int64_t* Padding;
+    const int64_t* StrideShape;
+    const int64_t* OutputShape;
+    size_t InputSize;
+    size_t KernelSize;
+    size_t OutputSize;
+    size_t LineCount;
+    size_t LinesPerThread;
+};
+
+inline
+void
+MlasIm2colComputeValidRange(
+    ptrdiff_t Start,
+    size_t Step,
+    size_t Count,
+    ptrdiff_t Limit,
+    size_t* Begin,
+    size_t* End
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the range of indices I of the sequence
+    Start + I * Step, 0 <= I < Count, that address the range [0, Limit).
+
+Arguments:
+
+    Start - Supplies the first element of the sequence.
+
+    Step - Supplies the distance between the elements of the sequence.
+
+    Count - Supplies the number of elements of the sequence.
+
+    Limit - Supplies the end of the valid range.
+
+    Begin - Receives the first index that addresses the valid range.
+
+    End - Receives the index after the last index that addresses the valid
+        range. End equals Begin if no index addresses the valid range.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t SignedStep = ptrdiff_t(Step);
+
+    size_t First = (Start >= 0) ? 0 : size_t((SignedStep - 1 - Start) / SignedStep);
+    size_t Last = (Start >= Limit) ? 0 : size_t((Limit - Start + SignedStep - 1) / SignedStep);
+
+    First = std::min(First, Count);
+    Last = std::min(Last, Count);
+
+    *Begin = First;
+    *End = std::max(First, Last);
+}
+
+template<typename T>
+void
+MlasIm2colCopyLine(
+    const T* Input,
+    T* Output,
+    ptrdiff_t Start,
+    size_t Stride,
+    size_t Count,
+    size_t InputWidth,
+    T PaddingValue
+    )
+/*++
+
+Routine Description:
+
+    This routine copies the elements Start + I * Stride, 0 <= I < Count, of a
+    row of the image to a line of the column matrix, substituting the padding
+    value for the elements outside of the row.
+
+Arguments:
+
+    Input - Supplies the row of the image.
+
+    Output - Supplies the line of the column matrix.
+
+    Start - Supplies the index of the first element, which may be negative.
+
+    Stride - Supplies the distance between the elements.
+
+    Count - Supplies the number of elements of the line.
+
+    InputWidth - Supplies the number of elements of the row.
+
+    PaddingValue - Supplies the value of the padding.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t Begin;
+    size_t End;
+
+    MlasIm2colComputeValidRange(Start, Stride, Count, ptrdiff_t(InputWidth), &Begin, &End);
+
+    std::fill_n(Output, Begin, PaddingValue);
+
+    const T* Row = Input + (Start + ptrdiff_t(Begin * Stride));
+    size_t n = End - Begin;
+    T* Line = Output + Begin;
+
+    if (Stride == 1) {
+
+        std::copy_n(Row, n, Line);
+
+    } else {
+
+        while (n >= 4) {
+
+            Line[0] = Row[0];
+            Line[1] = Row[Stride];
+            Line[2] = Row[Stride * 2];
+            Line[3] = Row[Stride * 3];
+
+            Row += Stride * 4;
+            Line += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+
+            *Line++ = *Row;
+
+            Row += Stride;
+            n -= 1;
+        }
+    }
+
+    std::fill_n(Output + End, Count - End, PaddingValue);
+}
+
+template<typename T>
+void
+MlasIm2colOperation(
+    const MLAS_IM2COL_WORK_BLOCK* WorkBlock,
+    size_t StartLine,
+    size_t CountLines
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a range of lines of the column matrix of a CHW
+    image. Each line is one output row of one kernel position of one channel.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartLine - Supplies the index of the first line to expand.
+
+    CountLines - Supplies the number of lines to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Dimensions = WorkBlock->Dimensions;
+    const size_t LastDimension = Dimensions - 1;
+
+    const int64_t* InputShape = WorkBlock->InputShape;
+    const int64_t* KernelShape = WorkBlock->KernelShape;
+    const int64_t* DilationShape = WorkBlock->DilationShape;
+    const int64_t* Padding = WorkBlock->Padding;
+    const int64_t* StrideShape = WorkBlock->StrideShape;
+    const int64_t* OutputShape = WorkBlock->OutputShape;
+
+    const size_t InputWidth = size_t(InputShape[LastDimension]);
+    const size_t KernelWidth = size_t(KernelShape[LastDimension]);
+    const size_t OutputWidth = size_t(OutputShape[LastDimension]);
+    const size_t OutputRows = WorkBlock->OutputSize / OutputWidth;
+    const size_t StrideWidth = size_t(StrideShape[LastDimension]);
+
+    const T PaddingValue = *(const T*)WorkBlock->PaddingValue;
+
+    for (size_t Line = StartLine; Line < StartLine + CountLines; Line++) {
+
+        T* Output = (T*)WorkBlock->Output + Line * OutputWidth;
+
+        size_t Row = Line % OutputRows;
+        size_t KernelIndex = (Line / OutputRows) % WorkBlock->KernelSize;
+        const size_t Channel = Line / OutputRows / WorkBlock->KernelSize;
+
+        //
+        // Compute the offset of the image row read by the line from the outer
+        // spatial dimensions. The line is padding if any of these dimensions
+        // is outside of the image.
+        //
+
+        const size_t KernelColumn = KernelIndex % KernelWidth;
+        KernelIndex /= KernelWidth;
+
+        ptrdiff_t InputOffset = 0;
+        size_t InputStride = InputWidth;
+        bool IsPadding = false;
+
+        for (size_t dim = LastDimension; dim-- > 0;) {
+
+            const int64_t KernelOffset = int64_t(KernelIndex % size_t(KernelShape[dim]));
+            KernelIndex /= size_t(KernelShape[dim]);
+
+            const int64_t OutputOffset = int64_t(Row % size_t(OutputShape[dim]));
+            Row /= size_t(OutputShape[dim]);
+
+            const int64_t InputIndex = OutputOffset * StrideShape[dim] - Padding[dim] +
+                KernelOffset * DilationShape[dim];
+
+            if (InputIndex < 0 || InputIndex >= InputShape[dim]) {
+                IsPadding = true;
+                break;
+            }
+
+            InputOffset += ptrdiff_t(InputIndex) * ptrdiff_t(InputStride);
+            InputStride *= size_t(InputShape[dim]);
+        }
+
+        if (IsPadding) {
+            std::fill_n(Output, OutputWidth, PaddingValue);
+            continue;
+        }
+
+        const T* Input = (const T*)WorkBlock->Input + Channel * WorkBlock->InputSize + InputOffset;
+
+        const ptrdiff_t Start = ptrdiff_t(KernelColumn) * ptrdiff_t(DilationShape[LastDimension]) -
+            ptrdiff_t(Padding[LastDimension]);
+
+        MlasIm2colCopyLine<T>(Input, Output, Start, StrideWidth, OutputWidth, InputWidth, PaddingValue);
+    }
+}
+
+template<typename T>
+void
+MlasIm2colNhwcOperation(
+    const MLAS_IM2COL_WORK_BLOCK* WorkBlock,
+    size_t StartLine,
+    size_t CountLines
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a range of lines of the column matrix of an HWC
+    image. Each line is all kernel positions of one output element. The
+    kernel positions of the innermost spatial dimension read adjacent image
+    elements when the dilation is one, so they are copied together.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartLine - Supplies the index of the first line to expand.
+
+    CountLines - Supplies the number of lines to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Dimensions = WorkBlock->Dimensions;
+    const size_t LastDimension = Dimensions - 1;
+    const size_t Channels = WorkBlock->Channels;
+
+    const int64_t* InputShape = WorkBlock->InputShape;
+    const int64_t* KernelShape = WorkBlock->KernelShape;
+    const int64_t* DilationShape = WorkBlock->DilationShape;
+    const int64_t* Padding = WorkBlock->Padding;
+    const int64_t* StrideShape = WorkBlock->StrideShape;
+    const int64_t* OutputShape = WorkBlock->OutputShape;
+
+    const size_t InputWidth = size_t(InputShape[LastDimension]);
+    const size_t KernelWidth = size_t(KernelShape[LastDimension]);
+    const size_t DilationWidth = size_t(DilationShape[LastDimension]);
+    const size_t KernelRows = WorkBlock->KernelSize / KernelWidth;
+
+    const T PaddingValue = *(const T*)WorkBlock->PaddingValue;
+
+    T* Output = (T*)WorkBlock->Output + StartLine * WorkBlock->KernelSize * Channels;
+
+    for (size_t Line = StartLine; Line < StartLine + CountLines; Line++) {
+
+        const ptrdiff_t Start = ptrdiff_t(Line % size_t(OutputShape[LastDimension])) *
+            ptrdiff_t(StrideShape[LastDimension]) - ptrdiff_t(Padding[LastDimension]);
+
+        for (size_t KernelRow = 0; KernelRow < KernelRows; KernelRow++) {
+
+            //
+            // Compute the offset of the image row read by the kernel row from
+            // the outer spatial dimensions.
+            //
+
+            size_t OutputIndex = Line / size_t(OutputShape[LastDimension]);
+            size_t KernelIndex = KernelRow;
+            ptrdiff_t InputOffset = 0;
+            size_t InputStride = InputWidth;
+            bool IsPadding = false;
+
+            for (size_t dim = LastDimension; dim-- > 0;) {
+
+                const int64_t KernelOffset = int64_t(KernelIndex % size_t(KernelShape[dim]));
+                KernelIndex /= size_t(KernelShape[dim]);
+
+                const int64_t OutputOffset = int64_t(OutputIndex % size_t(OutputShape[dim]));
+                OutputIndex /= size_t(OutputShape[dim]);
+
+                const int64_t InputIndex = OutputOffset * StrideShape[dim] - Padding[dim] +
+                    KernelOffset * DilationShape[dim];
+
+                if (InputIndex < 0 || InputIndex >= InputShape[dim]) {
+                    IsPadding = true;
+                    break;
+                }
+
+                InputOffset += ptrdiff_t(InputIndex) * ptrdiff_t(InputStride);
+                InputStride *= size_t(InputShape[dim]);
+            }
+
+            if (IsPadding) {
+                std::fill_n(Output, KernelWidth * Channels, PaddingValue);
+                Output += KernelWidth * Channels;
+                continue;
+            }
+
+            size_t Begin;
+            size_t End;
+
+            MlasIm2colComputeValidRange(Start, DilationWidth, KernelWidth, ptrdiff_t(InputWidth),
+                &Begin, &End);
+
+            std::fill_n(Output, Begin * Channels, PaddingValue);
+
+            const T* Input = (const T*)WorkBlock->Input +
+                (InputOffset + Start + ptrdiff_t(Begin * DilationWidth)) * ptrdiff_t(Channels);
+
+            if (DilationWidth == 1) {
+                std::copy_n(Input, (End - Begin) * Channels, Output + Begin * Channels);
+            } else {
+                for (size_t k = Begin; k < End; k++) {
+                    std::copy_n(Input, Channels, Output + k * Channels);
+                    Input += DilationWidth * Channels;
+                }
+            }
+
+            std::fill_n(Output + End * Channels, (KernelWidth - End) * Channels, PaddingValue);
+
+            Output += KernelWidth * Channels;
+        }
+    }
+}
+
+template<typename T, bool IsNhwc>
+void
+MlasIm2colThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of an
+    im2col operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_IM2COL_WORK_BLOCK* WorkBlock = (const MLAS_IM2COL_WORK_BLOCK*)Context;
+
+    const size_t StartLine = size_t(Index) * WorkBlock->LinesPerThread;
+    const size_t CountLines = std::min(WorkBlock->LineCount - StartLine,
+        WorkBlock->LinesPerThread);
+
+    if (IsNhwc) {
+        MlasIm2colNhwcOperation<T>(WorkBlock, StartLine, CountLines);
+    } else {
+        MlasIm2colOperation<T>(WorkBlock, StartLine, CountLines);
+    }
+}
+
+template<typename T, bool IsNhwc>
+void
+MlasIm2colSchedule(
+    const T* Input,
+    T* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    T PaddingValue
+    )
+/*++
+
+Routine Description:
+
+    This routine segments an im2col operation across multiple threads or
+    executes the operation on the current thread based on the size of the
+    operation and the system configuration.
+
+Arguments:
+
+    See MlasIm2col.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_IM2COL_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.PaddingValue = &PaddingValue;
+    WorkBlock.Dimensions = Dimensions;
+    WorkBlock.Channels = Channels;
+    WorkBlock.InputShape = InputShape;
+    WorkBlock.KernelShape = KernelShape;
+    WorkBlock.DilationShape = DilationShape;
+    WorkBlock.Padding = Padding;
+    WorkBlock.StrideShape = StrideShape;
+    WorkBlock.OutputShape = OutputShape;
+
+    size_t InputSize = 1;
+    size_t KernelSize = 1;
+    size_t OutputSize = 1;
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        InputSize *= size_t(InputShape[dim]);
+        KernelSize *= size_t(KernelShape[dim]);
+        OutputSize *= size_t(OutputShape[dim]);
+    }
+
+    WorkBlock.InputSize = InputSize;
+    WorkBlock.KernelSize = KernelSize;
+    WorkBlock.OutputSize = OutputSize;
+
+    const size_t TotalElements = Channels * KernelSize * OutputSize;
+
+    if (TotalElements == 0) {
+        return;
+    }
+
+    if (IsNhwc) {
+        WorkBlock.LineCount = OutputSize;
+    } else {
+        WorkBlock.LineCount = Channels * KernelSize * (OutputSize / size_t(OutputShape[Dimensions - 1]));
+    }
+
+    int32_t TargetThreadCount = 1;
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    //
+    // Compute the number of target threads given the number of elements to
+    // expand. Small requests should run using the single threaded path.
+    //
+
+    if (TotalElements < MLAS_IM2COL_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(TotalElements / MLAS_IM2COL_THREAD_COMPLEXITY) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > WorkBlock.LineCount) {
+        TargetThreadCount = int32_t(WorkBlock.LineCount);
+    }
+
+#endif
+
+    if (TargetThreadCount == 1) {
+        if (IsNhwc) {
+            MlasIm2colNhwcOperation<T>(&WorkBlock, 0, WorkBlock.LineCount);
+        } else {
+            MlasIm2colOperation<T>(&WorkBlock, 0, WorkBlock.LineCount);
+        }
+        return;
+    }
+
+    //
+    // Segment the operation across multiple threads by lines of the column
+    // matrix.
+    //
+
+    const size_t LinesPerThread = (WorkBlock.LineCount + TargetThreadCount - 1) / TargetThreadCount;
+
+    WorkBlock.LinesPerThread = LinesPerThread;
+
+    int32_t Index = int32_t((WorkBlock.LineCount + LinesPerThread - 1) / LinesPerThread);
+
+    MlasExecuteThreaded(MlasIm2colThreaded<T, IsNhwc>, &WorkBlock, Index);
+}
+
+void
+MLASCALL
+MlasIm2col(
+    const float* Input,
+    float* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    float PaddingValue
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a single precision floating point CHW image into the
+    [Channels x KernelSize x OutputSize] column matrix of a convolution.
+
+Arguments:
+
+    Input - Supplies the input image.
+
+    Output - Supplies the column matrix.
+
+    Dimensions - Supplies the number of spatial dimensions.
+
+    Channels - Supplies the number of channels of the image.
+
+    InputShape - Supplies the shape of the spatial dimensions of the image.
+
+    KernelShape - Supplies the shape of the kernel.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    Padding - Supplies the number of leading padding elements of each
+        dimension followed by the number of trailing padding elements.
+
+    StrideShape - Supplies the shape of the stride.
+
+    OutputShape - Supplies the shape of the spatial dimensions of the output.
+
+    PaddingValue - Supplies the value of the padding elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasIm2colSchedule<float, false>(Input, Output, Dimensions, Channels, InputShape,
+        KernelShape, DilationShape, Padding, StrideShape, OutputShape, PaddingValue);
+}
+
+void
+MLASCALL
+MlasIm2col(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    uint8_t PaddingValue
+    )
+/*++
+
+Routine Description:
+
+    This routine expands an unsigned 8-bit integer CHW image into the
+    [Channels x KernelSize x OutputSize] column matrix of a convolution.
+
+    See the single precision variant for the description of the arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasIm2colSchedule<uint8_t, false>(Input, Output, Dimensions, Channels, InputShape,
+        KernelShape, DilationShape, Padding, StrideShape, OutputShape, PaddingValue);
+}
+
+void
+MLASCALL
+MlasIm2colNhwc(
+    const float* Input,
+    float* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    float PaddingValue
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a single precision floating point HWC image into the
+    [OutputSize x KernelSize x Channels] column matrix of a convolution.
+
+    See MlasIm2col for the description of the arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasIm2colSchedule<float, true>(Input, Output, Dimensions, Channels, InputShape,
+        KernelShape, DilationShape, Padding, StrideShape, OutputShape, PaddingValue);
+}
+
+void
+MLASCALL
+MlasIm2colNhwc(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t Dimensions,
+    size_t Channels,
+    const int64_t* InputShape,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* Padding,
+    const int64_t* StrideShape,
+    const int64_t* OutputShape,
+    uint8_t PaddingValue
+    )
+/*++
+
+Routine Description:
+
+    This routine expands an unsigned 8-bit integer HWC image into the
+    [OutputSize x KernelSize x Channels] column matrix of a convolution.
+
+    See MlasIm2col for the description of the arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasIm2colSchedule<uint8_t, true>(Input, Output, Dimensions, Channels, InputShape,
+        KernelShape, DilationShape, Padding, StrideShape, OutputShape, PaddingValue);
+}
@@ -21,6 +21,7 @@ Abstract:
 #include <mlas.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 #if defined(_WIN32)
@@ -109,6 +110,22 @@ Abstract:
 
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 
+//
+// Define the default strides to step through slices of the input matrices
+// for the quantized integer matrix/matrix multiply operation.
+//
+// The QGEMM kernels operate on matrices that have been widened to 16-bit
+// values with the zero point removed. Pairs of elements along the K dimension
+// are multiplied and accumulated with a single pmaddwd (or vpdpwssd)
+// instruction, so matrix A is packed as 32-bit pairs and matrix B is packed as
+// panels of MLAS_QGEMM_PANEL_N columns that interleave each pair of rows.
+//
+
+#define MLAS_QGEMM_STRIDEN                          256
+#define MLAS_QGEMM_STRIDEK                          128
+#define MLAS_QGEMM_PANEL_N                          16
+#define MLAS_QGEMM_PACKA_ROWS                       16
+
 //
 // Define the prototypes of the platform optimized routines.
 //
@@ -153,6 +170,22 @@ void
 
 typedef MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE* PMLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE;
 
+typedef
+size_t
+(MLASCALL MLAS_QGEMM_KERNEL_ROUTINE)(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    );
+
+typedef MLAS_QGEMM_KERNEL_ROUTINE* PMLAS_QGEMM_KERNEL_ROUTINE;
+
 typedef
 void
 (MLASCALL MLAS_LOGISTIC_KERNEL_ROUTINE)(
@@ -200,6 +233,17 @@ extern "C" {
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE MlasSgemmTransposePackB16x4Avx;
 #endif
 
+#if defined(MLAS_TARGET_AMD64_IX86)
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelSse2;
+#else
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernel;
+#endif
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx2;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx512BW;
+    MLAS_QGEMM_KERNEL_ROUTINE MlasQgemmKernelAvx512Vnni;
+#endif
+
     MLAS_TANH_KERNEL_ROUTINE MlasLogisticKernel;
     MLAS_TANH_KERNEL_ROUTINE MlasTanhKernel;
 #if defined(MLAS_TARGET_AMD64)
@@ -228,6 +272,34 @@ extern "C" {
 #endif
 #endif
 
+//
+// The QGEMM kernels retire twice as many multiplies per instruction as the
+// SGEMM kernels, so use a proportionally larger amount of work per thread.
+//
+
+#define MLAS_QGEMM_THREAD_COMPLEXITY                (MLAS_SGEMM_THREAD_COMPLEXITY * 2)
+
+//
+// Define the target number of per-thread elements to quantize or dequantize
+// before using another thread to perform additional work.
+//
+
+#define MLAS_QUANTIZE_THREAD_COMPLEXITY             (64 * 1024)
+
+//
+// Define the target number of per-thread elements to expand into a column
+// matrix before using another thread to perform additional work.
+//
+
+#define MLAS_IM2COL_THREAD_COMPLEXITY               (64 * 1024)
+
+//
+// Define the target number of per-thread elements to normalize before using
+// another thread to perform additional work.
+//
+
+#define MLAS_NORMALIZE_THREAD_COMPLEXITY            (64 * 1024)
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
@@ -249,6 +321,27 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+//
+// Winograd convolution routines.
+//
+
+bool
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t ThreadCount,
+    size_t* WorkingBufferSize
+    );
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    );
+
 //
 // Environment information class.
 //
@@ -257,9 +350,12 @@ struct MLAS_PLATFORM {
 
     MLAS_PLATFORM(void);
 
+    const char* Name;
+
 #if defined(MLAS_TARGET_AMD64_IX86)
     PMLAS_SGEMM_KERNEL_ROUTINE KernelZeroRoutine;
     PMLAS_SGEMM_KERNEL_ROUTINE KernelAddRoutine;
+    PMLAS_QGEMM_KERNEL_ROUTINE QgemmKernelRoutine;
 #endif
 
 #if defined(MLAS_TARGET_AMD64)
@@ -351,8 +447,10 @@ MlasExecuteThreaded(
 
 #if defined(MLAS_NEON_INTRINSICS)
 typedef float32x4_t MLAS_FLOAT32X4;
+typedef int32x4_t MLAS_INT32X4;
 #elif defined(MLAS_SSE2_INTRINSICS)
 typedef __m128 MLAS_FLOAT32X4;
+typedef __m128i MLAS_INT32X4;
 #endif
 
 inline
@@ -563,6 +661,176 @@ MlasMinimumFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
 #endif
 }
 
+inline
+MLAS_FLOAT32X4
+MlasInterleaveLowFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip1q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[0];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpacklo_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasInterleaveHighFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vzip2q_f32(Vector1, Vector2);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    return vzipq_f32(Vector1, Vector2).val[1];
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_unpackhi_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasSquareRootFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vsqrtq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 0)), Vector, 0);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 1)), Vector, 1);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 2)), Vector, 2);
+    Vector = vsetq_lane_f32(std::sqrt(vgetq_lane_f32(Vector, 3)), Vector, 3);
+    return Vector;
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sqrt_ps(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceAddFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vaddvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vadd_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    return vget_lane_f32(vpadd_f32(VectorLow, VectorLow), 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_add_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_add_ss(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMaximumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    return vmaxvq_f32(Vector);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vmax_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    return vget_lane_f32(vpmax_f32(VectorLow, VectorLow), 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_max_ps(Vector, _mm_movehl_ps(Vector, Vector));
+    Vector = _mm_max_ss(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 1, 1, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasAndFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(Vector1), vreinterpretq_u32_f32(Vector2)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_and_ps(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasOrFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(Vector1), vreinterpretq_u32_f32(Vector2)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_ps(Vector1, Vector2);
+#endif
+}
+
+// Computes the bitwise AND of the complement of Vector1 with Vector2.
+inline
+MLAS_FLOAT32X4
+MlasAndNotFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(Vector2), vreinterpretq_u32_f32(Vector1)));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_andnot_ps(Vector1, Vector2);
+#endif
+}
+
+// Returns a mask with all bits set in the lanes where Vector1 > Vector2.
+inline
+MLAS_FLOAT32X4
+MlasGreaterThanFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_u32(vcgtq_f32(Vector1, Vector2));
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_cmpgt_ps(Vector1, Vector2);
+#endif
+}
+
+// Selects the lanes of Vector2 where the Selection mask is set and the lanes
+// of Vector1 elsewhere.
+inline
+MLAS_FLOAT32X4
+MlasBlendFloat32x4(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2, MLAS_FLOAT32X4 Selection)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vbslq_f32(vreinterpretq_u32_f32(Selection), Vector2, Vector1);
+#elif defined(MLAS_AVX_INTRINSICS)
+    return _mm_blendv_ps(Vector1, Vector2, Selection);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_or_ps(_mm_and_ps(Selection, Vector2), _mm_andnot_ps(Selection, Vector1));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasReinterpretAsInt32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasReinterpretAsFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castsi128_ps(Vector);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftLeftInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshlq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_slli_epi32(Vector, ShiftCount);
+#endif
+}
+
 //
 // Reads a platform specific time stamp counter.
 //
@@ -0,0 +1,1020 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    normalize.cpp
+
+Abstract:
+
+    This module implements the batch, instance, layer and local response
+    normalization operations.
+
+    The mean and variance of a plane are computed in one pass over blocks of
+    the plane. Each block accumulates the sum and the sum of squares of its
+    elements relative to its first element, which keeps the sums small enough
+    for single precision, and the block results are combined with the
+    parallel form of Welford's algorithm.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of elements of a block of a plane whose moments are
+// accumulated in single precision.
+//
+
+#define MLAS_NORMALIZE_MOMENTS_BLOCK_SIZE           1024
+
+//
+// Define the number of elements of a plane processed together by the local
+// response normalization.
+//
+
+#define MLAS_LRN_SEGMENT_SIZE                       256
+
+//
+// Define the parameters to execute segments of a normalization operation on
+// worker threads.
+//
+
+struct MLAS_NORMALIZE_WORK_BLOCK {
+    const float* Input;
+    float* Output;
+    size_t BatchCount;
+    size_t ChannelCount;
+    size_t PlaneSize;
+    const float* Scale;
+    const float* Shift;
+    float* Mean;
+    float* Variance;
+    float Epsilon;
+    size_t Size;
+    float Alpha;
+    float Beta;
+    float Bias;
+    size_t TotalWork;
+    size_t WorkPerThread;
+};
+
+typedef
+void
+(MLAS_NORMALIZE_OPERATION)(
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t StartWork,
+    size_t CountWork
+    );
+
+//
+// Define the running moments of a sequence of elements.
+//
+
+struct MLAS_MOMENTS {
+    size_t Count;
+    double Mean;
+    double M2;
+};
+
+void
+MlasAccumulateMoments(
+    const float* Input,
+    size_t N,
+    MLAS_MOMENTS* Moments
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the moments of a buffer into running moments.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Moments - Supplies the running moments to update.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N > 0) {
+
+        const size_t BlockSize = std::min(N, size_t(MLAS_NORMALIZE_MOMENTS_BLOCK_SIZE));
+        const float Origin = Input[0];
+
+        MLAS_FLOAT32X4 OriginVector = MlasBroadcastFloat32x4(Origin);
+        MLAS_FLOAT32X4 Sum0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 Sum1 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 SumSquares0 = MlasZeroFloat32x4();
+        MLAS_FLOAT32X4 SumSquares1 = MlasZeroFloat32x4();
+
+        size_t n = BlockSize;
+
+        while (n >= 8) {
+
+            MLAS_FLOAT32X4 Vector0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input), OriginVector);
+            MLAS_FLOAT32X4 Vector1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + 4), OriginVector);
+
+            Sum0 = MlasAddFloat32x4(Sum0, Vector0);
+            Sum1 = MlasAddFloat32x4(Sum1, Vector1);
+            SumSquares0 = MlasMultiplyAddFloat32x4(Vector0, Vector0, SumSquares0);
+            SumSquares1 = MlasMultiplyAddFloat32x4(Vector1, Vector1, SumSquares1);
+
+            Input += 8;
+            n -= 8;
+        }
+
+        float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(Sum0, Sum1));
+        float SumSquares = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquares0, SumSquares1));
+
+        while (n > 0) {
+
+            float Value = *Input++ - Origin;
+
+            Sum += Value;
+            SumSquares += Value * Value;
+
+            n -= 1;
+        }
+
+        //
+        // Combine the moments of the block with the running moments.
+        //
+
+        const double BlockCount = double(BlockSize);
+        const double BlockMean = double(Origin) + double(Sum) / BlockCount;
+        const double BlockM2 = std::max(double(SumSquares) - double(Sum) * double(Sum) / BlockCount, 0.0);
+
+        if (Moments->Count == 0) {
+
+            Moments->Mean = BlockMean;
+            Moments->M2 = BlockM2;
+
+        } else {
+
+            const double Count = double(Moments->Count);
+            const double TotalCount = Count + BlockCount;
+            const double Delta = BlockMean - Moments->Mean;
+
+            Moments->Mean += Delta * BlockCount / TotalCount;
+            Moments->M2 += BlockM2 + Delta * Delta * Count * BlockCount / TotalCount;
+        }
+
+        Moments->Count += BlockSize;
+        N -= BlockSize;
+    }
+}
+
+void
+MlasScaleShiftKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Origin,
+    float Scale,
+    float Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine computes Output = (Input - Origin) * Scale + Shift for a
+    buffer. Subtracting the origin first avoids the cancellation of folding it
+    into the shift when the origin is large relative to the deviations.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Origin - Supplies the origin.
+
+    Scale - Supplies the scale.
+
+    Shift - Supplies the shift.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 OriginVector = MlasBroadcastFloat32x4(Origin);
+    MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+    MLAS_FLOAT32X4 ShiftVector = MlasBroadcastFloat32x4(Shift);
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input), OriginVector);
+        MLAS_FLOAT32X4 Vector1 = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + 4), OriginVector);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(Vector0, ScaleVector, ShiftVector));
+        MlasStoreFloat32x4(Output + 4, MlasMultiplyAddFloat32x4(Vector1, ScaleVector, ShiftVector));
+
+        Input += 8;
+        Output += 8;
+        N -= 8;
+    }
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input), OriginVector);
+
+        MlasStoreFloat32x4(Output, MlasMultiplyAddFloat32x4(Vector, ScaleVector, ShiftVector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output++ = (*Input++ - Origin) * Scale + Shift;
+
+        N -= 1;
+    }
+}
+
+void
+MlasBatchNormalizationOperation(
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t StartWork,
+    size_t CountWork
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the per-channel scale and shift to a range of
+    elements, splitting the range at each change of plane.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartWork - Supplies the index of the first element to process.
+
+    CountWork - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* Input = WorkBlock->Input + StartWork;
+    float* Output = WorkBlock->Output + StartWork;
+
+    const size_t PlaneSize = WorkBlock->PlaneSize;
+
+    size_t Plane = StartWork / PlaneSize;
+    size_t PlaneOffset = StartWork - Plane * PlaneSize;
+
+    while (CountWork > 0) {
+
+        const size_t Channel = Plane % WorkBlock->ChannelCount;
+        const size_t CountN = std::min(PlaneSize - PlaneOffset, CountWork);
+
+        MlasScaleShiftKernel(Input, Output, CountN, 0.0f, WorkBlock->Scale[Channel],
+            WorkBlock->Shift[Channel]);
+
+        Input += CountN;
+        Output += CountN;
+        CountWork -= CountN;
+
+        Plane++;
+        PlaneOffset = 0;
+    }
+}
+
+void
+MlasInstanceNormalizationOperation(
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t StartWork,
+    size_t CountWork
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a range of planes. The moments of each plane are
+    computed and the plane is normalized while it is still in the cache.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartWork - Supplies the index of the first plane to process.
+
+    CountWork - Supplies the number of planes to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PlaneSize = WorkBlock->PlaneSize;
+
+    for (size_t Plane = StartWork; Plane < StartWork + CountWork; Plane++) {
+
+        const float* Input = WorkBlock->Input + Plane * PlaneSize;
+        float* Output = WorkBlock->Output + Plane * PlaneSize;
+        const size_t Channel = Plane % WorkBlock->ChannelCount;
+
+        MLAS_MOMENTS Moments = { 0, 0.0, 0.0 };
+
+        MlasAccumulateMoments(Input, PlaneSize, &Moments);
+
+        const double Variance = Moments.M2 / double(PlaneSize);
+        const double InverseStdDev = 1.0 / std::sqrt(Variance + double(WorkBlock->Epsilon));
+
+        const float Scale = float(double(WorkBlock->Scale[Channel]) * InverseStdDev);
+
+        MlasScaleShiftKernel(Input, Output, PlaneSize, float(Moments.Mean), Scale,
+            WorkBlock->Shift[Channel]);
+    }
+}
+
+void
+MlasLayerNormalizationOperation(
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t StartWork,
+    size_t CountWork
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a range of rows. The moments of each row are
+    computed and the row is normalized and scaled by the per-element affine
+    while it is still in the cache.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartWork - Supplies the index of the first row to process.
+
+    CountWork - Supplies the number of rows to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t RowSize = WorkBlock->PlaneSize;
+    const float* Scale = WorkBlock->Scale;
+    const float* Bias = WorkBlock->Shift;
+
+    for (size_t Row = StartWork; Row < StartWork + CountWork; Row++) {
+
+        const float* Input = WorkBlock->Input + Row * RowSize;
+        float* Output = WorkBlock->Output + Row * RowSize;
+
+        MLAS_MOMENTS Moments = { 0, 0.0, 0.0 };
+
+        MlasAccumulateMoments(Input, RowSize, &Moments);
+
+        const double Variance = Moments.M2 / double(RowSize);
+        const float Mean = float(Moments.Mean);
+        const float InverseStdDev = float(1.0 / std::sqrt(Variance + double(WorkBlock->Epsilon)));
+
+        MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+        MLAS_FLOAT32X4 InverseStdDevVector = MlasBroadcastFloat32x4(InverseStdDev);
+
+        size_t i = 0;
+
+        for (; i + 4 <= RowSize; i += 4) {
+
+            MLAS_FLOAT32X4 Vector = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input + i), MeanVector);
+            Vector = MlasMultiplyFloat32x4(Vector, InverseStdDevVector);
+
+            if (Bias != nullptr) {
+                Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(Scale + i),
+                    MlasLoadFloat32x4(Bias + i));
+            } else {
+                Vector = MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(Scale + i));
+            }
+
+            MlasStoreFloat32x4(Output + i, Vector);
+        }
+
+        for (; i < RowSize; i++) {
+
+            float Value = (Input[i] - Mean) * InverseStdDev * Scale[i];
+
+            if (Bias != nullptr) {
+                Value += Bias[i];
+            }
+
+            Output[i] = Value;
+        }
+    }
+}
+
+void
+MlasComputeChannelMomentsOperation(
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t StartWork,
+    size_t CountWork
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the moments of a range of channels across the batch.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartWork - Supplies the index of the first channel to process.
+
+    CountWork - Supplies the number of channels to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ChannelCount = WorkBlock->ChannelCount;
+    const size_t PlaneSize = WorkBlock->PlaneSize;
+
+    for (size_t Channel = StartWork; Channel < StartWork + CountWork; Channel++) {
+
+        MLAS_MOMENTS Moments = { 0, 0.0, 0.0 };
+
+        for (size_t Batch = 0; Batch < WorkBlock->BatchCount; Batch++) {
+            MlasAccumulateMoments(WorkBlock->Input + (Batch * ChannelCount + Channel) * PlaneSize,
+                PlaneSize, &Moments);
+        }
+
+        WorkBlock->Mean[Channel] = float(Moments.Mean);
+        WorkBlock->Variance[Channel] = float(Moments.M2 / double(Moments.Count));
+    }
+}
+
+void
+MlasLocalResponseNormalizationOperation(
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t StartWork,
+    size_t CountWork
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a range of segments of the planes of an image.
+    A segment is a range of elements of a plane that is processed for all
+    channels of the image. The sum of the squares of the window of channels
+    is updated as the window slides across the channels by adding the
+    square of the channel entering the window and subtracting the square of
+    the channel leaving it.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartWork - Supplies the index of the first segment to process.
+
+    CountWork - Supplies the number of segments to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ChannelCount = WorkBlock->ChannelCount;
+    const size_t PlaneSize = WorkBlock->PlaneSize;
+    const size_t SegmentCount = (PlaneSize + MLAS_LRN_SEGMENT_SIZE - 1) / MLAS_LRN_SEGMENT_SIZE;
+
+    const size_t PrePad = (WorkBlock->Size - 1) / 2;
+    const size_t PostPad = WorkBlock->Size - 1 - PrePad;
+
+    const float AlphaOverSize = WorkBlock->Alpha / float(WorkBlock->Size);
+    const float Beta = WorkBlock->Beta;
+    const float Bias = WorkBlock->Bias;
+
+    MLAS_FLOAT32X4 AlphaOverSizeVector = MlasBroadcastFloat32x4(AlphaOverSize);
+    MLAS_FLOAT32X4 BiasVector = MlasBroadcastFloat32x4(Bias);
+
+    MLAS_DECLSPEC_ALIGN(float SquareSum[MLAS_LRN_SEGMENT_SIZE], 16);
+
+    for (size_t Work = StartWork; Work < StartWork + CountWork; Work++) {
+
+        const size_t Batch = Work / SegmentCount;
+        const size_t SegmentOffset = (Work % SegmentCount) * MLAS_LRN_SEGMENT_SIZE;
+        const size_t SegmentSize = std::min(PlaneSize - SegmentOffset, size_t(MLAS_LRN_SEGMENT_SIZE));
+
+        const float* Input = WorkBlock->Input + Batch * ChannelCount * PlaneSize + SegmentOffset;
+        float* Output = WorkBlock->Output + Batch * ChannelCount * PlaneSize + SegmentOffset;
+
+        //
+        // Accumulate the squares of the channels of the window of the first
+        // channel.
+        //
+
+        std::fill_n(SquareSum, SegmentSize, 0.0f);
+
+        auto AccumulateSquares = [&](size_t Channel, float Sign) {
+
+            const float* ChannelInput = Input + Channel * PlaneSize;
+            MLAS_FLOAT32X4 SignVector = MlasBroadcastFloat32x4(Sign);
+
+            size_t i = 0;
+
+            for (; i + 4 <= SegmentSize; i += 4) {
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(ChannelInput + i);
+                Vector = MlasMultiplyFloat32x4(Vector, SignVector);
+                Vector = MlasMultiplyAddFloat32x4(Vector, MlasLoadFloat32x4(ChannelInput + i),
+                    MlasLoadFloat32x4(SquareSum + i));
+                MlasStoreAlignedFloat32x4(SquareSum + i, Vector);
+            }
+
+            for (; i < SegmentSize; i++) {
+                SquareSum[i] += Sign * ChannelInput[i] * ChannelInput[i];
+            }
+        };
+
+        for (size_t Channel = 0; Channel <= std::min(PostPad, ChannelCount - 1); Channel++) {
+            AccumulateSquares(Channel, 1.0f);
+        }
+
+        for (size_t Channel = 0; Channel < ChannelCount; Channel++) {
+
+            //
+            // Slide the window of channels to be centered on this channel.
+            //
+
+            if (Channel > 0) {
+                if (Channel + PostPad < ChannelCount) {
+                    AccumulateSquares(Channel + PostPad, 1.0f);
+                }
+                if (Channel > PrePad) {
+                    AccumulateSquares(Channel - PrePad - 1, -1.0f);
+                }
+            }
+
+            const float* ChannelInput = Input + Channel * PlaneSize;
+            float* ChannelOutput = Output + Channel * PlaneSize;
+
+            size_t i = 0;
+
+            //
+            // The common exponent of 0.75 is computed as the reciprocal of the
+            // product of the square root and the fourth root.
+            //
+
+            if (Beta == 0.75f) {
+
+                for (; i + 4 <= SegmentSize; i += 4) {
+                    MLAS_FLOAT32X4 Vector = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(SquareSum + i),
+                        AlphaOverSizeVector, BiasVector);
+                    MLAS_FLOAT32X4 SquareRoot = MlasSquareRootFloat32x4(Vector);
+                    Vector = MlasMultiplyFloat32x4(SquareRoot, MlasSquareRootFloat32x4(SquareRoot));
+                    Vector = MlasDivideFloat32x4(MlasLoadFloat32x4(ChannelInput + i), Vector);
+                    MlasStoreFloat32x4(ChannelOutput + i, Vector);
+                }
+            }
+
+            for (; i < SegmentSize; i++) {
+                ChannelOutput[i] = ChannelInput[i] * std::pow(Bias + AlphaOverSize * SquareSum[i], -Beta);
+            }
+        }
+    }
+}
+
+template<MLAS_NORMALIZE_OPERATION* Operation>
+void
+MlasNormalizeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_NORMALIZE_WORK_BLOCK* WorkBlock = (const MLAS_NORMALIZE_WORK_BLOCK*)Context;
+
+    const size_t StartWork = size_t(Index) * WorkBlock->WorkPerThread;
+    const size_t CountWork = std::min(WorkBlock->TotalWork - StartWork,
+        WorkBlock->WorkPerThread);
+
+    Operation(WorkBlock, StartWork, CountWork);
+}
+
+template<MLAS_NORMALIZE_OPERATION* Operation>
+void
+MlasNormalizeSchedule(
+    MLAS_NORMALIZE_WORK_BLOCK* WorkBlock,
+    size_t TotalWork,
+    size_t TotalElements,
+    size_t WorkAlignment
+    )
+/*++
+
+Routine Description:
+
+    This routine segments a normalization operation across multiple threads
+    or executes the operation on the current thread based on the size of the
+    operation and the system configuration.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    TotalWork - Supplies the number of units of work of the operation.
+
+    TotalElements - Supplies the number of elements processed by the
+        operation.
+
+    WorkAlignment - Supplies the multiple of the units of work assigned to
+        each thread.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (TotalWork == 0) {
+        return;
+    }
+
+    WorkBlock->TotalWork = TotalWork;
+
+    int32_t TargetThreadCount = 1;
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    //
+    // Compute the number of target threads given the number of elements to
+    // process. Small requests should run using the single threaded path.
+    //
+
+    if (TotalElements < MLAS_NORMALIZE_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(TotalElements / MLAS_NORMALIZE_THREAD_COMPLEXITY) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    if (size_t(TargetThreadCount) > TotalWork) {
+        TargetThreadCount = int32_t(TotalWork);
+    }
+
+#else
+
+    MLAS_UNREFERENCED_PARAMETER(TotalElements);
+
+#endif
+
+    if (TargetThreadCount == 1) {
+        Operation(WorkBlock, 0, TotalWork);
+        return;
+    }
+
+    size_t WorkPerThread = (TotalWork + TargetThreadCount - 1) / TargetThreadCount;
+
+    WorkPerThread = (WorkPerThread + WorkAlignment - 1) / WorkAlignment * WorkAlignment;
+
+    WorkBlock->WorkPerThread = WorkPerThread;
+
+    int32_t Index = int32_t((TotalWork + WorkPerThread - 1) / WorkPerThread);
+
+    MlasExecuteThreaded(MlasNormalizeThreaded<Operation>, WorkBlock, Index);
+}
+
+void
+MLASCALL
+MlasBatchNormalization(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    const float* Scale,
+    const float* Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine applies an inference batch normalization folded into a
+    scale and shift per channel.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+    BatchCount - Supplies the number of images.
+
+    ChannelCount - Supplies the number of channels per image.
+
+    PlaneSize - Supplies the number of elements per channel.
+
+    Scale - Supplies the scale of each channel.
+
+    Shift - Supplies the shift of each channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NORMALIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.ChannelCount = ChannelCount;
+    WorkBlock.PlaneSize = PlaneSize;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Shift = Shift;
+
+    //
+    // Each thread processes a range of elements that is a multiple of the
+    // vector width, so that only the final range processes a partial vector.
+    //
+
+    const size_t TotalElements = BatchCount * ChannelCount * PlaneSize;
+
+    MlasNormalizeSchedule<MlasBatchNormalizationOperation>(&WorkBlock, TotalElements,
+        TotalElements, 16);
+}
+
+void
+MLASCALL
+MlasInstanceNormalization(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    const float* Scale,
+    const float* Bias,
+    float Epsilon
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes each plane of a tensor by its mean and variance
+    and applies the affine of its channel.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+    BatchCount - Supplies the number of images.
+
+    ChannelCount - Supplies the number of channels per image.
+
+    PlaneSize - Supplies the number of elements per channel.
+
+    Scale - Supplies the scale of each channel.
+
+    Bias - Supplies the bias of each channel.
+
+    Epsilon - Supplies the value added to the variance.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NORMALIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.ChannelCount = ChannelCount;
+    WorkBlock.PlaneSize = PlaneSize;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Shift = Bias;
+    WorkBlock.Epsilon = Epsilon;
+
+    if (PlaneSize == 0) {
+        return;
+    }
+
+    MlasNormalizeSchedule<MlasInstanceNormalizationOperation>(&WorkBlock,
+        BatchCount * ChannelCount, BatchCount * ChannelCount * PlaneSize, 1);
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    float* Output,
+    size_t RowCount,
+    size_t RowSize,
+    const float* Scale,
+    const float* Bias,
+    float Epsilon
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes each row of a matrix by its mean and variance and
+    applies a per-element affine shared by all rows.
+
+Arguments:
+
+    Input - Supplies the input matrix.
+
+    Output - Supplies the output matrix.
+
+    RowCount - Supplies the number of rows.
+
+    RowSize - Supplies the number of elements per row.
+
+    Scale - Supplies the scale of each element of a row.
+
+    Bias - Optionally supplies the bias of each element of a row.
+
+    Epsilon - Supplies the value added to the variance.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NORMALIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.PlaneSize = RowSize;
+    WorkBlock.Scale = Scale;
+    WorkBlock.Shift = Bias;
+    WorkBlock.Epsilon = Epsilon;
+
+    if (RowSize == 0) {
+        return;
+    }
+
+    MlasNormalizeSchedule<MlasLayerNormalizationOperation>(&WorkBlock, RowCount,
+        RowCount * RowSize, 1);
+}
+
+void
+MLASCALL
+MlasComputeChannelMoments(
+    const float* Input,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    float* Mean,
+    float* Variance
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and population variance of each channel
+    of a tensor across the images of the batch.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    BatchCount - Supplies the number of images.
+
+    ChannelCount - Supplies the number of channels per image.
+
+    PlaneSize - Supplies the number of elements per channel.
+
+    Mean - Supplies the buffer to receive the mean of each channel.
+
+    Variance - Supplies the buffer to receive the variance of each channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NORMALIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.BatchCount = BatchCount;
+    WorkBlock.ChannelCount = ChannelCount;
+    WorkBlock.PlaneSize = PlaneSize;
+    WorkBlock.Mean = Mean;
+    WorkBlock.Variance = Variance;
+
+    if (BatchCount == 0 || PlaneSize == 0) {
+        return;
+    }
+
+    MlasNormalizeSchedule<MlasComputeChannelMomentsOperation>(&WorkBlock, ChannelCount,
+        BatchCount * ChannelCount * PlaneSize, 1);
+}
+
+void
+MLASCALL
+MlasLocalResponseNormalization(
+    const float* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    size_t Size,
+    float Alpha,
+    float Beta,
+    float Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine applies a local response normalization across the channels
+    of each image.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+    BatchCount - Supplies the number of images.
+
+    ChannelCount - Supplies the number of channels per image.
+
+    PlaneSize - Supplies the number of elements per channel.
+
+    Size - Supplies the number of channels of the window.
+
+    Alpha - Supplies the scale of the sum of squares.
+
+    Beta - Supplies the exponent.
+
+    Bias - Supplies the bias added to the scaled sum of squares.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_NORMALIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.ChannelCount = ChannelCount;
+    WorkBlock.PlaneSize = PlaneSize;
+    WorkBlock.Size = Size;
+    WorkBlock.Alpha = Alpha;
+    WorkBlock.Beta = Beta;
+    WorkBlock.Bias = Bias;
+
+    if (ChannelCount == 0) {
+        return;
+    }
+
+    const size_t SegmentCount = (PlaneSize + MLAS_LRN_SEGMENT_SIZE - 1) / MLAS_LRN_SEGMENT_SIZE;
+
+    MlasNormalizeSchedule<MlasLocalResponseNormalizationOperation>(&WorkBlock,
+        BatchCount * SegmentCount, BatchCount * ChannelCount * PlaneSize, 1);
+}
@@ -78,14 +78,18 @@ Return Value:
 --*/
 {
 
+    this->Name = "Default";
+
 #if defined(MLAS_TARGET_AMD64_IX86)
 
     //
     // Default to the baseline SSE2 support.
     //
 
+    this->Name = "SSE2";
     this->KernelZeroRoutine = MlasSgemmKernelZeroSse;
     this->KernelAddRoutine = MlasSgemmKernelAddSse;
+    this->QgemmKernelRoutine = MlasQgemmKernelSse2;
 #if defined(MLAS_TARGET_AMD64)
     this->TransposePackB16x4Routine = MlasSgemmTransposePackB16x4Sse;
     this->LogisticKernelRoutine = MlasLogisticKernel;
@@ -115,6 +119,7 @@ Return Value:
 
 #if defined(MLAS_TARGET_IX86)
 
+            this->Name = "AVX";
             this->KernelZeroRoutine = MlasSgemmKernelZeroAvx;
             this->KernelAddRoutine = MlasSgemmKernelAddAvx;
 
@@ -134,10 +139,32 @@ Return Value:
 
             if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
 
+                this->QgemmKernelRoutine = MlasQgemmKernelAvx2;
+
                 if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                    this->Name = "AVX512F";
                     this->KernelZeroRoutine = MlasSgemmKernelZeroAvx512F;
                     this->KernelAddRoutine = MlasSgemmKernelAddAvx512F;
+
+                    //
+                    // Check if the processor supports AVX512BW and the AVX512
+                    // vector neural network instructions. The VNNI kernel is
+                    // only built when the compiler supports the instructions.
+                    //
+
+                    if ((Cpuid7[1] & 0x40000000) != 0) {
+
+                        this->QgemmKernelRoutine = MlasQgemmKernelAvx512BW;
+
+#if defined(MLAS_AVX512VNNI_SUPPORTED)
+                        if ((Cpuid7[2] & 0x800) != 0) {
+                            this->QgemmKernelRoutine = MlasQgemmKernelAvx512Vnni;
+                        }
+#endif
+                    }
+
                 } else {
+                    this->Name = "FMA3";
                     this->KernelZeroRoutine = MlasSgemmKernelZeroFma3;
                     this->KernelAddRoutine = MlasSgemmKernelAddFma3;
                 }
@@ -147,6 +174,7 @@ Return Value:
 
             } else {
 
+                this->Name = "AVX";
                 this->KernelZeroRoutine = MlasSgemmKernelZeroAvx;
                 this->KernelAddRoutine = MlasSgemmKernelAddAvx;
             }
@@ -181,3 +209,53 @@ Return Value:
 #endif
 
 }
+
+const char*
+MLASCALL
+MlasGetPlatformName(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the name of the instruction set used by the SGEMM
+    kernels that were selected for the processor.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns a static string such as "AVX512F".
+
+--*/
+{
+    return MlasPlatform.Name;
+}
+
+size_t
+MLASCALL
+MlasGetMaximumThreadCount(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the maximum number of threads that the library
+    splits an operation across.
+
+Arguments:
+
+    None.
+
+Return Value:
+
+    Returns the maximum thread count.
+
+--*/
+{
+    return size_t(MlasPlatform.GetMaximumThreadCount());
+}
@@ -0,0 +1,1216 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm.cpp
+
+Abstract:
+
+    This module implements the quantized integer matrix/matrix multiply
+    operation (QGEMM).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute segments of a QGEMM operation on worker
+// threads.
+//
+
+struct MLAS_QGEMM_WORK_BLOCK {
+    size_t K;
+    const uint8_t* A;
+    size_t lda;
+    uint8_t offa;
+    const void* B;
+    size_t ldb;
+    int16_t offb;
+    bool BIsSigned;
+    const int16_t* PackedB;
+    size_t PackedCountN;
+    int32_t* C;
+    size_t ldc;
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize;
+    struct SEGMENT {
+        size_t StartM;
+        size_t CountM;
+        size_t StartN;
+        size_t CountN;
+    } Segments[MLAS_MAXIMUM_THREAD_COUNT];
+};
+
+void
+MlasQgemmPackA(
+    int32_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    uint8_t offa
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer. Each element is widened to a 16-bit value with the zero
+    point removed and adjacent elements along the K dimension are stored as a
+    32-bit pair. An odd trailing element is paired with zero.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows of the source matrix to copy.
+
+    CountK - Supplies the number of columns of the source matrix to copy.
+
+    offa - Supplies the zero point of the source matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    const __m128i ZeroVector = _mm_setzero_si128();
+    const __m128i OffsetVector = _mm_set1_epi16(offa);
+#endif
+
+    const size_t PairCountK = (CountK + 1) / 2;
+
+    while (CountM-- > 0) {
+
+        const uint8_t* a = A;
+        int32_t* d = D;
+        size_t k = CountK;
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+        while (k >= 16) {
+
+            __m128i Bytes = _mm_loadu_si128((const __m128i*)a);
+
+            __m128i Words0 = _mm_sub_epi16(_mm_unpacklo_epi8(Bytes, ZeroVector), OffsetVector);
+            __m128i Words1 = _mm_sub_epi16(_mm_unpackhi_epi8(Bytes, ZeroVector), OffsetVector);
+
+            _mm_storeu_si128((__m128i*)d, Words0);
+            _mm_storeu_si128((__m128i*)(d + 4), Words1);
+
+            a += 16;
+            d += 8;
+            k -= 16;
+        }
+
+#endif
+
+        while (k >= 2) {
+
+            uint16_t Element0 = uint16_t(int16_t(a[0]) - int16_t(offa));
+            uint16_t Element1 = uint16_t(int16_t(a[1]) - int16_t(offa));
+
+            *d++ = int32_t(uint32_t(Element0) | (uint32_t(Element1) << 16));
+
+            a += 2;
+            k -= 2;
+        }
+
+        if (k > 0) {
+            *d = int32_t(uint16_t(int16_t(a[0]) - int16_t(offa)));
+        }
+
+        A += lda;
+        D += PairCountK;
+    }
+}
+
+template<typename T>
+void
+MlasQgemmCopyPackB(
+    int16_t* D,
+    const T* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int16_t offb
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+    Columns of the source matrix are grouped into panels of MLAS_QGEMM_PANEL_N
+    columns. Within a panel, each pair of rows is interleaved so that the two
+    16-bit values along the K dimension for a column are adjacent. Columns
+    beyond CountN and an odd trailing row are padded with zeroes.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    offb - Supplies the zero point of the source matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    const __m128i OffsetVector = _mm_set1_epi16(offb);
+#endif
+
+    while (CountN > 0) {
+
+        const size_t CountNPanel = std::min(CountN, size_t(MLAS_QGEMM_PANEL_N));
+
+        const T* b = B;
+        size_t k = CountK;
+
+        while (k >= 2) {
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+            if (CountNPanel == MLAS_QGEMM_PANEL_N) {
+
+                __m128i Row0 = _mm_loadu_si128((const __m128i*)b);
+                __m128i Row1 = _mm_loadu_si128((const __m128i*)(b + ldb));
+
+                __m128i Interleaved0 = _mm_unpacklo_epi8(Row0, Row1);
+                __m128i Interleaved1 = _mm_unpackhi_epi8(Row0, Row1);
+
+                __m128i Words0;
+                __m128i Words1;
+                __m128i Words2;
+                __m128i Words3;
+
+                if (std::numeric_limits<T>::is_signed) {
+                    Words0 = _mm_srai_epi16(_mm_unpacklo_epi8(Interleaved0, Interleaved0), 8);
+                    Words1 = _mm_srai_epi16(_mm_unpackhi_epi8(Interleaved0, Interleaved0), 8);
+                    Words2 = _mm_srai_epi16(_mm_unpacklo_epi8(Interleaved1, Interleaved1), 8);
+                    Words3 = _mm_srai_epi16(_mm_unpackhi_epi8(Interleaved1, Interleaved1), 8);
+                } else {
+                    __m128i ZeroVector = _mm_setzero_si128();
+                    Words0 = _mm_unpacklo_epi8(Interleaved0, ZeroVector);
+                    Words1 = _mm_unpackhi_epi8(Interleaved0, ZeroVector);
+                    Words2 = _mm_unpacklo_epi8(Interleaved1, ZeroVector);
+                    Words3 = _mm_unpackhi_epi8(Interleaved1, ZeroVector);
+                }
+
+                _mm_storeu_si128((__m128i*)D, _mm_sub_epi16(Words0, OffsetVector));
+                _mm_storeu_si128((__m128i*)(D + 8), _mm_sub_epi16(Words1, OffsetVector));
+                _mm_storeu_si128((__m128i*)(D + 16), _mm_sub_epi16(Words2, OffsetVector));
+                _mm_storeu_si128((__m128i*)(D + 24), _mm_sub_epi16(Words3, OffsetVector));
+
+                D += MLAS_QGEMM_PANEL_N * 2;
+                b += ldb * 2;
+                k -= 2;
+
+                continue;
+            }
+
+#endif
+
+            for (size_t n = 0; n < MLAS_QGEMM_PANEL_N; n++) {
+                if (n < CountNPanel) {
+                    D[n * 2] = int16_t(int16_t(b[n]) - offb);
+                    D[n * 2 + 1] = int16_t(int16_t(b[ldb + n]) - offb);
+                } else {
+                    D[n * 2] = 0;
+                    D[n * 2 + 1] = 0;
+                }
+            }
+
+            D += MLAS_QGEMM_PANEL_N * 2;
+            b += ldb * 2;
+            k -= 2;
+        }
+
+        if (k > 0) {
+
+            for (size_t n = 0; n < MLAS_QGEMM_PANEL_N; n++) {
+                D[n * 2] = (n < CountNPanel) ? int16_t(int16_t(b[n]) - offb) : 0;
+                D[n * 2 + 1] = 0;
+            }
+
+            D += MLAS_QGEMM_PANEL_N * 2;
+        }
+
+        B += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+#if !defined(MLAS_TARGET_AMD64_IX86)
+
+size_t
+MLASCALL
+MlasQgemmKernel(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasQgemmPackA.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasQgemmCopyPackB.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of packed pairs from matrix A and the
+        number of packed pairs of rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the number of packed pairs per row of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    while (CountN > 0) {
+
+        int32_t Accumulators[MLAS_QGEMM_PANEL_N] = { 0 };
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            const int32_t Element0 = int16_t(uint32_t(A[k]) & 0xFFFF);
+            const int32_t Element1 = int16_t(uint32_t(A[k]) >> 16);
+
+            for (size_t n = 0; n < MLAS_QGEMM_PANEL_N; n++) {
+                Accumulators[n] += Element0 * B[n * 2] + Element1 * B[n * 2 + 1];
+            }
+
+            B += MLAS_QGEMM_PANEL_N * 2;
+        }
+
+        const size_t CountNPanel = std::min(CountN, size_t(MLAS_QGEMM_PANEL_N));
+
+        for (size_t n = 0; n < CountNPanel; n++) {
+            C[n] = ZeroMode ? Accumulators[n] : C[n] + Accumulators[n];
+        }
+
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+
+    return 1;
+}
+
+#else
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelSse2Rows(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    while (CountN > 0) {
+
+        __m128i Accumulators[RowCount][4];
+
+        for (size_t row = 0; row < RowCount; row++) {
+            for (size_t i = 0; i < 4; i++) {
+                Accumulators[row][i] = _mm_setzero_si128();
+            }
+        }
+
+        const int32_t* a = A;
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            __m128i BElements0 = _mm_loadu_si128((const __m128i*)B);
+            __m128i BElements1 = _mm_loadu_si128((const __m128i*)(B + 8));
+            __m128i BElements2 = _mm_loadu_si128((const __m128i*)(B + 16));
+            __m128i BElements3 = _mm_loadu_si128((const __m128i*)(B + 24));
+
+            for (size_t row = 0; row < RowCount; row++) {
+
+                __m128i AElements = _mm_set1_epi32(a[row * lda]);
+
+                Accumulators[row][0] = _mm_add_epi32(Accumulators[row][0], _mm_madd_epi16(AElements, BElements0));
+                Accumulators[row][1] = _mm_add_epi32(Accumulators[row][1], _mm_madd_epi16(AElements, BElements1));
+                Accumulators[row][2] = _mm_add_epi32(Accumulators[row][2], _mm_madd_epi16(AElements, BElements2));
+                Accumulators[row][3] = _mm_add_epi32(Accumulators[row][3], _mm_madd_epi16(AElements, BElements3));
+            }
+
+            a += 1;
+            B += MLAS_QGEMM_PANEL_N * 2;
+        }
+
+        const size_t CountNPanel = std::min(CountN, size_t(MLAS_QGEMM_PANEL_N));
+
+        for (size_t row = 0; row < RowCount; row++) {
+
+            int32_t* c = C + row * ldc;
+
+            if (CountNPanel == MLAS_QGEMM_PANEL_N) {
+
+                for (size_t i = 0; i < 4; i++) {
+
+                    __m128i Result = Accumulators[row][i];
+
+                    if (!ZeroMode) {
+                        Result = _mm_add_epi32(Result, _mm_loadu_si128((const __m128i*)(c + i * 4)));
+                    }
+
+                    _mm_storeu_si128((__m128i*)(c + i * 4), Result);
+                }
+
+            } else {
+
+                MLAS_DECLSPEC_ALIGN(int32_t Buffer[MLAS_QGEMM_PANEL_N], 16);
+
+                for (size_t i = 0; i < 4; i++) {
+                    _mm_store_si128((__m128i*)(Buffer + i * 4), Accumulators[row][i]);
+                }
+
+                for (size_t n = 0; n < CountNPanel; n++) {
+                    c[n] = ZeroMode ? Buffer[n] : c[n] + Buffer[n];
+                }
+            }
+        }
+
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmKernelSse2(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using SSE2 instructions.
+
+    See MlasQgemmKernel for the description of the arguments.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 2) {
+        MlasQgemmKernelSse2Rows<2>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+        return 2;
+    }
+
+    MlasQgemmKernelSse2Rows<1>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+    return 1;
+}
+
+#endif
+
+inline
+int32_t
+MlasQgemmRoundingDoublingHighMultiply(
+    int32_t Value,
+    int32_t Multiplier
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the high 32 bits of the doubled product of the two
+    values, rounded to nearest with ties away from zero and saturated for the
+    single overflowing case.
+
+--*/
+{
+    if (Value == Multiplier && Value == std::numeric_limits<int32_t>::min()) {
+        return std::numeric_limits<int32_t>::max();
+    }
+
+    int64_t Product = int64_t(Value) * int64_t(Multiplier);
+    int64_t Nudge = (Product >= 0) ? (int64_t(1) << 30) : (1 - (int64_t(1) << 30));
+
+    return int32_t((Product + Nudge) / (int64_t(1) << 31));
+}
+
+inline
+int32_t
+MlasQgemmRoundingRightShift(
+    int32_t Value,
+    int32_t Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine divides the value by a power of two, rounded to nearest with
+    ties away from zero.
+
+--*/
+{
+    const int32_t Mask = int32_t((int64_t(1) << Shift) - 1);
+    const int32_t Remainder = Value & Mask;
+    const int32_t Threshold = (Mask >> 1) + ((Value < 0) ? 1 : 0);
+
+    return (Value >> Shift) + ((Remainder > Threshold) ? 1 : 0);
+}
+
+void
+MlasQgemmRequantizeOutput(
+    const int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize,
+    size_t StartM,
+    size_t CountM,
+    size_t StartN,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of the 32-bit output matrix to the 8-bit
+    output using the fixed point multiplier and shift of the requantize
+    parameters.
+
+Arguments:
+
+    C - Supplies the address of the block of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Requantize - Supplies the requantize parameters.
+
+    StartM - Supplies the first row of the block.
+
+    CountM - Supplies the number of rows of the block.
+
+    StartN - Supplies the first column of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int32_t Multiplier = Requantize->Multiplier;
+    const int32_t RightShift = std::min(std::max(Requantize->Shift, int32_t(0)), int32_t(31));
+    const int32_t LeftShift = std::max(-Requantize->Shift, int32_t(0));
+    const int32_t ZeroPoint = Requantize->ZeroPoint;
+    const size_t ldo = Requantize->ldo;
+
+    uint8_t* Output = Requantize->Output + StartM * ldo + StartN;
+
+    for (size_t m = 0; m < CountM; m++) {
+
+        const int32_t Bias = (Requantize->Bias != nullptr) ? Requantize->Bias[StartM + m] : 0;
+
+        for (size_t n = 0; n < CountN; n++) {
+
+            int32_t Value = int32_t(uint32_t(C[n] + Bias) << LeftShift);
+
+            Value = MlasQgemmRoundingDoublingHighMultiply(Value, Multiplier);
+            Value = MlasQgemmRoundingRightShift(Value, RightShift) + ZeroPoint;
+
+            Output[n] = uint8_t(std::min(std::max(Value, int32_t(0)), int32_t(255)));
+        }
+
+        C += ldc;
+        Output += ldo;
+    }
+}
+
+void
+MlasQgemmOperation(
+    const MLAS_QGEMM_WORK_BLOCK* WorkBlock,
+    size_t StartM,
+    size_t CountM,
+    size_t StartN,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for a block of the output matrix.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the QGEMM parameters.
+
+    StartM - Supplies the first row of the output block.
+
+    CountM - Supplies the number of rows of the output block.
+
+    StartN - Supplies the first column of the output block. The column must be
+        a multiple of MLAS_QGEMM_PANEL_N.
+
+    CountN - Supplies the number of columns of the output block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(int32_t PanelA[MLAS_QGEMM_PACKA_ROWS * MLAS_QGEMM_STRIDEK / 2], 64);
+    MLAS_DECLSPEC_ALIGN(int16_t PanelB[MLAS_QGEMM_STRIDEN * MLAS_QGEMM_STRIDEK], 64);
+
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldc = WorkBlock->ldc;
+
+    const uint8_t* A = WorkBlock->A + StartM * lda;
+    int32_t* C = WorkBlock->C + StartM * ldc + StartN;
+
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
+
+    size_t StrideN;
+    size_t StrideK;
+
+    for (size_t n = 0; n < CountN; n += StrideN) {
+
+        StrideN = std::min(CountN - n, size_t(MLAS_QGEMM_STRIDEN));
+
+        //
+        // An empty K dimension produces a zero output.
+        //
+
+        if (K == 0) {
+            for (size_t m = 0; m < CountM; m++) {
+                std::fill_n(C + m * ldc + n, StrideN, 0);
+            }
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension.
+        //
+
+        for (size_t k = 0; k < K; k += StrideK) {
+
+            StrideK = std::min(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+            const size_t PairCountK = (StrideK + 1) / 2;
+
+            //
+            // Reference the packed panels of matrix B or copy the panels to a
+            // local packed buffer.
+            //
+
+            const int16_t* b;
+
+            if (WorkBlock->PackedB != nullptr) {
+
+                b = WorkBlock->PackedB + k * WorkBlock->PackedCountN +
+                    ((StartN + n) / MLAS_QGEMM_PANEL_N) * PairCountK * MLAS_QGEMM_PANEL_N * 2;
+
+            } else {
+
+                if (WorkBlock->BIsSigned) {
+                    const int8_t* B = (const int8_t*)WorkBlock->B + k * WorkBlock->ldb + StartN + n;
+                    MlasQgemmCopyPackB(PanelB, B, WorkBlock->ldb, StrideN, StrideK, WorkBlock->offb);
+                } else {
+                    const uint8_t* B = (const uint8_t*)WorkBlock->B + k * WorkBlock->ldb + StartN + n;
+                    MlasQgemmCopyPackB(PanelB, B, WorkBlock->ldb, StrideN, StrideK, WorkBlock->offb);
+                }
+
+                b = PanelB;
+            }
+
+            //
+            // Step through each slice of matrix A along the M dimension.
+            //
+
+            const uint8_t* a = A + k;
+            int32_t* c = C + n;
+
+            size_t RowsRemaining = CountM;
+
+            while (RowsRemaining > 0) {
+
+                size_t RowsPacked = std::min(RowsRemaining, size_t(MLAS_QGEMM_PACKA_ROWS));
+
+                MlasQgemmPackA(PanelA, a, lda, RowsPacked, StrideK, WorkBlock->offa);
+
+                const int32_t* pa = PanelA;
+                size_t RowsToHandle = RowsPacked;
+
+                do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                    size_t RowsHandled = MlasPlatform.QgemmKernelRoutine(pa, b, c, PairCountK,
+                        RowsToHandle, StrideN, PairCountK, ldc, k == 0);
+#else
+                    size_t RowsHandled = MlasQgemmKernel(pa, b, c, PairCountK, RowsToHandle,
+                        StrideN, PairCountK, ldc, k == 0);
+#endif
+
+                    pa += PairCountK * RowsHandled;
+                    c += ldc * RowsHandled;
+
+                    RowsToHandle -= RowsHandled;
+
+                } while (RowsToHandle > 0);
+
+                a += lda * RowsPacked;
+                RowsRemaining -= RowsPacked;
+            }
+        }
+
+        //
+        // Requantize the completed slice of the output matrix while it is
+        // still resident in the cache.
+        //
+
+        if (WorkBlock->Requantize != nullptr) {
+            MlasQgemmRequantizeOutput(C + n, ldc, WorkBlock->Requantize, StartM, CountM,
+                StartN + n, StrideN);
+        }
+    }
+}
+
+void
+MlasQgemmOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    QGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK* WorkBlock = (MLAS_QGEMM_WORK_BLOCK*)Context;
+
+    MLAS_QGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
+
+    MlasQgemmOperation(WorkBlock, Segment->StartM, Segment->CountM, Segment->StartN,
+        Segment->CountN);
+}
+
+void
+MlasQgemmSchedule(
+    MLAS_QGEMM_WORK_BLOCK* WorkBlock,
+    size_t M,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine segments a QGEMM operation across multiple threads or
+    executes the operation on the current thread based on the complexity of
+    the operation and the system configuration.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the QGEMM parameters.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    int32_t TargetThreadCount = 1;
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    //
+    // Compute the number of target threads given the complexity of the QGEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    double Complexity = double(M) * double(N) * double(WorkBlock->K);
+
+    if (Complexity < double(MLAS_QGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_QGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+#endif
+
+    if (TargetThreadCount == 1) {
+        MlasQgemmOperation(WorkBlock, 0, M, 0, N);
+        return;
+    }
+
+    //
+    // Segment the operation across multiple threads. Segments along the N
+    // dimension are aligned to the panels of a packed matrix B.
+    //
+
+    int32_t Index = 0;
+
+    if (N > M) {
+
+        size_t StrideN = N / TargetThreadCount;
+
+        if ((StrideN * TargetThreadCount) != N) {
+            StrideN++;
+        }
+
+        StrideN = (StrideN + MLAS_QGEMM_PANEL_N - 1) & ~size_t(MLAS_QGEMM_PANEL_N - 1);
+
+        for (size_t CountN, n = 0; n < N; n += CountN) {
+
+            CountN = std::min(N - n, StrideN);
+
+            WorkBlock->Segments[Index].StartM = 0;
+            WorkBlock->Segments[Index].CountM = M;
+            WorkBlock->Segments[Index].StartN = n;
+            WorkBlock->Segments[Index].CountN = CountN;
+
+            Index++;
+        }
+
+    } else {
+
+        size_t StrideM = M / TargetThreadCount;
+
+        if ((StrideM * TargetThreadCount) != M) {
+            StrideM++;
+        }
+
+        for (size_t CountM, m = 0; m < M; m += CountM) {
+
+            CountM = std::min(M - m, StrideM);
+
+            WorkBlock->Segments[Index].StartM = m;
+            WorkBlock->Segments[Index].CountM = CountM;
+            WorkBlock->Segments[Index].StartN = 0;
+            WorkBlock->Segments[Index].CountN = N;
+
+            Index++;
+        }
+    }
+
+    MlasExecuteThreaded(MlasQgemmOperationThreaded, WorkBlock, Index);
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for an unsigned matrix B.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Requantize - Optionally supplies the parameters to convert matrix C to an
+        8-bit output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.offa = offa;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.offb = offb;
+    WorkBlock.BIsSigned = false;
+    WorkBlock.PackedB = nullptr;
+    WorkBlock.PackedCountN = 0;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.Requantize = Requantize;
+
+    MlasQgemmSchedule(&WorkBlock, M, N);
+}
+
+void
+MLASCALL
+MlasQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) for a signed matrix B.
+
+    See the unsigned version of MlasQgemm for the description of the
+    arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.offa = offa;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.offb = offb;
+    WorkBlock.BIsSigned = true;
+    WorkBlock.PackedB = nullptr;
+    WorkBlock.PackedCountN = 0;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.Requantize = Requantize;
+
+    MlasQgemmSchedule(&WorkBlock, M, N);
+}
+
+inline
+size_t
+MlasQgemmPackedCountN(
+    size_t N
+    )
+{
+    return (N + MLAS_QGEMM_PANEL_N - 1) & ~size_t(MLAS_QGEMM_PANEL_N - 1);
+}
+
+size_t
+MLASCALL
+MlasQgemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix B using
+    MlasQgemmPackB.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size of the packed buffer in bytes.
+
+--*/
+{
+    const size_t AlignedK = (K + 1) & ~size_t(1);
+
+    return MlasQgemmPackedCountN(N) * AlignedK * sizeof(int16_t);
+}
+
+template<typename T>
+void
+MlasQgemmPackBImpl(
+    size_t N,
+    size_t K,
+    const T* B,
+    size_t ldb,
+    T offb,
+    void* PackedB
+    )
+{
+    const size_t PackedCountN = MlasQgemmPackedCountN(N);
+
+    //
+    // The packed buffer is organized as slices of MLAS_QGEMM_STRIDEK rows of
+    // matrix B so that the QGEMM operation can reference each slice directly.
+    //
+
+    for (size_t CountK, k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_QGEMM_STRIDEK));
+
+        MlasQgemmCopyPackB((int16_t*)PackedB + k * PackedCountN, B + k * ldb, ldb, N, CountK, int16_t(offb));
+    }
+}
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    uint8_t offb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs an unsigned matrix B for use by MlasQgemmPackedB.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    offb - Supplies the zero point of matrix B.
+
+    PackedB - Supplies the address of the packed buffer. The buffer must be
+        at least MlasQgemmPackBSize bytes.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQgemmPackBImpl(N, K, B, ldb, offb, PackedB);
+}
+
+void
+MLASCALL
+MlasQgemmPackB(
+    size_t N,
+    size_t K,
+    const int8_t* B,
+    size_t ldb,
+    int8_t offb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs a signed matrix B for use by MlasQgemmPackedB.
+
+    See the unsigned version of MlasQgemmPackB for the description of the
+    arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQgemmPackBImpl(N, K, B, ldb, offb, PackedB);
+}
+
+void
+MLASCALL
+MlasQgemmPackedB(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const void* PackedB,
+    int32_t* C,
+    size_t ldc,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* Requantize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM) using a matrix B that was packed by MlasQgemmPackB.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    offa - Supplies the zero point of matrix A.
+
+    PackedB - Supplies the address of the packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Requantize - Optionally supplies the parameters to convert matrix C to an
+        8-bit output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_QGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.offa = offa;
+    WorkBlock.B = nullptr;
+    WorkBlock.ldb = 0;
+    WorkBlock.offb = 0;
+    WorkBlock.BIsSigned = false;
+    WorkBlock.PackedB = (const int16_t*)PackedB;
+    WorkBlock.PackedCountN = MlasQgemmPackedCountN(N);
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.Requantize = Requantize;
+
+    MlasQgemmSchedule(&WorkBlock, M, N);
+}
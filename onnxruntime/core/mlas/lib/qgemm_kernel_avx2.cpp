@@ -0,0 +1,175 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX2 instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelAvx2Rows(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    while (CountN > 0) {
+
+        __m256i Accumulators[RowCount][2];
+
+        for (size_t row = 0; row < RowCount; row++) {
+            Accumulators[row][0] = _mm256_setzero_si256();
+            Accumulators[row][1] = _mm256_setzero_si256();
+        }
+
+        const int32_t* a = A;
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            __m256i BElements0 = _mm256_loadu_si256((const __m256i*)B);
+            __m256i BElements1 = _mm256_loadu_si256((const __m256i*)(B + 16));
+
+            for (size_t row = 0; row < RowCount; row++) {
+
+                __m256i AElements = _mm256_set1_epi32(a[row * lda]);
+
+                Accumulators[row][0] = _mm256_add_epi32(Accumulators[row][0], _mm256_madd_epi16(AElements, BElements0));
+                Accumulators[row][1] = _mm256_add_epi32(Accumulators[row][1], _mm256_madd_epi16(AElements, BElements1));
+            }
+
+            a += 1;
+            B += MLAS_QGEMM_PANEL_N * 2;
+        }
+
+        const size_t CountNPanel = std::min(CountN, size_t(MLAS_QGEMM_PANEL_N));
+
+        for (size_t row = 0; row < RowCount; row++) {
+
+            int32_t* c = C + row * ldc;
+
+            if (CountNPanel == MLAS_QGEMM_PANEL_N) {
+
+                __m256i Result0 = Accumulators[row][0];
+                __m256i Result1 = Accumulators[row][1];
+
+                if (!ZeroMode) {
+                    Result0 = _mm256_add_epi32(Result0, _mm256_loadu_si256((const __m256i*)c));
+                    Result1 = _mm256_add_epi32(Result1, _mm256_loadu_si256((const __m256i*)(c + 8)));
+                }
+
+                _mm256_storeu_si256((__m256i*)c, Result0);
+                _mm256_storeu_si256((__m256i*)(c + 8), Result1);
+
+            } else {
+
+                MLAS_DECLSPEC_ALIGN(int32_t Buffer[MLAS_QGEMM_PANEL_N], 32);
+
+                _mm256_store_si256((__m256i*)Buffer, Accumulators[row][0]);
+                _mm256_store_si256((__m256i*)(Buffer + 8), Accumulators[row][1]);
+
+                for (size_t n = 0; n < CountNPanel; n++) {
+                    c[n] = ZeroMode ? Buffer[n] : c[n] + Buffer[n];
+                }
+            }
+        }
+
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmKernelAvx2(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using AVX2 instructions.
+
+    Each pair of 16-bit elements from matrix A is broadcast and multiplied
+    with the interleaved pairs from a panel of matrix B using vpmaddwd. The
+    elements were widened from 8 bits when packed, so unlike vpmaddubsw, the
+    intermediate sums cannot saturate.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasQgemmPackA.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasQgemmCopyPackB.
+
+    C - Supplies the address of matrix C.
+
+    PairCountK - Supplies the number of packed pairs from matrix A and the
+        number of packed pairs of rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    lda - Supplies the number of packed pairs per row of matrix A.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    switch (CountM) {
+
+        case 1:
+            MlasQgemmKernelAvx2Rows<1>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 1;
+
+        case 2:
+            MlasQgemmKernelAvx2Rows<2>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 2;
+
+        case 3:
+            MlasQgemmKernelAvx2Rows<3>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 3;
+
+        default:
+            MlasQgemmKernelAvx2Rows<4>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 4;
+    }
+}
@@ -0,0 +1,131 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_avx512bw.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using AVX512BW instructions.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t RowCount>
+inline
+void
+MlasQgemmKernelAvx512BWRows(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+{
+    while (CountN > 0) {
+
+        __m512i Accumulators[RowCount];
+
+        for (size_t row = 0; row < RowCount; row++) {
+            Accumulators[row] = _mm512_setzero_si512();
+        }
+
+        const int32_t* a = A;
+
+        for (size_t k = 0; k < PairCountK; k++) {
+
+            __m512i BElements = _mm512_loadu_si512(B);
+
+            for (size_t row = 0; row < RowCount; row++) {
+
+                __m512i AElements = _mm512_set1_epi32(a[row * lda]);
+
+                Accumulators[row] = _mm512_add_epi32(Accumulators[row], _mm512_madd_epi16(AElements, BElements));
+            }
+
+            a += 1;
+            B += MLAS_QGEMM_PANEL_N * 2;
+        }
+
+        const size_t CountNPanel = std::min(CountN, size_t(MLAS_QGEMM_PANEL_N));
+        const __mmask16 StoreMask = __mmask16((1u << CountNPanel) - 1);
+
+        for (size_t row = 0; row < RowCount; row++) {
+
+            int32_t* c = C + row * ldc;
+
+            __m512i Result = Accumulators[row];
+
+            if (!ZeroMode) {
+                Result = _mm512_add_epi32(Result, _mm512_maskz_loadu_epi32(StoreMask, c));
+            }
+
+            _mm512_mask_storeu_epi32(c, StoreMask, Result);
+        }
+
+        C += CountNPanel;
+        CountN -= CountNPanel;
+    }
+}
+
+size_t
+MLASCALL
+MlasQgemmKernelAvx512BW(
+    const int32_t* A,
+    const int16_t* B,
+    int32_t* C,
+    size_t PairCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldc,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using AVX512BW instructions.
+
+    See MlasQgemmKernelAvx2 for the description of the arguments.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    switch (CountM) {
+
+        case 1:
+            MlasQgemmKernelAvx512BWRows<1>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 1;
+
+        case 2:
+            MlasQgemmKernelAvx512BWRows<2>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 2;
+
+        case 3:
+            MlasQgemmKernelAvx512BWRows<3>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 3;
+
+        case 4:
+        case 5:
+            MlasQgemmKernelAvx512BWRows<4>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 4;
+
+        default:
+            MlasQgemmKernelAvx512BWRows<6>(A, B, C, PairCountK, CountN, lda, ldc, ZeroMode);
+            return 6;
+    }
+}
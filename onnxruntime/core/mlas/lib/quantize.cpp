@@ -0,0 +1,650 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    quantize.cpp
+
+Abstract:
+
+    This module implements routines to quantize single precision floating
+    point values to 8-bit integers and to dequantize 8-bit integers back to
+    single precision floating point values.
+
+--*/
+
+#include "mlasi.h"
+#include <cmath>
+
+//
+// Define the parameters to execute segments of a quantize or dequantize
+// operation on worker threads.
+//
+// The tensor is viewed as [BatchCount, ChannelCount, BlockSize] where each
+// channel supplies its own scale and zero point. Each thread processes a
+// contiguous range of elements that may span several blocks.
+//
+
+struct MLAS_QUANTIZE_WORK_BLOCK {
+    const void* Input;
+    void* Output;
+    size_t ChannelCount;
+    size_t BlockSize;
+    const float* Scale;
+    const void* ZeroPoint;
+    size_t StrideElements;
+    size_t TotalElements;
+};
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+template<typename OutputType>
+__m128i
+MlasQuantizePackVector(
+    __m128i Integer0,
+    __m128i Integer1,
+    __m128i Integer2,
+    __m128i Integer3
+    );
+
+template<>
+inline
+__m128i
+MlasQuantizePackVector<uint8_t>(
+    __m128i Integer0,
+    __m128i Integer1,
+    __m128i Integer2,
+    __m128i Integer3
+    )
+{
+    __m128i Words0 = _mm_packs_epi32(Integer0, Integer1);
+    __m128i Words1 = _mm_packs_epi32(Integer2, Integer3);
+
+    return _mm_packus_epi16(Words0, Words1);
+}
+
+template<>
+inline
+__m128i
+MlasQuantizePackVector<int8_t>(
+    __m128i Integer0,
+    __m128i Integer1,
+    __m128i Integer2,
+    __m128i Integer3
+    )
+{
+    __m128i Words0 = _mm_packs_epi32(Integer0, Integer1);
+    __m128i Words1 = _mm_packs_epi32(Integer2, Integer3);
+
+    return _mm_packs_epi16(Words0, Words1);
+}
+
+template<typename InputType>
+void
+MlasDequantizeUnpackVector(
+    __m128i Bytes,
+    __m128i* Words0,
+    __m128i* Words1
+    );
+
+template<>
+inline
+void
+MlasDequantizeUnpackVector<uint8_t>(
+    __m128i Bytes,
+    __m128i* Words0,
+    __m128i* Words1
+    )
+{
+    __m128i ZeroVector = _mm_setzero_si128();
+
+    *Words0 = _mm_unpacklo_epi8(Bytes, ZeroVector);
+    *Words1 = _mm_unpackhi_epi8(Bytes, ZeroVector);
+}
+
+template<>
+inline
+void
+MlasDequantizeUnpackVector<int8_t>(
+    __m128i Bytes,
+    __m128i* Words0,
+    __m128i* Words1
+    )
+{
+    *Words0 = _mm_srai_epi16(_mm_unpacklo_epi8(Bytes, Bytes), 8);
+    *Words1 = _mm_srai_epi16(_mm_unpackhi_epi8(Bytes, Bytes), 8);
+}
+
+#endif
+
+template<typename OutputType>
+void
+MlasQuantizeLinearKernel(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    float Scale,
+    OutputType ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes a buffer of single precision floating point values
+    using a single scale and zero point.
+
+    The values are divided by the scale, rounded to the nearest integer with
+    ties rounded to even, offset by the zero point, and saturated to the range
+    of the output type. Clamping is done before the conversion to integer using
+    bounds that have the zero point removed, which gives the same result as
+    saturating afterwards since the bounds are integral.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the quantization scale.
+
+    ZeroPoint - Supplies the quantization zero point.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float MinimumValue = float(std::numeric_limits<OutputType>::lowest()) - float(ZeroPoint);
+    const float MaximumValue = float(std::numeric_limits<OutputType>::max()) - float(ZeroPoint);
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128 ScaleVector = _mm_set1_ps(Scale);
+    const __m128 MinimumVector = _mm_set1_ps(MinimumValue);
+    const __m128 MaximumVector = _mm_set1_ps(MaximumValue);
+    const __m128i ZeroPointVector = _mm_set1_epi32(int32_t(ZeroPoint));
+
+    while (N >= 16) {
+
+        __m128i Integers[4];
+
+        for (size_t i = 0; i < 4; i++) {
+
+            __m128 FloatVector = _mm_div_ps(_mm_loadu_ps(Input + i * 4), ScaleVector);
+
+            FloatVector = _mm_max_ps(FloatVector, MinimumVector);
+            FloatVector = _mm_min_ps(FloatVector, MaximumVector);
+
+            Integers[i] = _mm_add_epi32(_mm_cvtps_epi32(FloatVector), ZeroPointVector);
+        }
+
+        __m128i Bytes = MlasQuantizePackVector<OutputType>(Integers[0], Integers[1],
+            Integers[2], Integers[3]);
+
+        _mm_storeu_si128((__m128i*)Output, Bytes);
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+#endif
+
+    //
+    // Process the remaining elements. The comparisons are ordered so that a
+    // NaN input is clamped to the minimum value, matching the vector path.
+    //
+
+    while (N > 0) {
+
+        float FloatValue = *Input++ / Scale;
+
+        FloatValue = std::max(MinimumValue, FloatValue);
+        FloatValue = std::min(MaximumValue, FloatValue);
+
+        *Output++ = OutputType(int32_t(std::nearbyint(FloatValue)) + int32_t(ZeroPoint));
+
+        N -= 1;
+    }
+}
+
+template<typename InputType>
+void
+MlasDequantizeLinearKernel(
+    const InputType* Input,
+    float* Output,
+    size_t N,
+    float Scale,
+    InputType ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a buffer of 8-bit integer values using a single
+    scale and zero point.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Scale - Supplies the quantization scale.
+
+    ZeroPoint - Supplies the quantization zero point.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128 ScaleVector = _mm_set1_ps(Scale);
+    const __m128i ZeroPointVector = _mm_set1_epi32(int32_t(ZeroPoint));
+
+    while (N >= 16) {
+
+        __m128i Words[2];
+
+        MlasDequantizeUnpackVector<InputType>(_mm_loadu_si128((const __m128i*)Input),
+            &Words[0], &Words[1]);
+
+        for (size_t i = 0; i < 4; i++) {
+
+            __m128i WordVector = Words[i / 2];
+            __m128i Integer = (i & 1) ? _mm_unpackhi_epi16(WordVector, WordVector) :
+                _mm_unpacklo_epi16(WordVector, WordVector);
+
+            Integer = _mm_sub_epi32(_mm_srai_epi32(Integer, 16), ZeroPointVector);
+
+            _mm_storeu_ps(Output + i * 4, _mm_mul_ps(_mm_cvtepi32_ps(Integer), ScaleVector));
+        }
+
+        Input += 16;
+        Output += 16;
+        N -= 16;
+    }
+
+#endif
+
+    while (N > 0) {
+
+        *Output++ = float(int32_t(*Input++) - int32_t(ZeroPoint)) * Scale;
+
+        N -= 1;
+    }
+}
+
+template<typename InputType, typename OutputType, typename ZeroPointType, bool IsQuantize>
+void
+MlasQuantizeOperation(
+    const MLAS_QUANTIZE_WORK_BLOCK* WorkBlock,
+    size_t StartElement,
+    size_t CountElements
+    )
+/*++
+
+Routine Description:
+
+    This routine processes a range of elements of a quantize or dequantize
+    operation, splitting the range at each change of channel.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the operation parameters.
+
+    StartElement - Supplies the index of the first element to process.
+
+    CountElements - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const InputType* Input = (const InputType*)WorkBlock->Input + StartElement;
+    OutputType* Output = (OutputType*)WorkBlock->Output + StartElement;
+    const ZeroPointType* ZeroPoint = (const ZeroPointType*)WorkBlock->ZeroPoint;
+
+    const size_t BlockSize = WorkBlock->BlockSize;
+
+    size_t Block = StartElement / BlockSize;
+    size_t BlockOffset = StartElement - Block * BlockSize;
+
+    while (CountElements > 0) {
+
+        const size_t Channel = Block % WorkBlock->ChannelCount;
+        const size_t CountN = std::min(BlockSize - BlockOffset, CountElements);
+
+        const float Scale = WorkBlock->Scale[Channel];
+        const ZeroPointType ZeroPointValue = (ZeroPoint != nullptr) ? ZeroPoint[Channel] : ZeroPointType(0);
+
+        if (IsQuantize) {
+            MlasQuantizeLinearKernel<ZeroPointType>((const float*)Input, (ZeroPointType*)Output,
+                CountN, Scale, ZeroPointValue);
+        } else {
+            MlasDequantizeLinearKernel<ZeroPointType>((const ZeroPointType*)Input, (float*)Output,
+                CountN, Scale, ZeroPointValue);
+        }
+
+        Input += CountN;
+        Output += CountN;
+        CountElements -= CountN;
+
+        Block++;
+        BlockOffset = 0;
+    }
+}
+
+template<typename InputType, typename OutputType, typename ZeroPointType, bool IsQuantize>
+void
+MlasQuantizeOperationThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    quantize or dequantize operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_QUANTIZE_WORK_BLOCK* WorkBlock = (const MLAS_QUANTIZE_WORK_BLOCK*)Context;
+
+    const size_t StartElement = size_t(Index) * WorkBlock->StrideElements;
+    const size_t CountElements = std::min(WorkBlock->TotalElements - StartElement,
+        WorkBlock->StrideElements);
+
+    MlasQuantizeOperation<InputType, OutputType, ZeroPointType, IsQuantize>(WorkBlock,
+        StartElement, CountElements);
+}
+
+template<typename InputType, typename OutputType, typename ZeroPointType, bool IsQuantize>
+void
+MlasQuantizeSchedule(
+    const InputType* Input,
+    OutputType* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const ZeroPointType* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine segments a quantize or dequantize operation across multiple
+    threads or executes the operation on the current thread based on the size
+    of the operation and the system configuration.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    BatchCount - Supplies the number of batches of channels.
+
+    ChannelCount - Supplies the number of channels per batch.
+
+    BlockSize - Supplies the number of elements per channel.
+
+    Scale - Supplies the scale for each channel.
+
+    ZeroPoint - Supplies the optional zero point for each channel.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TotalElements = BatchCount * ChannelCount * BlockSize;
+
+    if (TotalElements == 0) {
+        return;
+    }
+
+    MLAS_QUANTIZE_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.ChannelCount = ChannelCount;
+    WorkBlock.BlockSize = BlockSize;
+    WorkBlock.Scale = Scale;
+    WorkBlock.ZeroPoint = ZeroPoint;
+    WorkBlock.TotalElements = TotalElements;
+
+    int32_t TargetThreadCount = 1;
+
+#if defined(MLAS_HAS_THREADING_SUPPORT)
+
+    //
+    // Compute the number of target threads given the number of elements to
+    // process. Small requests should run using the single threaded path.
+    //
+
+    if (TotalElements < MLAS_QUANTIZE_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT) {
+        TargetThreadCount = int32_t(TotalElements / MLAS_QUANTIZE_THREAD_COMPLEXITY) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+#endif
+
+    if (TargetThreadCount == 1) {
+        MlasQuantizeOperation<InputType, OutputType, ZeroPointType, IsQuantize>(&WorkBlock,
+            0, TotalElements);
+        return;
+    }
+
+    //
+    // Segment the operation across multiple threads. Each segment is aligned
+    // to a multiple of the vector width so that only the final segment needs
+    // to process a partial vector.
+    //
+
+    size_t StrideElements = TotalElements / TargetThreadCount;
+
+    if ((StrideElements * TargetThreadCount) != TotalElements) {
+        StrideElements++;
+    }
+
+    StrideElements = (StrideElements + 15) & ~size_t(15);
+
+    WorkBlock.StrideElements = StrideElements;
+
+    int32_t Index = int32_t((TotalElements + StrideElements - 1) / StrideElements);
+
+    MlasExecuteThreaded(MlasQuantizeOperationThreaded<InputType, OutputType, ZeroPointType, IsQuantize>,
+        &WorkBlock, Index);
+}
+
+void
+MLASCALL
+MlasQuantizeLinear(
+    const float* Input,
+    uint8_t* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const uint8_t* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes a tensor of single precision floating point values
+    to unsigned 8-bit integers.
+
+    The tensor is viewed as [BatchCount, ChannelCount, BlockSize] where each
+    channel has its own scale and zero point. Per-tensor quantization uses a
+    BatchCount and ChannelCount of one.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+    BatchCount - Supplies the number of batches of channels.
+
+    ChannelCount - Supplies the number of channels per batch.
+
+    BlockSize - Supplies the number of elements per channel.
+
+    Scale - Supplies the scale for each channel.
+
+    ZeroPoint - Supplies the zero point for each channel. If nullptr, a zero
+        point of zero is used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQuantizeSchedule<float, uint8_t, uint8_t, true>(Input, Output, BatchCount,
+        ChannelCount, BlockSize, Scale, ZeroPoint);
+}
+
+void
+MLASCALL
+MlasQuantizeLinear(
+    const float* Input,
+    int8_t* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const int8_t* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes a tensor of single precision floating point values
+    to signed 8-bit integers.
+
+    See the unsigned variant for the description of the arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQuantizeSchedule<float, int8_t, int8_t, true>(Input, Output, BatchCount,
+        ChannelCount, BlockSize, Scale, ZeroPoint);
+}
+
+void
+MLASCALL
+MlasDequantizeLinear(
+    const uint8_t* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const uint8_t* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a tensor of unsigned 8-bit integers to single
+    precision floating point values.
+
+    The tensor is viewed as [BatchCount, ChannelCount, BlockSize] where each
+    channel has its own scale and zero point. Per-tensor dequantization uses a
+    BatchCount and ChannelCount of one.
+
+Arguments:
+
+    Input - Supplies the input tensor.
+
+    Output - Supplies the output tensor.
+
+    BatchCount - Supplies the number of batches of channels.
+
+    ChannelCount - Supplies the number of channels per batch.
+
+    BlockSize - Supplies the number of elements per channel.
+
+    Scale - Supplies the scale for each channel.
+
+    ZeroPoint - Supplies the zero point for each channel. If nullptr, a zero
+        point of zero is used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQuantizeSchedule<uint8_t, float, uint8_t, false>(Input, Output, BatchCount,
+        ChannelCount, BlockSize, Scale, ZeroPoint);
+}
+
+void
+MLASCALL
+MlasDequantizeLinear(
+    const int8_t* Input,
+    float* Output,
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    const float* Scale,
+    const int8_t* ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a tensor of signed 8-bit integers to single
+    precision floating point values.
+
+    See the unsigned variant for the description of the arguments.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasQuantizeSchedule<int8_t, float, int8_t, false>(Input, Output, BatchCount,
+        ChannelCount, BlockSize, Scale, ZeroPoint);
+}
@@ -40,12 +40,16 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    bool HasEpilogue;
     struct SEGMENT {
         size_t M;
         size_t N;
         const float* A;
         const float* B;
         float* C;
+        MLAS_COMPRESSED_MATRIX CompressedA;
+        MLAS_COMPRESSED_MATRIX CompressedB;
+        MLAS_SGEMM_EPILOGUE Epilogue;
     } Segments[MLAS_MAXIMUM_THREAD_COUNT];
 };
 
@@ -772,6 +776,610 @@ Return Value:
     }
 }
 
+inline
+float
+MlasSgemmExpandElement(
+    uint16_t Value
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a half precision element to single precision.
+
+Arguments:
+
+    Value - Supplies the half precision element.
+
+Return Value:
+
+    Returns the single precision value.
+
+--*/
+{
+    union {
+        uint32_t u;
+        float f;
+    } Result, Denormal;
+
+    //
+    // Move the exponent and mantissa bits into place and rebias the exponent.
+    // Infinities and NaNs keep the maximum exponent. Denormals are normalized
+    // by the floating point subtraction of the implicit leading one.
+    //
+
+    const uint32_t ShiftedExponent = 0x7C00 << 13;
+
+    Result.u = uint32_t(Value & 0x7FFF) << 13;
+    uint32_t Exponent = Result.u & ShiftedExponent;
+    Result.u += (127 - 15) << 23;
+
+    if (Exponent == ShiftedExponent) {
+        Result.u += (128 - 16) << 23;
+    } else if (Exponent == 0) {
+        Denormal.u = 113 << 23;
+        Result.u += 1 << 23;
+        Result.f -= Denormal.f;
+    }
+
+    Result.u |= uint32_t(Value & 0x8000) << 16;
+
+    return Result.f;
+}
+
+inline
+float
+MlasSgemmExpandElement(
+    int8_t Value
+    )
+{
+    return float(Value);
+}
+
+template<typename ElementType>
+void
+MlasSgemmExpandPackB(
+    float* D,
+    const ElementType* B,
+    size_t StrideX,
+    size_t StrideY,
+    const float* Scale,
+    size_t CountX,
+    size_t CountY
+    )
+/*++
+
+Routine Description:
+
+    This routine expands elements from the compressed source matrix to the
+    destination packed buffer.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous for better locality inside the SGEMM kernels. Any remaining
+    columns less than 16 elements wide are zero-padded. This is the layout
+    produced by MlasSgemmCopyPackB and MlasSgemmTransposePackB.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    StrideX - Supplies the number of elements between the columns of the
+        source matrix.
+
+    StrideY - Supplies the number of elements between the rows of the source
+        matrix.
+
+    Scale - Optionally supplies the scale of each column of the source matrix.
+
+    CountX - Supplies the number of columns of the source matrix to expand.
+
+    CountY - Supplies the number of rows of the source matrix to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float ScaleBlock[16];
+
+    while (CountX > 0) {
+
+        size_t CountBlock = (CountX < 16) ? CountX : 16;
+
+        for (size_t x = 0; x < 16; x++) {
+            ScaleBlock[x] = (x >= CountBlock) ? 0.0f : (Scale != nullptr) ? Scale[x] : 1.0f;
+        }
+
+        const ElementType* b = B;
+        size_t y = CountY;
+
+        do {
+
+            for (size_t x = 0; x < CountBlock; x++) {
+                D[x] = MlasSgemmExpandElement(b[x * StrideX]) * ScaleBlock[x];
+            }
+
+            for (size_t x = CountBlock; x < 16; x++) {
+                D[x] = 0.0f;
+            }
+
+            D += 16;
+            b += StrideY;
+            y--;
+
+        } while (y > 0);
+
+        B += CountBlock * StrideX;
+        CountX -= CountBlock;
+
+        if (Scale != nullptr) {
+            Scale += CountBlock;
+        }
+    }
+}
+
+template<typename ElementType>
+void
+MlasSgemmExpandA(
+    float* D,
+    const ElementType* A,
+    size_t lda,
+    const float* Scale,
+    size_t CountY,
+    size_t CountX
+    )
+/*++
+
+Routine Description:
+
+    This routine expands rows of elements from the compressed source matrix to
+    the destination buffer.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    Scale - Optionally supplies the scale of each row of the source matrix.
+
+    CountY - Supplies the number of rows of the source matrix to expand.
+
+    CountX - Supplies the number of columns of the source matrix to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    do {
+
+        const float RowScale = (Scale != nullptr) ? *Scale++ : 1.0f;
+
+        for (size_t x = 0; x < CountX; x++) {
+            D[x] = MlasSgemmExpandElement(A[x]) * RowScale;
+        }
+
+        D += CountX;
+        A += lda;
+        CountY--;
+
+    } while (CountY > 0);
+}
+
+inline
+size_t
+MlasCompressedElementSize(
+    const MLAS_COMPRESSED_MATRIX* Matrix
+    )
+{
+    return (Matrix->Format == MlasCompressedFloat16) ? sizeof(uint16_t) : sizeof(int8_t);
+}
+
+void
+MlasSgemmExpandPackB(
+    float* D,
+    const MLAS_COMPRESSED_MATRIX* B,
+    CBLAS_TRANSPOSE TransB,
+    size_t n,
+    size_t k,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a panel of the compressed matrix B to the destination
+    packed buffer.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the compressed matrix B.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    n - Supplies the first column of matrix B to expand.
+
+    k - Supplies the first row of matrix B to expand.
+
+    CountN - Supplies the number of columns of matrix B to expand.
+
+    CountK - Supplies the number of rows of matrix B to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t StrideN = (TransB == CblasNoTrans) ? 1 : B->ld;
+    const size_t StrideK = (TransB == CblasNoTrans) ? B->ld : 1;
+    const size_t Offset = n * StrideN + k * StrideK;
+    const float* Scale = (B->Scale != nullptr) ? B->Scale + n : nullptr;
+
+    if (B->Format == MlasCompressedFloat16) {
+        MlasSgemmExpandPackB(D, (const uint16_t*)B->Data + Offset, StrideN, StrideK, Scale, CountN, CountK);
+    } else {
+        MlasSgemmExpandPackB(D, (const int8_t*)B->Data + Offset, StrideN, StrideK, Scale, CountN, CountK);
+    }
+}
+
+void
+MlasSgemmExpandA(
+    float* D,
+    const MLAS_COMPRESSED_MATRIX* A,
+    size_t m,
+    size_t k,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine expands a block of rows of the compressed matrix A to the
+    destination buffer.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the compressed matrix A.
+
+    m - Supplies the first row of matrix A to expand.
+
+    k - Supplies the first column of matrix A to expand.
+
+    CountM - Supplies the number of rows of matrix A to expand.
+
+    CountK - Supplies the number of columns of matrix A to expand.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t Offset = m * A->ld + k;
+    const float* Scale = (A->Scale != nullptr) ? A->Scale + m : nullptr;
+
+    if (A->Format == MlasCompressedFloat16) {
+        MlasSgemmExpandA(D, (const uint16_t*)A->Data + Offset, A->ld, Scale, CountM, CountK);
+    } else {
+        MlasSgemmExpandA(D, (const int8_t*)A->Data + Offset, A->ld, Scale, CountM, CountK);
+    }
+}
+
+MLAS_COMPRESSED_MATRIX
+MlasOffsetCompressedMatrix(
+    const MLAS_COMPRESSED_MATRIX* Matrix,
+    size_t Channel,
+    size_t ChannelStride
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a view of the compressed matrix that starts at the
+    supplied channel.
+
+Arguments:
+
+    Matrix - Supplies the compressed matrix.
+
+    Channel - Supplies the first channel of the view.
+
+    ChannelStride - Supplies the number of elements between the channels of
+        the compressed matrix.
+
+Return Value:
+
+    Returns the view of the compressed matrix.
+
+--*/
+{
+    MLAS_COMPRESSED_MATRIX View = *Matrix;
+
+    View.Data = (const uint8_t*)Matrix->Data + Channel * ChannelStride * MlasCompressedElementSize(Matrix);
+
+    if (View.Scale != nullptr) {
+        View.Scale += Channel;
+    }
+
+    return View;
+}
+
+void
+MlasSgemmAddBias(
+    float* C,
+    const float* Bias,
+    size_t ldbias,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine adds a bias matrix to a tile of the output matrix.
+
+Arguments:
+
+    C - Supplies the address of the tile of matrix C.
+
+    Bias - Supplies the address of the bias for the first row of the tile.
+
+    ldbias - Supplies the first dimension of the bias matrix. A value of zero
+        adds the same bias to each row of the tile.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        float* c = C;
+        const float* bias = Bias;
+        size_t n = CountN;
+
+        while (n >= 4) {
+
+            MlasStoreFloat32x4(c, MlasAddFloat32x4(MlasLoadFloat32x4(c), MlasLoadFloat32x4(bias)));
+
+            c += 4;
+            bias += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+
+            *c++ += *bias++;
+            n -= 1;
+        }
+
+        C += ldc;
+        Bias += ldbias;
+    }
+}
+
+void
+MlasSgemmAddScalarBias(
+    float* C,
+    float Bias,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine adds a scalar bias to a tile of the output matrix.
+
+Arguments:
+
+    C - Supplies the address of the tile of matrix C.
+
+    Bias - Supplies the bias value.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 BiasBroadcast = MlasBroadcastFloat32x4(Bias);
+
+    while (CountM-- > 0) {
+
+        float* c = C;
+        size_t n = CountN;
+
+        while (n >= 4) {
+
+            MlasStoreFloat32x4(c, MlasAddFloat32x4(MlasLoadFloat32x4(c), BiasBroadcast));
+
+            c += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+
+            *c++ += Bias;
+            n -= 1;
+        }
+
+        C += ldc;
+    }
+}
+
+void
+MlasSgemmApplyEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    float* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the bias and activation of the epilogue to a tile of
+    the output matrix that has been completely accumulated.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue parameters.
+
+    C - Supplies the address of the tile of matrix C.
+
+    StartM - Supplies the row of matrix C of the first row of the tile.
+
+    StartN - Supplies the column of matrix C of the first column of the tile.
+
+    CountM - Supplies the number of rows of the tile.
+
+    CountN - Supplies the number of columns of the tile.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float* RowBias = nullptr;
+
+    switch (Epilogue->BiasKind) {
+
+        case MlasSgemmNoBias:
+        {
+            break;
+        }
+
+        case MlasSgemmScalarBias:
+        {
+            MlasSgemmAddScalarBias(C, Epilogue->Bias[0], CountM, CountN, ldc);
+            break;
+        }
+
+        case MlasSgemmRowBias:
+        {
+            RowBias = Epilogue->Bias + StartM;
+            break;
+        }
+
+        case MlasSgemmColumnBias:
+        {
+            MlasSgemmAddBias(C, Epilogue->Bias + StartN, 0, CountM, CountN, ldc);
+            break;
+        }
+
+        case MlasSgemmMatrixBias:
+        {
+            MlasSgemmAddBias(C, Epilogue->Bias + StartM * Epilogue->ldbias + StartN,
+                Epilogue->ldbias, CountM, CountN, ldc);
+            break;
+        }
+    }
+
+    if (Epilogue->Activation != nullptr || RowBias != nullptr) {
+
+        MLAS_ACTIVATION IdentityActivation = { MlasIdentityActivation, 0.0f };
+
+        const MLAS_ACTIVATION* Activation =
+            (Epilogue->Activation != nullptr) ? Epilogue->Activation : &IdentityActivation;
+
+        MlasActivation(Activation, C, RowBias, CountM, C, CountN, ldc);
+    }
+}
+
+MLAS_SGEMM_EPILOGUE
+MlasOffsetEpilogue(
+    const MLAS_SGEMM_EPILOGUE* Epilogue,
+    size_t StartM,
+    size_t StartN
+    )
+/*++
+
+Routine Description:
+
+    This routine returns a view of the epilogue for the submatrix of matrix C
+    that starts at the supplied row and column.
+
+Arguments:
+
+    Epilogue - Supplies the epilogue parameters.
+
+    StartM - Supplies the first row of the submatrix.
+
+    StartN - Supplies the first column of the submatrix.
+
+Return Value:
+
+    Returns the view of the epilogue.
+
+--*/
+{
+    MLAS_SGEMM_EPILOGUE View = *Epilogue;
+
+    switch (Epilogue->BiasKind) {
+
+        case MlasSgemmRowBias:
+        {
+            View.Bias += StartM;
+            break;
+        }
+
+        case MlasSgemmColumnBias:
+        {
+            View.Bias += StartN;
+            break;
+        }
+
+        case MlasSgemmMatrixBias:
+        {
+            View.Bias += StartM * Epilogue->ldbias + StartN;
+            break;
+        }
+
+        default:
+        {
+            break;
+        }
+    }
+
+    return View;
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -782,18 +1390,22 @@ MlasSgemmOperation(
     float alpha,
     const float* A,
     size_t lda,
+    const MLAS_COMPRESSED_MATRIX* CompressedA,
     const float* B,
     size_t ldb,
+    const MLAS_COMPRESSED_MATRIX* CompressedB,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
 Routine Description:
 
     This routine implements the single precision matrix/matrix multiply
-    operation (SGEMM).
+    operation (SGEMM) where either matrix may be stored in a compressed format
+    and the output may be processed by an epilogue.
 
 Arguments:
 
@@ -814,16 +1426,25 @@ Arguments:
 
     lda - Supplies the first dimension of matrix A.
 
+    CompressedA - Optionally supplies the compressed matrix A, which is used
+        instead of A and lda. TransA must be CblasNoTrans.
+
     B - Supplies the address of matrix B.
 
     ldb - Supplies the first dimension of matrix B.
 
+    CompressedB - Optionally supplies the compressed matrix B, which is used
+        instead of B and ldb.
+
     beta - Supplies the scaler beta multiplier (see SGEMM definition).
 
     C - Supplies the address of matrix C.
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the bias and activation to apply to matrix
+        C.
+
 Return Value:
 
     None.
@@ -833,13 +1454,45 @@ Return Value:
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
     MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
 
+    //
+    // Handle the special case of an empty K dimension. The product is zero,
+    // so matrix C is only scaled by beta before the epilogue applies the bias
+    // and the activation.
+    //
+
+    if (K == 0) {
+
+        if (M == 0 || N == 0) {
+            return;
+        }
+
+        if (beta != 1.0f) {
+
+            for (size_t m = 0; m < M; m++) {
+
+                float* c = C + m * ldc;
+
+                for (size_t n = 0; n < N; n++) {
+                    c[n] = (beta == 0.0f) ? 0.0f : c[n] * beta;
+                }
+            }
+        }
+
+        if (Epilogue != nullptr) {
+            MlasSgemmApplyEpilogue(Epilogue, C, 0, 0, M, N, ldc);
+        }
+
+        return;
+    }
+
     //
     // Handle the special case of a small M. The data from matrix B is not
     // referenced multiple times, so using a local packed buffer is a wasted
     // memory copy.
     //
 
-    if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f)) {
+    if (M == 1 && TransA == CblasNoTrans && alpha == 1.0f && (beta == 0.0f || beta == 1.0f) &&
+        CompressedA == nullptr && CompressedB == nullptr) {
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -852,7 +1505,13 @@ Return Value:
         }
 
         if (SgemmKernelM1Routine != nullptr) {
+
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+
+            if (Epilogue != nullptr) {
+                MlasSgemmApplyEpilogue(Epilogue, C, 0, 0, 1, N, ldc);
+            }
+
             return;
         }
 
@@ -865,9 +1524,11 @@ Return Value:
     //
     // Expand the N stride if K is small or expand the K stride if N is small
     // for better utilization of the B panel. Avoid changing the K stride if
-    // the A panel needs to be used for transposing.
+    // the A panel needs to be used for transposing or expanding.
     //
 
+    const bool UsePanelA = (TransA != CblasNoTrans || CompressedA != nullptr);
+
     uint32_t StrideN = MLAS_SGEMM_STRIDEN;
     uint32_t StrideK = MLAS_SGEMM_STRIDEK;
 
@@ -878,7 +1539,7 @@ Return Value:
             StrideK /= 2;
         }
 
-    } else if (TransA == CblasNoTrans) {
+    } else if (!UsePanelA) {
 
         while (StrideN > 16 && StrideN / 2 >= N) {
             StrideK *= 2;
@@ -922,10 +1583,13 @@ Return Value:
             }
 
             //
-            // Copy or transpose a panel of matrix B to a local packed buffer.
+            // Copy, transpose or expand a panel of matrix B to a local packed
+            // buffer.
             //
 
-            if (TransB == CblasNoTrans) {
+            if (CompressedB != nullptr) {
+                MlasSgemmExpandPackB(PanelB, CompressedB, TransB, n, k, CountN, CountK);
+            } else if (TransB == CblasNoTrans) {
                 MlasSgemmCopyPackB(PanelB, B + n + k * ldb, ldb, CountN, CountK);
             } else {
                 MlasSgemmTransposePackB(PanelB, B + k + n * ldb, ldb, CountN, CountK);
@@ -937,6 +1601,13 @@ Return Value:
 
             bool UseKernelZeroRoutine = (k == 0 && beta == 0.0f);
 
+            //
+            // Apply the epilogue to each tile of the output after the last
+            // slice of the K dimension has been accumulated.
+            //
+
+            bool ApplyEpilogue = (Epilogue != nullptr && k + CountK == K);
+
 #if defined(MLAS_TARGET_AMD64_IX86)
             PMLAS_SGEMM_KERNEL_ROUTINE SgemmKernelRoutine =
                 UseKernelZeroRoutine ? MlasPlatform.KernelZeroRoutine : MlasPlatform.KernelAddRoutine;
@@ -950,8 +1621,9 @@ Return Value:
 
             size_t RowsRemaining = M;
             size_t RowsHandled;
+            size_t RowsCompleted = 0;
 
-            if (TransA == CblasNoTrans) {
+            if (!UsePanelA) {
 
                 const float* a = A + k;
 
@@ -971,8 +1643,13 @@ Return Value:
                     }
 #endif
 
+                    if (ApplyEpilogue) {
+                        MlasSgemmApplyEpilogue(Epilogue, c, RowsCompleted, n, RowsHandled, CountN, ldc);
+                    }
+
                     c += ldc * RowsHandled;
                     a += lda * RowsHandled;
+                    RowsCompleted += RowsHandled;
 
                     RowsRemaining -= RowsHandled;
 
@@ -981,11 +1658,13 @@ Return Value:
             } else {
 
                 const float* a = A + k * lda;
+                size_t m = 0;
 
                 do {
 
                     //
-                    // Transpose elements from matrix A into a local buffer.
+                    // Transpose or expand elements from matrix A into a local
+                    // buffer.
                     //
 
                     size_t RowsTransposed = RowsRemaining;
@@ -996,9 +1675,13 @@ Return Value:
 
                     RowsRemaining -= RowsTransposed;
 
-                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
-
-                    a += RowsTransposed;
+                    if (CompressedA != nullptr) {
+                        MlasSgemmExpandA(PanelA, CompressedA, m, k, RowsTransposed, CountK);
+                        m += RowsTransposed;
+                    } else {
+                        MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+                        a += RowsTransposed;
+                    }
 
                     //
                     // Step through the rows of the local buffer.
@@ -1018,8 +1701,13 @@ Return Value:
                         }
 #endif
 
+                        if (ApplyEpilogue) {
+                            MlasSgemmApplyEpilogue(Epilogue, c, RowsCompleted, n, RowsHandled, CountN, ldc);
+                        }
+
                         c += ldc * RowsHandled;
                         pa += CountK * RowsHandled;
+                        RowsCompleted += RowsHandled;
 
                         RowsTransposed -= RowsHandled;
 
@@ -1031,6 +1719,68 @@ Return Value:
     }
 }
 
+void
+MlasSgemmOperation(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM).
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, nullptr, B, ldb,
+        nullptr, beta, C, ldc, nullptr);
+}
+
 void
 MlasSgemmOperationThreaded(
     void* Context,
@@ -1059,10 +1809,18 @@ Return Value:
 
     MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
+    const MLAS_COMPRESSED_MATRIX* CompressedA =
+        (Segment->CompressedA.Data != nullptr) ? &Segment->CompressedA : nullptr;
+    const MLAS_COMPRESSED_MATRIX* CompressedB =
+        (Segment->CompressedB.Data != nullptr) ? &Segment->CompressedB : nullptr;
+
+    const MLAS_SGEMM_EPILOGUE* Epilogue =
+        WorkBlock->HasEpilogue ? &Segment->Epilogue : nullptr;
+
     MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
         Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
-        Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
+        CompressedA, Segment->B, WorkBlock->ldb, CompressedB, WorkBlock->beta,
+        Segment->C, WorkBlock->ldc, Epilogue);
 }
 
 inline
@@ -1076,11 +1834,14 @@ MlasSgemmTryMultithread(
     float alpha,
     const float* A,
     size_t lda,
+    const MLAS_COMPRESSED_MATRIX* CompressedA,
     const float* B,
     size_t ldb,
+    const MLAS_COMPRESSED_MATRIX* CompressedB,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
     )
 /*++
 
@@ -1108,16 +1869,25 @@ Arguments:
 
     lda - Supplies the first dimension of matrix A.
 
+    CompressedA - Optionally supplies the compressed matrix A, which is used
+        instead of A and lda.
+
     B - Supplies the address of matrix B.
 
     ldb - Supplies the first dimension of matrix B.
 
+    CompressedB - Optionally supplies the compressed matrix B, which is used
+        instead of B and ldb.
+
     beta - Supplies the scaler beta multiplier (see SGEMM definition).
 
     C - Supplies the address of matrix C.
 
     ldc - Supplies the first dimension of matrix C.
 
+    Epilogue - Optionally supplies the bias and activation to apply to matrix
+        C.
+
 Return Value:
 
     Returns true if the operation was completed across multiple threads, else
@@ -1166,6 +1936,7 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.HasEpilogue = (Epilogue != nullptr);
 
     //
     // Segment the operation across multiple threads.
@@ -1197,9 +1968,27 @@ Return Value:
             WorkBlock.Segments[Index].M = M;
             WorkBlock.Segments[Index].N = CountN;
             WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
             WorkBlock.Segments[Index].C = C + n;
 
+            if (CompressedB != nullptr) {
+                WorkBlock.Segments[Index].B = nullptr;
+                WorkBlock.Segments[Index].CompressedB =
+                    MlasOffsetCompressedMatrix(CompressedB, n, (TransB == CblasNoTrans) ? 1 : CompressedB->ld);
+            } else {
+                WorkBlock.Segments[Index].B = B + n * pldb;
+                WorkBlock.Segments[Index].CompressedB.Data = nullptr;
+            }
+
+            if (CompressedA != nullptr) {
+                WorkBlock.Segments[Index].CompressedA = *CompressedA;
+            } else {
+                WorkBlock.Segments[Index].CompressedA.Data = nullptr;
+            }
+
+            if (Epilogue != nullptr) {
+                WorkBlock.Segments[Index].Epilogue = MlasOffsetEpilogue(Epilogue, 0, n);
+            }
+
             Index++;
         }
 
@@ -1223,10 +2012,28 @@ Return Value:
 
             WorkBlock.Segments[Index].M = CountM;
             WorkBlock.Segments[Index].N = N;
-            WorkBlock.Segments[Index].A = A + m * plda;
             WorkBlock.Segments[Index].B = B;
             WorkBlock.Segments[Index].C = C + m * ldc;
 
+            if (CompressedA != nullptr) {
+                WorkBlock.Segments[Index].A = nullptr;
+                WorkBlock.Segments[Index].CompressedA =
+                    MlasOffsetCompressedMatrix(CompressedA, m, CompressedA->ld);
+            } else {
+                WorkBlock.Segments[Index].A = A + m * plda;
+                WorkBlock.Segments[Index].CompressedA.Data = nullptr;
+            }
+
+            if (CompressedB != nullptr) {
+                WorkBlock.Segments[Index].CompressedB = *CompressedB;
+            } else {
+                WorkBlock.Segments[Index].CompressedB.Data = nullptr;
+            }
+
+            if (Epilogue != nullptr) {
+                WorkBlock.Segments[Index].Epilogue = MlasOffsetEpilogue(Epilogue, m, 0);
+            }
+
             Index++;
         }
     }
@@ -1249,11 +2056,14 @@ Return Value:
     MLAS_UNREFERENCED_PARAMETER(alpha);
     MLAS_UNREFERENCED_PARAMETER(A);
     MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(CompressedA);
     MLAS_UNREFERENCED_PARAMETER(B);
     MLAS_UNREFERENCED_PARAMETER(ldb);
+    MLAS_UNREFERENCED_PARAMETER(CompressedB);
     MLAS_UNREFERENCED_PARAMETER(beta);
     MLAS_UNREFERENCED_PARAMETER(C);
     MLAS_UNREFERENCED_PARAMETER(ldc);
+    MLAS_UNREFERENCED_PARAMETER(Epilogue);
 
     return false;
 
@@ -1325,7 +2135,196 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc)) {
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, nullptr, B, ldb, nullptr, beta, C, ldc, nullptr)) {
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc,
+    const MLAS_SGEMM_EPILOGUE* Epilogue
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) and applies an epilogue to each tile of the output.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    Epilogue - Supplies the bias and activation to apply to matrix C after
+        the multiply.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, nullptr, B, ldb, nullptr, beta, C, ldc, Epilogue)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, nullptr, B, ldb, nullptr, beta, C, ldc, Epilogue);
+    }
+}
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_COMPRESSED_MATRIX* B,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B stored in a compressed format.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the compressed matrix B. The scale is indexed by the columns
+        of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, nullptr, nullptr, 0, B, beta, C, ldc, nullptr)) {
+        MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, nullptr, nullptr, 0, B, beta, C, ldc, nullptr);
+    }
+}
+
+void
+MLASCALL
+MlasSgemm(
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_COMPRESSED_MATRIX* A,
+    const float* B,
+    size_t ldb,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix A stored in a compressed format.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scaler alpha multiplier (see SGEMM definition).
+
+    A - Supplies the compressed matrix A, which is not transposed. The scale is
+        indexed by the rows of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    beta - Supplies the scaler beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (!MlasSgemmTryMultithread(CblasNoTrans, TransB, M, N, K, alpha, nullptr, 0, A, B, ldb, nullptr, beta, C, ldc, nullptr)) {
+        MlasSgemmOperation(CblasNoTrans, TransB, M, N, K, alpha, nullptr, 0, A, B, ldb, nullptr, beta, C, ldc, nullptr);
+    }
+}
@@ -0,0 +1,245 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    softmax.cpp
+
+Abstract:
+
+    This module implements routines to compute the softmax function over the
+    rows of a matrix.
+
+    Each row is processed in three passes: the maximum of the row is found,
+    the exponentials of the elements minus the maximum are stored to the
+    output and summed, and the output is scaled by the reciprocal of the sum.
+    Subtracting the maximum keeps the exponentials in [0, 1], so the exponent
+    routine only needs to handle non-positive inputs.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Bundles the floating point constants of the exponential function.
+//
+
+const struct {
+    float LowerRange;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float P0;
+    float P1;
+    float P2;
+    float P3;
+    float P4;
+    float P5;
+    float P6;
+    float RoundingBias;
+    float ExponentBias;
+} MlasExpConstants = {
+    -87.3365479f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.38319808e-3f,
+    8.37550033e-3f,
+    4.16689515e-2f,
+    1.66664466e-1f,
+    4.99999851e-1f,
+    1.0f,
+    1.0f,
+    1.25829120e+7f,
+    127.0f,
+};
+
+inline
+MLAS_FLOAT32X4
+MlasExpFloat32x4(
+    MLAS_FLOAT32X4 Value
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of a vector of
+    non-positive values.
+
+    The exponential is computed as 2^n * exp(r) where r = Value - n * ln(2)
+    is reduced to [-ln(2)/2, ln(2)/2]. Adding the rounding bias rounds the
+    scaled input to an integer held in the low bits of the mantissa, which
+    are shifted into the exponent field to build 2^n. Inputs below the lower
+    range are clamped so that 2^n remains a normal number.
+
+Arguments:
+
+    Value - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential of each element of the input vector.
+
+--*/
+{
+    Value = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Value);
+
+    MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+
+    MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(Value,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    MLAS_FLOAT32X4 Exponent = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    MLAS_FLOAT32X4 Reduced;
+    Reduced = MlasMultiplyAddFloat32x4(Exponent, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Value);
+    Reduced = MlasMultiplyAddFloat32x4(Exponent, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), Reduced);
+
+    MLAS_FLOAT32X4 Result;
+    Result = MlasMultiplyAddFloat32x4(Reduced, MlasBroadcastFloat32x4(MlasExpConstants.P0),
+        MlasBroadcastFloat32x4(MlasExpConstants.P1));
+    Result = MlasMultiplyAddFloat32x4(Result, Reduced, MlasBroadcastFloat32x4(MlasExpConstants.P2));
+    Result = MlasMultiplyAddFloat32x4(Result, Reduced, MlasBroadcastFloat32x4(MlasExpConstants.P3));
+    Result = MlasMultiplyAddFloat32x4(Result, Reduced, MlasBroadcastFloat32x4(MlasExpConstants.P4));
+    Result = MlasMultiplyAddFloat32x4(Result, Reduced, MlasBroadcastFloat32x4(MlasExpConstants.P5));
+    Result = MlasMultiplyAddFloat32x4(Result, Reduced, MlasBroadcastFloat32x4(MlasExpConstants.P6));
+
+    Biased = MlasAddFloat32x4(Biased, MlasBroadcastFloat32x4(MlasExpConstants.ExponentBias));
+    MLAS_FLOAT32X4 PowerOf2 = MlasReinterpretAsFloat32x4(MlasShiftLeftInt32x4<23>(MlasReinterpretAsInt32x4(Biased)));
+
+    return MlasMultiplyFloat32x4(Result, PowerOf2);
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax function of each row of a matrix.
+
+Arguments:
+
+    Input - Supplies the input matrix of N rows and D columns.
+
+    Output - Supplies the output matrix of N rows and D columns. The output
+        may be the same buffer as the input.
+
+    N - Supplies the number of rows.
+
+    D - Supplies the number of columns.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N-- > 0) {
+
+        //
+        // Find the maximum of the row.
+        //
+
+        const float* x = Input;
+        size_t n = D;
+
+        float Maximum = std::numeric_limits<float>::lowest();
+
+        if (n >= 4) {
+
+            MLAS_FLOAT32X4 MaximumVector = MlasLoadFloat32x4(x);
+
+            x += 4;
+            n -= 4;
+
+            while (n >= 4) {
+
+                MaximumVector = MlasMaximumFloat32x4(MaximumVector, MlasLoadFloat32x4(x));
+
+                x += 4;
+                n -= 4;
+            }
+
+            Maximum = MlasReduceMaximumFloat32x4(MaximumVector);
+        }
+
+        while (n > 0) {
+
+            Maximum = (std::max)(Maximum, *x++);
+
+            n -= 1;
+        }
+
+        //
+        // Store the exponentials of the shifted row and accumulate their sum.
+        //
+
+        MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(Maximum);
+        MLAS_FLOAT32X4 SumVector = MlasZeroFloat32x4();
+
+        x = Input;
+        float* y = Output;
+        n = D;
+
+        while (n >= 4) {
+
+            MLAS_FLOAT32X4 Exp = MlasExpFloat32x4(MlasSubtractFloat32x4(MlasLoadFloat32x4(x), MaximumVector));
+
+            MlasStoreFloat32x4(y, Exp);
+            SumVector = MlasAddFloat32x4(SumVector, Exp);
+
+            x += 4;
+            y += 4;
+            n -= 4;
+        }
+
+        float Sum = MlasReduceAddFloat32x4(SumVector);
+
+        while (n > 0) {
+
+            float Exp = std::exp(*x++ - Maximum);
+
+            *y++ = Exp;
+            Sum += Exp;
+
+            n -= 1;
+        }
+
+        //
+        // Normalize the row.
+        //
+
+        float Scale = 1.0f / Sum;
+        MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+        y = Output;
+        n = D;
+
+        while (n >= 4) {
+
+            MlasStoreFloat32x4(y, MlasMultiplyFloat32x4(MlasLoadFloat32x4(y), ScaleVector));
+
+            y += 4;
+            n -= 4;
+        }
+
+        while (n > 0) {
+
+            *y++ *= Scale;
+
+            n -= 1;
+        }
+
+        Input += D;
+        Output += D;
+    }
+}
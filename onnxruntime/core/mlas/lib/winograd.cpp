@@ -0,0 +1,948 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    winograd.cpp
+
+Abstract:
+
+    This module implements the Winograd minimal filtering algorithm for 3x3
+    convolutions with unit stride and dilation.
+
+    The output image is divided into tiles of TileSize x TileSize elements.
+    The Alpha x Alpha input patch of each tile (Alpha = TileSize + 2) and the
+    3x3 filters are transformed to the Winograd domain, where the convolution
+    of a tile becomes an elementwise product. Summing the products over the
+    input channels turns each of the Alpha x Alpha transformed elements into
+    an independent GEMM of the filters by the tiles, and the transformed
+    output is transformed back to the TileSize x TileSize output tile.
+
+    F(2x2,3x3) and F(4x4,3x3) are supported. The tile transforms are computed
+    for four tiles at a time with one tile in each vector lane.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of working buffer elements to target per thread. This
+// bounds the number of tiles that are transformed for one batch of GEMMs.
+//
+
+#define MLAS_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD    (512 * 1024)
+
+//
+// Define the minimum number of input channels and filters and the minimum
+// output height and width for the Winograd algorithm. Below these, the tile
+// transforms and the reads of the larger transformed filter cost more than
+// the multiplies that are saved.
+//
+
+#define MLAS_WINOGRAD_MINIMUM_CHANNELS                  32
+#define MLAS_WINOGRAD_MINIMUM_OUTPUT_SIZE               6
+
+//
+// Define the parameters to execute blocks of tile rows of a Winograd
+// convolution on worker threads.
+//
+
+struct MLAS_CONV_WINOGRAD_WORK_BLOCK {
+    const MLAS_CONV_PARAMETERS* Parameters;
+    const float* Input;
+    const float* Filter;
+    const float* Bias;
+    float* WorkingBuffer;
+    float* Output;
+    size_t BlockCount;
+};
+
+//
+// Define the transform matrices of each tile size. The input transform
+// computes B^T * d * B, the filter transform computes G * g * G^T and the
+// output transform computes A^T * m * A, where each transform applies a one
+// dimensional transform to the columns and then to the rows of a tile.
+//
+
+template<size_t TileSize>
+struct MLAS_WINOGRAD_TRANSFORM;
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<2>
+{
+    static constexpr size_t Alpha = 4;
+
+    static const float G[Alpha][3];
+
+    static
+    void
+    Input(
+        const MLAS_FLOAT32X4* d,
+        size_t Stride,
+        MLAS_FLOAT32X4* o
+        )
+    {
+        MLAS_FLOAT32X4 d0 = d[0 * Stride];
+        MLAS_FLOAT32X4 d1 = d[1 * Stride];
+        MLAS_FLOAT32X4 d2 = d[2 * Stride];
+        MLAS_FLOAT32X4 d3 = d[3 * Stride];
+
+        o[0 * Stride] = MlasSubtractFloat32x4(d0, d2);
+        o[1 * Stride] = MlasAddFloat32x4(d1, d2);
+        o[2 * Stride] = MlasSubtractFloat32x4(d2, d1);
+        o[3 * Stride] = MlasSubtractFloat32x4(d1, d3);
+    }
+
+    static
+    void
+    Output(
+        const MLAS_FLOAT32X4* m,
+        size_t Stride,
+        MLAS_FLOAT32X4* o,
+        size_t OutputStride
+        )
+    {
+        MLAS_FLOAT32X4 m0 = m[0 * Stride];
+        MLAS_FLOAT32X4 m1 = m[1 * Stride];
+        MLAS_FLOAT32X4 m2 = m[2 * Stride];
+        MLAS_FLOAT32X4 m3 = m[3 * Stride];
+
+        o[0 * OutputStride] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1), m2);
+        o[1 * OutputStride] = MlasSubtractFloat32x4(MlasSubtractFloat32x4(m1, m2), m3);
+    }
+};
+
+const float MLAS_WINOGRAD_TRANSFORM<2>::G[4][3] = {
+    { 1.0f, 0.0f, 0.0f },
+    { 0.5f, 0.5f, 0.5f },
+    { 0.5f, -0.5f, 0.5f },
+    { 0.0f, 0.0f, 1.0f },
+};
+
+template<>
+struct MLAS_WINOGRAD_TRANSFORM<4>
+{
+    static constexpr size_t Alpha = 6;
+
+    static const float G[Alpha][3];
+
+    static
+    void
+    Input(
+        const MLAS_FLOAT32X4* d,
+        size_t Stride,
+        MLAS_FLOAT32X4* o
+        )
+    {
+        const MLAS_FLOAT32X4 Two = MlasBroadcastFloat32x4(2.0f);
+        const MLAS_FLOAT32X4 Four = MlasBroadcastFloat32x4(4.0f);
+        const MLAS_FLOAT32X4 Five = MlasBroadcastFloat32x4(5.0f);
+
+        MLAS_FLOAT32X4 d0 = d[0 * Stride];
+        MLAS_FLOAT32X4 d1 = d[1 * Stride];
+        MLAS_FLOAT32X4 d2 = d[2 * Stride];
+        MLAS_FLOAT32X4 d3 = d[3 * Stride];
+        MLAS_FLOAT32X4 d4 = d[4 * Stride];
+        MLAS_FLOAT32X4 d5 = d[5 * Stride];
+
+        //
+        // Share the common subexpressions of the middle rows:
+        //
+        //     o1 = (d3 + d4) - 4 * (d1 + d2)
+        //     o2 = (d4 - d3) + 4 * (d1 - d2)
+        //     o3 = (d4 - d2) + 2 * (d3 - d1)
+        //     o4 = (d4 - d2) - 2 * (d3 - d1)
+        //
+
+        MLAS_FLOAT32X4 d3_plus_d4 = MlasAddFloat32x4(d3, d4);
+        MLAS_FLOAT32X4 d1_plus_d2 = MlasAddFloat32x4(d1, d2);
+        MLAS_FLOAT32X4 d4_minus_d3 = MlasSubtractFloat32x4(d4, d3);
+        MLAS_FLOAT32X4 d1_minus_d2 = MlasSubtractFloat32x4(d1, d2);
+        MLAS_FLOAT32X4 d4_minus_d2 = MlasSubtractFloat32x4(d4, d2);
+        MLAS_FLOAT32X4 d3_minus_d1 = MlasMultiplyFloat32x4(Two, MlasSubtractFloat32x4(d3, d1));
+
+        o[0 * Stride] = MlasAddFloat32x4(MlasSubtractFloat32x4(MlasMultiplyFloat32x4(Four, d0), MlasMultiplyFloat32x4(Five, d2)), d4);
+        o[1 * Stride] = MlasSubtractFloat32x4(d3_plus_d4, MlasMultiplyFloat32x4(Four, d1_plus_d2));
+        o[2 * Stride] = MlasAddFloat32x4(d4_minus_d3, MlasMultiplyFloat32x4(Four, d1_minus_d2));
+        o[3 * Stride] = MlasAddFloat32x4(d4_minus_d2, d3_minus_d1);
+        o[4 * Stride] = MlasSubtractFloat32x4(d4_minus_d2, d3_minus_d1);
+        o[5 * Stride] = MlasAddFloat32x4(MlasSubtractFloat32x4(MlasMultiplyFloat32x4(Four, d1), MlasMultiplyFloat32x4(Five, d3)), d5);
+    }
+
+    static
+    void
+    Output(
+        const MLAS_FLOAT32X4* m,
+        size_t Stride,
+        MLAS_FLOAT32X4* o,
+        size_t OutputStride
+        )
+    {
+        const MLAS_FLOAT32X4 Two = MlasBroadcastFloat32x4(2.0f);
+        const MLAS_FLOAT32X4 Four = MlasBroadcastFloat32x4(4.0f);
+        const MLAS_FLOAT32X4 Eight = MlasBroadcastFloat32x4(8.0f);
+
+        MLAS_FLOAT32X4 m0 = m[0 * Stride];
+        MLAS_FLOAT32X4 m1 = m[1 * Stride];
+        MLAS_FLOAT32X4 m2 = m[2 * Stride];
+        MLAS_FLOAT32X4 m3 = m[3 * Stride];
+        MLAS_FLOAT32X4 m4 = m[4 * Stride];
+        MLAS_FLOAT32X4 m5 = m[5 * Stride];
+
+        MLAS_FLOAT32X4 m1_plus_m2 = MlasAddFloat32x4(m1, m2);
+        MLAS_FLOAT32X4 m1_minus_m2 = MlasSubtractFloat32x4(m1, m2);
+        MLAS_FLOAT32X4 m3_plus_m4 = MlasAddFloat32x4(m3, m4);
+        MLAS_FLOAT32X4 m3_minus_m4 = MlasSubtractFloat32x4(m3, m4);
+
+        o[0 * OutputStride] = MlasAddFloat32x4(MlasAddFloat32x4(m0, m1_plus_m2), m3_plus_m4);
+        o[1 * OutputStride] = MlasMultiplyAddFloat32x4(Two, m3_minus_m4, m1_minus_m2);
+        o[2 * OutputStride] = MlasMultiplyAddFloat32x4(Four, m3_plus_m4, m1_plus_m2);
+        o[3 * OutputStride] = MlasAddFloat32x4(MlasMultiplyAddFloat32x4(Eight, m3_minus_m4, m1_minus_m2), m5);
+    }
+};
+
+const float MLAS_WINOGRAD_TRANSFORM<4>::G[6][3] = {
+    { 1.0f / 4.0f, 0.0f, 0.0f },
+    { -1.0f / 6.0f, -1.0f / 6.0f, -1.0f / 6.0f },
+    { -1.0f / 6.0f, 1.0f / 6.0f, -1.0f / 6.0f },
+    { 1.0f / 24.0f, 1.0f / 12.0f, 1.0f / 6.0f },
+    { 1.0f / 24.0f, -1.0f / 12.0f, 1.0f / 6.0f },
+    { 0.0f, 0.0f, 1.0f },
+};
+
+template<size_t TileSize>
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* TransformedInput,
+    size_t StartTile,
+    size_t CountTiles
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the input patches of a range of tiles for all of
+    the input channels.
+
+    The transformed input is stored as Alpha * Alpha matrices of shape
+    [InputChannels, CountTiles], ready to be used as the B matrix of the
+    GEMMs in the Winograd domain.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the current batch and group.
+
+    TransformedInput - Supplies the buffer to receive the transformed input.
+
+    StartTile - Supplies the index of the first tile to transform.
+
+    CountTiles - Supplies the number of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t Alpha = MLAS_WINOGRAD_TRANSFORM<TileSize>::Alpha;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+
+    const size_t TransformedStride = InputChannels * CountTiles;
+
+    MLAS_DECLSPEC_ALIGN(float Patch[Alpha * Alpha * 4], 16);
+    MLAS_DECLSPEC_ALIGN(float Remainder[Alpha * Alpha * 4], 16);
+    MLAS_FLOAT32X4 d[Alpha * Alpha];
+    MLAS_FLOAT32X4 t[Alpha * Alpha];
+    MLAS_FLOAT32X4 v[Alpha * Alpha];
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+        float* transformed = TransformedInput + c * CountTiles;
+
+        for (size_t tile = 0; tile < CountTiles; tile += 4) {
+
+            //
+            // Gather the input patch of each tile to its own vector lane.
+            // Elements in the padding region and the unused lanes of the
+            // last group of tiles are zero.
+            //
+
+            const size_t CountLanes = (CountTiles - tile >= 4) ? 4 : (CountTiles - tile);
+
+            for (size_t lane = 0; lane < 4; lane++) {
+
+                if (lane >= CountLanes) {
+                    for (size_t i = 0; i < Alpha * Alpha; i++) {
+                        Patch[i * 4 + lane] = 0.0f;
+                    }
+                    continue;
+                }
+
+                const size_t TileIndex = StartTile + tile + lane;
+                const size_t OriginY = (TileIndex / TileCountWidth) * TileSize - PaddingTop;
+                const size_t OriginX = (TileIndex % TileCountWidth) * TileSize - PaddingLeft;
+
+                for (size_t i = 0; i < Alpha; i++) {
+
+                    const size_t InputY = OriginY + i;
+
+                    for (size_t j = 0; j < Alpha; j++) {
+
+                        const size_t InputX = OriginX + j;
+
+                        Patch[(i * Alpha + j) * 4 + lane] = (InputY < InputHeight && InputX < InputWidth) ?
+                            input[InputY * InputWidth + InputX] : 0.0f;
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < Alpha * Alpha; i++) {
+                d[i] = MlasLoadFloat32x4(&Patch[i * 4]);
+            }
+
+            //
+            // Transform the columns and then the rows of the patches.
+            //
+
+            for (size_t j = 0; j < Alpha; j++) {
+                MLAS_WINOGRAD_TRANSFORM<TileSize>::Input(&d[j], Alpha, &t[j]);
+            }
+
+            for (size_t i = 0; i < Alpha; i++) {
+                MLAS_WINOGRAD_TRANSFORM<TileSize>::Input(&t[i * Alpha], 1, &v[i * Alpha]);
+            }
+
+            //
+            // Store each transformed element of the four tiles to its matrix.
+            //
+
+            if (CountLanes == 4) {
+
+                for (size_t i = 0; i < Alpha * Alpha; i++) {
+                    MlasStoreFloat32x4(&transformed[i * TransformedStride + tile], v[i]);
+                }
+
+            } else {
+
+                for (size_t i = 0; i < Alpha * Alpha; i++) {
+                    MlasStoreAlignedFloat32x4(&Remainder[i * 4], v[i]);
+                    for (size_t lane = 0; lane < CountLanes; lane++) {
+                        transformed[i * TransformedStride + tile + lane] = Remainder[i * 4 + lane];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    float* Output,
+    size_t StartTile,
+    size_t CountTiles
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the output of a range of tiles for all of the
+    filters back to the output tensor.
+
+    If the Beta of the parameters is nonzero, the existing contents of the
+    output tensor are scaled and accumulated into the output.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the Alpha * Alpha matrices of shape
+        [FilterCount, CountTiles] computed by the GEMMs in the Winograd domain.
+
+    Output - Supplies the output tensor of the current batch and group.
+
+    StartTile - Supplies the index of the first tile to transform.
+
+    CountTiles - Supplies the number of tiles to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t Alpha = MLAS_WINOGRAD_TRANSFORM<TileSize>::Alpha;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+    const float Beta = Parameters->Beta;
+
+    const size_t TransformedStride = FilterCount * CountTiles;
+
+    MLAS_DECLSPEC_ALIGN(float Remainder[Alpha * Alpha * 4], 16);
+    MLAS_DECLSPEC_ALIGN(float Tile[TileSize * TileSize * 4], 16);
+    MLAS_FLOAT32X4 m[Alpha * Alpha];
+    MLAS_FLOAT32X4 t[TileSize * Alpha];
+    MLAS_FLOAT32X4 y[TileSize * TileSize];
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float* transformed = TransformedOutput + f * CountTiles;
+        float* output = Output + f * OutputSize;
+
+        for (size_t tile = 0; tile < CountTiles; tile += 4) {
+
+            const size_t CountLanes = (CountTiles - tile >= 4) ? 4 : (CountTiles - tile);
+
+            if (CountLanes == 4) {
+
+                for (size_t i = 0; i < Alpha * Alpha; i++) {
+                    m[i] = MlasLoadFloat32x4(&transformed[i * TransformedStride + tile]);
+                }
+
+            } else {
+
+                for (size_t i = 0; i < Alpha * Alpha; i++) {
+                    for (size_t lane = 0; lane < 4; lane++) {
+                        Remainder[i * 4 + lane] = (lane < CountLanes) ?
+                            transformed[i * TransformedStride + tile + lane] : 0.0f;
+                    }
+                    m[i] = MlasLoadFloat32x4(&Remainder[i * 4]);
+                }
+            }
+
+            //
+            // Transform the columns and then the rows of the tiles.
+            //
+
+            for (size_t j = 0; j < Alpha; j++) {
+                MLAS_WINOGRAD_TRANSFORM<TileSize>::Output(&m[j], Alpha, &t[j], Alpha);
+            }
+
+            for (size_t i = 0; i < TileSize; i++) {
+                MLAS_WINOGRAD_TRANSFORM<TileSize>::Output(&t[i * Alpha], 1, &y[i * TileSize], 1);
+            }
+
+            for (size_t i = 0; i < TileSize * TileSize; i++) {
+                MlasStoreAlignedFloat32x4(&Tile[i * 4], y[i]);
+            }
+
+            //
+            // Scatter each output tile, clipping the tiles at the bottom and
+            // right edges of the output.
+            //
+
+            for (size_t lane = 0; lane < CountLanes; lane++) {
+
+                const size_t TileIndex = StartTile + tile + lane;
+                const size_t OriginY = (TileIndex / TileCountWidth) * TileSize;
+                const size_t OriginX = (TileIndex % TileCountWidth) * TileSize;
+
+                const size_t CountY = (OutputHeight - OriginY >= TileSize) ? TileSize : (OutputHeight - OriginY);
+                const size_t CountX = (OutputWidth - OriginX >= TileSize) ? TileSize : (OutputWidth - OriginX);
+
+                for (size_t i = 0; i < CountY; i++) {
+
+                    float* row = output + (OriginY + i) * OutputWidth + OriginX;
+
+                    for (size_t j = 0; j < CountX; j++) {
+
+                        float Value = Tile[(i * TileSize + j) * 4 + lane];
+
+                        if (Beta != 0.0f) {
+                            Value += Beta * row[j];
+                        }
+
+                        row[j] = Value;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock,
+    float* WorkingBuffer,
+    size_t Block
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the output of a block of tile rows.
+
+Arguments:
+
+    WorkBlock - Supplies the structure that contains the convolution
+        operation.
+
+    WorkingBuffer - Supplies the thread local slice of the working buffer.
+
+    Block - Supplies the index of the block of tile rows.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t Alpha = MLAS_WINOGRAD_TRANSFORM<TileSize>::Alpha;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t TileCountHeight = Parameters->u.Winograd.TileCountHeight;
+    const size_t TileCountWidth = Parameters->u.Winograd.TileCountWidth;
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+
+    const size_t StartTileRow = Block * TileRowsPerBlock;
+    const size_t CountTileRows = (TileCountHeight - StartTileRow >= TileRowsPerBlock) ?
+        TileRowsPerBlock : (TileCountHeight - StartTileRow);
+
+    const size_t StartTile = StartTileRow * TileCountWidth;
+    const size_t CountTiles = CountTileRows * TileCountWidth;
+
+    float* TransformedInput = WorkingBuffer;
+    float* TransformedOutput = WorkingBuffer + Alpha * Alpha * InputChannels * TileRowsPerBlock * TileCountWidth;
+
+    MlasConvWinogradTransformInput<TileSize>(Parameters, WorkBlock->Input,
+        TransformedInput, StartTile, CountTiles);
+
+    //
+    // Multiply the transformed filters by the transformed input for each of
+    // the Alpha * Alpha elements of the Winograd domain.
+    //
+
+    for (size_t i = 0; i < Alpha * Alpha; i++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, CountTiles,
+            InputChannels, 1.0f, WorkBlock->Filter + i * FilterCount * InputChannels,
+            InputChannels, TransformedInput + i * InputChannels * CountTiles,
+            CountTiles, 0.0f, TransformedOutput + i * FilterCount * CountTiles,
+            CountTiles);
+    }
+
+    MlasConvWinogradTransformOutput<TileSize>(Parameters, TransformedOutput,
+        WorkBlock->Output, StartTile, CountTiles);
+
+    //
+    // Apply the activation with optional bias to the output rows of the
+    // block, which are contiguous in each output channel.
+    //
+
+    const size_t StartY = StartTileRow * TileSize;
+    const size_t EndY = (StartY + CountTileRows * TileSize < OutputHeight) ?
+        (StartY + CountTileRows * TileSize) : OutputHeight;
+
+    float* output = WorkBlock->Output + StartY * OutputWidth;
+
+    MlasActivation(Parameters->Activation, output, WorkBlock->Bias, FilterCount,
+        output, (EndY - StartY) * OutputWidth, OutputSize);
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute the blocks of tile
+    rows of a Winograd convolution assigned to the thread.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_CONV_WINOGRAD_WORK_BLOCK* WorkBlock = (MLAS_CONV_WINOGRAD_WORK_BLOCK*)Context;
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t TileSize = Parameters->u.Winograd.TileSize;
+    const size_t ThreadCount = Parameters->u.Winograd.ThreadCount;
+    const size_t Alpha = TileSize + 2;
+
+    const size_t WorkingBufferSizePerThread = Alpha * Alpha *
+        (Parameters->InputChannels + Parameters->FilterCount) *
+        Parameters->u.Winograd.TileRowsPerBlock * Parameters->u.Winograd.TileCountWidth;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer + Index * WorkingBufferSizePerThread;
+
+    for (size_t Block = size_t(Index); Block < WorkBlock->BlockCount; Block += ThreadCount) {
+
+        if (TileSize == 4) {
+            MlasConvWinogradOperation<4>(WorkBlock, WorkingBuffer, Block);
+        } else {
+            MlasConvWinogradOperation<2>(WorkBlock, WorkingBuffer, Block);
+        }
+    }
+}
+
+void
+MlasConvWinograd(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd convolution for one batch and group.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the batch and group.
+
+    Filter - Supplies the transformed filter of the group.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    WorkingBuffer - Supplies a working buffer sized to the number of elements
+        returned by MlasConvPrepare.
+
+    Output - Supplies the output tensor of the batch and group.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t TileCountHeight = Parameters->u.Winograd.TileCountHeight;
+    const size_t TileRowsPerBlock = Parameters->u.Winograd.TileRowsPerBlock;
+
+    MLAS_CONV_WINOGRAD_WORK_BLOCK WorkBlock;
+
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.Input = Input;
+    WorkBlock.Filter = Filter;
+    WorkBlock.Bias = Bias;
+    WorkBlock.WorkingBuffer = WorkingBuffer;
+    WorkBlock.Output = Output;
+    WorkBlock.BlockCount = (TileCountHeight + TileRowsPerBlock - 1) / TileRowsPerBlock;
+
+    MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock,
+        int32_t(Parameters->u.Winograd.ThreadCount));
+}
+
+bool
+MlasConvWinogradPrepare(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t ThreadCount,
+    size_t* WorkingBufferSize
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether the Winograd algorithm should be used for
+    the convolution and if so, computes its parameters.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    ThreadCount - Supplies the number of threads to split the tiles across,
+        or zero to only select the Winograd algorithm if it is expected to be
+        faster and to derive the thread count from the complexity.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results.
+
+Return Value:
+
+    Returns true if the Winograd algorithm was selected, else false.
+
+--*/
+{
+    if (Parameters->Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (Parameters->KernelShape[dim] != 3 || Parameters->StrideShape[dim] != 1 ||
+            Parameters->DilationShape[dim] != 1) {
+            return false;
+        }
+    }
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+
+    //
+    // The transforms are amortized over the channels and the filters, and
+    // the transformed filter is only reused by a few tiles of small images.
+    //
+
+    if (ThreadCount == 0 &&
+        (InputChannels < MLAS_WINOGRAD_MINIMUM_CHANNELS ||
+         FilterCount < MLAS_WINOGRAD_MINIMUM_CHANNELS ||
+         OutputHeight < MLAS_WINOGRAD_MINIMUM_OUTPUT_SIZE ||
+         OutputWidth < MLAS_WINOGRAD_MINIMUM_OUTPUT_SIZE)) {
+        return false;
+    }
+
+    //
+    // F(4x4,3x3) saves 4x of the multiplies versus 2.25x for F(2x2,3x3), so
+    // use the larger tile unless the image is too small to fill it.
+    //
+
+    const size_t TileSize = (OutputHeight >= 8 && OutputWidth >= 8) ? 4 : 2;
+    const size_t Alpha = TileSize + 2;
+
+    const size_t TileCountHeight = (OutputHeight + TileSize - 1) / TileSize;
+    const size_t TileCountWidth = (OutputWidth + TileSize - 1) / TileSize;
+
+    //
+    // Unless supplied, compute the number of target threads given the
+    // complexity of the GEMMs in the Winograd domain. Small requests should run using the single
+    // threaded path.
+    //
+
+    int32_t TargetThreadCount;
+
+    if (ThreadCount == 0) {
+
+        double Complexity = double(Alpha * Alpha) * double(FilterCount) * double(InputChannels) *
+            double(TileCountHeight * TileCountWidth);
+
+        if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+            TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+        } else {
+            TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+        }
+
+    } else {
+        TargetThreadCount = int32_t(ThreadCount);
+    }
+
+    int32_t MaximumThreadCount = MlasPlatform.GetMaximumThreadCount();
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Size the blocks of tile rows to the working buffer budget of a thread
+    // and so that each thread receives at least one block.
+    //
+
+    const size_t WorkingBufferSizePerTile = Alpha * Alpha * (InputChannels + FilterCount);
+
+    size_t TileRowsPerBlock = MLAS_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD /
+        (WorkingBufferSizePerTile * TileCountWidth);
+
+    const size_t TileRowsPerThread = (TileCountHeight + TargetThreadCount - 1) / TargetThreadCount;
+
+    if (TileRowsPerBlock > TileRowsPerThread) {
+        TileRowsPerBlock = TileRowsPerThread;
+    }
+
+    if (TileRowsPerBlock == 0) {
+        TileRowsPerBlock = 1;
+    }
+
+    const size_t BlockCount = (TileCountHeight + TileRowsPerBlock - 1) / TileRowsPerBlock;
+
+    if (size_t(TargetThreadCount) > BlockCount) {
+        TargetThreadCount = int32_t(BlockCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->u.Winograd.TileSize = TileSize;
+    Parameters->u.Winograd.TileCountHeight = TileCountHeight;
+    Parameters->u.Winograd.TileCountWidth = TileCountWidth;
+    Parameters->u.Winograd.TileRowsPerBlock = TileRowsPerBlock;
+    Parameters->u.Winograd.ThreadCount = size_t(TargetThreadCount);
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * WorkingBufferSizePerTile *
+        TileRowsPerBlock * TileCountWidth;
+
+    return true;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradFilterSize(
+    const MLAS_CONV_PARAMETERS* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the number of elements of the transformed filter for
+    a convolution that uses the Winograd algorithm.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+Return Value:
+
+    Returns the number of elements of the transformed filter.
+
+--*/
+{
+    const size_t Alpha = Parameters->u.Winograd.TileSize + 2;
+
+    return Parameters->GroupCount * Alpha * Alpha * Parameters->FilterCount *
+        Parameters->InputChannels;
+}
+
+template<size_t TileSize>
+void
+MlasConvWinogradTransformFilterTile(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter for the supplied tile size.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t Alpha = MLAS_WINOGRAD_TRANSFORM<TileSize>::Alpha;
+    const float (&G)[Alpha][3] = MLAS_WINOGRAD_TRANSFORM<TileSize>::G;
+
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t TransformedStride = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < Parameters->GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter + (f * InputChannels + c) * 9;
+                float t[Alpha][3];
+
+                //
+                // Compute G * g and then (G * g) * G^T.
+                //
+
+                for (size_t i = 0; i < Alpha; i++) {
+                    for (size_t j = 0; j < 3; j++) {
+                        t[i][j] = G[i][0] * g[0 * 3 + j] + G[i][1] * g[1 * 3 + j] + G[i][2] * g[2 * 3 + j];
+                    }
+                }
+
+                for (size_t i = 0; i < Alpha; i++) {
+                    for (size_t j = 0; j < Alpha; j++) {
+                        TransformedFilter[(i * Alpha + j) * TransformedStride + f * InputChannels + c] =
+                            t[i][0] * G[j][0] + t[i][1] * G[j][1] + t[i][2] * G[j][2];
+                    }
+                }
+            }
+        }
+
+        Filter += FilterCount * InputChannels * 9;
+        TransformedFilter += Alpha * Alpha * TransformedStride;
+    }
+}
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the filter of a convolution that uses the
+    Winograd algorithm.
+
+    The transformed filter of each group is stored as Alpha * Alpha matrices
+    of shape [FilterCount, InputChannels], ready to be used as the A matrix of
+    the GEMMs in the Winograd domain.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Filter - Supplies the filter tensor.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter,
+        sized to the number of elements returned by MlasConvWinogradFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Parameters->u.Winograd.TileSize == 4) {
+        MlasConvWinogradTransformFilterTile<4>(Parameters, Filter, TransformedFilter);
+    } else {
+        MlasConvWinogradTransformFilterTile<2>(Parameters, Filter, TransformedFilter);
+    }
+}
@@ -0,0 +1,352 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+#include <cmath>
+#include <cstring>
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// Returns the node that produces an input of the node if the node is its only consumer and they are on the same
+// execution provider, or nullptr.
+const Node* GetOnlyProducer(const Graph& graph, const Node& node, int input_index) {
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() != input_index) {
+      continue;
+    }
+    const Node& input_node = it->GetNode();
+    if (input_node.GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(input_node) ||
+        input_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      return nullptr;
+    }
+    return &input_node;
+  }
+  return nullptr;
+}
+
+bool IsOp(const Node* node, const std::string& op_type, int version) {
+  return node != nullptr && graph_utils::IsSupportedOptypeVersionAndDomain(*node, op_type, version);
+}
+
+bool IsMatMul(const Node* node) {
+  return IsOp(node, "MatMul", 1) || IsOp(node, "MatMul", 9);
+}
+
+bool IsTranspose(const Node* node, const std::vector<int64_t>& perm) {
+  std::vector<int64_t> node_perm;
+  return IsOp(node, "Transpose", 1) && graph_utils::GetRepeatedNodeAttributeValues(*node, "perm", node_perm) &&
+         node_perm == perm;
+}
+
+// Returns true if the input is an int64 constant, such as the shape of a Reshape, and stores its values.
+bool GetInt64Constant(const Graph& graph, const NodeArg* input_def, std::vector<int64_t>& values) {
+  const TensorProto* tensor_proto = nullptr;
+  if (!graph.GetInitializedTensor(input_def->Name(), tensor_proto) ||
+      tensor_proto->data_type() != TensorProto_DataType_INT64) {
+    return false;
+  }
+  if (tensor_proto->has_raw_data()) {
+    const std::string& raw_data = tensor_proto->raw_data();
+    values.resize(raw_data.size() / sizeof(int64_t));
+    memcpy(values.data(), raw_data.data(), values.size() * sizeof(int64_t));
+  } else {
+    values.assign(tensor_proto->int64_data().begin(), tensor_proto->int64_data().end());
+  }
+  return true;
+}
+
+// Returns true if a value of the target shape of a Reshape keeps the input dimension at the same index: 0 copies
+// it, -1 infers it and a positive value must match it.
+bool KeepsDim(int64_t value, const TensorShapeProto_Dimension& dim) {
+  return value == 0 || value == -1 || optimizer_utils::IsDimValue(dim, value);
+}
+
+// Returns true if the mask is known to broadcast to [batch, 1, sequence, sequence] as required by the Attention
+// kernel, given the [batch, sequence, hidden_size] shape of X.
+bool IsSupportedMask(const NodeArg* mask_def, const TensorShapeProto& x_shape) {
+  const auto* mask_type = mask_def->Type();
+  const auto* mask_shape = mask_def->Shape();
+  if (mask_type == nullptr || *mask_type != "tensor(float)" || mask_shape == nullptr ||
+      mask_shape->dim_size() < 1 || mask_shape->dim_size() > 4) {
+    return false;
+  }
+
+  // dimension i of the mask shape left padded with ones to rank 4
+  const int padding = 4 - mask_shape->dim_size();
+  TensorShapeProto_Dimension one;
+  one.set_dim_value(1);
+  const auto dim = [&](int i) -> const TensorShapeProto_Dimension& {
+    return i < padding ? one : mask_shape->dim(i - padding);
+  };
+
+  return (optimizer_utils::IsDimValue(dim(0), 1) || optimizer_utils::IsSameDim(dim(0), x_shape.dim(0))) &&
+         optimizer_utils::IsDimValue(dim(1), 1) &&
+         (optimizer_utils::IsDimValue(dim(2), 1) || optimizer_utils::IsSameDim(dim(2), x_shape.dim(1))) &&
+         optimizer_utils::IsSameDim(dim(3), x_shape.dim(1));
+}
+
+// The projection of X to the heads of Q, K or V: Reshape(MatMul(X, weight) + bias) to
+// [batch, sequence, num_heads, head_size]. The Add of the bias is optional.
+struct HeadProjection {
+  const Node* matmul_node;
+  const Node* bias_node;
+  const Node* reshape_node;
+  const NodeArg* weight_def;
+  const NodeArg* bias_def;
+  int64_t num_heads;
+  int64_t head_size;
+};
+
+// Matches the projection that produces the input of the Transpose that moves the heads first.
+bool MatchHeadProjection(const Graph& graph, const Node& transpose_node, HeadProjection& projection) {
+  const Node* reshape_node = GetOnlyProducer(graph, transpose_node, 0);
+  if (!IsOp(reshape_node, "Reshape", 5)) {
+    return false;
+  }
+
+  const Node* matmul_node = GetOnlyProducer(graph, *reshape_node, 0);
+  const Node* bias_node = nullptr;
+  const NodeArg* bias_def = nullptr;
+  if (IsOp(matmul_node, "Add", 7)) {
+    bias_node = matmul_node;
+    matmul_node = nullptr;
+    for (int i = 0; i < 2 && matmul_node == nullptr; i++) {
+      const Node* input_node = GetOnlyProducer(graph, *bias_node, i);
+      if (IsMatMul(input_node)) {
+        matmul_node = input_node;
+        bias_def = bias_node->InputDefs()[1 - i];
+      }
+    }
+  }
+  if (!IsMatMul(matmul_node)) {
+    return false;
+  }
+
+  // X is [batch, sequence, hidden_size], the weight is a constant [hidden_size, hidden_size] and the bias a
+  // constant [hidden_size].
+  const NodeArg* x_def = matmul_node->InputDefs()[0];
+  const NodeArg* weight_def = matmul_node->InputDefs()[1];
+  const auto* x_type = x_def->Type();
+  const auto* x_shape = x_def->Shape();
+  const TensorProto* weight_proto = optimizer_utils::GetConstantFloatInput(graph, weight_def);
+  if (x_type == nullptr || *x_type != "tensor(float)" || x_shape == nullptr || x_shape->dim_size() != 3 ||
+      weight_proto == nullptr || weight_proto->dims_size() != 2 || weight_proto->dims(0) != weight_proto->dims(1)) {
+    return false;
+  }
+  const int64_t hidden_size = weight_proto->dims(0);
+
+  if (bias_def != nullptr) {
+    const TensorProto* bias_proto = optimizer_utils::GetConstantFloatInput(graph, bias_def);
+    if (bias_proto == nullptr || bias_proto->dims_size() != 1 || bias_proto->dims(0) != hidden_size) {
+      return false;
+    }
+  }
+
+  std::vector<int64_t> shape;
+  if (!GetInt64Constant(graph, reshape_node->InputDefs()[1], shape) || shape.size() != 4 ||
+      !KeepsDim(shape[0], x_shape->dim(0)) || !KeepsDim(shape[1], x_shape->dim(1)) || shape[2] <= 0 ||
+      hidden_size % shape[2] != 0 || (shape[3] != -1 && shape[2] * shape[3] != hidden_size)) {
+    return false;
+  }
+
+  projection = {matmul_node, bias_node, reshape_node, weight_def, bias_def, shape[2], hidden_size / shape[2]};
+  return true;
+}
+}  // namespace
+
+Status AttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    // probabilities = Softmax(scores) over the key positions. Attention only has a CPU kernel, and the nodes of the
+    // subgraph are all on the execution provider of the Softmax.
+    if (!IsOp(&node, "Softmax", 1) || node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+    const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+    if (axis_attr == nullptr || (axis_attr->i() != 3 && axis_attr->i() != -1)) {
+      continue;
+    }
+
+    // scores = MatMul(Q, K') / sqrt(head_size) + mask, where the Add of the mask is optional
+    const Node* scale_node = GetOnlyProducer(graph, node, 0);
+    const Node* mask_node = nullptr;
+    const NodeArg* mask_def = nullptr;
+    if (IsOp(scale_node, "Add", 7)) {
+      mask_node = scale_node;
+      scale_node = nullptr;
+      for (int i = 0; i < 2 && scale_node == nullptr; i++) {
+        const Node* input_node = GetOnlyProducer(graph, *mask_node, i);
+        if (IsOp(input_node, "Div", 7) || IsOp(input_node, "Mul", 7)) {
+          scale_node = input_node;
+          mask_def = mask_node->InputDefs()[1 - i];
+        }
+      }
+    }
+
+    float scale;
+    int scores_index = 0;
+    if (IsOp(scale_node, "Div", 7)) {
+      float divisor;
+      if (!optimizer_utils::GetScalarConstant(graph, scale_node->InputDefs()[1], divisor) || divisor == 0.0f) {
+        continue;
+      }
+      scale = 1.0f / divisor;
+    } else if (IsOp(scale_node, "Mul", 7)) {
+      if (optimizer_utils::GetScalarConstant(graph, scale_node->InputDefs()[0], scale)) {
+        scores_index = 1;
+      } else if (!optimizer_utils::GetScalarConstant(graph, scale_node->InputDefs()[1], scale)) {
+        continue;
+      }
+    } else {
+      continue;
+    }
+
+    const Node* scores_node = GetOnlyProducer(graph, *scale_node, scores_index);
+    if (!IsMatMul(scores_node)) {
+      continue;
+    }
+
+    // Q is transposed to [batch, num_heads, sequence, head_size] and K to [batch, num_heads, head_size, sequence],
+    // either directly or by a second Transpose that swaps the last two dimensions.
+    const Node* q_transpose_node = GetOnlyProducer(graph, *scores_node, 0);
+    const Node* k_transpose_node = GetOnlyProducer(graph, *scores_node, 1);
+    const Node* k_swap_node = nullptr;
+    if (IsTranspose(k_transpose_node, {0, 1, 3, 2})) {
+      k_swap_node = k_transpose_node;
+      k_transpose_node = GetOnlyProducer(graph, *k_swap_node, 0);
+      if (!IsTranspose(k_transpose_node, {0, 2, 1, 3})) {
+        continue;
+      }
+    } else if (!IsTranspose(k_transpose_node, {0, 2, 3, 1})) {
+      continue;
+    }
+    if (!IsTranspose(q_transpose_node, {0, 2, 1, 3})) {
+      continue;
+    }
+
+    // Y = Reshape(Transpose(MatMul(probabilities, V))) to [batch, sequence, hidden_size]
+    const Node* context_node = optimizer_utils::GetOnlyConsumer(graph, node);
+    if (!IsMatMul(context_node) || context_node->InputDefs()[0] != node.OutputDefs()[0]) {
+      continue;
+    }
+    const Node* v_transpose_node = GetOnlyProducer(graph, *context_node, 1);
+    const Node* output_transpose_node = optimizer_utils::GetOnlyConsumer(graph, *context_node);
+    if (!IsTranspose(v_transpose_node, {0, 2, 1, 3}) || !IsTranspose(output_transpose_node, {0, 2, 1, 3})) {
+      continue;
+    }
+    const Node* output_node = optimizer_utils::GetOnlyConsumer(graph, *output_transpose_node);
+    if (!IsOp(output_node, "Reshape", 5)) {
+      continue;
+    }
+
+    // Q, K and V are projections of the same X with the same heads.
+    HeadProjection q;
+    HeadProjection k;
+    HeadProjection v;
+    if (!MatchHeadProjection(graph, *q_transpose_node, q) || !MatchHeadProjection(graph, *k_transpose_node, k) ||
+        !MatchHeadProjection(graph, *v_transpose_node, v)) {
+      continue;
+    }
+    const NodeArg* x_def = q.matmul_node->InputDefs()[0];
+    if (k.matmul_node->InputDefs()[0] != x_def || v.matmul_node->InputDefs()[0] != x_def ||
+        k.num_heads != q.num_heads || v.num_heads != q.num_heads || k.head_size != q.head_size ||
+        v.head_size != q.head_size) {
+      continue;
+    }
+    const int64_t num_heads = q.num_heads;
+    const int64_t head_size = q.head_size;
+    const int64_t hidden_size = num_heads * head_size;
+
+    if (std::fabs(scale * std::sqrt(static_cast<float>(head_size)) - 1.0f) > 1e-6f) {
+      continue;
+    }
+
+    const auto& x_shape = *x_def->Shape();
+    std::vector<int64_t> output_shape;
+    if (!GetInt64Constant(graph, output_node->InputDefs()[1], output_shape) || output_shape.size() != 3 ||
+        !KeepsDim(output_shape[0], x_shape.dim(0)) || !KeepsDim(output_shape[1], x_shape.dim(1)) ||
+        (output_shape[2] != -1 && output_shape[2] != hidden_size)) {
+      continue;
+    }
+
+    if (mask_def != nullptr && !IsSupportedMask(mask_def, x_shape)) {
+      continue;
+    }
+
+    // Concatenate the weights and biases of Q, K and V along the columns.
+    std::vector<float> weight(static_cast<size_t>(hidden_size * 3 * hidden_size));
+    std::vector<float> bias(static_cast<size_t>(3 * hidden_size), 0.0f);
+    const HeadProjection* projections[] = {&q, &k, &v};
+    for (int64_t p = 0; p < 3; p++) {
+      const HeadProjection& projection = *projections[p];
+
+      Initializer projection_weight{optimizer_utils::GetConstantFloatInput(graph, projection.weight_def)};
+      const float* weight_data = projection_weight.data<float>();
+      for (int64_t row = 0; row < hidden_size; row++) {
+        std::copy(weight_data + row * hidden_size, weight_data + (row + 1) * hidden_size,
+                  weight.begin() + row * 3 * hidden_size + p * hidden_size);
+      }
+
+      if (projection.bias_def != nullptr) {
+        Initializer projection_bias{optimizer_utils::GetConstantFloatInput(graph, projection.bias_def)};
+        const float* bias_data = projection_bias.data<float>();
+        std::copy(bias_data, bias_data + hidden_size, bias.begin() + p * hidden_size);
+      }
+    }
+
+    std::vector<NodeArg*> attention_input_defs{
+        graph.GetNodeArg(x_def->Name()),
+        &optimizer_utils::AddInitializer(graph, q.weight_def->Name() + "_qkv", TensorProto_DataType_FLOAT,
+                                         {hidden_size, 3 * hidden_size}, weight.data(), weight.size() * sizeof(float)),
+        &optimizer_utils::AddInitializer(graph, q.weight_def->Name() + "_qkv_bias", TensorProto_DataType_FLOAT,
+                                         {3 * hidden_size}, bias.data(), bias.size() * sizeof(float))};
+    if (mask_def != nullptr) {
+      attention_input_defs.push_back(graph.GetNodeArg(mask_def->Name()));
+    }
+
+    Node& attention_node = graph.AddNode(graph.GenerateNodeName("Attention"),
+                                         "Attention",
+                                         "fused multi-head self attention subgraph",
+                                         attention_input_defs,
+                                         graph.GetNode(output_node->Index())->MutableOutputDefs(),
+                                         nullptr,
+                                         kMSDomain);
+    attention_node.AddAttribute("num_heads", num_heads);
+    attention_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (const Node* fused_node : {q.matmul_node, q.bias_node, q.reshape_node, q_transpose_node,
+                                   k.matmul_node, k.bias_node, k.reshape_node, k_transpose_node, k_swap_node,
+                                   v.matmul_node, v.bias_node, v.reshape_node, v_transpose_node,
+                                   scores_node, scale_node, mask_node, static_cast<const Node*>(&node),
+                                   context_node, output_transpose_node, output_node}) {
+      if (fused_node != nullptr) {
+        removed_nodes.push_front(fused_node->Index());
+      }
+    }
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class AttentionFusion
+
+Fuses the multi-head self attention subgraph that frameworks export for BERT and transformer models into a single
+Attention contrib node:
+  Q, K and V = Reshape(MatMul(X, W) + B) to [batch, sequence, num_heads, head_size], transposed to heads first
+  Y = Reshape(Transpose(MatMul(Softmax(MatMul(Q, K') / sqrt(head_size) + mask), V)))
+The query, key and value weights and biases must be constants. They are concatenated into the packed weight and
+bias of the Attention node so the three projections are computed by one GEMM.
+*/
+class AttentionFusion : public onnxruntime::GraphTransformer {
+ public:
+  AttentionFusion() noexcept
+      : onnxruntime::GraphTransformer("AttentionFusion", "Fusing multi-head self attention subgraph into Attention") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <deque>
+#include <unordered_set>
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/conv_residual_add_fusion.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+bool IsFusableActivation(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", 6) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", 6) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", 6) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", 6);
+}
+
+// Returns true if both values have fully known and identical shapes, so the Add doesn't broadcast.
+bool HaveSameShape(const NodeArg& a, const NodeArg& b) {
+  const auto* a_shape = a.Shape();
+  const auto* b_shape = b.Shape();
+  if (a_shape == nullptr || b_shape == nullptr || a_shape->dim_size() != b_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < a_shape->dim_size(); i++) {
+    const auto& a_dim = a_shape->dim(i);
+    const auto& b_dim = b_shape->dim(i);
+    if (a_dim.has_dim_value() && b_dim.has_dim_value()) {
+      if (a_dim.dim_value() != b_dim.dim_value()) {
+        return false;
+      }
+    } else if (!a_dim.has_dim_param() || !b_dim.has_dim_param() || a_dim.dim_param() != b_dim.dim_param()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+}  // namespace
+
+Status ConvResidualAddFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+  std::unordered_set<onnxruntime::NodeIndex> fused_add_nodes;
+  for (auto index : order) {
+    auto& node = *graph.GetNode(index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    // FusedConv only has a CPU kernel
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", 1) ||
+        node.GetExecutionProviderType() != kCpuExecutionProvider || node.GetOutputEdgesCount() != 1 ||
+        graph.IsNodeOutputsInGraphOutputs(node)) {
+      continue;
+    }
+
+    const Node& add_node = *node.OutputNodesBegin();
+    // an Add of two Conv outputs is fused with the first of them
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(add_node, "Add", 7) ||
+        add_node.GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        fused_add_nodes.count(add_node.Index()) != 0) {
+      continue;
+    }
+
+    // the residual is the input of the Add that isn't the Conv output
+    const NodeArg* conv_output_def = node.OutputDefs()[0];
+    const auto& add_input_defs = add_node.InputDefs();
+    if (add_input_defs[0] == add_input_defs[1]) {
+      continue;
+    }
+    const int residual_index = add_input_defs[0] == conv_output_def ? 1 : 0;
+    NodeArg* residual_def = graph.GetNode(add_node.Index())->MutableInputDefs()[residual_index];
+
+    // constant Adds are folded into the bias by ConvAddFusion
+    const TensorProto* tensor_proto = nullptr;
+    const auto* residual_type = residual_def->Type();
+    if (graph.GetInitializedTensor(residual_def->Name(), tensor_proto) ||
+        residual_type == nullptr || *residual_type != "tensor(float)" ||
+        !HaveSameShape(*conv_output_def, *residual_def)) {
+      continue;
+    }
+
+    // an activation that only consumes the Add is applied after the residual
+    const Node* act_node = nullptr;
+    if (add_node.GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(add_node)) {
+      const Node& next_node = *add_node.OutputNodesBegin();
+      if (IsFusableActivation(next_node) && next_node.GetExecutionProviderType() == node.GetExecutionProviderType()) {
+        act_node = &next_node;
+      }
+    }
+
+    auto& conv_input_defs = node.MutableInputDefs();
+    std::vector<NodeArg*> fused_input_defs{conv_input_defs[0], conv_input_defs[1]};
+    fused_input_defs.push_back(conv_input_defs.size() > 2 ? conv_input_defs[2]
+                                                          : &graph.GetOrCreateNodeArg("", nullptr));
+    fused_input_defs.push_back(residual_def);
+
+    const Node& last_node = act_node != nullptr ? *act_node : add_node;
+    Node& fused_conv = graph.AddNode(graph.GenerateNodeName("fused " + node.Name()), "FusedConv",
+                                     "fused Conv " + node.Name() + " with residual Add " + add_node.Name(),
+                                     fused_input_defs,
+                                     graph.GetNode(last_node.Index())->MutableOutputDefs(),
+                                     &node.GetAttributes(),
+                                     kMSDomain);
+    fused_conv.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    if (act_node != nullptr) {
+      fused_conv.AddAttribute("activation", act_node->OpType());
+      if (act_node->OpType() == "LeakyRelu") {
+        for (const auto& attr : act_node->GetAttributes()) {
+          fused_conv.AddAttribute(attr.first, attr.second);
+        }
+      }
+      removed_nodes.push_front(act_node->Index());
+    }
+
+    fused_add_nodes.insert(add_node.Index());
+    removed_nodes.push_front(node.Index());
+    removed_nodes.push_front(add_node.Index());
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
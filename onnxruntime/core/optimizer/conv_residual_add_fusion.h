@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class ConvResidualAddFusion
+
+Fuses a Conv followed by an Add of a non-constant tensor with the shape of the Conv output, such as the skip
+connection of a residual block, into a FusedConv that takes the tensor as its Z input. An activation that is the
+only consumer of the Add is fused as well. Constant Adds are left to ConvAddFusion, which folds them into the bias.
+*/
+class ConvResidualAddFusion : public onnxruntime::GraphTransformer {
+ public:
+  ConvResidualAddFusion() noexcept
+      : onnxruntime::GraphTransformer("ConvResidualAddFusion", "Fusing residual Add and activation into Conv") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
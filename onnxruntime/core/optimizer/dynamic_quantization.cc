@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/dynamic_quantization.h"
+#include "core/optimizer/utils.h"
+#include "core/optimizer/quantization_utils.h"
+#include "core/graph/graph_utils.h"
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status DynamicQuantization::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    const bool is_matmul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 1) ||
+                           graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 9);
+    const bool is_gemm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", 7) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", 9);
+    if ((!is_matmul && !is_gemm) || node.GetExecutionProviderType() != kCpuExecutionProvider || IsExcluded(node)) {
+      continue;
+    }
+
+    auto& input_defs = node.MutableInputDefs();
+    const auto* a_type = input_defs[0]->Type();
+    if (a_type == nullptr || *a_type != "tensor(float)") {
+      continue;
+    }
+
+    const TensorProto* b_tensor_proto = optimizer_utils::GetConstantFloatInput(graph, input_defs[1]);
+    if (b_tensor_proto == nullptr || b_tensor_proto->dims_size() != 2) {
+      continue;
+    }
+
+    bool trans_b = false;
+    float alpha = 1.0f;
+    float beta = 1.0f;
+    if (is_gemm) {
+      if (graph_utils::GetIntAttribute(node, "transA", 0) != 0) {
+        continue;
+      }
+      trans_b = graph_utils::GetIntAttribute(node, "transB", 0) != 0;
+      alpha = graph_utils::GetFloatAttribute(node, "alpha", 1.0f);
+      beta = graph_utils::GetFloatAttribute(node, "beta", 1.0f);
+    }
+
+    Initializer b{b_tensor_proto};
+    const int64_t K = b.dims()[trans_b ? 1 : 0];
+    const int64_t N = b.dims()[trans_b ? 0 : 1];
+
+    // the bias must be a constant that broadcasts along the rows of the output
+    std::vector<float> bias;
+    if (is_gemm && !optimizer_utils::GetGemmRowBias(graph, node, N, beta, bias)) {
+      continue;
+    }
+
+    // B is stored as [K, N] and quantized per column, transposing the weights of Gemm if needed
+    const float* b_data = b.data<float>();
+    std::vector<int8_t> quantized_b;
+    std::vector<float> b_scale;
+    quantization_utils::QuantizeChannelsToInt8(
+        N, K, alpha,
+        [&](int64_t n, int64_t k) { return trans_b ? b_data[n * K + k] : b_data[k * N + n]; },
+        [&](int64_t n, int64_t k) { return static_cast<size_t>(k * N + n); },
+        quantized_b, b_scale);
+
+    std::vector<NodeArg*> quantized_input_defs{
+        input_defs[0],
+        &optimizer_utils::AddInitializer(graph, input_defs[1]->Name() + "_quantized", TensorProto_DataType_INT8,
+                                         {K, N}, quantized_b.data(), quantized_b.size() * sizeof(int8_t)),
+        &optimizer_utils::AddInitializer(graph, input_defs[1]->Name() + "_scale", TensorProto_DataType_FLOAT, {N},
+                                         b_scale.data(), b_scale.size() * sizeof(float))};
+
+    if (!bias.empty()) {
+      // b_zero_point is left out; the int8 weights are symmetric
+      quantized_input_defs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+      quantized_input_defs.push_back(&optimizer_utils::AddInitializer(graph, input_defs[1]->Name() + "_bias",
+                                                                      TensorProto_DataType_FLOAT, {N},
+                                                                      bias.data(), bias.size() * sizeof(float)));
+    }
+
+    Node& quantized_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_quantized"),
+                                         "DynamicQuantizeMatMul",
+                                         "dynamically quantized " + node.OpType(),
+                                         quantized_input_defs,
+                                         node.MutableOutputDefs(),
+                                         nullptr,
+                                         kMSDomain);
+    quantized_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    removed_nodes.push_front(node.Index());
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  // the float weights are removed by Graph::Resolve once nothing consumes them
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_set>
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class DynamicQuantization
+
+Rewrites float MatMul and Gemm nodes whose weights are constant initializers into DynamicQuantizeMatMul nodes.
+The weights are quantized once to int8 with a symmetric scale per output column; the activations are quantized
+to uint8 at runtime from their observed range. Gemm's alpha, beta and bias are folded into the new node.
+
+DynamicQuantizeMatMul only has a CPU kernel, so only nodes assigned to the CPU execution provider are rewritten.
+This changes the numerics of the model, so it only runs when enabled explicitly by name. Nodes can be kept in
+float by listing their names or operator types in the exclusion lists, see
+SessionOptions::dynamic_quantization_excluded_op_types.
+*/
+class DynamicQuantization : public onnxruntime::GraphTransformer {
+ public:
+  DynamicQuantization(const std::unordered_set<std::string>& excluded_op_types = {},
+                      const std::unordered_set<std::string>& excluded_node_names = {}) noexcept
+      : onnxruntime::GraphTransformer("DynamicQuantization", "Quantize the constant weights of MatMul and Gemm to int8"),
+        excluded_op_types_(excluded_op_types),
+        excluded_node_names_(excluded_node_names) {}
+
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+
+ private:
+  bool IsExcluded(const Node& node) const {
+    return excluded_op_types_.count(node.OpType()) != 0 || excluded_node_names_.count(node.Name()) != 0;
+  }
+
+  std::unordered_set<std::string> excluded_op_types_;
+  std::unordered_set<std::string> excluded_node_names_;
+};
+
+}  // namespace onnxruntime
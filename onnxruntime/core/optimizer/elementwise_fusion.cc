@@ -0,0 +1,243 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+#include <algorithm>
+#include <cfloat>
+#include <deque>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+struct ElementwiseOp {
+  const char* op_type;
+  int version;
+  const char* domain;
+};
+
+// The operators implemented by the FusedElementwise kernel.
+const ElementwiseOp kElementwiseOps[] = {
+    {"Abs", 6, kOnnxDomain}, {"Ceil", 6, kOnnxDomain}, {"Clip", 6, kOnnxDomain}, {"Erf", 9, kOnnxDomain},
+    {"Exp", 6, kOnnxDomain}, {"Floor", 6, kOnnxDomain}, {"Gelu", 1, kMSDomain}, {"LeakyRelu", 6, kOnnxDomain},
+    {"Log", 6, kOnnxDomain}, {"Neg", 6, kOnnxDomain}, {"Reciprocal", 6, kOnnxDomain}, {"Relu", 6, kOnnxDomain},
+    {"Sigmoid", 6, kOnnxDomain}, {"Sqrt", 6, kOnnxDomain}, {"Tanh", 6, kOnnxDomain}, {"Add", 7, kOnnxDomain},
+    {"Div", 7, kOnnxDomain}, {"Max", 6, kOnnxDomain}, {"Max", 8, kOnnxDomain}, {"Min", 6, kOnnxDomain},
+    {"Min", 8, kOnnxDomain}, {"Mul", 7, kOnnxDomain}, {"Pow", 7, kOnnxDomain}, {"Sub", 7, kOnnxDomain},
+};
+
+bool IsElementwiseOp(const Node& node) {
+  for (const auto& op : kElementwiseOps) {
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(node, op.op_type, op.version, op.domain)) {
+      // Max and Min are variadic, the kernel only implements them for two inputs.
+      return (node.OpType() != "Max" && node.OpType() != "Min") || node.InputDefs().size() == 2;
+    }
+  }
+  return false;
+}
+
+bool IsSameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
+  if (shape1.dim_size() != shape2.dim_size()) {
+    return false;
+  }
+  for (int i = 0; i < shape1.dim_size(); i++) {
+    if (!optimizer_utils::IsSameDim(shape1.dim(i), shape2.dim(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the kernel can read the input with the period of its size: the input shape left padded with ones
+// must be ones up to a dimension and then match the trailing dimensions of the output shape.
+bool IsBroadcastFromTrailingDims(const TensorShapeProto& input_shape, const TensorShapeProto& output_shape) {
+  const int padding = output_shape.dim_size() - input_shape.dim_size();
+  if (padding < 0) {
+    return false;
+  }
+  int first = 0;
+  while (first < input_shape.dim_size() && optimizer_utils::IsDimValue(input_shape.dim(first), 1)) {
+    first++;
+  }
+  for (int i = first; i < input_shape.dim_size(); i++) {
+    if (!optimizer_utils::IsSameDim(input_shape.dim(i), output_shape.dim(padding + i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if the node can be fused into a subgraph with the given output shape. The FusedElementwise kernel is
+// only implemented by the CPU execution provider.
+bool IsFusable(const Node& node, const TensorShapeProto& output_shape) {
+  if (!IsElementwiseOp(node) || node.GetExecutionProviderType() != kCpuExecutionProvider ||
+      node.OutputDefs().size() != 1) {
+    return false;
+  }
+  const NodeArg* output_def = node.OutputDefs()[0];
+  const auto* output_type = output_def->Type();
+  if (output_type == nullptr || *output_type != "tensor(float)" || output_def->Shape() == nullptr ||
+      !IsSameShape(*output_def->Shape(), output_shape)) {
+    return false;
+  }
+  for (const NodeArg* input_def : node.InputDefs()) {
+    if (!input_def->Exists() || input_def->Shape() == nullptr ||
+        !IsBroadcastFromTrailingDims(*input_def->Shape(), output_shape)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns true if all the consumers of the node are in the subgraph and its output is not a graph output, so the
+// node can be fused without exposing its output.
+bool IsInternalNode(const Graph& graph, const Node& node, const std::unordered_set<NodeIndex>& subgraph) {
+  if (graph.IsNodeOutputsInGraphOutputs(node)) {
+    return false;
+  }
+  for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+    if (subgraph.count((*it).Index()) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  std::unordered_map<NodeIndex, size_t> topological_order;
+  for (size_t i = 0; i < node_topology_list.size(); i++) {
+    topological_order[node_topology_list[i]] = i;
+  }
+
+  for (auto node_index : node_topology_list) {
+    ORT_RETURN_IF_ERROR(Recurse(*graph.GetNode(node_index), modified, graph_level));
+  }
+
+  // The subgraphs are grown from the last node, so the nodes are visited in reverse topological order and a node is
+  // only visited as the output of a subgraph if it was not fused into a later subgraph.
+  std::unordered_set<NodeIndex> fused_nodes;
+  for (auto it = node_topology_list.rbegin(); it != node_topology_list.rend(); ++it) {
+    const Node& node = *graph.GetNode(*it);
+    if (fused_nodes.count(node.Index()) != 0 || node.OutputDefs().size() != 1 ||
+        node.OutputDefs()[0]->Shape() == nullptr) {
+      continue;
+    }
+    const TensorShapeProto& output_shape = *node.OutputDefs()[0]->Shape();
+    if (!IsFusable(node, output_shape)) {
+      continue;
+    }
+
+    // Producers are considered from the last in topological order, so all of the consumers of a producer that may
+    // join the subgraph have joined it when the producer is considered. As only the output node of the subgraph has
+    // consumers outside of it, fusing the subgraph can't create a cycle.
+    std::unordered_set<NodeIndex> subgraph{node.Index()};
+    std::priority_queue<std::pair<size_t, NodeIndex>> candidates;
+    auto add_producers = [&](const Node& consumer) {
+      for (auto input_it = consumer.InputNodesBegin(); input_it != consumer.InputNodesEnd(); ++input_it) {
+        candidates.emplace(topological_order[(*input_it).Index()], (*input_it).Index());
+      }
+    };
+    add_producers(node);
+    while (!candidates.empty()) {
+      const Node& candidate = *graph.GetNode(candidates.top().second);
+      candidates.pop();
+      if (subgraph.count(candidate.Index()) != 0 || fused_nodes.count(candidate.Index()) != 0 ||
+          !IsFusable(candidate, output_shape) || !IsInternalNode(graph, candidate, subgraph)) {
+        continue;
+      }
+      subgraph.insert(candidate.Index());
+      add_producers(candidate);
+    }
+    if (subgraph.size() < 2) {
+      continue;
+    }
+
+    std::vector<const Node*> subgraph_nodes;
+    for (NodeIndex index : subgraph) {
+      subgraph_nodes.push_back(graph.GetNode(index));
+    }
+    std::sort(subgraph_nodes.begin(), subgraph_nodes.end(), [&](const Node* a, const Node* b) {
+      return topological_order[a->Index()] < topological_order[b->Index()];
+    });
+
+    // The values of the program are the inputs of the subgraph followed by the results of its nodes.
+    std::unordered_set<const NodeArg*> result_defs;
+    for (const Node* subgraph_node : subgraph_nodes) {
+      result_defs.insert(subgraph_node->OutputDefs()[0]);
+    }
+    std::vector<NodeArg*> input_defs;
+    std::unordered_map<const NodeArg*, int64_t> value_indices;
+    for (const Node* subgraph_node : subgraph_nodes) {
+      for (const NodeArg* input_def : subgraph_node->InputDefs()) {
+        if (result_defs.count(input_def) == 0 && value_indices.count(input_def) == 0) {
+          value_indices[input_def] = static_cast<int64_t>(input_defs.size());
+          input_defs.push_back(graph.GetNodeArg(input_def->Name()));
+        }
+      }
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    std::vector<float> alphas;
+    std::vector<float> betas;
+    for (const Node* subgraph_node : subgraph_nodes) {
+      const auto& node_input_defs = subgraph_node->InputDefs();
+      operands.push_back(value_indices[node_input_defs[0]]);
+      operands.push_back(node_input_defs.size() > 1 ? value_indices[node_input_defs[1]] : -1);
+      value_indices[subgraph_node->OutputDefs()[0]] = static_cast<int64_t>(input_defs.size() + ops.size());
+      ops.push_back(subgraph_node->OpType());
+      float alpha = 0.0f;
+      float beta = 0.0f;
+      if (subgraph_node->OpType() == "Clip") {
+        alpha = graph_utils::GetFloatAttribute(*subgraph_node, "min", -FLT_MAX);
+        beta = graph_utils::GetFloatAttribute(*subgraph_node, "max", FLT_MAX);
+      } else if (subgraph_node->OpType() == "LeakyRelu") {
+        alpha = graph_utils::GetFloatAttribute(*subgraph_node, "alpha", 0.01f);
+      }
+      alphas.push_back(alpha);
+      betas.push_back(beta);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused elementwise subgraph",
+                                     input_defs,
+                                     graph.GetNode(node.Index())->MutableOutputDefs(),
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.AddAttribute("alphas", alphas);
+    fused_node.AddAttribute("betas", betas);
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (const Node* subgraph_node : subgraph_nodes) {
+      fused_nodes.insert(subgraph_node->Index());
+      removed_nodes.push_front(subgraph_node->Index());
+    }
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
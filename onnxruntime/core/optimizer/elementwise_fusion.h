@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class ElementwiseFusion
+
+Fuses connected subgraphs of float elementwise operators into a single FusedElementwise contrib node, which evaluates
+the subgraph block by block so that the intermediate tensors are never written to memory. A subgraph is grown from
+the node producing its output: a producer joins it when all of its consumers are in the subgraph, its output has the
+shape of the subgraph output and its other inputs are scalars or broadcast from the trailing dimensions.
+*/
+class ElementwiseFusion : public onnxruntime::GraphTransformer {
+ public:
+  ElementwiseFusion() noexcept
+      : onnxruntime::GraphTransformer("ElementwiseFusion", "Fusing elementwise subgraphs into FusedElementwise") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
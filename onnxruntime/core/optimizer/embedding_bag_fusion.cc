@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+#include "core/graph/graph_utils.h"
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// Gather(table[V, D], indices[B, L]) on axis 0 produces [B, L, D]; the bag axis is 1.
+bool IsEmbeddingGather(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gather", 1)) {
+    return false;
+  }
+
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr != nullptr && axis_attr->i() != 0) {
+    return false;
+  }
+
+  const auto& input_defs = node.InputDefs();
+  const auto* table_type = input_defs[0]->Type();
+  const auto* table_shape = input_defs[0]->Shape();
+  const auto* indices_shape = input_defs[1]->Shape();
+  return table_type != nullptr && *table_type == "tensor(float)" &&
+         table_shape != nullptr && table_shape->dim_size() == 2 &&
+         indices_shape != nullptr && indices_shape->dim_size() == 2;
+}
+
+// Returns true if the node reduces the bag axis of a [B, L, D] input and drops it.
+bool IsBagReduction(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceSum", 1) &&
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", 1)) {
+    return false;
+  }
+
+  std::vector<int64_t> axes;
+  if (!graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes) || axes.size() != 1 ||
+      (axes[0] != 1 && axes[0] != -2)) {
+    return false;
+  }
+
+  // keepdims defaults to 1, which would leave a [B, 1, D] output.
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  return keepdims_attr != nullptr && keepdims_attr->i() == 0;
+}
+}  // namespace
+
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    // EmbeddingBag is only implemented by the CPU execution provider.
+    if (!IsEmbeddingGather(node) || node.GetExecutionProviderType() != kCpuExecutionProvider ||
+        node.GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(node)) {
+      continue;
+    }
+
+    const Node& next_node = *node.OutputNodesBegin();
+    if (!IsBagReduction(next_node) || next_node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+
+    Node& gather_node = node;
+    Node& reduce_node = const_cast<Node&>(next_node);
+
+    Node& embedding_bag_node = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                             "EmbeddingBag",
+                                             "fused Gather and " + reduce_node.OpType(),
+                                             gather_node.MutableInputDefs(),
+                                             reduce_node.MutableOutputDefs(),
+                                             nullptr,
+                                             kMSDomain);
+    embedding_bag_node.AddAttribute("mode", std::string(reduce_node.OpType() == "ReduceSum" ? "sum" : "mean"));
+    embedding_bag_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+    removed_nodes.push_front(gather_node.Index());
+    removed_nodes.push_front(reduce_node.Index());
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class EmbeddingBagFusion
+
+Rewrites Gather(table, indices[num_bags, bag_size]) followed by ReduceSum/ReduceMean over the bag axis into a
+single EmbeddingBag node, so the gathered rows are pooled directly into the output.
+*/
+class EmbeddingBagFusion : public onnxruntime::GraphTransformer {
+ public:
+  EmbeddingBagFusion() noexcept : onnxruntime::GraphTransformer("EmbeddingBagFusion", "Fusing Gather and ReduceSum/ReduceMean into EmbeddingBag") {}
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,245 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/gelu_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+#include <cmath>
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// Returns the node that produces an input of the node, or nullptr if the input is not produced by a node.
+const Node* GetInputNode(const Node& node, int input_index) {
+  for (auto it = node.InputEdgesBegin(); it != node.InputEdgesEnd(); ++it) {
+    if (it->GetDstArgIndex() == input_index) {
+      return &it->GetNode();
+    }
+  }
+  return nullptr;
+}
+
+// Returns true if the input is a float constant holding a single value close to the expected value.
+bool IsScalarConstant(const Graph& graph, const NodeArg* input_def, float expected_value) {
+  float value;
+  return optimizer_utils::GetScalarConstant(graph, input_def, value) &&
+         std::fabs(value - expected_value) <= 1e-6f * expected_value;
+}
+
+// Returns the other input of a binary node if one of its inputs is the given value, or nullptr.
+const NodeArg* GetOtherInput(const Node& node, const NodeArg* input_def) {
+  const auto& input_defs = node.InputDefs();
+  if (input_defs[0] == input_def) {
+    return input_defs[1];
+  }
+  if (input_defs[1] == input_def) {
+    return input_defs[0];
+  }
+  return nullptr;
+}
+
+bool HasRank(const NodeArg* def, int rank) {
+  const auto* shape = def->Shape();
+  return shape != nullptr && shape->dim_size() == rank;
+}
+
+// Returns the Gemm or the MatMul that produces x through the Add of a bias vector, if the GELU can be applied by the
+// epilogue of a FusedGemm computing x. x must have no consumers other than the x_consumer_count GELU nodes, and
+// must be computed in float on the execution provider of the Erf node.
+const Node* GetFusableGemm(const Graph& graph, const Node& erf_node, const Node* x_node, size_t x_consumer_count,
+                           const Node*& bias_node) {
+  bias_node = nullptr;
+  if (x_node == nullptr || x_node->GetExecutionProviderType() != erf_node.GetExecutionProviderType() ||
+      x_node->GetOutputEdgesCount() != x_consumer_count || graph.IsNodeOutputsInGraphOutputs(*x_node)) {
+    return nullptr;
+  }
+  const auto* x_type = x_node->OutputDefs()[0]->Type();
+  const auto* erf_type = erf_node.OutputDefs()[0]->Type();
+  if (x_type == nullptr || erf_type == nullptr || *x_type != *erf_type) {
+    return nullptr;
+  }
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*x_node, "Gemm", 7) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(*x_node, "Gemm", 9)) {
+    return x_node;
+  }
+
+  // x = MatMul(A[M, K], B[K, N]) + bias[N]
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(*x_node, "Add", 7)) {
+    return nullptr;
+  }
+  for (int i = 0; i < 2; i++) {
+    const Node* matmul_node = GetInputNode(*x_node, i);
+    if (matmul_node == nullptr ||
+        !(graph_utils::IsSupportedOptypeVersionAndDomain(*matmul_node, "MatMul", 1) ||
+          graph_utils::IsSupportedOptypeVersionAndDomain(*matmul_node, "MatMul", 9)) ||
+        matmul_node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*matmul_node) ||
+        matmul_node->GetExecutionProviderType() != x_node->GetExecutionProviderType()) {
+      continue;
+    }
+
+    const auto& matmul_input_defs = matmul_node->InputDefs();
+    const NodeArg* bias_def = x_node->InputDefs()[1 - i];
+    const auto* matmul_type = matmul_input_defs[0]->Type();
+    if (matmul_type == nullptr || *matmul_type != "tensor(float)" || !HasRank(matmul_input_defs[0], 2) ||
+        !HasRank(matmul_input_defs[1], 2) || !HasRank(bias_def, 1)) {
+      continue;
+    }
+
+    const auto& n_dim = matmul_input_defs[1]->Shape()->dim(1);
+    const auto& bias_dim = bias_def->Shape()->dim(0);
+    if (n_dim.has_dim_value() && bias_dim.has_dim_value() && n_dim.dim_value() == bias_dim.dim_value()) {
+      bias_node = x_node;
+      return matmul_node;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+Status GeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  const float sqrt2 = std::sqrt(2.0f);
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    // Gelu and FusedGemm only have float CPU kernels
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", 9) ||
+        node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+    const auto* erf_type = node.OutputDefs()[0]->Type();
+    if (erf_type == nullptr || *erf_type != "tensor(float)") {
+      continue;
+    }
+
+    // Erf(x / sqrt(2)) or Erf(x * (1 / sqrt(2)))
+    const Node* div_node = GetInputNode(node, 0);
+    if (div_node == nullptr || div_node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*div_node) ||
+        div_node->GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+    const NodeArg* x_def = div_node->InputDefs()[0];
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*div_node, "Div", 7)) {
+      if (!IsScalarConstant(graph, div_node->InputDefs()[1], sqrt2)) {
+        continue;
+      }
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*div_node, "Mul", 7)) {
+      if (IsScalarConstant(graph, div_node->InputDefs()[0], 1.0f / sqrt2)) {
+        x_def = div_node->InputDefs()[1];
+      } else if (!IsScalarConstant(graph, div_node->InputDefs()[1], 1.0f / sqrt2)) {
+        continue;
+      }
+    } else {
+      continue;
+    }
+
+    // 1 + Erf(...)
+    const Node* add_node = optimizer_utils::GetOnlyConsumer(graph, node, "Add", 7);
+    if (add_node == nullptr) {
+      continue;
+    }
+    const NodeArg* one_def = GetOtherInput(*add_node, node.OutputDefs()[0]);
+    if (one_def == nullptr || !IsScalarConstant(graph, one_def, 1.0f)) {
+      continue;
+    }
+
+    // (x * (1 + Erf(...))) * 0.5 or (x * 0.5) * (1 + Erf(...))
+    const Node* mul_node = optimizer_utils::GetOnlyConsumer(graph, *add_node, "Mul", 7);
+    if (mul_node == nullptr) {
+      continue;
+    }
+    const NodeArg* mul_input_def = GetOtherInput(*mul_node, add_node->OutputDefs()[0]);
+    const Node* half_node = nullptr;
+    const Node* output_node = nullptr;
+    if (mul_input_def == x_def) {
+      half_node = optimizer_utils::GetOnlyConsumer(graph, *mul_node, "Mul", 7);
+      output_node = half_node;
+      if (half_node == nullptr) {
+        continue;
+      }
+      const NodeArg* half_def = GetOtherInput(*half_node, mul_node->OutputDefs()[0]);
+      if (half_def == nullptr || !IsScalarConstant(graph, half_def, 0.5f)) {
+        continue;
+      }
+    } else if (mul_input_def != nullptr) {
+      half_node = GetInputNode(*mul_node, mul_node->InputDefs()[0] == mul_input_def ? 0 : 1);
+      output_node = mul_node;
+      if (half_node == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*half_node, "Mul", 7) ||
+          half_node->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+          half_node->GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(*half_node)) {
+        continue;
+      }
+      const NodeArg* half_def = GetOtherInput(*half_node, x_def);
+      if (half_def == nullptr || !IsScalarConstant(graph, half_def, 0.5f)) {
+        continue;
+      }
+    } else {
+      continue;
+    }
+
+    // x is consumed by the Div and by one of the Mul nodes.
+    const Node* x_node = GetInputNode(*div_node, div_node->InputDefs()[0] == x_def ? 0 : 1);
+    const Node* bias_node = nullptr;
+    const Node* gemm_node = GetFusableGemm(graph, node, x_node, 2, bias_node);
+
+    auto& output_defs = graph.GetNode(output_node->Index())->MutableOutputDefs();
+    if (gemm_node != nullptr) {
+      Node& mutable_gemm_node = *graph.GetNode(gemm_node->Index());
+      std::vector<NodeArg*> gemm_input_defs = mutable_gemm_node.MutableInputDefs();
+      if (bias_node != nullptr) {
+        const auto& bias_input_defs = bias_node->InputDefs();
+        gemm_input_defs.push_back(graph.GetNodeArg(
+            (bias_input_defs[0] == gemm_node->OutputDefs()[0] ? bias_input_defs[1] : bias_input_defs[0])->Name()));
+      }
+
+      Node& fused_gemm_node = graph.AddNode(graph.GenerateNodeName("FusedGemm"),
+                                            "FusedGemm",
+                                            "fused " + gemm_node->OpType() + " and Gelu",
+                                            gemm_input_defs,
+                                            output_defs,
+                                            bias_node == nullptr ? &gemm_node->GetAttributes() : nullptr,
+                                            kMSDomain);
+      fused_gemm_node.AddAttribute("activation", std::string("Gelu"));
+      fused_gemm_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+      removed_nodes.push_front(gemm_node->Index());
+      if (bias_node != nullptr) {
+        removed_nodes.push_front(bias_node->Index());
+      }
+    } else {
+      Node& gelu_node = graph.AddNode(graph.GenerateNodeName("Gelu"),
+                                      "Gelu",
+                                      "fused Erf based GELU subgraph",
+                                      {graph.GetNodeArg(x_def->Name())},
+                                      output_defs,
+                                      nullptr,
+                                      kMSDomain);
+      gelu_node.SetExecutionProviderType(node.GetExecutionProviderType());
+    }
+
+    for (const Node* fused_node : {div_node, static_cast<const Node*>(&node), add_node, mul_node, half_node}) {
+      removed_nodes.push_front(fused_node->Index());
+    }
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
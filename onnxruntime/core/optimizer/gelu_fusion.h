@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class GeluFusion
+
+Fuses the Div, Erf, Add, Mul and Mul chain that frameworks export for 0.5 * x * (1 + erf(x / sqrt(2))) into a
+single Gelu contrib node. The multiplication by 0.5 may be applied to x or to the product, and the division by
+sqrt(2) may be a multiplication by its reciprocal. If x is the output of a 2-D Gemm, or of a 2-D MatMul followed by
+the Add of a bias vector, that isn't used elsewhere, the GELU is applied by the epilogue of a FusedGemm instead.
+*/
+class GeluFusion : public onnxruntime::GraphTransformer {
+ public:
+  GeluFusion() noexcept
+      : onnxruntime::GraphTransformer("GeluFusion", "Fusing Erf based GELU subgraph into Gelu or FusedGemm") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
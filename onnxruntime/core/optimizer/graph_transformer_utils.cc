@@ -5,7 +5,13 @@
 #include "core/optimizer/conv_mul_fusion.h"
 #include "core/optimizer/conv_bn_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
+#include "core/optimizer/conv_residual_add_fusion.h"
 #include "core/optimizer/unsqueeze_elimination.h"
+#include "core/optimizer/embedding_bag_fusion.h"
+#include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/gelu_fusion.h"
+#include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 
 namespace onnxruntime {
 
@@ -54,6 +60,12 @@ std::vector<TransformerProviderSet> GenerateTransformers(const TransformerLevel&
       std::vector<std::string> l2_execution_providers = {onnxruntime::kCpuExecutionProvider};
       transformers.emplace_back(std::make_unique<ConvAddFusion>(), l2_execution_providers);
       transformers.emplace_back(std::make_unique<ConvMulFusion>(), l2_execution_providers);
+      transformers.emplace_back(std::make_unique<ConvResidualAddFusion>(), l2_execution_providers);
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(), l2_execution_providers);
+      transformers.emplace_back(std::make_unique<LayerNormFusion>(), l2_execution_providers);
+      transformers.emplace_back(std::make_unique<GeluFusion>(), l2_execution_providers);
+      transformers.emplace_back(std::make_unique<AttentionFusion>(), l2_execution_providers);
+      transformers.emplace_back(std::make_unique<ElementwiseFusion>(), l2_execution_providers);
     } break;
 
     default:
@@ -0,0 +1,204 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+#include <algorithm>
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+// Returns the number of trailing dimensions reduced by a ReduceMean that keeps them, or 0 if the ReduceMean
+// doesn't reduce a contiguous range of trailing dimensions of an input of known rank.
+int64_t GetTrailingReductionCount(const Node& node) {
+  const auto* keepdims_attr = graph_utils::GetNodeAttribute(node, "keepdims");
+  if (keepdims_attr != nullptr && keepdims_attr->i() == 0) {
+    return 0;
+  }
+
+  const auto* input_shape = node.InputDefs()[0]->Shape();
+  std::vector<int64_t> axes;
+  if (input_shape == nullptr || !graph_utils::GetRepeatedNodeAttributeValues(node, "axes", axes) || axes.empty()) {
+    return 0;
+  }
+
+  const int64_t rank = input_shape->dim_size();
+  std::vector<bool> reduced(static_cast<size_t>(rank), false);
+  for (int64_t axis : axes) {
+    if (axis < -rank || axis >= rank) {
+      return 0;
+    }
+    reduced[static_cast<size_t>(axis < 0 ? axis + rank : axis)] = true;
+  }
+
+  const int64_t count = static_cast<int64_t>(axes.size());
+  for (int64_t i = 0; i < rank; i++) {
+    if (reduced[static_cast<size_t>(i)] != (i >= rank - count)) {
+      return 0;
+    }
+  }
+  return count;
+}
+
+// Returns the constant operand of a binary node if it has the shape of the normalized dimensions, or nullptr.
+// Leading dimensions of size 1 are allowed as long as the constant doesn't have a higher rank than the input, so the
+// constant broadcasts the same way as the scale and bias of LayerNormalization and the output shape is unchanged.
+NodeArg* GetAffineConstant(const Graph& graph, Node& node, const NodeArg* variable_def,
+                           const std::vector<int64_t>& normalized_dims, int input_rank) {
+  auto& input_defs = node.MutableInputDefs();
+  if (input_defs[0] == input_defs[1] || (input_defs[0] != variable_def && input_defs[1] != variable_def)) {
+    return nullptr;
+  }
+  NodeArg* constant_def = input_defs[0] == variable_def ? input_defs[1] : input_defs[0];
+  const TensorProto* tensor_proto = optimizer_utils::GetConstantFloatInput(graph, constant_def);
+  if (tensor_proto == nullptr || tensor_proto->dims_size() > input_rank) {
+    return nullptr;
+  }
+
+  // compare the dimensions from the last one, treating missing dimensions as 1
+  const int rank = tensor_proto->dims_size();
+  const int normalized_rank = static_cast<int>(normalized_dims.size());
+  for (int i = 0; i < std::max(rank, normalized_rank); i++) {
+    const int64_t dim = i < rank ? tensor_proto->dims(rank - 1 - i) : 1;
+    const int64_t normalized_dim = i < normalized_rank ? normalized_dims[normalized_rank - 1 - i] : 1;
+    if (dim != normalized_dim) {
+      return nullptr;
+    }
+  }
+  return constant_def;
+}
+}  // namespace
+
+Status LayerNormFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    // mean = ReduceMean(X) over the trailing dimensions. LayerNormalization only has a CPU kernel.
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "ReduceMean", 1) ||
+        node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+    const int64_t reduction_count = GetTrailingReductionCount(node);
+    if (reduction_count == 0) {
+      continue;
+    }
+
+    // the normalized dimensions must be known to check the scale and bias
+    NodeArg* input_def = node.MutableInputDefs()[0];
+    const auto* input_shape = input_def->Shape();
+    const int input_rank = input_shape->dim_size();
+    std::vector<int64_t> normalized_dims;
+    for (int i = input_rank - static_cast<int>(reduction_count); i < input_rank; i++) {
+      const auto& dim = input_shape->dim(i);
+      if (!dim.has_dim_value() || dim.dim_value() <= 0) {
+        break;
+      }
+      normalized_dims.push_back(dim.dim_value());
+    }
+    if (static_cast<int64_t>(normalized_dims.size()) != reduction_count) {
+      continue;
+    }
+
+    // d = Sub(X, mean)
+    const Node* sub_node = optimizer_utils::GetOnlyConsumer(graph, node, "Sub", 7);
+    if (sub_node == nullptr || sub_node->InputDefs()[0] != input_def ||
+        sub_node->GetOutputEdgesCount() != 2 || graph.IsNodeOutputsInGraphOutputs(*sub_node)) {
+      continue;
+    }
+
+    // d is consumed by Pow(d, 2) and by Div(d, stddev)
+    const Node* pow_node = nullptr;
+    const Node* div_node = nullptr;
+    for (auto it = sub_node->OutputNodesBegin(); it != sub_node->OutputNodesEnd(); ++it) {
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(*it, "Pow", 7)) {
+        pow_node = &*it;
+      } else if (graph_utils::IsSupportedOptypeVersionAndDomain(*it, "Div", 7)) {
+        div_node = &*it;
+      }
+    }
+    float exponent;
+    if (pow_node == nullptr || div_node == nullptr ||
+        pow_node->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        div_node->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+        div_node->InputDefs()[0] != sub_node->OutputDefs()[0] ||
+        !optimizer_utils::GetScalarConstant(graph, pow_node->InputDefs()[1], exponent) || exponent != 2.0f) {
+      continue;
+    }
+
+    // variance = ReduceMean(d ^ 2) over the same dimensions
+    const Node* variance_node = optimizer_utils::GetOnlyConsumer(graph, *pow_node, "ReduceMean", 1);
+    if (variance_node == nullptr || GetTrailingReductionCount(*variance_node) != reduction_count) {
+      continue;
+    }
+
+    // stddev = Sqrt(variance + epsilon)
+    const Node* epsilon_node = optimizer_utils::GetOnlyConsumer(graph, *variance_node, "Add", 7);
+    if (epsilon_node == nullptr) {
+      continue;
+    }
+    const auto& epsilon_input_defs = epsilon_node->InputDefs();
+    float epsilon;
+    const NodeArg* epsilon_def = epsilon_input_defs[epsilon_input_defs[0] == variance_node->OutputDefs()[0] ? 1 : 0];
+    if (!optimizer_utils::GetScalarConstant(graph, epsilon_def, epsilon)) {
+      continue;
+    }
+    const Node* sqrt_node = optimizer_utils::GetOnlyConsumer(graph, *epsilon_node, "Sqrt", 6);
+    if (sqrt_node == nullptr || div_node->InputDefs()[1] != sqrt_node->OutputDefs()[0]) {
+      continue;
+    }
+
+    // Y = d / stddev * scale + B
+    const Node* scale_node = optimizer_utils::GetOnlyConsumer(graph, *div_node, "Mul", 7);
+    if (scale_node == nullptr) {
+      continue;
+    }
+    const Node* bias_node = optimizer_utils::GetOnlyConsumer(graph, *scale_node, "Add", 7);
+    if (bias_node == nullptr) {
+      continue;
+    }
+    NodeArg* scale_def = GetAffineConstant(graph, *graph.GetNode(scale_node->Index()), div_node->OutputDefs()[0],
+                                           normalized_dims, input_rank);
+    NodeArg* bias_def = GetAffineConstant(graph, *graph.GetNode(bias_node->Index()), scale_node->OutputDefs()[0],
+                                          normalized_dims, input_rank);
+    if (scale_def == nullptr || bias_def == nullptr) {
+      continue;
+    }
+
+    Node& layer_norm_node = graph.AddNode(graph.GenerateNodeName("LayerNormalization"),
+                                          "LayerNormalization",
+                                          "fused layer normalization subgraph",
+                                          {input_def, scale_def, bias_def},
+                                          graph.GetNode(bias_node->Index())->MutableOutputDefs(),
+                                          nullptr,
+                                          kMSDomain);
+    layer_norm_node.AddAttribute("axis", -reduction_count);
+    layer_norm_node.AddAttribute("epsilon", epsilon);
+    layer_norm_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    for (const Node* fused_node : {static_cast<const Node*>(&node), sub_node, pow_node, variance_node, epsilon_node,
+                                   sqrt_node, div_node, scale_node, bias_node}) {
+      removed_nodes.push_front(fused_node->Index());
+    }
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class LayerNormFusion
+
+Fuses the ReduceMean, Sub, Pow, ReduceMean, Add, Sqrt, Div, Mul and Add chain that frameworks export for layer
+normalization into a single LayerNormalization contrib node. The epsilon must be a scalar constant and the scale
+and bias must be constants with one element per normalized element.
+*/
+class LayerNormFusion : public onnxruntime::GraphTransformer {
+ public:
+  LayerNormFusion() noexcept
+      : onnxruntime::GraphTransformer("LayerNormFusion", "Fusing layer normalization subgraph into LayerNormalization") {}
+
+ private:
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace quantization_utils {
+
+/**
+Quantizes the weights of 'channels' channels of 'channel_size' elements each to int8 with a symmetric scale per
+channel, where weight(c, i) returns element i of channel c and offset(c, i) is its position in 'quantized'. The values
+are limited to [-127, 127] so the range is symmetric around the zero point of 0. The scales are multiplied by
+'scale_multiplier'.
+*/
+template <typename WeightFn, typename OffsetFn>
+void QuantizeChannelsToInt8(int64_t channels, int64_t channel_size, float scale_multiplier,
+                            WeightFn weight, OffsetFn offset,
+                            std::vector<int8_t>& quantized, std::vector<float>& scales) {
+  quantized.resize(static_cast<size_t>(channels * channel_size));
+  scales.resize(static_cast<size_t>(channels));
+
+  for (int64_t c = 0; c < channels; c++) {
+    float max_abs = 0.0f;
+    for (int64_t i = 0; i < channel_size; i++) {
+      max_abs = std::max(max_abs, std::abs(weight(c, i)));
+    }
+
+    const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+    for (int64_t i = 0; i < channel_size; i++) {
+      const float value = std::nearbyint(weight(c, i) / scale);
+      quantized[offset(c, i)] = static_cast<int8_t>(std::max(-127.0f, std::min(127.0f, value)));
+    }
+
+    scales[static_cast<size_t>(c)] = scale * scale_multiplier;
+  }
+}
+
+}  // namespace quantization_utils
+
+}  // namespace onnxruntime
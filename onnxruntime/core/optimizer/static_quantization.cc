@@ -0,0 +1,251 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/static_quantization.h"
+#include "core/optimizer/utils.h"
+#include "core/graph/graph_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+struct QuantizationParameters {
+  float scale;
+  uint8_t zero_point;
+};
+
+// A uint8 value standing for a float tensor, with the initializers holding its scale and zero point.
+struct QuantizedValue {
+  NodeArg* value;
+  NodeArg* scale;
+  NodeArg* zero_point;
+  QuantizationParameters parameters;
+};
+
+// Chooses the asymmetric uint8 parameters that cover [min_value, max_value]. The range is extended to contain 0
+// so that zero, e.g. the padding of a convolution, is exactly representable.
+QuantizationParameters ComputeQuantizationParameters(float min_value, float max_value) {
+  min_value = std::min(min_value, 0.0f);
+  max_value = std::max(max_value, 0.0f);
+
+  const float scale = (max_value - min_value) / 255.0f;
+  if (scale == 0.0f) {
+    return {1.0f, 0};
+  }
+
+  const float zero_point = std::nearbyint(-min_value / scale);
+  return {scale, static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, zero_point)))};
+}
+
+void QuantizeValues(const float* data, size_t size, const QuantizationParameters& parameters,
+                    std::vector<uint8_t>& quantized) {
+  quantized.resize(size);
+  for (size_t i = 0; i < size; i++) {
+    const float value = std::nearbyint(data[i] / parameters.scale) + parameters.zero_point;
+    quantized[i] = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, value)));
+  }
+}
+
+QuantizedValue AddQuantizedValue(Graph& graph, const std::string& base_name, NodeArg& value,
+                                 const QuantizationParameters& parameters) {
+  return QuantizedValue{
+      &value,
+      &optimizer_utils::AddInitializer(graph, base_name + "_scale", TensorProto_DataType_FLOAT, {},
+                                       &parameters.scale, sizeof(float)),
+      &optimizer_utils::AddInitializer(graph, base_name + "_zero_point", TensorProto_DataType_UINT8, {},
+                                       &parameters.zero_point, sizeof(uint8_t)),
+      parameters};
+}
+
+// Adds the uint8 value computed from a float tensor with the calibrated range 'range'.
+QuantizedValue AddQuantizedActivation(Graph& graph, const std::string& base_name,
+                                      const std::pair<float, float>& range) {
+  TypeProto type;
+  type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_UINT8);
+  NodeArg& value = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(base_name + "_quantized"), &type);
+
+  return AddQuantizedValue(graph, base_name, value, ComputeQuantizationParameters(range.first, range.second));
+}
+
+// Quantizes the values of a float initializer with a scale and zero point for the whole tensor.
+QuantizedValue AddQuantizedInitializer(Graph& graph, const NodeArg& input_def, const TensorProto& tensor_proto) {
+  Initializer initializer{&tensor_proto};
+  const float* data = initializer.data<float>();
+  const auto size = static_cast<size_t>(initializer.size());
+  const auto minmax = std::minmax_element(data, data + size);
+  const QuantizationParameters parameters = ComputeQuantizationParameters(*minmax.first, *minmax.second);
+
+  std::vector<uint8_t> quantized_data;
+  QuantizeValues(data, size, parameters, quantized_data);
+  NodeArg& value = optimizer_utils::AddInitializer(graph, input_def.Name() + "_quantized",
+                                                   TensorProto_DataType_UINT8, initializer.dims(),
+                                                   quantized_data.data(), quantized_data.size());
+
+  return AddQuantizedValue(graph, input_def.Name(), value, parameters);
+}
+}  // namespace
+
+Status StaticQuantization::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+  std::vector<onnxruntime::NodeIndex> dequantize_nodes;
+
+  // the uint8 values that stand for float tensors, keyed by the name of the float tensor
+  std::unordered_map<std::string, QuantizedValue> quantized_values;
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    const bool is_conv = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", 1);
+    const bool is_matmul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 1) ||
+                           graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 9);
+    if ((!is_conv && !is_matmul) || node.GetExecutionProviderType() != kCpuExecutionProvider || IsExcluded(node)) {
+      continue;
+    }
+
+    auto& input_defs = node.MutableInputDefs();
+    const auto* x_type = input_defs[0]->Type();
+    if (x_type == nullptr || *x_type != "tensor(float)") {
+      continue;
+    }
+
+    const TensorProto* w_tensor_proto = optimizer_utils::GetConstantFloatInput(graph, input_defs[1]);
+    if (w_tensor_proto == nullptr || (is_conv ? w_tensor_proto->dims_size() < 3 : w_tensor_proto->dims_size() != 2)) {
+      continue;
+    }
+
+    const TensorProto* b_tensor_proto = nullptr;
+    if (is_conv && input_defs.size() > 2 && input_defs[2]->Exists()) {
+      b_tensor_proto = optimizer_utils::GetConstantFloatInput(graph, input_defs[2]);
+      if (b_tensor_proto == nullptr) {
+        continue;
+      }
+    }
+
+    // the input is either already quantized by an earlier node, or is quantized with its calibrated range
+    auto x_quantized = quantized_values.find(input_defs[0]->Name());
+    auto x_range = tensor_ranges_.find(input_defs[0]->Name());
+    if (x_quantized == quantized_values.end() && x_range == tensor_ranges_.end()) {
+      continue;
+    }
+
+    // a Relu that only consumes this node is computed by the clamp to [0, 255] of the requantization
+    Node* relu_node = nullptr;
+    if (node.GetOutputEdgesCount() == 1 && !graph.IsNodeOutputsInGraphOutputs(node)) {
+      const Node& next_node = *node.OutputNodesBegin();
+      if (graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "Relu", 6) &&
+          next_node.GetExecutionProviderType() == node.GetExecutionProviderType() &&
+          tensor_ranges_.count(next_node.OutputDefs()[0]->Name()) != 0) {
+        relu_node = graph.GetNode(next_node.Index());
+      }
+    }
+
+    NodeArg* y_def = relu_node != nullptr ? relu_node->MutableOutputDefs()[0] : node.MutableOutputDefs()[0];
+    auto y_range = tensor_ranges_.find(y_def->Name());
+    if (y_range == tensor_ranges_.end()) {
+      continue;
+    }
+
+    if (x_quantized == quantized_values.end()) {
+      const QuantizedValue x = AddQuantizedActivation(graph, input_defs[0]->Name(), x_range->second);
+      Node& quantize_node = graph.AddNode(graph.GenerateNodeName(input_defs[0]->Name() + "_QuantizeLinear"),
+                                          "QuantizeLinear",
+                                          "quantize " + input_defs[0]->Name(),
+                                          {input_defs[0], x.scale, x.zero_point},
+                                          {x.value},
+                                          nullptr,
+                                          kMSDomain);
+      quantize_node.SetExecutionProviderType(kCpuExecutionProvider);
+      x_quantized = quantized_values.emplace(input_defs[0]->Name(), x).first;
+    }
+    const QuantizedValue& x = x_quantized->second;
+
+    // the output range of a folded Relu starts at 0, so its zero point is 0
+    const QuantizedValue y = AddQuantizedActivation(graph, y_def->Name(), y_range->second);
+    const QuantizedValue w = AddQuantizedInitializer(graph, *input_defs[1], *w_tensor_proto);
+
+    std::vector<NodeArg*> quantized_input_defs{x.value, x.scale, x.zero_point,
+                                               w.value, w.scale, w.zero_point,
+                                               y.scale, y.zero_point};
+
+    if (b_tensor_proto != nullptr) {
+      // the bias is added to the 32-bit accumulators, so it is quantized with their scale and no zero point
+      Initializer b{b_tensor_proto};
+      const float b_scale = x.parameters.scale * w.parameters.scale;
+      std::vector<int32_t> quantized_b(static_cast<size_t>(b.size()));
+      for (size_t i = 0; i < quantized_b.size(); i++) {
+        quantized_b[i] = static_cast<int32_t>(std::nearbyint(b.data<float>()[i] / b_scale));
+      }
+      quantized_input_defs.push_back(&optimizer_utils::AddInitializer(graph, input_defs[2]->Name() + "_quantized",
+                                                                      TensorProto_DataType_INT32, b.dims(),
+                                                                      quantized_b.data(),
+                                                                      quantized_b.size() * sizeof(int32_t)));
+    }
+
+    Node& quantized_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_quantized"),
+                                         is_conv ? "QLinearConv" : "QLinearMatMul",
+                                         "statically quantized " + node.OpType(),
+                                         quantized_input_defs,
+                                         {y.value},
+                                         is_conv ? &node.GetAttributes() : nullptr,
+                                         kMSDomain);
+    quantized_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+    // float consumers of the output read it through a DequantizeLinear, which is dropped below if there are none
+    Node& dequantize_node = graph.AddNode(graph.GenerateNodeName(y_def->Name() + "_DequantizeLinear"),
+                                          "DequantizeLinear",
+                                          "dequantize " + y_def->Name(),
+                                          {y.value, y.scale, y.zero_point},
+                                          {y_def},
+                                          nullptr,
+                                          kMSDomain);
+    dequantize_node.SetExecutionProviderType(kCpuExecutionProvider);
+    dequantize_nodes.push_back(dequantize_node.Index());
+    quantized_values.emplace(y_def->Name(), y);
+
+    removed_nodes.push_front(node.Index());
+    if (relu_node != nullptr) {
+      removed_nodes.push_front(relu_node->Index());
+    }
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  if (!dequantize_nodes.empty()) {
+    std::unordered_set<std::string> consumed_values;
+    for (const auto& node : graph.Nodes()) {
+      for (const auto* input_def : node.InputDefs()) {
+        consumed_values.insert(input_def->Name());
+      }
+      for (const auto* input_def : node.ImplicitInputDefs()) {
+        consumed_values.insert(input_def->Name());
+      }
+    }
+
+    for (auto dequantize_index : dequantize_nodes) {
+      const Node& dequantize_node = *graph.GetNode(dequantize_index);
+      if (consumed_values.count(dequantize_node.OutputDefs()[0]->Name()) == 0 &&
+          !graph.IsNodeOutputsInGraphOutputs(dequantize_node)) {
+        graph.RemoveNode(dequantize_index);
+      }
+    }
+  }
+
+  // the float weights are removed by Graph::Resolve once nothing consumes them
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
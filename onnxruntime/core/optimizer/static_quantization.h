@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_set>
+#include "core/framework/framework_common.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class StaticQuantization
+
+Rewrites float Conv and MatMul nodes whose weights are constant initializers into QLinearConv and QLinearMatMul
+nodes that compute in uint8. The quantization parameters of the activations are derived from the ranges recorded
+by a calibration run (see SessionOptions::enable_calibration); nodes whose input or output has no recorded range
+are left in float. A Relu that is the only consumer of a quantized node is folded into it by requantizing to the
+range of the Relu output.
+
+QuantizeLinear and DequantizeLinear nodes are inserted where values cross between float and uint8 nodes. A value
+produced by a quantized node feeds the quantized nodes that consume it directly, so consecutive quantized nodes
+don't round trip through float. The quantized operators only have CPU kernels, so only nodes assigned to the CPU
+execution provider are rewritten.
+
+This changes the numerics of the model, so it is never added by default. The transformed model can be kept with
+SessionOptions::optimized_model_filepath.
+*/
+class StaticQuantization : public onnxruntime::GraphTransformer {
+ public:
+  StaticQuantization(const TensorRangeMap& tensor_ranges,
+                     const std::unordered_set<std::string>& excluded_op_types = {},
+                     const std::unordered_set<std::string>& excluded_node_names = {}) noexcept
+      : onnxruntime::GraphTransformer("StaticQuantization", "Quantize Conv and MatMul to uint8 using calibrated ranges"),
+        tensor_ranges_(tensor_ranges),
+        excluded_op_types_(excluded_op_types),
+        excluded_node_names_(excluded_node_names) {}
+
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+
+ private:
+  bool IsExcluded(const Node& node) const {
+    return excluded_op_types_.count(node.OpType()) != 0 || excluded_node_names_.count(node.Name()) != 0;
+  }
+
+  TensorRangeMap tensor_ranges_;
+  std::unordered_set<std::string> excluded_op_types_;
+  std::unordered_set<std::string> excluded_node_names_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,99 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace optimizer_utils {
+
+const TensorProto* GetConstantFloatInput(const Graph& graph, const NodeArg* input_def) {
+  const TensorProto* tensor_proto = nullptr;
+  if (!graph.GetInitializedTensor(input_def->Name(), tensor_proto) ||
+      tensor_proto->data_type() != TensorProto_DataType_FLOAT) {
+    return nullptr;
+  }
+  return tensor_proto;
+}
+
+bool GetScalarConstant(const Graph& graph, const NodeArg* input_def, float& value) {
+  const TensorProto* tensor_proto = GetConstantFloatInput(graph, input_def);
+  if (tensor_proto == nullptr) {
+    return false;
+  }
+  Initializer initializer{tensor_proto};
+  if (initializer.size() != 1) {
+    return false;
+  }
+  value = *initializer.data<float>();
+  return true;
+}
+
+const Node* GetOnlyConsumer(const Graph& graph, const Node& node) {
+  if (node.GetOutputEdgesCount() != 1 || graph.IsNodeOutputsInGraphOutputs(node)) {
+    return nullptr;
+  }
+  const Node& next_node = *node.OutputNodesBegin();
+  return next_node.GetExecutionProviderType() == node.GetExecutionProviderType() ? &next_node : nullptr;
+}
+
+const Node* GetOnlyConsumer(const Graph& graph, const Node& node, const std::string& op_type, int version) {
+  const Node* next_node = GetOnlyConsumer(graph, node);
+  if (next_node == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*next_node, op_type, version)) {
+    return nullptr;
+  }
+  return next_node;
+}
+
+bool IsDimValue(const TensorShapeProto_Dimension& dim, int64_t value) {
+  return dim.has_dim_value() && dim.dim_value() == value;
+}
+
+bool IsSameDim(const TensorShapeProto_Dimension& dim1, const TensorShapeProto_Dimension& dim2) {
+  if (dim1.has_dim_value() && dim2.has_dim_value()) {
+    return dim1.dim_value() == dim2.dim_value();
+  }
+  return dim1.has_dim_param() && dim2.has_dim_param() && dim1.dim_param() == dim2.dim_param();
+}
+
+NodeArg& AddInitializer(Graph& graph, const std::string& base_name, TensorProto_DataType data_type,
+                        const std::vector<int64_t>& dims, const void* data, size_t data_size) {
+  TensorProto tensor_proto;
+  tensor_proto.set_name(graph.GenerateNodeArgName(base_name));
+  tensor_proto.set_data_type(data_type);
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+  }
+  tensor_proto.set_raw_data(data, data_size);
+  graph.AddInitializedTensor(tensor_proto);
+  return *graph.GetNodeArg(tensor_proto.name());
+}
+
+bool GetGemmRowBias(const Graph& graph, const Node& gemm_node, int64_t N, float beta, std::vector<float>& bias) {
+  bias.clear();
+  if (beta == 0.0f) {
+    return true;
+  }
+
+  const TensorProto* c_tensor_proto = GetConstantFloatInput(graph, gemm_node.InputDefs()[2]);
+  if (c_tensor_proto == nullptr) {
+    return false;
+  }
+
+  Initializer c{c_tensor_proto};
+  if (c.size() != 1 && (c.size() != N || c.dims().back() != N)) {
+    return false;
+  }
+  bias.resize(static_cast<size_t>(N));
+  for (int64_t n = 0; n < N; n++) {
+    bias[n] = beta * c.data<float>()[c.size() == 1 ? 0 : n];
+  }
+  return true;
+}
+
+}  // namespace optimizer_utils
+
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/graph/onnx_protobuf.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace optimizer_utils {
+
+/** Return the float initializer for a node input, or nullptr if the input is not an initializer of type float. */
+const ONNX_NAMESPACE::TensorProto* GetConstantFloatInput(const Graph& graph, const NodeArg* input_def);
+
+/** Returns true if the input is a float constant holding a single value, and stores the value. */
+bool GetScalarConstant(const Graph& graph, const NodeArg* input_def, float& value);
+
+/** Return the only consumer of the node if it is on the same execution provider, or nullptr. The output of the
+    node must not be a graph output. */
+const Node* GetOnlyConsumer(const Graph& graph, const Node& node);
+
+/** Return the only consumer of the node if it is on the same execution provider and has the given op type, or
+    nullptr. */
+const Node* GetOnlyConsumer(const Graph& graph, const Node& node, const std::string& op_type, int version);
+
+/** Returns true if the dimension has the given value. */
+bool IsDimValue(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim, int64_t value);
+
+/** Returns true if the dimensions are known to be equal. */
+bool IsSameDim(const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim1,
+               const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim2);
+
+/** Add an initializer with a unique name derived from base_name and the given raw data, and return its NodeArg. */
+NodeArg& AddInitializer(Graph& graph, const std::string& base_name, ONNX_NAMESPACE::TensorProto_DataType data_type,
+                        const std::vector<int64_t>& dims, const void* data, size_t data_size);
+
+/** Compute the bias vector of N values that is equivalent to beta * C of a Gemm, for replacing the Gemm by a
+    kernel that adds a bias to each row of its output. Returns false if C is not a float constant that broadcasts
+    along the rows of the output. The bias is left empty if beta is 0. */
+bool GetGemmRowBias(const Graph& graph, const Node& gemm_node, int64_t N, float beta, std::vector<float>& bias);
+
+}  // namespace optimizer_utils
+
+}  // namespace onnxruntime
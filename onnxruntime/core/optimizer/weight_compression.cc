@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/weight_compression.h"
+#include "core/optimizer/utils.h"
+#include "core/optimizer/quantization_utils.h"
+#include "core/graph/graph_utils.h"
+#include "core/util/math.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+struct CompressedWeights {
+  std::vector<uint16_t> float16_data;
+  std::vector<int8_t> int8_data;
+  // one scale per output channel, or empty if the weights are used as is
+  std::vector<float> scales;
+};
+
+// Compresses the weights of 'channels' output channels of 'channel_size' elements each, where weight(c, i) returns
+// element i of channel c and offset(c, i) is its position in the compressed tensor. The weights are multiplied by
+// 'multiplier'. Returns false if the weights can't be represented, i.e. they overflow float16.
+template <typename WeightFn, typename OffsetFn>
+bool CompressWeights(WeightCompressionFormat format, int64_t channels, int64_t channel_size, float multiplier,
+                     WeightFn weight, OffsetFn offset, CompressedWeights& compressed) {
+  const auto size = static_cast<size_t>(channels * channel_size);
+
+  if (format == WeightCompressionFormat::Float16) {
+    // the multiplier is applied by the scale so that the rounded weights are those of the model
+    compressed.float16_data.resize(size);
+    for (int64_t c = 0; c < channels; c++) {
+      for (int64_t i = 0; i < channel_size; i++) {
+        const float value = weight(c, i);
+        if (std::abs(value) > 65504.0f) {
+          return false;
+        }
+        compressed.float16_data[offset(c, i)] = math::floatToHalf(value);
+      }
+    }
+    if (multiplier != 1.0f) {
+      compressed.scales.assign(static_cast<size_t>(channels), multiplier);
+    }
+    return true;
+  }
+
+  quantization_utils::QuantizeChannelsToInt8(channels, channel_size, multiplier, weight, offset,
+                                             compressed.int8_data, compressed.scales);
+  return true;
+}
+
+// Adds the compressed weights and their scales to the node inputs. A missing scale is passed as an empty input if
+// the bias follows it.
+void AddCompressedWeights(Graph& graph, const std::string& base_name, const std::vector<int64_t>& dims,
+                          const CompressedWeights& compressed, bool has_bias, std::vector<NodeArg*>& input_defs) {
+  if (!compressed.float16_data.empty()) {
+    input_defs.push_back(&optimizer_utils::AddInitializer(graph, base_name + "_float16", TensorProto_DataType_FLOAT16,
+                                                          dims, compressed.float16_data.data(),
+                                                          compressed.float16_data.size() * sizeof(uint16_t)));
+  } else {
+    input_defs.push_back(&optimizer_utils::AddInitializer(graph, base_name + "_int8", TensorProto_DataType_INT8, dims,
+                                                          compressed.int8_data.data(),
+                                                          compressed.int8_data.size() * sizeof(int8_t)));
+  }
+
+  if (!compressed.scales.empty()) {
+    input_defs.push_back(&optimizer_utils::AddInitializer(graph, base_name + "_scale", TensorProto_DataType_FLOAT,
+                                                          {static_cast<int64_t>(compressed.scales.size())},
+                                                          compressed.scales.data(),
+                                                          compressed.scales.size() * sizeof(float)));
+  } else if (has_bias) {
+    input_defs.push_back(&graph.GetOrCreateNodeArg("", nullptr));
+  }
+}
+}  // namespace
+
+Status WeightCompression::ApplyImpl(Graph& graph, bool& modified, int graph_level) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::deque<onnxruntime::NodeIndex> removed_nodes;
+
+  if (format_ == WeightCompressionFormat::None) {
+    return Status::OK();
+  }
+
+  for (auto node_index : node_topology_list) {
+    auto& node = *graph.GetNode(node_index);
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level));
+
+    const bool is_matmul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 1) ||
+                           graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", 9);
+    const bool is_gemm = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", 7) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", 9);
+    const bool is_conv = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", 1);
+    if ((!is_matmul && !is_gemm && !is_conv) || node.GetExecutionProviderType() != kCpuExecutionProvider ||
+        IsExcluded(node)) {
+      continue;
+    }
+
+    auto& input_defs = node.MutableInputDefs();
+    const auto* x_type = input_defs[0]->Type();
+    if (x_type == nullptr || *x_type != "tensor(float)") {
+      continue;
+    }
+
+    const TensorProto* w_tensor_proto = optimizer_utils::GetConstantFloatInput(graph, input_defs[1]);
+    if (w_tensor_proto == nullptr || (is_conv ? w_tensor_proto->dims_size() < 3 : w_tensor_proto->dims_size() != 2)) {
+      continue;
+    }
+
+    Initializer w{w_tensor_proto};
+    const float* w_data = w.data<float>();
+    std::vector<NodeArg*> compressed_input_defs{input_defs[0]};
+    CompressedWeights compressed;
+
+    if (is_conv) {
+      // the filter keeps its shape and is compressed per output channel
+      const int64_t M = w.dims()[0];
+      const int64_t channel_size = w.size() / M;
+      if (!CompressWeights(
+              format_, M, channel_size, 1.0f,
+              [&](int64_t c, int64_t i) { return w_data[c * channel_size + i]; },
+              [&](int64_t c, int64_t i) { return static_cast<size_t>(c * channel_size + i); },
+              compressed)) {
+        continue;
+      }
+
+      const bool has_bias = input_defs.size() > 2 && input_defs[2]->Exists();
+      AddCompressedWeights(graph, input_defs[1]->Name(), w.dims(), compressed, has_bias, compressed_input_defs);
+      if (has_bias) {
+        compressed_input_defs.push_back(input_defs[2]);
+      }
+    } else {
+      bool trans_b = false;
+      float alpha = 1.0f;
+      float beta = 1.0f;
+      if (is_gemm) {
+        if (graph_utils::GetIntAttribute(node, "transA", 0) != 0) {
+          continue;
+        }
+        trans_b = graph_utils::GetIntAttribute(node, "transB", 0) != 0;
+        alpha = graph_utils::GetFloatAttribute(node, "alpha", 1.0f);
+        beta = graph_utils::GetFloatAttribute(node, "beta", 1.0f);
+      }
+
+      // B is stored as [K, N] and compressed per column, transposing the weights of Gemm if needed
+      const int64_t K = w.dims()[trans_b ? 1 : 0];
+      const int64_t N = w.dims()[trans_b ? 0 : 1];
+
+      // the bias must be a constant that broadcasts along the rows of the output
+      std::vector<float> bias;
+      if (is_gemm && !optimizer_utils::GetGemmRowBias(graph, node, N, beta, bias)) {
+        continue;
+      }
+
+      if (!CompressWeights(
+              format_, N, K, alpha,
+              [&](int64_t n, int64_t k) { return trans_b ? w_data[n * K + k] : w_data[k * N + n]; },
+              [&](int64_t n, int64_t k) { return static_cast<size_t>(k * N + n); },
+              compressed)) {
+        continue;
+      }
+
+      AddCompressedWeights(graph, input_defs[1]->Name(), {K, N}, compressed, !bias.empty(), compressed_input_defs);
+      if (!bias.empty()) {
+        compressed_input_defs.push_back(&optimizer_utils::AddInitializer(graph, input_defs[1]->Name() + "_bias",
+                                                                         TensorProto_DataType_FLOAT, {N},
+                                                                         bias.data(), bias.size() * sizeof(float)));
+      }
+    }
+
+    Node& compressed_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_compressed"),
+                                          is_conv ? "CompressedConv" : "CompressedMatMul",
+                                          "compressed weights of " + node.OpType(),
+                                          compressed_input_defs,
+                                          node.MutableOutputDefs(),
+                                          is_conv ? &node.GetAttributes() : nullptr,
+                                          kMSDomain);
+    compressed_node.SetExecutionProviderType(kCpuExecutionProvider);
+
+    removed_nodes.push_front(node.Index());
+  }
+
+  // Have to remove node in reversed order for now to walk around the issue in RemoveNode
+  for (auto it = removed_nodes.begin(); it != removed_nodes.end(); ++it) {
+    graph.RemoveNode(*it);
+  }
+
+  // the float weights are removed by Graph::Resolve once nothing consumes them
+  if (!removed_nodes.empty()) {
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
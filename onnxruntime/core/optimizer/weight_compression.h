@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <unordered_set>
+#include "core/framework/framework_common.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class WeightCompression
+
+Rewrites float MatMul, Gemm and Conv nodes whose weights are constant initializers into CompressedMatMul and
+CompressedConv nodes, which keep the weights as float16 or as int8 with a symmetric scale per output channel.
+The kernels expand the weights to float inside the GEMM packing, so the float weights are dropped from the graph
+and never held in memory. Gemm's alpha, beta and bias are folded into the new node. The compressed operators only
+have CPU kernels, so only nodes assigned to the CPU execution provider are rewritten.
+
+This rounds the weights, so it only runs when SessionOptions::weight_compression is set or when registered
+explicitly. Nodes can be kept in float by listing their names or operator types in the exclusion lists.
+*/
+class WeightCompression : public onnxruntime::GraphTransformer {
+ public:
+  WeightCompression(WeightCompressionFormat format,
+                    const std::unordered_set<std::string>& excluded_op_types = {},
+                    const std::unordered_set<std::string>& excluded_node_names = {}) noexcept
+      : onnxruntime::GraphTransformer("WeightCompression", "Store the constant weights of MatMul, Gemm and Conv compressed"),
+        format_(format),
+        excluded_op_types_(excluded_op_types),
+        excluded_node_names_(excluded_node_names) {}
+
+  Status ApplyImpl(onnxruntime::Graph& graph, bool& modified, int graph_level) const override;
+
+ private:
+  bool IsExcluded(const Node& node) const {
+    return excluded_op_types_.count(node.OpType()) != 0 || excluded_node_names_.count(node.Name()) != 0;
+  }
+
+  WeightCompressionFormat format_;
+  std::unordered_set<std::string> excluded_op_types_;
+  std::unordered_set<std::string> excluded_node_names_;
+};
+
+}  // namespace onnxruntime
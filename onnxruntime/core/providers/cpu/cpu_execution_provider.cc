@@ -6,6 +6,7 @@
 #include "core/framework/kernel_registry.h"
 #include "contrib_ops/contrib_kernels.h"
 #include "core/framework/compute_capability.h"
+#include "core/providers/cpu/nn/conv_autotuner.h"
 
 namespace onnxruntime {
 
@@ -272,6 +273,9 @@ class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain,
 // Opset 10
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, StringNormalizer);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, TopK);
+class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, float, Resize);
+class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, int32_t, Resize);
+class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, uint8_t, Resize);
 
 void RegisterOnnxOperatorKernels(KernelRegistry& kernel_registry) {
   kernel_registry.Register(BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 6, Clip)>());
@@ -537,6 +541,9 @@ void RegisterOnnxOperatorKernels(KernelRegistry& kernel_registry) {
   // Opset 10
   kernel_registry.Register(BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, StringNormalizer)>());
   kernel_registry.Register(BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, TopK)>());
+  kernel_registry.Register(BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, float, Resize)>());
+  kernel_registry.Register(BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, int32_t, Resize)>());
+  kernel_registry.Register(BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 10, uint8_t, Resize)>());
 }
 
 // Forward declarations of ml op kernels
@@ -642,6 +649,32 @@ std::shared_ptr<KernelRegistry> GetCpuKernelRegistry() {
   return kernel_registry;
 }
 
+CPUExecutionProvider::CPUExecutionProvider(const CPUExecutionProviderInfo& info)
+    : IExecutionProvider{onnxruntime::kCpuExecutionProvider}, info_{info} {
+  if (info.enable_conv_autotuning) {
+    conv_tuning_cache_ = std::make_unique<ConvTuningCache>(info.conv_tuning_file);
+  }
+
+  DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
+                                              [](int) { return std::make_unique<CPUAllocator>(); },
+                                              std::numeric_limits<size_t>::max()};
+#ifdef USE_JEMALLOC
+  //JEMalloc already has memory pool, so just use device allocator.
+  InsertAllocator(
+      std::shared_ptr<IArenaAllocator>(
+          std::make_unique<DummyArena>(device_info.factory(0))));
+#else
+  if (info.create_arena)
+    InsertAllocator(CreateAllocator(device_info));
+  else
+    InsertAllocator(
+        std::shared_ptr<IArenaAllocator>(
+            std::make_unique<DummyArena>(device_info.factory(0))));
+#endif
+}
+
+CPUExecutionProvider::~CPUExecutionProvider() = default;
+
 std::shared_ptr<KernelRegistry> CPUExecutionProvider::GetKernelRegistry() const {
   static std::shared_ptr<KernelRegistry> kernel_registry = GetCpuKernelRegistry();
   return kernel_registry;
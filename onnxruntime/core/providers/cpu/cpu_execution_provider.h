@@ -9,10 +9,21 @@
 
 namespace onnxruntime {
 
+class ConvTuningCache;
+
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
 
+  // Allow Conv to select the Winograd algorithm for 3x3 convolutions. It is faster but doesn't round like the
+  // direct convolution, so it can be disabled when results must match another implementation exactly.
+  bool enable_winograd_conv{true};
+
+  // Time the Conv algorithms the first time each convolution shape is seen and use the fastest, instead of the
+  // heuristics of MLAS. If conv_tuning_file is set, the choices are also loaded from and saved to that file.
+  bool enable_conv_autotuning{false};
+  std::basic_string<ORTCHAR_T> conv_tuning_file;
+
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
 
@@ -25,26 +36,8 @@ using FuseRuleFn = std::function<void(const onnxruntime::GraphViewer&,
 // Logical device representation.
 class CPUExecutionProvider : public IExecutionProvider {
  public:
-  explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info)
-      : IExecutionProvider{onnxruntime::kCpuExecutionProvider} {
-    DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
-                                                [](int) { return std::make_unique<CPUAllocator>(); },
-                                                std::numeric_limits<size_t>::max()};
-#ifdef USE_JEMALLOC
-    ORT_UNUSED_PARAMETER(info);
-    //JEMalloc already has memory pool, so just use device allocator.
-    InsertAllocator(
-        std::shared_ptr<IArenaAllocator>(
-            std::make_unique<DummyArena>(device_info.factory(0))));
-#else
-    if (info.create_arena)
-      InsertAllocator(CreateAllocator(device_info));
-    else
-      InsertAllocator(
-          std::shared_ptr<IArenaAllocator>(
-              std::make_unique<DummyArena>(device_info.factory(0))));
-#endif
-  }
+  explicit CPUExecutionProvider(const CPUExecutionProviderInfo& info);
+  ~CPUExecutionProvider() override;
 
   Status CopyTensor(const Tensor&, Tensor&) const override {
     return Status(common::ONNXRUNTIME, common::FAIL, "Shouldn't reach here. CPUExecutionProvider doesn't support CopyTensor");
@@ -57,8 +50,14 @@ class CPUExecutionProvider : public IExecutionProvider {
 
   std::shared_ptr<KernelRegistry> GetKernelRegistry() const override;
 
+  const CPUExecutionProviderInfo& GetInfo() const noexcept { return info_; }
+
+  // The Conv algorithms chosen by autotuning, or nullptr if autotuning is disabled.
+  ConvTuningCache* GetConvTuningCache() const noexcept { return conv_tuning_cache_.get(); }
 
  private:
+  CPUExecutionProviderInfo info_;
+  std::unique_ptr<ConvTuningCache> conv_tuning_cache_;
   std::vector<FuseRuleFn> fuse_rules_;
 };
 }  // namespace onnxruntime
@@ -2,7 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/element_wise_ops.h"
-#include <unsupported/Eigen/SpecialFunctions>
+#include "core/providers/cpu/tensor/strided_copy.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -949,33 +950,6 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     PRelu<float>);
 
-// This is a special case version of TBroadcaster just for Expand that only has a shape as the second parameter
-template <typename T>
-struct TBroadcasterExpand {
-  TBroadcasterExpand(const Tensor& input, const std::vector<int64_t>& shape)
-      : input_tensor_(input),
-        broadcaster_(input.Shape().GetDims(), shape) {
-  }
-
-  TensorShape GetOutputShape() const { return TensorShape(broadcaster_.output_shape_); }
-  size_t GetSpanSize() const { return span_size_; }
-
-  bool IsInput0Scalar() const { return broadcaster_.iterator1_.deltas_.front() == 0; }
-
-  T NextScalar() { return *Next(); }
-
-  ConstEigenVectorMap<T> NextEigen() { return ConstEigenVectorMap<T>(Next(), span_size_); }
-
- private:
-  const T* Next() { return input_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
-
-  const Tensor& input_tensor_;
-  Broadcaster broadcaster_;
-  size_t span_size_{broadcaster_.GetSpanSize()};
-
-  const T* input_{input_tensor_.template Data<T>()};
-};
-
 template <typename T>
 Status Expand_8<T>::Compute(OpKernelContext* context) const {
   auto& tensor_shape = *context->Input<Tensor>(1);
@@ -985,19 +959,30 @@ Status Expand_8<T>::Compute(OpKernelContext* context) const {
   const int64_t* p_shape = tensor_shape.template Data<int64_t>();
   std::vector<int64_t> shape{p_shape, p_shape + tensor_shape.Shape().Size()};
 
-  TBroadcasterExpand<T> bc(*context->Input<Tensor>(0), shape);
-  TBroadcastOutput<T> output(bc.GetSpanSize(), *context->Output(0, bc.GetOutputShape()));
+  // Broadcast the input against the requested shape. Expand is then a Tile of the input, with every broadcast
+  // axis (input extent of 1) repeated to its output extent.
+  auto& input = *context->Input<Tensor>(0);
+  const auto& input_dims = input.Shape().GetDims();
+  const size_t rank = std::max(input_dims.size(), shape.size());
+  std::vector<int64_t> output_dims(rank), tile_dims(rank), repeats(rank);
+  for (size_t axis = 0; axis < rank; ++axis) {
+    const int64_t input_dim = axis + input_dims.size() >= rank ? input_dims[axis + input_dims.size() - rank] : 1;
+    const int64_t shape_dim = axis + shape.size() >= rank ? shape[axis + shape.size() - rank] : 1;
+    if (input_dim != shape_dim && input_dim != 1 && shape_dim != 1) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expand: input dimension ", input_dim,
+                             " can not be broadcast to ", shape_dim, " on axis ", axis);
+    }
+    output_dims[axis] = input_dim == 1 ? shape_dim : input_dim;
+    tile_dims[axis] = input_dim;
+    repeats[axis] = input_dim == 1 ? shape_dim : 1;
+  }
 
-  // This doesn't use BroadcastLoop since there is no second tensor, just duplicating the first
-  if (bc.IsInput0Scalar()) {
-    // Input0 being a scalar is the only special case here, since we're duplicating a single value
-    while (output)
-      output.NextEigenOutput().array() = bc.NextScalar();
-  } else {
-    // Input1 being a scalar doesn't matter (as there's no actual input1). We're still duplicating Input0 in the same sized chunks
-    while (output)
-      output.NextEigenOutput() = bc.NextEigen();
+  auto& output = *context->Output(0, TensorShape(output_dims));
+  if (output.Shape().Size() == 0) {
+    return Status::OK();
   }
+
+  TileBytes(input.template Data<T>(), output.template MutableData<T>(), tile_dims, repeats, sizeof(T));
   return Status::OK();
 }
 
@@ -1036,7 +1021,7 @@ Status Erf<float>::Compute(OpKernelContext* context) const {
   ORT_ENFORCE(X_ptr != nullptr);
   auto& X = *X_ptr;
   auto& Y = *context->Output(0, X.Shape());
-  EigenMap<float>(Y) = EigenMap<float>(X).array().erf();
+  MlasComputeErf(X.template Data<float>(), Y.template MutableData<float>(), X.Shape().Size());
 
   return Status::OK();
 }
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
@@ -47,17 +48,64 @@ class Gemm : public OpKernel {
       return Status::OK();
     T_Y* y_data = Y->template MutableData<T_Y>();
 
+    MLAS_ACTIVATION activation;
+    MLAS_SGEMM_EPILOGUE epilogue;
+    epilogue.BiasKind = MlasSgemmNoBias;
+    epilogue.Bias = nullptr;
+    epilogue.ldbias = 0;
+    epilogue.Activation = nullptr;
+
+    if (!activation_.empty()) {
+      if (activation_ == "Relu") {
+        activation.ActivationKind = MlasReluActivation;
+      } else if (activation_ == "LeakyRelu") {
+        activation.ActivationKind = MlasLeakyReluActivation;
+        activation.alpha = leaky_relu_alpha_;
+      } else if (activation_ == "Tanh") {
+        activation.ActivationKind = MlasTanhActivation;
+      } else if (activation_ == "Sigmoid") {
+        activation.ActivationKind = MlasLogisticActivation;
+      } else if (activation_ == "Gelu") {
+        activation.ActivationKind = MlasGeluActivation;
+      } else {
+        ORT_NOT_IMPLEMENTED("Not implemented fused activation: ", activation_);
+      }
+      epilogue.Activation = &activation;
+    }
+
     //bias
-    // Todo: we might should move this part into math::gemm to let eigen
-    // have better chance to further optimize it.
-    if (beta_ != 0) {
+    // A bias that isn't scaled is added by the epilogue of the GEMM to each tile of the output while it is in
+    // cache, otherwise it is broadcast to the output before the GEMM accumulates into it. MKL-DNN has no
+    // epilogue, so with it the bias is always broadcast and the activation is applied after the GEMM.
+    float beta = 0.0f;
+    auto& b_shape = B->Shape();
+
+    if (kUseSgemmEpilogue && beta_ == 1.0f) {
+      epilogue.Bias = B->template Data<T_B>();
+      // if B is (), (1,) or (1, 1), add the scalar
+      if (b_shape.Size() == 1) {
+        epilogue.BiasKind = MlasSgemmScalarBias;
+      }
+      // B is (N,) or (1, N)
+      else if (b_shape.NumDimensions() == 1 || b_shape[0] == 1) {
+        epilogue.BiasKind = MlasSgemmColumnBias;
+      }
+      // B is (M, 1)
+      else if (b_shape[1] == 1) {
+        epilogue.BiasKind = MlasSgemmRowBias;
+      }
+      // B is (M, N), no broadcast needed.
+      else {
+        epilogue.BiasKind = MlasSgemmMatrixBias;
+        epilogue.ldbias = static_cast<size_t>(N);
+      }
+    } else if (beta_ != 0) {
       auto output_mat = EigenMatrixMapRowMajor<T_Y>(
           Y->template MutableData<T_Y>(),
           M,
           N);
       output_mat.setZero();
 
-      auto& b_shape = B->Shape();
       // if B is (), (1,) or (1, 1), add the scalar
       if (b_shape.Size() == 1) {
         output_mat.array() += *(B->template Data<T_B>());
@@ -92,8 +140,11 @@ class Gemm : public OpKernel {
           output_mat += bias_mat;
         }
       }
+
+      beta = beta_;
     }
 
+#if defined(USE_MKLDNN)
     // W * x
     math::Gemm<T_X, CPUMathUtil>(
         trans_A_,
@@ -104,16 +155,42 @@ class Gemm : public OpKernel {
         alpha_,
         X->template Data<T_X>(),
         W->template Data<T_W>(),
-        beta_,
+        beta,
         y_data,
         &CPUMathUtil::Instance());
 
-    FuseActivation<T_Y>(activation_, y_data, M * N, leaky_relu_alpha_);
+    if (epilogue.Activation != nullptr) {
+      MlasActivation(epilogue.Activation, y_data, nullptr, static_cast<size_t>(M), y_data, static_cast<size_t>(N),
+                     static_cast<size_t>(N));
+    }
+#else
+    // W * x, then the bias and the activation
+    MlasSgemm(trans_A_,
+              trans_B_,
+              static_cast<size_t>(M),
+              static_cast<size_t>(N),
+              static_cast<size_t>(K),
+              alpha_,
+              X->template Data<T_X>(),
+              static_cast<size_t>(trans_A_ == CblasNoTrans ? K : M),
+              W->template Data<T_W>(),
+              static_cast<size_t>(trans_B_ == CblasNoTrans ? N : K),
+              beta,
+              y_data,
+              static_cast<size_t>(N),
+              &epilogue);
+#endif
 
     return Status::OK();
   }
 
  private:
+#if defined(USE_MKLDNN)
+  static constexpr bool kUseSgemmEpilogue = false;
+#else
+  static constexpr bool kUseSgemmEpilogue = true;
+#endif
+
   CBLAS_TRANSPOSE trans_A_;
   CBLAS_TRANSPOSE trans_B_;
   float alpha_;
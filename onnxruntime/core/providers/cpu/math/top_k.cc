@@ -21,7 +21,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
-#include <queue>
+#include <algorithm>
 using namespace std;
 namespace onnxruntime {
 
@@ -44,19 +44,99 @@ static int64_t SizeFromDim(size_t k, const vector<int64_t>& dims) {
   return r;
 }
 
+// Number of input elements a single unit of parallel work should cover before another thread is used
+static constexpr int64_t kTopKParallelGrain = 16 * 1024;
+
+// Orders (value, index) pairs so that the preferred element comes first. Ties are broken in favor of the
+// smaller index so that the results are deterministic.
+template <typename T>
+struct GreaterValueCmp {
+  explicit GreaterValueCmp(const T* data) : data_(data) {}
+  bool operator()(int64_t lhs, int64_t rhs) const {
+    return data_[lhs] > data_[rhs] || (data_[lhs] == data_[rhs] && lhs < rhs);
+  }
+  const T* data_;
+};
+
 template <typename T>
-struct ValueCmp {
-  bool operator()(
-      const pair<T, int64_t>& lhs,
-      const pair<T, int64_t>& rhs) {
-    return (
-        lhs.first > rhs.first ||
-        (lhs.first == rhs.first && lhs.second < rhs.second));
+struct LesserValueCmp {
+  explicit LesserValueCmp(const T* data) : data_(data) {}
+  bool operator()(int64_t lhs, int64_t rhs) const {
+    return data_[lhs] < data_[rhs] || (data_[lhs] == data_[rhs] && lhs < rhs);
   }
+  const T* data_;
 };
 
+// Selects the top k of the 'cols' contiguous values in 'data' using nth_element followed by a partial sort
+// of the selected range. 'indices' is scratch space of at least 'cols' elements. The selected indices are
+// left in the first k entries of 'indices'.
+template <typename T, typename Compare>
+static void SelectTopK(const T* data, int64_t cols, unsigned k, bool sorted, int64_t* indices) {
+  for (int64_t l = 0; l < cols; ++l) {
+    indices[l] = l;
+  }
+
+  Compare cmp(data);
+  if (static_cast<int64_t>(k) < cols) {
+    std::nth_element(indices, indices + k - 1, indices + cols, cmp);
+  }
+  if (sorted) {
+    std::sort(indices, indices + k, cmp);
+  }
+}
+
+// k == 1 along a contiguous axis: a vectorized reduction finds the best value and a linear scan finds its
+// first occurrence.
+template <typename T>
+static void FindTop1Contiguous(const T* data, int64_t cols, bool largest, T& value, int64_t& index) {
+  auto input_map = ConstEigenVectorArrayMap<T>(data, cols);
+  const T best = largest ? input_map.maxCoeff() : input_map.minCoeff();
+  index = std::find(data, data + cols, best) - data;
+
+  if (index == cols) {
+    // The reduction result may not compare equal to any input (e.g. NaN). Fall back to a scalar scan.
+    index = 0;
+    for (int64_t l = 1; l < cols; ++l) {
+      if (largest ? (data[l] > data[index]) : (data[l] < data[index])) {
+        index = l;
+      }
+    }
+  }
+  value = data[index];
+}
+
+// k == 1 along a strided axis: reduce across the axis while walking the inner 'block_slice' elements
+// contiguously, so each input row is touched once in memory order.
+template <typename T>
+static void FindTop1Strided(const T* data, int64_t axis_dim, int64_t block_slice, bool largest,
+                            T* values, int64_t* indices) {
+  std::copy(data, data + block_slice, values);
+  std::fill(indices, indices + block_slice, int64_t{0});
+
+  for (int64_t l = 1; l < axis_dim; ++l) {
+    const T* input = data + l * block_slice;
+    if (largest) {
+      for (int64_t j = 0; j < block_slice; ++j) {
+        if (input[j] > values[j]) {
+          values[j] = input[j];
+          indices[j] = l;
+        }
+      }
+    } else {
+      for (int64_t j = 0; j < block_slice; ++j) {
+        if (input[j] < values[j]) {
+          values[j] = input[j];
+          indices[j] = l;
+        }
+      }
+    }
+  }
+}
+
 // Core TopK implementation
-Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int axis, const unsigned k) {
+template <typename T>
+static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int axis, const unsigned k,
+                       bool largest, bool sorted) {
   const vector<int64_t>& in_dims = X->Shape().GetDims();
   // Will return axis_ as is if positive or fixes it in case it is negative
   auto axis_parsed = HandleNegativeAxis(axis, in_dims.size());
@@ -67,13 +147,6 @@ Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int
     return Status(common::ONNXRUNTIME, common::FAIL, err_msg.str());
   }
 
-  const int64_t rows = SizeToDim(axis_parsed, in_dims);
-  const int64_t cols = X->Shape().Size() / rows;
-  auto input_map = ConstEigenMatrixMapRowMajor<float>(
-      static_cast<const float*>(X->template Data<float>()),
-      rows,
-      cols);
-
   // Resize output tensors to be the same shape as the input except
   // for the specified dimension ((i.e.) axis_parsed), which will be of size k. E.x. for an input tensor
   // of shape [3, 4, 5] and k=2 with axis_parsed=1, both of these will be shape [3, 2, 5]
@@ -82,43 +155,78 @@ Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int
   auto* Values = p_op_kernel_context->Output(0, output_linear_shape);
   auto* Indices = p_op_kernel_context->Output(1, output_linear_shape);
 
-  // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
-  const int64_t reduced_cols = SizeFromDim(axis_parsed, output_linear_shape);
-  auto Values_map = EigenMatrixMapRowMajor<float>(
-      Values->template MutableData<float>(), rows, reduced_cols);
-  auto Indices_map = EigenMatrixMapRowMajor<int64_t>(
-      Indices->template MutableData<int64_t>(), rows, reduced_cols);
-
+  const int64_t rows = SizeToDim(axis_parsed, in_dims);
+  const int64_t axis_dim = in_dims[axis_parsed];
   // This is basically the number of elements within each of the "k" rows
-  const int64_t block_slice = reduced_cols / k;
-  // Sort preserving Indices
-  for (int64_t i = 0; i < rows; ++i) {
-    for (int64_t j = 0; j < block_slice; ++j) {
-      // Build a min-heap, the heap element is pair of (value, idx)
-      // the top of the heap is the smallest value
-      priority_queue<
-          pair<float, int64_t>,
-          vector<pair<float, int64_t>>,
-          ValueCmp<float>>
-          min_heap;
-      // Maintain the size of heap to be less or equal to k_, so the
-      // heap will hold the k largest Values
-      for (int64_t l = 0; l < in_dims[axis_parsed]; ++l) {
-        const auto value = input_map(i, l * block_slice + j);
-        if (min_heap.size() < k || value > min_heap.top().first) {
-          min_heap.push({value, l});
-        }
-        if (min_heap.size() > k) {
-          min_heap.pop();
+  const int64_t block_slice = SizeFromDim(axis_parsed + 1, in_dims);
+  if (rows == 0 || block_slice == 0) {
+    return Status::OK();
+  }
+
+  const T* input_data = X->template Data<T>();
+  T* values_data = Values->template MutableData<T>();
+  int64_t* indices_data = Indices->template MutableData<int64_t>();
+
+  const int64_t input_row_size = axis_dim * block_slice;
+  const int64_t output_row_size = static_cast<int64_t>(k) * block_slice;
+
+  if (k == 1 && block_slice > 1) {
+#ifdef USE_OPENMP
+#pragma omp parallel for if (rows * input_row_size >= kTopKParallelGrain)
+#endif
+    for (int64_t i = 0; i < rows; ++i) {
+      FindTop1Strided(input_data + i * input_row_size, axis_dim, block_slice, largest,
+                      values_data + i * output_row_size, indices_data + i * output_row_size);
+    }
+    return Status::OK();
+  }
+
+  // Every (row, j) pair selects independently. Group them into blocks large enough to amortize the scratch
+  // buffers and the cost of dispatching to another thread.
+  const int64_t lanes = rows * block_slice;
+  const int64_t lanes_per_block = std::max<int64_t>(1, kTopKParallelGrain / std::max<int64_t>(axis_dim, 1));
+  const int64_t lane_blocks = (lanes + lanes_per_block - 1) / lanes_per_block;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (lanes * axis_dim >= kTopKParallelGrain)
+#endif
+  for (int64_t lane_block = 0; lane_block < lane_blocks; ++lane_block) {
+    std::vector<int64_t> scratch_indices(k == 1 ? 0 : axis_dim);
+    std::vector<T> scratch_values(block_slice > 1 ? axis_dim : 0);
+
+    const int64_t lane_end = std::min(lanes, (lane_block + 1) * lanes_per_block);
+    for (int64_t lane = lane_block * lanes_per_block; lane < lane_end; ++lane) {
+      const int64_t i = lane / block_slice;
+      const int64_t j = lane % block_slice;
+
+      // Bring strided values into a contiguous buffer so the selection works on dense memory.
+      const T* lane_data = input_data + i * input_row_size + j;
+      if (block_slice > 1) {
+        for (int64_t l = 0; l < axis_dim; ++l) {
+          scratch_values[l] = lane_data[l * block_slice];
         }
+        lane_data = scratch_values.data();
+      }
+
+      T* lane_values = values_data + i * output_row_size + j;
+      int64_t* lane_indices = indices_data + i * output_row_size + j;
+
+      if (k == 1) {
+        FindTop1Contiguous(lane_data, axis_dim, largest, *lane_values, *lane_indices);
+        continue;
+      }
+
+      if (largest) {
+        SelectTopK<T, GreaterValueCmp<T>>(lane_data, axis_dim, k, sorted, scratch_indices.data());
+      } else {
+        SelectTopK<T, LesserValueCmp<T>>(lane_data, axis_dim, k, sorted, scratch_indices.data());
       }
+
       // Extract these k elements and place them in the results placeholder
-      for (int64_t l = 0; l < k; ++l) {
-        auto& pqElem = min_heap.top();
-        auto col_index = (k - l - 1) * block_slice + j;
-        Values_map(i, col_index) = pqElem.first;
-        Indices_map(i, col_index) = pqElem.second;
-        min_heap.pop();
+      for (unsigned l = 0; l < k; ++l) {
+        const int64_t index = scratch_indices[l];
+        lane_values[l * block_slice] = lane_data[index];
+        lane_indices[l * block_slice] = index;
       }
     }
   }
@@ -126,9 +234,32 @@ Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* X, const int
   return Status::OK();
 }
 
+static Status TopKDispatch(OpKernelContext* p_op_kernel_context, const Tensor* X, const int axis, const unsigned k,
+                           bool largest, bool sorted) {
+  const auto data_type = X->DataType();
+  if (data_type == DataTypeImpl::GetType<float>()) {
+    return TopKImpl<float>(p_op_kernel_context, X, axis, k, largest, sorted);
+  }
+  if (data_type == DataTypeImpl::GetType<double>()) {
+    return TopKImpl<double>(p_op_kernel_context, X, axis, k, largest, sorted);
+  }
+  if (data_type == DataTypeImpl::GetType<int32_t>()) {
+    return TopKImpl<int32_t>(p_op_kernel_context, X, axis, k, largest, sorted);
+  }
+  if (data_type == DataTypeImpl::GetType<int64_t>()) {
+    return TopKImpl<int64_t>(p_op_kernel_context, X, axis, k, largest, sorted);
+  }
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "TopK: unsupported input data type");
+}
+
+static void ReadSelectionAttributes(const OpKernelInfo& op_kernel_info, bool& largest, bool& sorted) {
+  largest = op_kernel_info.GetAttrOrDefault<int64_t>("largest", 1) == 1;
+  sorted = op_kernel_info.GetAttrOrDefault<int64_t>("sorted", 1) == 1;
+}
+
 // Opset ver - 1 to 9
 template <>
-TopK<9, float>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
+TopK<9>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
   int64_t k_temp;
   ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("k", &k_temp).IsOK());
   ORT_ENFORCE(k_temp > 0);
@@ -137,28 +268,32 @@ TopK<9, float>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_in
   int64_t axis_temp;
   ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("axis", &axis_temp).IsOK());
   axis_ = gsl::narrow_cast<int>(axis_temp);
+
+  ReadSelectionAttributes(op_kernel_info, largest_, sorted_);
 }
 
 // Opset ver - 1 to 9
 template <>
-Status TopK<9, float>::Compute(OpKernelContext* p_op_kernel_context) const {
+Status TopK<9>::Compute(OpKernelContext* p_op_kernel_context) const {
   const Tensor* X = p_op_kernel_context->Input<Tensor>(0);
   if (X == nullptr) return Status(common::ONNXRUNTIME, common::FAIL,
                                   "input count mismatch, expected 1 input - the tensor to be processed");
-  return TopKImpl(p_op_kernel_context, X, axis_, k_);
+  return TopKDispatch(p_op_kernel_context, X, axis_, k_, largest_, sorted_);
 }
 
 // Opset ver - 10
 template <>
-TopK<10, float>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
+TopK<10>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel_info) {
   int64_t axis_temp;
   ORT_ENFORCE(op_kernel_info.GetAttr<int64_t>("axis", &axis_temp).IsOK());
   axis_ = gsl::narrow_cast<int>(axis_temp);
+
+  ReadSelectionAttributes(op_kernel_info, largest_, sorted_);
 }
 
 // Opset ver - 10
 template <>
-Status TopK<10, float>::Compute(OpKernelContext* p_op_kernel_context) const {
+Status TopK<10>::Compute(OpKernelContext* p_op_kernel_context) const {
   const Tensor* X = p_op_kernel_context->Input<Tensor>(0);
   const Tensor* Y = p_op_kernel_context->Input<Tensor>(1);
   if (X == nullptr || Y == nullptr) return Status(common::ONNXRUNTIME, common::FAIL,
@@ -166,9 +301,10 @@ Status TopK<10, float>::Compute(OpKernelContext* p_op_kernel_context) const {
                                                   "the tensor to be processed and a tensor containing k value");
   const vector<int64_t>& y_shape = Y->Shape().GetDims();
   if (y_shape.size() != 1 || y_shape[0] != 1) return Status(common::ONNXRUNTIME, common::FAIL, "k tensor should be a 1D tensor of size 1");
-  unsigned parsed_input_k = gsl::narrow_cast<unsigned>(Y->template Data<int64_t>()[0]);
-  if (parsed_input_k <= 0) return Status(common::ONNXRUNTIME, common::FAIL, "value of k should be greater than 0");
-  return TopKImpl(p_op_kernel_context, X, axis_, parsed_input_k);
+  const int64_t input_k = Y->template Data<int64_t>()[0];
+  if (input_k <= 0) return Status(common::ONNXRUNTIME, common::FAIL, "value of k should be greater than 0");
+  unsigned parsed_input_k = gsl::narrow_cast<unsigned>(input_k);
+  return TopKDispatch(p_op_kernel_context, X, axis_, parsed_input_k, largest_, sorted_);
 }
 
 // Register necessary kernels
@@ -176,13 +312,14 @@ Status TopK<10, float>::Compute(OpKernelContext* p_op_kernel_context) const {
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     TopK,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
-    TopK<9, float>);
+    KernelDefBuilder().TypeConstraint("T", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<double>()}).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
+    TopK<9>);
 
+// The integer types are only allowed by the TopK schema from opset 11, which this kernel also serves.
 ONNX_CPU_OPERATOR_KERNEL(
     TopK,
     10,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
-    TopK<10, float>);
+    KernelDefBuilder().TypeConstraint("T", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<double>(), DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}).TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),
+    TopK<10>);
 
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -6,7 +6,7 @@
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
-template <int OpSet, typename T>
+template <int OpSet>
 class TopK final : public OpKernel {
  public:
   TopK(const OpKernelInfo& op_kernel_info);
@@ -16,5 +16,9 @@ class TopK final : public OpKernel {
  private:
   int axis_;
   unsigned k_;
+  // 'largest' and 'sorted' are not part of the TopK schema before opset 11, so they always take
+  // their default values for the opsets registered here. The implementation honors both.
+  bool largest_;
+  bool sorted_;
 };
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
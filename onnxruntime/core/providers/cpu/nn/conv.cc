@@ -2,16 +2,41 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/conv_impl.h"
+#include "core/providers/cpu/nn/conv_autotuner.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 
+template <>
+const float* Conv<float>::GetWinogradFilter(const MLAS_CONV_PARAMETERS& parameters,
+                                            const float* filter,
+                                            AllocatorPtr alloc,
+                                            BufferUniquePtr& buffer) const {
+  const size_t transformed_filter_size = MlasConvWinogradFilterSize(&parameters);
+
+  if (constant_filter_) {
+    std::lock_guard<OrtMutex> lock(winograd_filter_mutex_);
+    auto& transformed_filter = winograd_filters_[parameters.u.Winograd.TileSize];
+    if (transformed_filter.empty()) {
+      transformed_filter.resize(transformed_filter_size);
+      MlasConvWinogradTransformFilter(&parameters, filter, transformed_filter.data());
+    }
+    return transformed_filter.data();
+  }
+
+  buffer = BufferUniquePtr(alloc->Alloc(sizeof(float) * transformed_filter_size), BufferDeleter(alloc));
+  auto* transformed_filter = static_cast<float*>(buffer.get());
+  MlasConvWinogradTransformFilter(&parameters, filter, transformed_filter);
+  return transformed_filter;
+}
+
 template <>
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = context->Input<Tensor>(1);
-  const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
+  const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
   const int64_t M = W->Shape()[0];
@@ -46,6 +71,18 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   const float* Xdata = X->template Data<float>();
   float* Ydata = Y->template MutableData<float>();
 
+  // The residual input of a fused Add is accumulated into the output by the GEMM, before the bias and activation.
+  // The output may already share the buffer of the residual.
+  float Beta = 0.0f;
+  if (Sum != nullptr) {
+    ORT_RETURN_IF_NOT(Sum->Shape() == Y->Shape(), "Z must have the same shape as the output");
+    const float* Sumdata = Sum->template Data<float>();
+    if (Sumdata != Ydata) {
+      std::copy(Sumdata, Sumdata + Y->Shape().Size(), Ydata);
+    }
+    Beta = 1.0f;
+  }
+
   const size_t kernel_rank = kernel_shape.size();
 
   if (kernel_rank == 2 || kernel_rank == 3) {
@@ -80,14 +117,35 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     output_shape.GetDims().data(),
                     static_cast<size_t>(M / group_),
                     &Activation,
+                    Beta,
+                    enable_winograd_,
                     &WorkingBufferSize);
 
+    // Replace the algorithm selected by the heuristics with the one timed to be the fastest for this shape. A choice
+    // loaded from a tuning file that doesn't apply to this convolution leaves the heuristic choice in place.
+    if (tuning_cache_ != nullptr) {
+      const std::string key = ConvTuningCache::MakeKey(Parameters, enable_winograd_);
+      ConvAlgorithmChoice choice;
+      if (!tuning_cache_->Find(key, choice)) {
+        choice = TuneConvAlgorithm(Parameters, enable_winograd_, Xdata, W->template Data<float>(),
+                                   B != nullptr ? B->template Data<float>() : nullptr, alloc);
+        tuning_cache_->Insert(key, choice);
+      }
+      MlasConvSelectAlgorithm(&Parameters, choice.algorithm, choice.thread_count, &WorkingBufferSize);
+    }
+
     auto working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * WorkingBufferSize) : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
 
+    const float* Wdata = W->template Data<float>();
+    BufferUniquePtr transformed_filter_buffer;
+    if (Parameters.Algorithm == MlasConvAlgorithmWinograd) {
+      Wdata = GetWinogradFilter(Parameters, Wdata, alloc, transformed_filter_buffer);
+    }
+
     MlasConv(&Parameters,
              Xdata,
-             W->template Data<float>(),
+             Wdata,
              B != nullptr ? B->template Data<float>() : nullptr,
              static_cast<float*>(working_buffer.get()),
              Ydata);
@@ -105,26 +163,19 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
     float* col_buffer_data = static_cast<float*>(col_buffer.get());
 
-    TensorShape image_shape = X->Shape().Slice(1);
-    std::vector<int64_t> col_buffer_shape{kernel_dim};
-    col_buffer_shape.insert(col_buffer_shape.end(), output_shape.GetDims().begin(),
-                            output_shape.GetDims().end());
-
     for (int image_id = 0; image_id < N; ++image_id) {
       for (int group_id = 0; group_id < group_; ++group_id) {
-        math::Im2colNd<float, CPUMathUtil, StorageOrder::NCHW>()(
-            Xdata + group_id * X_offset,
-            image_shape.GetDims().data(),
-            col_buffer_shape.data(),
-            C * input_image_size,
-            col_buffer_size,
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<int>(kernel_shape.size()),
-            col_buffer_data,
-            &CPUMathUtil::Instance());
+        MlasIm2col(Xdata + group_id * X_offset,
+                   col_buffer_data,
+                   kernel_shape.size(),
+                   static_cast<size_t>(C / group_),
+                   input_shape.GetDims().data(),
+                   kernel_shape.data(),
+                   dilations.data(),
+                   pads.data(),
+                   strides.data(),
+                   output_shape.GetDims().data(),
+                   0.0f);
         math::Gemm<float, CPUMathUtil>(
             CblasNoTrans,
             CblasNoTrans,
@@ -134,7 +185,7 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
             1,
             W->template Data<float>() + group_id * W_offset,
             col_buffer_data,
-            0,
+            Beta,
             Ydata + group_id * Y_offset,
             &CPUMathUtil::Instance());
       }
@@ -18,6 +18,9 @@
 #pragma once
 
 #include "core/providers/cpu/nn/conv_base.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/platform/ort_mutex.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -25,9 +28,32 @@ template <typename T>
 class Conv : public OpKernel, public ConvBase {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), ConvBase(info) {
+    const auto* provider = info.GetExecutionProvider();
+    if (provider != nullptr && provider->Type() == kCpuExecutionProvider) {
+      const auto* cpu_provider = static_cast<const CPUExecutionProvider*>(provider);
+      enable_winograd_ = cpu_provider->GetInfo().enable_winograd_conv;
+      tuning_cache_ = cpu_provider->GetConvTuningCache();
+    }
+    const Tensor* W;
+    constant_filter_ = info.TryGetConstantInput(1, &W);
   }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Returns the filter transformed for the Winograd algorithm selected in 'parameters'. A constant filter is
+  // transformed once per tile size and cached in the kernel, otherwise it is transformed into 'buffer'.
+  const float* GetWinogradFilter(const MLAS_CONV_PARAMETERS& parameters,
+                                 const float* filter,
+                                 AllocatorPtr alloc,
+                                 BufferUniquePtr& buffer) const;
+
+  bool enable_winograd_{true};
+  bool constant_filter_{false};
+  ConvTuningCache* tuning_cache_{nullptr};
+
+  mutable OrtMutex winograd_filter_mutex_;
+  mutable std::unordered_map<size_t, std::vector<float>> winograd_filters_;
 };
 
 }  // namespace onnxruntime
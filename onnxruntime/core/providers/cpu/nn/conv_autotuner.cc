@@ -0,0 +1,210 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/nn/conv_autotuner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+
+namespace {
+const struct {
+  MLAS_CONV_ALGORITHM algorithm;
+  const char* name;
+} conv_algorithm_names[] = {
+    {MlasConvAlgorithmGemmDirect, "GemmDirect"},
+    {MlasConvAlgorithmExpandThenGemm, "ExpandThenGemm"},
+    {MlasConvAlgorithmExpandThenGemmSegmented, "ExpandThenGemmSegmented"},
+    {MlasConvAlgorithmWinograd, "Winograd"},
+};
+
+const char* GetAlgorithmName(MLAS_CONV_ALGORITHM algorithm) {
+  for (const auto& entry : conv_algorithm_names) {
+    if (entry.algorithm == algorithm) {
+      return entry.name;
+    }
+  }
+  return "";
+}
+
+bool ParseAlgorithmName(const std::string& name, MLAS_CONV_ALGORITHM& algorithm) {
+  for (const auto& entry : conv_algorithm_names) {
+    if (name == entry.name) {
+      algorithm = entry.algorithm;
+      return true;
+    }
+  }
+  return false;
+}
+
+void AppendShape(std::ostringstream& key, const char* label, const size_t* shape, size_t dimensions) {
+  key << ' ' << label;
+  for (size_t dim = 0; dim < dimensions; dim++) {
+    key << (dim == 0 ? "" : "x") << shape[dim];
+  }
+}
+
+// Number of timed runs of each candidate; the fastest run is kept to filter out preemptions.
+constexpr int kTimedRunCount = 3;
+}  // namespace
+
+ConvTuningCache::ConvTuningCache(const std::basic_string<ORTCHAR_T>& tuning_file) : tuning_file_(tuning_file) {
+  if (!tuning_file_.empty()) {
+    Load();
+  }
+}
+
+std::string ConvTuningCache::MakeKey(const MLAS_CONV_PARAMETERS& parameters, bool allow_winograd) {
+  const size_t dimensions = parameters.Dimensions;
+
+  std::ostringstream key;
+  key << MlasGetPlatformName() << '/' << MlasGetMaximumThreadCount()
+      << " n" << parameters.BatchCount
+      << " g" << parameters.GroupCount
+      << " c" << parameters.InputChannels
+      << " f" << parameters.FilterCount;
+  AppendShape(key, "i", parameters.InputShape, dimensions);
+  AppendShape(key, "k", parameters.KernelShape, dimensions);
+  AppendShape(key, "d", parameters.DilationShape, dimensions);
+  AppendShape(key, "p", parameters.Padding, dimensions * 2);
+  AppendShape(key, "s", parameters.StrideShape, dimensions);
+  key << " w" << (allow_winograd ? 1 : 0);
+  return key.str();
+}
+
+bool ConvTuningCache::Find(const std::string& key, ConvAlgorithmChoice& choice) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = choices_.find(key);
+  if (it == choices_.end()) {
+    return false;
+  }
+  choice = it->second;
+  return true;
+}
+
+void ConvTuningCache::Insert(const std::string& key, const ConvAlgorithmChoice& choice) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (!choices_.emplace(key, choice).second || tuning_file_.empty()) {
+    return;
+  }
+
+  std::ofstream file(tuning_file_, std::ios::app);
+  file << key << '\t' << GetAlgorithmName(choice.algorithm) << '\t' << choice.thread_count << '\n';
+  if (!file) {
+    LOGS_DEFAULT(WARNING) << "Failed to append the Conv tuning result for '" << key << "' to the tuning file";
+  }
+}
+
+// Each line of the tuning file holds a key, an algorithm name and a thread count separated by tabs. Lines that
+// can't be parsed, e.g. of algorithms of a newer release, are ignored and the shape is tuned again.
+void ConvTuningCache::Load() {
+  std::ifstream file(tuning_file_);
+  std::string line;
+  while (std::getline(file, line)) {
+    const auto key_end = line.find('\t');
+    const auto name_end = key_end == std::string::npos ? std::string::npos : line.find('\t', key_end + 1);
+    if (name_end == std::string::npos) {
+      continue;
+    }
+
+    ConvAlgorithmChoice choice;
+    if (!ParseAlgorithmName(line.substr(key_end + 1, name_end - key_end - 1), choice.algorithm)) {
+      continue;
+    }
+
+    std::istringstream thread_count(line.substr(name_end + 1));
+    if (!(thread_count >> choice.thread_count)) {
+      continue;
+    }
+
+    choices_[line.substr(0, key_end)] = choice;
+  }
+}
+
+ConvAlgorithmChoice TuneConvAlgorithm(const MLAS_CONV_PARAMETERS& parameters,
+                                      bool allow_winograd,
+                                      const float* input,
+                                      const float* filter,
+                                      const float* bias,
+                                      AllocatorPtr alloc) {
+  // The algorithms that rely on the threading of the GEMM take no thread count, the others are timed with
+  // thread counts doubling up to the maximum.
+  std::vector<ConvAlgorithmChoice> candidates{{MlasConvAlgorithmGemmDirect, 0},
+                                              {MlasConvAlgorithmExpandThenGemm, 0}};
+  const size_t maximum_thread_count = MlasGetMaximumThreadCount();
+  for (auto algorithm : {MlasConvAlgorithmExpandThenGemmSegmented, MlasConvAlgorithmWinograd}) {
+    if (algorithm == MlasConvAlgorithmWinograd && !allow_winograd) {
+      continue;
+    }
+    for (size_t thread_count = 1; thread_count < maximum_thread_count; thread_count *= 2) {
+      candidates.push_back({algorithm, thread_count});
+    }
+    candidates.push_back({algorithm, maximum_thread_count});
+  }
+
+  const size_t output_size =
+      parameters.BatchCount * parameters.GroupCount * parameters.FilterCount * parameters.OutputSize;
+  BufferUniquePtr output_buffer(alloc->Alloc(sizeof(float) * output_size), BufferDeleter(alloc));
+  auto* output = static_cast<float*>(output_buffer.get());
+  memset(output, 0, sizeof(float) * output_size);
+
+  ConvAlgorithmChoice best_choice{parameters.Algorithm, 0};
+  double best_time = std::numeric_limits<double>::max();
+
+  for (const auto& candidate : candidates) {
+    MLAS_CONV_PARAMETERS candidate_parameters = parameters;
+    size_t working_buffer_size;
+    if (!MlasConvSelectAlgorithm(&candidate_parameters, candidate.algorithm, candidate.thread_count,
+                                 &working_buffer_size)) {
+      continue;
+    }
+
+    BufferUniquePtr working_buffer(working_buffer_size > 0 ? alloc->Alloc(sizeof(float) * working_buffer_size)
+                                                           : nullptr,
+                                   BufferDeleter(alloc));
+
+    // The filter of a constant Winograd convolution is transformed once, so the transform isn't timed.
+    std::vector<float> transformed_filter;
+    if (candidate.algorithm == MlasConvAlgorithmWinograd) {
+      transformed_filter.resize(MlasConvWinogradFilterSize(&candidate_parameters));
+      MlasConvWinogradTransformFilter(&candidate_parameters, filter, transformed_filter.data());
+    }
+
+    auto run = [&]() {
+      MlasConv(&candidate_parameters,
+               input,
+               transformed_filter.empty() ? filter : transformed_filter.data(),
+               bias,
+               static_cast<float*>(working_buffer.get()),
+               output);
+    };
+
+    // The first run warms up the caches and the thread pool.
+    run();
+
+    double time = std::numeric_limits<double>::max();
+    for (int i = 0; i < kTimedRunCount; i++) {
+      const auto start = std::chrono::steady_clock::now();
+      run();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      time = std::min(time, elapsed.count());
+    }
+
+    if (time < best_time) {
+      best_time = time;
+      best_choice = candidate;
+    }
+  }
+
+  return best_choice;
+}
+
+}  // namespace onnxruntime
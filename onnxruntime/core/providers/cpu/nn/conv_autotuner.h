@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/ort_mutex.h"
+#include "core/session/onnxruntime_c_api.h"
+
+namespace onnxruntime {
+
+// The convolution algorithm and thread count passed to MlasConvSelectAlgorithm.
+struct ConvAlgorithmChoice {
+  MLAS_CONV_ALGORITHM algorithm;
+  size_t thread_count;
+};
+
+/**
+Caches the convolution algorithm measured to be the fastest for each convolution shape when Conv is autotuned
+(see CPUExecutionProviderInfo::enable_conv_autotuning). If a tuning file is set, the cache starts with the choices
+stored in it and each new choice is appended to it, so later processes start tuned. The keys include the kernels
+selected by MLAS for the processor and its thread count, so a tuning file can be shared by different machines.
+Find and Insert may be called concurrently by the kernels.
+*/
+class ConvTuningCache {
+ public:
+  explicit ConvTuningCache(const std::basic_string<ORTCHAR_T>& tuning_file = {});
+
+  /** Get the key of the convolution prepared by MlasConvPrepare. */
+  static std::string MakeKey(const MLAS_CONV_PARAMETERS& parameters, bool allow_winograd);
+
+  bool Find(const std::string& key, ConvAlgorithmChoice& choice) const;
+
+  /** Add the choice for a key, unless the key already has one. */
+  void Insert(const std::string& key, const ConvAlgorithmChoice& choice);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ConvTuningCache);
+
+  void Load();
+
+  const std::basic_string<ORTCHAR_T> tuning_file_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, ConvAlgorithmChoice> choices_;
+};
+
+/**
+Times every algorithm and thread count that can compute the convolution prepared in 'parameters' with the given
+inputs and returns the fastest. The outputs are written to a scratch buffer. The filter is the untransformed filter
+even if Winograd is allowed.
+*/
+ConvAlgorithmChoice TuneConvAlgorithm(const MLAS_CONV_PARAMETERS& parameters,
+                                      bool allow_winograd,
+                                      const float* input,
+                                      const float* filter,
+                                      const float* bias,
+                                      AllocatorPtr alloc);
+
+}  // namespace onnxruntime
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "core/providers/cpu/nn/conv_base.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -64,9 +65,18 @@ class ConvTransposeBase : public ConvBase {
 template <typename T>
 class ConvTranspose : public OpKernel, public ConvTransposeBase {
  public:
-  ConvTranspose(const OpKernelInfo& info) : OpKernel(info), ConvTransposeBase(info) {}
+  ConvTranspose(const OpKernelInfo& info) : OpKernel(info), ConvTransposeBase(info) {
+    const Tensor* F;
+    constant_filter_ = info.TryGetConstantInput(1, &F);
+  }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // The filter packed for MLAS is cached when the filter is a constant initializer.
+  bool constant_filter_{false};
+  mutable OrtMutex packed_filter_mutex_;
+  mutable std::vector<float> packed_filter_;
 };
 
 }  // namespace onnxruntime
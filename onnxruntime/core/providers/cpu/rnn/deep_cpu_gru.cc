@@ -159,6 +159,34 @@ using namespace rnn::detail;
 // internal helper code
 namespace detail {
 
+// Pack W [num_directions, 3*hidden_size, input_size] and R [num_directions, 3*hidden_size, hidden_size] so each
+// direction is a [input_size or hidden_size, 3*hidden_size] matrix with the gates in their original order.
+// Unlike LSTM the gates can't be tiled, as the reset gate must be complete before Ht-1 is multiplied by Rh.
+void PackGruWeights(const float* W, const float* R, int num_directions, int hidden_size, int input_size,
+                    float* packed_W, float* packed_R) {
+  for (int direction = 0; direction < num_directions; ++direction) {
+    PackGateWeights(W + direction * 3 * hidden_size * input_size, 3, hidden_size, input_size, hidden_size,
+                    packed_W + direction * 3 * hidden_size * input_size);
+    PackGateWeights(R + direction * 3 * hidden_size * hidden_size, 3, hidden_size, hidden_size, hidden_size,
+                    packed_R + direction * 3 * hidden_size * hidden_size);
+  }
+}
+
+// Quantize the weights packed by PackGruWeights to int8, one QuantizedWeights per direction. W is read by a
+// single GEMM over all the inputs, and R as Rzr and Rh.
+void QuantizeGruWeights(const float* packed_W, const float* packed_R, int num_directions, int hidden_size,
+                        int input_size, std::vector<QuantizedWeights>& quantized_W,
+                        std::vector<QuantizedWeights>& quantized_R) {
+  quantized_W.resize(num_directions);
+  quantized_R.resize(num_directions);
+  for (int direction = 0; direction < num_directions; ++direction) {
+    QuantizeWeights(packed_W + direction * 3 * hidden_size * input_size, input_size, 3 * hidden_size, {0},
+                    quantized_W[direction]);
+    QuantizeWeights(packed_R + direction * 3 * hidden_size * hidden_size, hidden_size, 3 * hidden_size,
+                    {0, 2 * hidden_size}, quantized_R[direction]);
+  }
+}
+
 /// The class represents DeepCPU implementation of a gated recurrent unit (GRU) operator.
 /// For details, refer to http://aka.ms/dl-optimization/.
 template <typename T>
@@ -177,12 +205,14 @@ class UniDirectionalGru {
                     const ActivationFuncs::Entry& activation_func_f,
                     const ActivationFuncs::Entry& activation_func_g,
                     const float clip,
+                    const RnnParallelism& parallelism,
 #ifdef USE_EIGEN_THREADPOOL
                     Eigen::NonBlockingThreadPool& ttp_);
 #else
                     TaskThreadPool& ttp_);
 #endif
 
+  // input_weights and recurrent_weights are packed by PackGruWeights
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
@@ -191,6 +221,10 @@ class UniDirectionalGru {
                gsl::span<T>& outputs,
                gsl::span<T>& final_hidden_state);
 
+  // run the GEMMs on int8 weights, quantized by QuantizeWeights from the packed weights, instead of the fp32
+  // weights given to Compute
+  void SetQuantizedWeights(const QuantizedWeights* input_weights, const QuantizedWeights* recurrent_weights);
+
   ~UniDirectionalGru() = default;
 
  private:
@@ -249,6 +283,17 @@ class UniDirectionalGru {
   gsl::span<T> inputs_reverse_;
   gsl::span<T> outputs_reverse_;
 
+  // int8 weights of the dynamically quantized operator, and the quantized rows of the left hand side of the
+  // recurrent GEMMs
+  const QuantizedWeights* quantized_input_weights_ = nullptr;
+  const QuantizedWeights* quantized_recurrent_weights_ = nullptr;
+  IAllocatorUniquePtr<uint8_t> quantized_state_ptr_, state_zero_points_ptr_;
+  IAllocatorUniquePtr<float> state_scales_ptr_;
+  IAllocatorUniquePtr<int32_t> state_products_ptr_;
+  gsl::span<uint8_t> quantized_state_, state_zero_points_;
+  gsl::span<float> state_scales_;
+  gsl::span<int32_t> state_products_;
+
   deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_ = nullptr;
 
   float zr_alpha_ = 0.f, zr_beta_ = 0.f;
@@ -259,7 +304,12 @@ class UniDirectionalGru {
   deepcpu::GruOutputGateFuncPtr output_gate_ = nullptr;
 
   void AllocateBuffers();
-  void SetNumThreads();
+  void SetNumThreads(const RnnParallelism& parallelism);
+
+  // C += A * R[:, column:column + N] for num_rows rows of A, which has hidden_size_ columns and starts at 'row'
+  // of the batch, using the int8 recurrent weights. A is quantized on each call as the GEMMs of a step read
+  // different matrices.
+  void QuantizedRecurrentGemm(int row, int num_rows, int N, const T* A, int column, T* C, int ldc);
 };
 }  // namespace detail
 
@@ -321,8 +371,34 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+
+  // use the weights packed at construction, or pack them now if they are not constant initializers.
+  // the quantized operator only keeps the int8 weights, so the fp32 spans are empty when those were prepared.
+  gsl::span<const T> input_weights = packed_input_weights_;
+  gsl::span<const T> recurrent_weights = packed_recurrent_weights_;
+  const std::vector<QuantizedWeights>* quantized_input_weights = &quantized_input_weights_;
+  const std::vector<QuantizedWeights>* quantized_recurrent_weights = &quantized_recurrent_weights_;
+
+  IAllocatorUniquePtr<T> local_packed_input_weights;
+  IAllocatorUniquePtr<T> local_packed_recurrent_weights;
+  std::vector<QuantizedWeights> local_quantized_input_weights;
+  std::vector<QuantizedWeights> local_quantized_recurrent_weights;
+  if (input_weights.empty() && quantized_input_weights_.empty()) {
+    gsl::span<T> packed_W = Allocate<T>(alloc, W.Shape().Size(), local_packed_input_weights);
+    gsl::span<T> packed_R = Allocate<T>(alloc, R.Shape().Size(), local_packed_recurrent_weights);
+    detail::PackGruWeights(W.Data<T>(), R.Data<T>(), num_directions_, hidden_size_, input_size,
+                           packed_W.data(), packed_R.data());
+    input_weights = packed_W;
+    recurrent_weights = packed_R;
+
+    if (quantize_weights_) {
+      detail::QuantizeGruWeights(packed_W.data(), packed_R.data(), num_directions_, hidden_size_, input_size,
+                                 local_quantized_input_weights, local_quantized_recurrent_weights);
+      quantized_input_weights = &local_quantized_input_weights;
+      quantized_recurrent_weights = &local_quantized_recurrent_weights;
+    }
+  }
+
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -330,8 +406,11 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  gsl::span<const T> input_weights_1 =
+      input_weights.empty() ? input_weights : input_weights.subspan(0, input_weights_size_per_direction);
+  gsl::span<const T> recurrent_weights_1 =
+      recurrent_weights.empty() ? recurrent_weights
+                                : recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -364,12 +443,21 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> hidden_output_1 = hidden_output.subspan(0, hidden_output_size_per_direction);
 
+  // split the batch rows of each direction, or run the two directions at once
+  const RnnParallelism parallelism = ChooseRnnParallelism(num_directions_, seq_length, batch_size, hidden_size_, 3,
+                                                          batch_size, 1,
+                                                          static_cast<int>(std::thread::hardware_concurrency()));
+
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
+    gsl::span<const T> input_weights_2 =
+        input_weights.empty() ? input_weights
+                              : input_weights.subspan(input_weights_size_per_direction,
+                                                      input_weights_size_per_direction);
+    gsl::span<const T> recurrent_weights_2 =
+        recurrent_weights.empty() ? recurrent_weights
+                                  : recurrent_weights.subspan(recurrent_weights_size_per_direction,
+                                                              recurrent_weights_size_per_direction);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -389,8 +477,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_1, initial_hidden_1,
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
-        clip_, ttp_);
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+        clip_, parallelism, ttp_);
 
     std::unique_ptr<detail::UniDirectionalGru<T>> bw = std::make_unique<detail::UniDirectionalGru<T>>(
         alloc, logger,
@@ -398,8 +485,27 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_2, initial_hidden_2,
         activation_funcs_.Entries()[2],
         activation_funcs_.Entries()[3],
-        clip_, ttp_);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+        clip_, parallelism, ttp_);
+
+    if (quantize_weights_) {
+      fw->SetQuantizedWeights(&(*quantized_input_weights)[0], &(*quantized_recurrent_weights)[0]);
+      bw->SetQuantizedWeights(&(*quantized_input_weights)[1], &(*quantized_recurrent_weights)[1]);
+    }
+
+    if (parallelism.concurrent_directions) {
+      // the directions only share read-only inputs and write to separate parts of the outputs
+      auto compute_direction = [&](int direction) {
+        if (direction == 0)
+          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+        else
+          bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+      };
+
+      ExecuteLambdaInParallel("Processing directions", compute_direction, num_directions_, 1, ttp_, logger);
+    } else {
+      fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
+      bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2, output_2, hidden_output_2);
+    }
 
   } else {
     std::unique_ptr<detail::UniDirectionalGru<T>> gru_p = std::make_unique<detail::UniDirectionalGru<T>>(
@@ -408,7 +514,10 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
         bias_1, initial_hidden_1,
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
-        clip_, ttp_);
+        clip_, parallelism, ttp_);
+
+    if (quantize_weights_)
+      gru_p->SetQuantizedWeights(&(*quantized_input_weights)[0], &(*quantized_recurrent_weights)[0]);
 
     gru_p->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1);
   }
@@ -421,6 +530,37 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   return Status::OK();
 }
 
+void DeepCpuGruOp::PrePackWeights(const OpKernelInfo& info) {
+  const Tensor* W;
+  const Tensor* R;
+  if (!info.TryGetConstantInput(1, &W) || !info.TryGetConstantInput(2, &R) ||
+      W->DataType() != DataTypeImpl::GetType<float>())
+    return;
+
+  // leave reporting unexpected shapes to ValidateCommonRnnInputs
+  auto& W_shape = W->Shape();
+  auto& R_shape = R->Shape();
+  if (W_shape.NumDimensions() != 3 || W_shape[0] != num_directions_ || W_shape[1] != 3 * hidden_size_ ||
+      R_shape.NumDimensions() != 3 || R_shape[0] != num_directions_ || R_shape[1] != 3 * hidden_size_ ||
+      R_shape[2] != hidden_size_)
+    return;
+
+  packed_input_weights_.resize(W_shape.Size());
+  packed_recurrent_weights_.resize(R_shape.Size());
+  detail::PackGruWeights(W->Data<float>(), R->Data<float>(), num_directions_, hidden_size_,
+                         gsl::narrow<int>(W_shape[2]), packed_input_weights_.data(), packed_recurrent_weights_.data());
+
+  if (quantize_weights_) {
+    detail::QuantizeGruWeights(packed_input_weights_.data(), packed_recurrent_weights_.data(), num_directions_,
+                               hidden_size_, gsl::narrow<int>(W_shape[2]),
+                               quantized_input_weights_, quantized_recurrent_weights_);
+
+    // only the int8 weights are used from now on
+    std::vector<float>().swap(packed_input_weights_);
+    std::vector<float>().swap(packed_recurrent_weights_);
+  }
+}
+
 //
 // Implementation of internal helper code
 namespace detail {
@@ -439,6 +579,7 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
                                         const ActivationFuncs::Entry& activation_func_f,
                                         const ActivationFuncs::Entry& activation_func_g,
                                         const float clip,
+                                        const RnnParallelism& parallelism,
 #ifdef USE_EIGEN_THREADPOOL
                                         Eigen::NonBlockingThreadPool& ttp)
 #else
@@ -468,7 +609,7 @@ UniDirectionalGru<T>::UniDirectionalGru(AllocatorPtr allocator,
   h_alpha_ = activation_func_g.alpha;
   h_beta_ = activation_func_g.beta;
 
-  SetNumThreads();
+  SetNumThreads(parallelism);
   AllocateBuffers();
 
   if (use_bias_) {
@@ -539,8 +680,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
   DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
 
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
+  // the packed R[zrh] is [hidden_size, 3*hidden_size], with Rz and Rr in the first 2*hidden_size columns.
+  // recurrent_weights is empty when the int8 weights are used instead.
+  auto recurrent_weightsZR = recurrent_weights.cbegin();
+  auto recurrent_weightsH = recurrent_weights.empty() ? recurrent_weights.cbegin()
+                                                      : recurrent_weights.cbegin() + 2 * hidden_size_;
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -569,13 +713,27 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   float beta = 0.0f;  // zero out outputZRH_ when calling ComputeGemm.
 
   // apply weights to all the inputs
-  ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, beta,
-              outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3);
+  if (quantized_input_weights_ != nullptr) {
+    IAllocatorUniquePtr<uint8_t> quantized_inputs_ptr, input_zero_points_ptr;
+    IAllocatorUniquePtr<float> input_scales_ptr;
+    IAllocatorUniquePtr<int32_t> input_products_ptr;
+    gsl::span<uint8_t> quantized_inputs = Allocate(allocator_, total_rows * input_size_, quantized_inputs_ptr);
+    gsl::span<float> input_scales = Allocate(allocator_, total_rows, input_scales_ptr);
+    gsl::span<uint8_t> input_zero_points = Allocate(allocator_, total_rows, input_zero_points_ptr);
+    gsl::span<int32_t> input_products = Allocate(allocator_, total_rows * hidden_size_x3, input_products_ptr);
+
+    ComputeQuantizedGemm(total_rows, hidden_size_x3, input_size_, inputs.data(), *quantized_input_weights_,
+                         outputZRH_.data(), quantized_inputs.data(), input_scales.data(), input_zero_points.data(),
+                         input_products.data());
+  } else {
+    ComputeGemmPackedB(total_rows, hidden_size_x3, input_size_, alpha,
+                       inputs.cbegin(), inputs.cend(),
+                       input_size_,
+                       input_weights.cbegin(), input_weights.cend(),
+                       hidden_size_x3, beta,
+                       outputZRH_.begin(), outputZRH_.end(),
+                       hidden_size_x3);
+  }
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -647,13 +805,18 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         out_added_offset = (step * batch_size_ + row) * hidden_size_x3;
 
         // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,
-                    hidden_size_,
-                    recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                    hidden_size_, beta,
-                    outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                    hidden_size_x3);
+        if (quantized_recurrent_weights_ != nullptr) {
+          QuantizedRecurrentGemm(row, local_fused_hidden_rows, hidden_size_x2, &*prev_Ht, 0,
+                                 outputZRH_.data() + out_added_offset, hidden_size_x3);
+        } else {
+          ComputeGemmPackedB(local_fused_hidden_rows, hidden_size_x2, hidden_size_, alpha,
+                             prev_Ht, prev_Ht_end,
+                             hidden_size_,
+                             recurrent_weightsZR, recurrent_weights.cend(),
+                             hidden_size_x3, beta,
+                             outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                             hidden_size_x3);
+        }
 
         DumpMatrix("Xt*(W[zr]^T) + Ht-1 * R[zr]" + row_str,
                    outputZRH_.data() + out_added_offset, local_fused_hidden_rows, hidden_size_x2, 0, hidden_size_x3);
@@ -664,13 +827,18 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                     linear_output_.subspan(linear_output_local - linear_output_.begin(), linear_output_local_end - linear_output_local));
 
           // compute Ht-1 * (Rh^T) + Rbh
-          ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
-                      prev_Ht, prev_Ht_end,  // Ht-1
-                      hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                      hidden_size_, beta,
-                      linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
-                      hidden_size_);
+          if (quantized_recurrent_weights_ != nullptr) {
+            QuantizedRecurrentGemm(row, local_fused_hidden_rows, hidden_size_, &*prev_Ht, hidden_size_x2,
+                                   &*linear_output_local, hidden_size_);
+          } else {
+            ComputeGemmPackedB(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
+                               prev_Ht, prev_Ht_end,  // Ht-1
+                               hidden_size_,
+                               recurrent_weightsH, recurrent_weights.cend(),  // Rh^T
+                               hidden_size_x3, beta,
+                               linear_output_local, linear_output_.end(),  // pre: Rbh, post:output
+                               hidden_size_);
+          }
 
           DumpMatrix("Ht-1 * (Rh^T) + Rbh " + row_str, &*linear_output_local, batch_size_, hidden_size_);
         }
@@ -727,13 +895,18 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
           }
         } else {
           label += " * Rh^T";
-          ComputeGemm(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
-                      cur_h_local, cur_h_local_end,
-                      hidden_size_,
-                      recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),
-                      hidden_size_, beta,
-                      outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
-                      hidden_size_x3);
+          if (quantized_recurrent_weights_ != nullptr) {
+            QuantizedRecurrentGemm(row, local_fused_hidden_rows, hidden_size_, &*cur_h_local, hidden_size_x2,
+                                   outputZRH_.data() + out_added_offset + hidden_size_x2, hidden_size_x3);
+          } else {
+            ComputeGemmPackedB(local_fused_hidden_rows, hidden_size_, hidden_size_, alpha,
+                               cur_h_local, cur_h_local_end,
+                               hidden_size_,
+                               recurrent_weightsH, recurrent_weights.cend(),
+                               hidden_size_x3, beta,
+                               outputZRH_.begin() + out_added_offset + hidden_size_x2, outputZRH_.end(),
+                               hidden_size_x3);
+          }
         }
 
         DumpMatrix("Xt*(Wh^T) + (" + label + ")" + row_str,
@@ -853,13 +1026,18 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
       // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
-      ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
-                  prev_Ht, prev_Ht_end,
-                  hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                  hidden_size_, beta,
-                  outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3);
+      if (quantized_recurrent_weights_ != nullptr) {
+        QuantizedRecurrentGemm(0, batch_size_, hidden_size_x2, &*prev_Ht, 0,
+                               outputZRH_.data() + out_added_offset, hidden_size_x3);
+      } else {
+        ComputeGemmPackedB(batch_size_, hidden_size_x2, hidden_size_, alpha,
+                           prev_Ht, prev_Ht_end,
+                           hidden_size_,
+                           recurrent_weightsZR, recurrent_weights.cend(),
+                           hidden_size_x3, beta,
+                           outputZRH_.begin() + out_added_offset, outputZRH_.end(),
+                           hidden_size_x3);
+      }
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -869,13 +1047,18 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         gsl::copy(batched_bias_Rh_.subspan(batched_bias_Rh_local - batched_bias_Rh_.begin(), batched_bias_Rh_local_end - batched_bias_Rh_local), linear_output_);
 
         // compute Ht-1 * (Rh^T) + Rbh
-        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, beta,
-                    linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
-                    hidden_size_);
+        if (quantized_recurrent_weights_ != nullptr) {
+          QuantizedRecurrentGemm(0, batch_size_, hidden_size_, &*prev_Ht, hidden_size_x2,
+                                 linear_output_.data(), hidden_size_);
+        } else {
+          ComputeGemmPackedB(batch_size_, hidden_size_, hidden_size_, alpha,
+                             prev_Ht, prev_Ht_end,  // Ht-1
+                             hidden_size_,
+                             recurrent_weightsH, recurrent_weights.cend(),  // Rh^T
+                             hidden_size_x3, beta,
+                             linear_output_.begin(), linear_output_.end(),  // pre: Rbh, post:output
+                             hidden_size_);
+        }
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
@@ -936,13 +1119,18 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
         auto out_H = outputZRH_.begin() + out_added_offset + hidden_size_x2;
 
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
-        ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, beta,
-                    out_H, outputZRH_.end(),
-                    hidden_size_x3);
+        if (quantized_recurrent_weights_ != nullptr) {
+          QuantizedRecurrentGemm(0, batch_size_, hidden_size_, &*cur_h_local, hidden_size_x2,
+                                 &*out_H, hidden_size_x3);
+        } else {
+          ComputeGemmPackedB(batch_size_, hidden_size_, hidden_size_, alpha,
+                             cur_h_local, cur_h_local_end,  // rt (.) Ht-1
+                             hidden_size_,
+                             recurrent_weightsH, recurrent_weights.cend(),  // Rh^T
+                             hidden_size_x3, beta,
+                             out_H, outputZRH_.end(),
+                             hidden_size_x3);
+        }
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
@@ -1041,6 +1229,32 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 }
 
+template <typename T>
+void UniDirectionalGru<T>::SetQuantizedWeights(const QuantizedWeights* input_weights,
+                                               const QuantizedWeights* recurrent_weights) {
+  quantized_input_weights_ = input_weights;
+  quantized_recurrent_weights_ = recurrent_weights;
+
+  quantized_state_ = Allocate(allocator_, batch_size_ * hidden_size_, quantized_state_ptr_);
+  state_scales_ = Allocate(allocator_, batch_size_, state_scales_ptr_);
+  state_zero_points_ = Allocate(allocator_, batch_size_, state_zero_points_ptr_);
+  state_products_ = Allocate(allocator_, batch_size_ * 3 * hidden_size_, state_products_ptr_);
+}
+
+template <typename T>
+void UniDirectionalGru<T>::QuantizedRecurrentGemm(int row, int num_rows, int N, const T* A, int column,
+                                                  T* C, int ldc) {
+  uint8_t* quantized_A = quantized_state_.data() + row * hidden_size_;
+  float* scales = state_scales_.data() + row;
+  uint8_t* zero_points = state_zero_points_.data() + row;
+
+  QuantizeRows(A, num_rows, hidden_size_, hidden_size_, quantized_A, scales, zero_points);
+  QuantizedGemm(num_rows, N, hidden_size_, quantized_A, hidden_size_, scales, zero_points,
+                *quantized_recurrent_weights_, column,
+                state_products_.data() + row * 3 * hidden_size_ + column, 3 * hidden_size_,
+                true, C, ldc);
+}
+
 template <typename T>
 void UniDirectionalGru<T>::AllocateBuffers() {
   cur_h_ = Allocate(allocator_, hidden_size_ * batch_size_, cur_h_ptr_);
@@ -1070,28 +1284,12 @@ void UniDirectionalGru<T>::AllocateBuffers() {
 }
 
 template <typename T>
-void UniDirectionalGru<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
-
-  if (threads < 1)
-    threads = 1;
-
-  hidden_num_threads_ = threads;
-  batch_parallel_ = false;
-
-  // for readability of the below logic
-  const auto num_rows = batch_size_;
-  const auto num_columns = hidden_size_;
-
-  // parallelize by partitioning the batch rows
-  if (num_rows > 4 ||
-      (num_rows >= 2 && num_columns <= 256) ||
-      (num_rows >= 3 && num_columns <= 512)) {
-    batch_parallel_ = true;
-    VLOGS(logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
-  }
+void UniDirectionalGru<T>::SetNumThreads(const RnnParallelism& parallelism) {
+  // the reset gate needs all of Ht-1 * Rzr^T before Ht-1 * Rh^T, so only the batch rows are split
+  hidden_num_threads_ = std::max(parallelism.partitions, 1);
+  batch_parallel_ = parallelism.batch_parallel;
 
-  ORT_ENFORCE(hidden_num_threads_ >= 1);
+  VLOGS(logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
 }
 }  // namespace detail
 }  // namespace onnxruntime
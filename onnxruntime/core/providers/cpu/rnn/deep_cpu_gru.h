@@ -13,9 +13,12 @@ namespace onnxruntime {
 
 /// The class represents GRU operator using DeepCPU implementation for
 /// fast inference computation on CPU machines.
-class DeepCpuGruOp final : public OpKernel {
+/// With quantize_weights the GEMMs run on int8 weights and uint8 activations quantized as they are used, which
+/// is the DynamicQuantizeGRU contrib operator.
+class DeepCpuGruOp : public OpKernel {
  public:
-  DeepCpuGruOp(const OpKernelInfo& info) : OpKernel(info) {
+  DeepCpuGruOp(const OpKernelInfo& info, bool quantize_weights = false)
+      : OpKernel(info), quantize_weights_(quantize_weights) {
     // required attributes
     std::string direction;
     ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
@@ -50,6 +53,8 @@ class DeepCpuGruOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    PrePackWeights(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -66,6 +71,17 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R for all directions in the layout produced by rnn::detail::PackGateWeights. Packed once here when
+  // they are constant initializers, otherwise packed by each call to Compute.
+  std::vector<float> packed_input_weights_;
+  std::vector<float> packed_recurrent_weights_;
+
+  // With quantize_weights_, the packed W and R of each direction quantized to int8. These replace the fp32 packed
+  // weights when W and R are constant initializers, otherwise they are quantized by each call to Compute.
+  bool quantize_weights_;
+  std::vector<rnn::detail::QuantizedWeights> quantized_input_weights_;
+  std::vector<rnn::detail::QuantizedWeights> quantized_recurrent_weights_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
@@ -78,6 +94,8 @@ class DeepCpuGruOp final : public OpKernel {
 
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
+
+  void PrePackWeights(const OpKernelInfo& info);
 };
 
 }  // namespace onnxruntime
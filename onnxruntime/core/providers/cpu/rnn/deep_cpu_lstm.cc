@@ -184,6 +184,42 @@ struct ActivationInfo {
 // copying the peephole values into UniDirectionalLstm seems unnecessary. don't do that until proven necessary
 #define LSTM_NO_PEEPHOLE_COPY
 
+// Number of hidden units per tile. The recurrent GEMM of a step and the gate computations that consume it run
+// one tile at a time, so the 4 * kGateTileSize outputs of a row are still in L1 when the gates read them.
+constexpr int kGateTileSize = 64;
+
+// Pack W [num_directions, 4*hidden_size, input_size] and R [num_directions, 4*hidden_size, hidden_size] so each
+// direction is a [input_size or hidden_size, 4*hidden_size] matrix with the gates of a tile next to each other.
+void PackLstmWeights(const float* W, const float* R, int num_directions, int hidden_size, int input_size,
+                     float* packed_W, float* packed_R) {
+  for (int direction = 0; direction < num_directions; ++direction) {
+    PackGateWeights(W + direction * 4 * hidden_size * input_size, 4, hidden_size, input_size, kGateTileSize,
+                    packed_W + direction * 4 * hidden_size * input_size);
+    PackGateWeights(R + direction * 4 * hidden_size * hidden_size, 4, hidden_size, hidden_size, kGateTileSize,
+                    packed_R + direction * 4 * hidden_size * hidden_size);
+  }
+}
+
+// Quantize the weights packed by PackLstmWeights to int8, one QuantizedWeights per direction. W is read by a
+// single GEMM over all the inputs, and R one tile of gates at a time.
+void QuantizeLstmWeights(const float* packed_W, const float* packed_R, int num_directions, int hidden_size,
+                         int input_size, std::vector<QuantizedWeights>& quantized_W,
+                         std::vector<QuantizedWeights>& quantized_R) {
+  std::vector<int> tile_columns;
+  for (int col = 0; col < hidden_size; col += kGateTileSize) {
+    tile_columns.push_back(4 * col);
+  }
+
+  quantized_W.resize(num_directions);
+  quantized_R.resize(num_directions);
+  for (int direction = 0; direction < num_directions; ++direction) {
+    QuantizeWeights(packed_W + direction * 4 * hidden_size * input_size, input_size, 4 * hidden_size, {0},
+                    quantized_W[direction]);
+    QuantizeWeights(packed_R + direction * 4 * hidden_size * hidden_size, hidden_size, 4 * hidden_size,
+                    tile_columns, quantized_R[direction]);
+  }
+}
+
 template <typename T>
 class UniDirectionalLstm {
  public:
@@ -203,12 +239,14 @@ class UniDirectionalLstm {
                      const ActivationFuncs::Entry& activation_func_g,
                      const ActivationFuncs::Entry& activation_func_h,
                      const float clip,
+                     const RnnParallelism& parallelism,
 #ifdef USE_EIGEN_THREADPOOL
                      Eigen::NonBlockingThreadPool& ttp);
 #else
                      TaskThreadPool& ttp);
 #endif
 
+  // input_weights and recurrent_weights are packed by PackLstmWeights
   void Compute(const gsl::span<const T>& inputs,
                const gsl::span<const int>& sequence_lengths,
                const int num_directions,
@@ -218,13 +256,17 @@ class UniDirectionalLstm {
                gsl::span<T>& final_hidden_state,
                gsl::span<T>& final_cell_state);
 
+  // run the GEMMs on int8 weights, quantized by QuantizeWeights from the packed weights, instead of the fp32
+  // weights given to Compute
+  void SetQuantizedWeights(const QuantizedWeights* input_weights, const QuantizedWeights* recurrent_weights);
+
   ~UniDirectionalLstm() = default;
 
  private:
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
   using span_T_iter = typename gsl::span<T>::iterator;
 
-  void SetNumThreads();
+  void SetNumThreads(const RnnParallelism& parallelism);
 
   void GateComputations(span_T_iter& out, span_T_iter& out_end,
                         span_T_iter& C_prev, span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
@@ -235,6 +277,8 @@ class UniDirectionalLstm {
                         const int step,
                         const int row,
                         const int local_fused_hidden_rows,
+                        const int col,
+                        const int cols,
                         bool output_sequence);
 
   void AllocateBuffers();
@@ -258,6 +302,7 @@ class UniDirectionalLstm {
   float clip_;
 
   bool batch_parallel_;
+  bool tile_parallel_;
 
   bool use_bias_;
   bool use_peepholes_;
@@ -265,9 +310,9 @@ class UniDirectionalLstm {
   int hidden_num_threads_ = -1;
 
   IAllocatorUniquePtr<T> output_iofc_ptr_;
-  IAllocatorUniquePtr<T> hidden0_ptr_, batched_hidden0_ptr_;
+  IAllocatorUniquePtr<T> hidden0_ptr_, batched_hidden0_ptr_, batched_hidden1_ptr_;
   gsl::span<T> output_iofc_;
-  gsl::span<T> hidden0_, batched_hidden0_;
+  gsl::span<T> hidden0_, batched_hidden0_, batched_hidden1_;
 
   IAllocatorUniquePtr<T> internal_memory_prev_ptr_, batched_internal_memory_prev_ptr_;
   IAllocatorUniquePtr<T> internal_memory_cur_ptr_, batched_internal_memory_cur_ptr_;
@@ -293,6 +338,16 @@ class UniDirectionalLstm {
   IAllocatorUniquePtr<int> sequence_lengths_ptr_;
   gsl::span<int> sequence_lengths_;
 
+  // int8 weights of the dynamically quantized operator, and Ht-1 quantized once per step for the recurrent GEMM
+  const QuantizedWeights* quantized_input_weights_ = nullptr;
+  const QuantizedWeights* quantized_recurrent_weights_ = nullptr;
+  IAllocatorUniquePtr<uint8_t> quantized_state_ptr_, state_zero_points_ptr_;
+  IAllocatorUniquePtr<float> state_scales_ptr_;
+  IAllocatorUniquePtr<int32_t> state_products_ptr_;
+  gsl::span<uint8_t> quantized_state_, state_zero_points_;
+  gsl::span<float> state_scales_;
+  gsl::span<int32_t> state_products_;
+
   deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_;
 
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_f_;
@@ -373,8 +428,33 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
 
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  // use the weights packed at construction, or pack them now if they are not constant initializers.
+  // the quantized operator only keeps the int8 weights, so the fp32 spans are empty when those were prepared.
+  gsl::span<const T> input_weights = packed_input_weights_;
+  gsl::span<const T> recurrent_weights = packed_recurrent_weights_;
+  const std::vector<QuantizedWeights>* quantized_input_weights = &quantized_input_weights_;
+  const std::vector<QuantizedWeights>* quantized_recurrent_weights = &quantized_recurrent_weights_;
+
+  IAllocatorUniquePtr<T> local_packed_input_weights;
+  IAllocatorUniquePtr<T> local_packed_recurrent_weights;
+  std::vector<QuantizedWeights> local_quantized_input_weights;
+  std::vector<QuantizedWeights> local_quantized_recurrent_weights;
+  if (input_weights.empty() && quantized_input_weights_.empty()) {
+    gsl::span<T> packed_W = Allocate(alloc, W.Shape().Size(), local_packed_input_weights);
+    gsl::span<T> packed_R = Allocate(alloc, R.Shape().Size(), local_packed_recurrent_weights);
+    detail::PackLstmWeights(W.Data<T>(), R.Data<T>(), num_directions_, hidden_size_, input_size,
+                            packed_W.data(), packed_R.data());
+    input_weights = packed_W;
+    recurrent_weights = packed_R;
+
+    if (quantize_weights_) {
+      detail::QuantizeLstmWeights(packed_W.data(), packed_R.data(), num_directions_, hidden_size_, input_size,
+                                  local_quantized_input_weights, local_quantized_recurrent_weights);
+      quantized_input_weights = &local_quantized_input_weights;
+      quantized_recurrent_weights = &local_quantized_recurrent_weights;
+    }
+  }
+
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
   gsl::span<const T> peephole_weights = P != nullptr ? P->DataAsSpan<T>() : gsl::span<const T>();
 
@@ -384,8 +464,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   const size_t bias_size_per_direction = 8 * hidden_size_;
   const size_t peephole_weights_size_per_direction = 3 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, hidden_weights_size_per_direction);
+  gsl::span<const T> input_weights_1 =
+      input_weights.empty() ? input_weights : input_weights.subspan(0, input_weights_size_per_direction);
+  gsl::span<const T> recurrent_weights_1 =
+      recurrent_weights.empty() ? recurrent_weights : recurrent_weights.subspan(0, hidden_weights_size_per_direction);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
   gsl::span<const T> peephole_weights_1 =
       peephole_weights.empty() ? peephole_weights
@@ -435,15 +517,25 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   gsl::span<T> last_cell_1 = last_cell.subspan(0, last_cell_size_per_direction);
 
+  // split the batch rows or the tiles of hidden units of each direction, or run the two directions at once
+  const int num_tiles = (hidden_size_ + detail::kGateTileSize - 1) / detail::kGateTileSize;
+  const RnnParallelism parallelism = ChooseRnnParallelism(num_directions_, seq_length, batch_size, hidden_size_, 4,
+                                                          batch_size, num_tiles,
+                                                          static_cast<int>(std::thread::hardware_concurrency()));
+
   std::unique_ptr<detail::UniDirectionalLstm<T>> fw;
   std::unique_ptr<detail::UniDirectionalLstm<T>> bw;
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> hidden_weights_2 = recurrent_weights.subspan(hidden_weights_size_per_direction,
-                                                                    hidden_weights_size_per_direction);
+    gsl::span<const T> input_weights_2 =
+        input_weights.empty() ? input_weights
+                              : input_weights.subspan(input_weights_size_per_direction,
+                                                      input_weights_size_per_direction);
+    gsl::span<const T> hidden_weights_2 =
+        recurrent_weights.empty() ? recurrent_weights
+                                  : recurrent_weights.subspan(hidden_weights_size_per_direction,
+                                                              hidden_weights_size_per_direction);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
     gsl::span<const T> peephole_weights_2 =
         peephole_weights.empty() ? peephole_weights
@@ -473,7 +565,7 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[0],
                                                          activation_funcs_.Entries()[1],
                                                          activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
+                                                         clip_, parallelism, ttp_);
 
     bw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -482,10 +574,27 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[3],
                                                          activation_funcs_.Entries()[4],
                                                          activation_funcs_.Entries()[5],
-                                                         clip_, ttp_);
+                                                         clip_, parallelism, ttp_);
 
-    fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    if (quantize_weights_) {
+      fw->SetQuantizedWeights(&(*quantized_input_weights)[0], &(*quantized_recurrent_weights)[0]);
+      bw->SetQuantizedWeights(&(*quantized_input_weights)[1], &(*quantized_recurrent_weights)[1]);
+    }
+
+    if (parallelism.concurrent_directions) {
+      // the directions only share read-only inputs and write to separate parts of the outputs
+      auto compute_direction = [&](int direction) {
+        if (direction == 0)
+          fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+        else
+          bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+      };
+
+      ExecuteLambdaInParallel("Processing directions", compute_direction, num_directions_, 1, ttp_, logger);
+    } else {
+      fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+      bw->Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    }
   } else {
     fw = std::make_unique<detail::UniDirectionalLstm<T>>(alloc, logger,
                                                          seq_length, batch_size, input_size,
@@ -494,7 +603,10 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
                                                          activation_funcs_.Entries()[0],
                                                          activation_funcs_.Entries()[1],
                                                          activation_funcs_.Entries()[2],
-                                                         clip_, ttp_);
+                                                         clip_, parallelism, ttp_);
+
+    if (quantize_weights_)
+      fw->SetQuantizedWeights(&(*quantized_input_weights)[0], &(*quantized_recurrent_weights)[0]);
 
     fw->Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
   }
@@ -509,6 +621,37 @@ Status DeepCpuLstmOp::ComputeImpl(OpKernelContext& context) const {
   return Status::OK();
 }
 
+void DeepCpuLstmOp::PrePackWeights(const OpKernelInfo& info) {
+  const Tensor* W;
+  const Tensor* R;
+  if (!info.TryGetConstantInput(1, &W) || !info.TryGetConstantInput(2, &R) ||
+      W->DataType() != DataTypeImpl::GetType<float>())
+    return;
+
+  // leave reporting unexpected shapes to ValidateInputs
+  auto& W_shape = W->Shape();
+  auto& R_shape = R->Shape();
+  if (W_shape.NumDimensions() != 3 || W_shape[0] != num_directions_ || W_shape[1] != 4 * hidden_size_ ||
+      R_shape.NumDimensions() != 3 || R_shape[0] != num_directions_ || R_shape[1] != 4 * hidden_size_ ||
+      R_shape[2] != hidden_size_)
+    return;
+
+  packed_input_weights_.resize(W_shape.Size());
+  packed_recurrent_weights_.resize(R_shape.Size());
+  detail::PackLstmWeights(W->Data<float>(), R->Data<float>(), num_directions_, hidden_size_,
+                          gsl::narrow<int>(W_shape[2]), packed_input_weights_.data(), packed_recurrent_weights_.data());
+
+  if (quantize_weights_) {
+    detail::QuantizeLstmWeights(packed_input_weights_.data(), packed_recurrent_weights_.data(), num_directions_,
+                                hidden_size_, gsl::narrow<int>(W_shape[2]),
+                                quantized_input_weights_, quantized_recurrent_weights_);
+
+    // only the int8 weights are used from now on
+    std::vector<float>().swap(packed_input_weights_);
+    std::vector<float>().swap(packed_recurrent_weights_);
+  }
+}
+
 Status DeepCpuLstmOp::ValidateInputs(const Tensor& X, const Tensor& W, const Tensor& R, const Tensor* B,
                                      const Tensor* sequence_lens, const Tensor* initial_h, const Tensor* initial_c,
                                      const Tensor* P, int batch_size) const {
@@ -566,6 +709,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
                                           const ActivationFuncs::Entry& activation_func_g,
                                           const ActivationFuncs::Entry& activation_func_h,
                                           const float clip,
+                                          const RnnParallelism& parallelism,
 #ifdef USE_EIGEN_THREADPOOL
                                           Eigen::NonBlockingThreadPool& ttp)
 #else
@@ -597,7 +741,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(AllocatorPtr allocator,
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
-  SetNumThreads();
+  SetNumThreads(parallelism);
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
 
@@ -615,6 +759,7 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   internal_memory_prev_ = Allocate(allocator_, hidden_size_, internal_memory_prev_ptr_, fill);
   internal_memory_cur_ = Allocate(allocator_, hidden_size_, internal_memory_cur_ptr_, fill);
   batched_hidden0_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_hidden0_ptr_, fill);
+  batched_hidden1_ = Allocate(allocator_, batch_size_ * hidden_size_, batched_hidden1_ptr_, fill);
 
   batched_internal_memory_prev_ = Allocate(allocator_, batch_size_ * hidden_size_,
                                            batched_internal_memory_prev_ptr_, fill);
@@ -646,6 +791,18 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
 #endif
 }
 
+template <typename T>
+void UniDirectionalLstm<T>::SetQuantizedWeights(const QuantizedWeights* input_weights,
+                                                const QuantizedWeights* recurrent_weights) {
+  quantized_input_weights_ = input_weights;
+  quantized_recurrent_weights_ = recurrent_weights;
+
+  quantized_state_ = Allocate(allocator_, batch_size_ * hidden_size_, quantized_state_ptr_);
+  state_scales_ = Allocate(allocator_, batch_size_, state_scales_ptr_);
+  state_zero_points_ = Allocate(allocator_, batch_size_, state_zero_points_ptr_);
+  state_products_ = Allocate(allocator_, batch_size_ * 4 * hidden_size_, state_products_ptr_);
+}
+
 template <typename T>
 void UniDirectionalLstm<T>::InitializeBuffers(const gsl::span<const T>& initial_hidden_state,
                                               const gsl::span<const T>& initial_cell_state) {
@@ -791,14 +948,29 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   const int hidden_size_x4 = 4 * hidden_size_;
   const int total_rows = max_sequence_length * batch_size_;
 
-  // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),  // W[iofc]
-              input_size_, beta,
-              output_iofc_.begin(), output_iofc_.end(),
-              hidden_size_x4);
+  // apply the weights to all the inputs and save to output_IOFC.
+  // the columns of output_IOFC follow the tiled gate order of the packed weights.
+  if (quantized_input_weights_ != nullptr) {
+    IAllocatorUniquePtr<uint8_t> quantized_inputs_ptr, input_zero_points_ptr;
+    IAllocatorUniquePtr<float> input_scales_ptr;
+    IAllocatorUniquePtr<int32_t> input_products_ptr;
+    gsl::span<uint8_t> quantized_inputs = Allocate(allocator_, total_rows * input_size_, quantized_inputs_ptr);
+    gsl::span<float> input_scales = Allocate(allocator_, total_rows, input_scales_ptr);
+    gsl::span<uint8_t> input_zero_points = Allocate(allocator_, total_rows, input_zero_points_ptr);
+    gsl::span<int32_t> input_products = Allocate(allocator_, total_rows * hidden_size_x4, input_products_ptr);
+
+    ComputeQuantizedGemm(total_rows, hidden_size_x4, input_size_, inputs.data(), *quantized_input_weights_,
+                         output_iofc_.data(), quantized_inputs.data(), input_scales.data(), input_zero_points.data(),
+                         input_products.data());
+  } else {
+    ComputeGemmPackedB(total_rows, hidden_size_x4, input_size_, alpha,
+                       inputs.cbegin(), inputs.cend(),
+                       input_size_,
+                       input_weights.cbegin(), input_weights.cend(),  // W[iofc]
+                       hidden_size_x4, beta,
+                       output_iofc_.begin(), output_iofc_.end(),
+                       hidden_size_x4);
+  }
 
   DumpMatrix("Xt*(W[iofc]^T)", output_iofc_.data(), total_rows, hidden_size_x4);
 
@@ -810,7 +982,101 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   // logic errors causing bounds violations.
   span_T_iter C_prev_end = batched_internal_state_prev_one_step.end();
   span_T_iter C_prev_clipped_end = batched_internal_state_clipped_one_step.end();
-  span_T_const_iter previous_state_end = batched_hidden_state_one_step.end();
+
+  const int num_tiles = (hidden_size_ + kGateTileSize - 1) / kGateTileSize;
+
+  // calculate Xt*(W[iofc]^T) + Ht-1*R[iofc] for the tiles [tile, tile_end) of num_rows rows starting at row, and
+  // run the gate computations for each tile while its part of the GEMM output is still in cache.
+  // previous_state and batched_output point to the first row of the step.
+  auto compute_tiles = [&](span_T_const_iter previous_state, span_T_const_iter previous_state_end,
+                           span_T_iter batched_output, span_T_iter batched_output_end,
+                           int step, int row, int num_rows, int tile, int tile_end) {
+    span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
+    span_T_iter step_out_IOFC_end = step_out_IOFC + num_rows * hidden_size_x4;
+
+    // these are all batch * hidden_size_ and get updated in-place when running GateComputations so non-const iters
+    span_T_iter c_prev = batched_internal_state_prev_one_step.begin() + row * hidden_size_;
+    span_T_iter c_prev_clipped = batched_internal_state_clipped_one_step.begin() + row * hidden_size_;
+
+    for (; tile < tile_end; ++tile) {
+      const int col = tile * kGateTileSize;
+      const int cols = std::min(kGateTileSize, hidden_size_ - col);
+
+      if (quantized_recurrent_weights_ != nullptr) {
+        // the int32 results of the tile are dequantized and added to Xt*(W[iofc]^T) just before the gates read them
+        QuantizedGemm(num_rows, 4 * cols, hidden_size_,
+                      quantized_state_.data() + row * hidden_size_, hidden_size_,  // Ht-1
+                      state_scales_.data() + row, state_zero_points_.data() + row,
+                      *quantized_recurrent_weights_, 4 * col,  // R[iofc]
+                      state_products_.data() + row * hidden_size_x4 + 4 * col, hidden_size_x4,
+                      true, &*(step_out_IOFC + 4 * col), hidden_size_x4);
+      } else {
+        ComputeGemmPackedB(num_rows, 4 * cols, hidden_size_, alpha,
+                           previous_state + row * hidden_size_, previous_state_end,  // Ht-1
+                           hidden_size_,
+                           recurrent_weights.cbegin() + 4 * col, recurrent_weights.cend(),  // R[iofc]
+                           hidden_size_x4, beta,
+                           step_out_IOFC + 4 * col, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
+                           hidden_size_x4);
+      }
+
+      GateComputations(step_out_IOFC, step_out_IOFC_end,
+                       c_prev, C_prev_end,
+                       c_prev_clipped, C_prev_clipped_end,
+                       batched_output, batched_output_end,
+                       sequence_lengths, min_sequence_length, step, row, num_rows, col, cols, output_sequence);
+    }
+  };
+
+  // with int8 recurrent weights, Ht-1 of the rows [row, row + num_rows) is quantized once per step, before any of
+  // the tiles read it
+  auto quantize_state = [&](span_T_const_iter previous_state, int row, int num_rows) {
+    if (quantized_recurrent_weights_ != nullptr) {
+      QuantizeRows(&*(previous_state + row * hidden_size_), num_rows, hidden_size_, hidden_size_,
+                   quantized_state_.data() + row * hidden_size_,
+                   state_scales_.data() + row, state_zero_points_.data() + row);
+    }
+  };
+
+  // where to write Ht for a step. the GEMM of the later tiles of a step still reads Ht-1, so when only the final
+  // hidden state is returned the steps alternate between two buffers instead of updating final_hidden_state
+  // in place, and each row is copied out at its last step.
+  auto step_output = [&](int step, span_T_iter& batched_output, span_T_iter& batched_output_end) {
+    if (output_sequence) {
+      batched_output = outputs.begin() + step * output_step_length;
+      batched_output_end = outputs.end();
+    } else {
+      gsl::span<T>& hidden_state = step % 2 == 0 ? batched_hidden1_ : batched_hidden0_;
+      batched_output = hidden_state.begin();
+      batched_output_end = hidden_state.end();
+    }
+  };
+
+  // copy the state of the rows that have reached the end of their sequence, and clear the output of the rows
+  // that are past it
+  auto finish_step = [&](span_T_iter batched_output, int step, int row, int num_rows) {
+    for (int lrow = row; lrow < row + num_rows; ++lrow) {
+      if ((step + 1) == sequence_lengths[lrow]) {
+        gsl::copy(batched_internal_memory_prev_.subspan(lrow * hidden_size_, hidden_size_),
+                  final_cell_state.subspan(lrow * hidden_size_, hidden_size_));
+
+        if (!output_sequence) {
+          std::copy_n(batched_output + lrow * hidden_size_, hidden_size_,
+                      final_hidden_state.begin() + lrow * hidden_size_);
+        }
+      }
+    }
+
+    if (output_sequence) {
+      // set to 0 if step >= sequence_length
+      for (int lrow = row; lrow < row + num_rows; lrow++) {
+        if (step >= min_sequence_length && step >= sequence_lengths[lrow]) {
+          auto output_lrow = outputs.begin() + step * output_step_length + lrow * hidden_size_;
+          std::fill_n(output_lrow, hidden_size_, (T)0);
+        }
+      }
+    }
+  };
 
   if (batch_parallel_) {
     int fused_hidden_rows = batch_size_ / hidden_num_threads_;
@@ -824,71 +1090,23 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
       if ((row + fused_hidden_rows) > batch_size_)
         local_fused_hidden_rows = batch_size_ - row;
 
-      // these are all batch * hidden_size_ and get updated in-place when running GateComputations so non-const iters
-      span_T_iter c_prev = batched_internal_state_prev_one_step.begin() + row * hidden_size_;
-      span_T_iter c_prev_clipped = batched_internal_state_clipped_one_step.begin() + row * hidden_size_;
-
       // hidden state can be provided as input for first step, so need to special case that.
       // after the first step this will switch to the output from the previous step
-      span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin() + row * hidden_size_;
+      span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin();
+      span_T_const_iter previous_state_end = batched_hidden_state_one_step.cend();
 
       // run through steps sequentially
       for (int step = 0; step < max_sequence_length; step++) {
-#if defined(DUMP_MATRIXES)
-        const std::string row_str = " [row=" + std::to_string(row) + ",seqno=" + std::to_string(step) + "]";
-#endif
-
-        span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_ + row) * hidden_size_x4;
-
-        // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-        ComputeGemm(local_fused_hidden_rows, hidden_size_x4, hidden_size_, alpha,
-                    previous_state, previous_state_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                    hidden_size_, beta,
-                    step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                    hidden_size_x4);
-
-        DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str,
-                   &*step_out_IOFC, local_fused_hidden_rows, hidden_size_x4);
-
         span_T_iter batched_output, batched_output_end;
-        if (output_sequence) {
-          batched_output = outputs.begin() + step * output_step_length;
-          batched_output_end = outputs.end();
-
-        } else {
-          batched_output = final_hidden_state.begin();
-          batched_output_end = final_hidden_state.end();
-        }
+        step_output(step, batched_output, batched_output_end);
 
-        span_T_iter step_out_IOFC_end = step_out_IOFC + local_fused_hidden_rows * hidden_size_x4;
-        GateComputations(step_out_IOFC, step_out_IOFC_end,
-                         c_prev, C_prev_end,
-                         c_prev_clipped, C_prev_clipped_end,
-                         batched_output, batched_output_end,
-                         sequence_lengths, min_sequence_length, step, row, local_fused_hidden_rows, output_sequence);
-
-        // copy last row to final_cell_state
-        for (int lrow = row; lrow < row + local_fused_hidden_rows; ++lrow) {
-          if ((step + 1) == sequence_lengths[lrow]) {
-            gsl::span<const T> src = batched_internal_memory_prev_.subspan(lrow * hidden_size_, hidden_size_);
-            gsl::span<T> dst = final_cell_state.subspan(lrow * hidden_size_, hidden_size_);
-            gsl::copy(src, dst);
-          }
-        }
+        quantize_state(previous_state, row, local_fused_hidden_rows);
+        compute_tiles(previous_state, previous_state_end, batched_output, batched_output_end,
+                      step, row, local_fused_hidden_rows, 0, num_tiles);
 
-        if (output_sequence) {
-          // set to 0 if step >= sequence_length
-          for (int lrow = row; lrow < row + local_fused_hidden_rows; lrow++) {
-            if (step >= min_sequence_length && step >= sequence_lengths[lrow]) {
-              auto output_lrow = outputs.begin() + step * output_step_length + lrow * hidden_size_;
-              std::fill_n(output_lrow, hidden_size_, (T)0);
-            }
-          }
-        }
+        finish_step(batched_output, step, row, local_fused_hidden_rows);
 
-        previous_state = batched_output + row * hidden_size_;
+        previous_state = batched_output;
         previous_state_end = batched_output_end;
       }
     };
@@ -896,12 +1114,17 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     ExecuteLambdaInParallel("Processing batch", hidden_gemm_and_activations, batch_size_, fused_hidden_rows, ttp_, logger_);
 
   } else {
-    span_T_iter c_prev = batched_internal_state_prev_one_step.begin();
-    span_T_iter c_prev_clipped = batched_internal_state_clipped_one_step.begin();
-
     // hidden state can be provided as input for first step, so need to special case that.
     // after the first step this will switch to the output from the previous step
     span_T_const_iter previous_state = batched_hidden_state_one_step.cbegin();
+    span_T_const_iter previous_state_end = batched_hidden_state_one_step.cend();
+
+    int tiles_per_task = num_tiles;
+    if (tile_parallel_) {
+      tiles_per_task = num_tiles / hidden_num_threads_;
+      if (num_tiles % hidden_num_threads_ != 0)
+        tiles_per_task++;
+    }
 
     //run through steps sequentially
     for (int step = 0; step < max_sequence_length; step++) {
@@ -911,51 +1134,25 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
 
       DumpMatrix("previous_state" + seqno_str, &*previous_state, batch_size_, hidden_size_);
 
-      span_T_iter step_out_IOFC = output_iofc_.begin() + (step * batch_size_) * hidden_size_x4;
-
-      // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
-      ComputeGemm(batch_size_, hidden_size_x4, hidden_size_, alpha,
-                  previous_state, previous_state_end,  // Ht-1
-                  hidden_size_,
-                  recurrent_weights.cbegin(), recurrent_weights.cend(),  // R[iofc]
-                  hidden_size_, beta,
-                  step_out_IOFC, output_iofc_.end(),  // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4);
-
       span_T_iter batched_output, batched_output_end;
-      if (output_sequence) {
-        batched_output = outputs.begin() + step * output_step_length;
-        batched_output_end = outputs.end();
+      step_output(step, batched_output, batched_output_end);
 
-      } else {
-        batched_output = final_hidden_state.begin();
-        batched_output_end = final_hidden_state.end();
-      }
+      quantize_state(previous_state, 0, batch_size_);
 
-      span_T_iter step_out_IOFC_end = step_out_IOFC + batch_size_ * hidden_size_x4;
-      GateComputations(step_out_IOFC, step_out_IOFC_end,
-                       c_prev, C_prev_end,
-                       c_prev_clipped, C_prev_clipped_end,
-                       batched_output, batched_output_end,
-                       sequence_lengths, min_sequence_length, step, 0, batch_size_, output_sequence);
+      // the tiles of a step are independent, so a large hidden size is split across the threads by tile
+      auto tiles_gemm_and_activations = [&](int tile) {
+        compute_tiles(previous_state, previous_state_end, batched_output, batched_output_end,
+                      step, 0, batch_size_, tile, std::min(tile + tiles_per_task, num_tiles));
+      };
 
-      // copy last row to final_cell_state
-      for (int lrow = 0; lrow < batch_size_; lrow++) {
-        if ((step + 1) == sequence_lengths[lrow]) {
-          gsl::copy(batched_internal_memory_prev_.subspan(lrow * hidden_size_, hidden_size_),
-                    final_cell_state.subspan(lrow * hidden_size_, hidden_size_));
-        }
+      if (tiles_per_task < num_tiles) {
+        ExecuteLambdaInParallel("Processing tiles", tiles_gemm_and_activations, num_tiles, tiles_per_task,
+                                ttp_, logger_);
+      } else {
+        tiles_gemm_and_activations(0);
       }
 
-      if (output_sequence) {
-        //set to 0 if step >= sequence_length
-        for (int lrow = 0; lrow < batch_size_; lrow++) {
-          if (step >= min_sequence_length && step >= sequence_lengths[lrow]) {
-            auto dst = outputs.begin() + step * output_step_length + lrow * hidden_size_;
-            std::fill_n(dst, hidden_size_, (T)0);
-          }
-        }
-      }
+      finish_step(batched_output, step, 0, batch_size_);
 
       previous_state = batched_output;
       previous_state_end = batched_output_end;
@@ -977,8 +1174,6 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 }
 
-// #define PREVIOUS_BROKEN_VERSION
-
 template <typename T>
 void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_end,
                                              span_T_iter& C_prev, span_T_iter& C_prev_end,  // Ct-1 value not 'ct'. using 'C' for clarity
@@ -989,6 +1184,8 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
                                              const int step,
                                              const int row,
                                              const int local_fused_hidden_rows,
+                                             const int col,
+                                             const int cols,
                                              bool output_sequence) {
   int hidden_size_x4 = 4 * hidden_size_;
 
@@ -996,8 +1193,8 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
   for (int b = 0; b < local_fused_hidden_rows; b++) {
     if (step >= min_sequence_length && step >= seq_lengths[row + b]) {
       if (output_sequence) {
-        auto fill_output = batched_output + (row + b) * hidden_size_;
-        std::fill(fill_output, fill_output + hidden_size_, T{});
+        auto fill_output = batched_output + (row + b) * hidden_size_ + col;
+        std::fill(fill_output, fill_output + cols, T{});
       }
 
       continue;
@@ -1005,125 +1202,101 @@ void UniDirectionalLstm<T>::GateComputations(span_T_iter& out, span_T_iter& out_
 
     // std::string row_str = " row[" + std::to_string(row + b) + "]";
 
-    // check that we have hidden_size_x4 left starting at cur_out + b * hidden_size_x4, and get a raw pointer to that
-    float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
-    float* po = pi + hidden_size_;
-    float* pf = po + hidden_size_;
-    float* pc = pf + hidden_size_;
+    // the i, o, f and c values of the tile are next to each other. check that we have 4 * cols left starting at
+    // the tile, and get a raw pointer to that
+    float* pi = SafeRawPointer<T>(out + b * hidden_size_x4 + 4 * col, out_end, 4 * cols);
+    float* po = pi + cols;
+    float* pf = po + cols;
+    float* pc = pf + cols;
 
-#ifdef PREVIOUS_BROKEN_VERSION
-    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev, C_prev_end, hidden_size_);
-#else
-    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
-#endif
+    float* pCprev_hidden_size = SafeRawPointer<T>(C_prev + b * hidden_size_ + col, C_prev_end, cols);
 
-    // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
+    // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, cols);
 
     // Input Gate
     if (use_peepholes_) {
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_),
-                                   pi, hidden_size_);
+      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, col, cols),
+                                   pi, cols);
     }
 
-    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
-    activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
+    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, col, cols) : nullptr;
+    clip_with_bias_ptr_(clip_, pBi, pi, cols);  // post: pi has input to f() to calculate i
+    activation_f_.func(pi, cols, activation_f_.alpha, activation_f_.beta);
+    // DumpMatrix("i" + row_str, pi, 1, cols);
 
     // Forget Gate
     if (input_forget_) {
-      for (int i = 0; i < hidden_size_; i++)
+      for (int i = 0; i < cols; i++)
         pf[i] = 1.0f - pi[i];
     } else {
       if (use_peepholes_) {
-        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_),
-                                     pf, hidden_size_);
+        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, col, cols),
+                                     pf, cols);
       }
 
-      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
-      clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
-      activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, col, cols) : nullptr;
+      clip_with_bias_ptr_(clip_, pBf, pf, cols);
+      activation_f_.func(pf, cols, activation_f_.alpha, activation_f_.beta);
     }
 
-    // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
+    // DumpMatrix("f" + row_str, pf, 1, cols);
 
     // Block Gate
-    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBc, pc, hidden_size_);
-    activation_g_.func(pc, hidden_size_, activation_g_.alpha, activation_g_.beta);
+    const float* pBc = use_bias_ ? SafeRawConstPointer<T>(bias_WRc_, col, cols) : nullptr;
+    clip_with_bias_ptr_(clip_, pBc, pc, cols);
+    activation_g_.func(pc, cols, activation_g_.alpha, activation_g_.beta);
 
-    // DumpMatrix("c" + row_str, pc, 1, hidden_size_);
+    // DumpMatrix("c" + row_str, pc, 1, cols);
 
     // C_current. use previous C value as input, and update in-place
     float* pC_cur = pCprev_hidden_size;
-#ifdef PREVIOUS_BROKEN_VERSION
-    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size + b * hidden_size_, pi, pf, pc, pCprev_hidden_size + b * hidden_size_, hidden_size_);
-    // DumpMatrix("C", pCprev_hidden_size + b * hidden_size_, 1, hidden_size_);
-#else
-    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, hidden_size_);
-    // DumpMatrix("C", pC_cur, 1, hidden_size_);
-#endif
+    deepcpu::merge_lstm_gates_to_memory(pCprev_hidden_size, pi, pf, pc, pC_cur, cols);
+    // DumpMatrix("C", pC_cur, 1, cols);
 
     // Output Gate
     if (use_peepholes_)
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_),
-                                   po, hidden_size_);
+      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, col, cols),
+                                   po, cols);
 
     // calculate 'ot'
-    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
-    activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("o" + row_str, po, 1, hidden_size_);
+    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, col, cols) : nullptr;
+    clip_with_bias_ptr_(clip_, pBo, po, cols);
+    activation_f_.func(po, cols, activation_f_.alpha, activation_f_.beta);
+    // DumpMatrix("o" + row_str, po, 1, cols);
 
     // calculate 'Ht'
-    float* pH = SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_,
-                                  batched_output_end, hidden_size_);
+    float* pH = SafeRawPointer<T>(batched_output + (row + b) * hidden_size_ + col, batched_output_end, cols);
 
     // the C_prev_clipped location is not actually used as input - it's temporary storage for writing
-    // the clipped Ct value to, before calling h(). As such a) it could just be a local variable
-    // of std::vector<float> with size of hidden_size_, b) the previous version wasn't 'broken' by never
-    // incrementing what C_prev_clipped pointed to.
-#ifdef PREVIOUS_BROKEN_VERSION
-    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped, C_prev_clipped_end, hidden_size_);
-#else
-    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_, C_prev_clipped_end, hidden_size_);
-#endif
+    // the clipped Ct value to, before calling h().
+    float* pC_prev_clipped = SafeRawPointer<T>(C_prev_clipped + b * hidden_size_ + col, C_prev_clipped_end, cols);
 
-    activation_h_.func(pC_cur, pC_prev_clipped, po, pH, hidden_size_, activation_h_.alpha, activation_h_.beta);
+    activation_h_.func(pC_cur, pC_prev_clipped, po, pH, cols, activation_h_.alpha, activation_h_.beta);
 
-    // DumpMatrix("H" + row_str, pH, 1, hidden_size_);
+    // DumpMatrix("H" + row_str, pH, 1, cols);
   }
 
-  auto num_rows = local_fused_hidden_rows - row;
-  std::string rows_str = " rows[" + std::to_string(row) + ".." + std::to_string(num_rows) + "]";
+#if defined(DUMP_MATRIXES)
+  std::string rows_str = " rows[" + std::to_string(row) + ".." + std::to_string(row + local_fused_hidden_rows) +
+                         "] cols[" + std::to_string(col) + ".." + std::to_string(col + cols) + "]";
+#endif
 
-  DumpMatrix("i" + rows_str, &*out, num_rows, hidden_size_, 0, hidden_size_x4);
-  DumpMatrix("o" + rows_str, &*out, num_rows, hidden_size_, 1 * hidden_size_, hidden_size_x4);
-  DumpMatrix("f" + rows_str, &*out, num_rows, hidden_size_, 2 * hidden_size_, hidden_size_x4);
-  DumpMatrix("c" + rows_str, &*out, num_rows, hidden_size_, 3 * hidden_size_, hidden_size_x4);
-  DumpMatrix("C" + rows_str, &*C_prev, num_rows, hidden_size_);  // Ct overwrites the input C_prev value
-  DumpMatrix("H" + rows_str, &*batched_output, num_rows, hidden_size_);
+  DumpMatrix("i" + rows_str, &*out, local_fused_hidden_rows, cols, 4 * col, hidden_size_x4);
+  DumpMatrix("o" + rows_str, &*out, local_fused_hidden_rows, cols, 4 * col + cols, hidden_size_x4);
+  DumpMatrix("f" + rows_str, &*out, local_fused_hidden_rows, cols, 4 * col + 2 * cols, hidden_size_x4);
+  DumpMatrix("c" + rows_str, &*out, local_fused_hidden_rows, cols, 4 * col + 3 * cols, hidden_size_x4);
+  DumpMatrix("C" + rows_str, &*C_prev, local_fused_hidden_rows, cols, col, hidden_size_);  // Ct overwrites the input C_prev value
+  DumpMatrix("H" + rows_str, &*batched_output, local_fused_hidden_rows, cols, row * hidden_size_ + col, hidden_size_);
 }
 
 template <typename T>
-void UniDirectionalLstm<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
-
-  if (threads < 1)
-    threads = 1;
+void UniDirectionalLstm<T>::SetNumThreads(const RnnParallelism& parallelism) {
+  // the batch rows are split once for the whole sequence, the tiles of hidden units once per step
+  hidden_num_threads_ = std::max(parallelism.partitions, 1);
+  batch_parallel_ = parallelism.batch_parallel;
+  tile_parallel_ = parallelism.hidden_parallel;
 
-  hidden_num_threads_ = threads;
-  batch_parallel_ = false;
-
-  // for readability of the below logic
-  const auto num_rows = batch_size_;
-  const auto num_columns = hidden_size_;
-
-  // parallelize by partitioning the batch rows
-  if (num_rows > 4 || (num_rows >= 2 && num_columns <= 256)) {
-    batch_parallel_ = true;
-    VLOGS(logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
-  }
+  VLOGS(logger_, 1) << "Hidden Threads : " << hidden_num_threads_;
 }
 
 }  // namespace detail
@@ -16,10 +16,15 @@ namespace onnxruntime {
 
 /// The class represents DeepCPU implementation of a long short term memory (LSTM) operator.
 /// For details, refer to http://aka.ms/dl-optimization/.
-class DeepCpuLstmOp final : public OpKernel {
+/// With quantize_weights the weights are quantized to int8 once, the inputs and the hidden state of each step are
+/// quantized to uint8 as they are used, and the GEMMs accumulate in int32. This is the DynamicQuantizeLSTM
+/// contrib operator.
+class DeepCpuLstmOp : public OpKernel {
  public:
-  DeepCpuLstmOp(const OpKernelInfo& info)
-      : OpKernel(info), clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())) {
+  DeepCpuLstmOp(const OpKernelInfo& info, bool quantize_weights = false)
+      : OpKernel(info),
+        clip_(info.GetAttrOrDefault<float>("clip", std::numeric_limits<float>::max())),
+        quantize_weights_(quantize_weights) {
     std::string direction;
     ORT_ENFORCE(info.GetAttr("direction", &direction).IsOK());
 
@@ -52,6 +57,8 @@ class DeepCpuLstmOp final : public OpKernel {
     activation_funcs_ = rnn::detail::ActivationFuncs(activation_func_names,
                                                      activation_func_alphas,
                                                      activation_func_betas);
+
+    PrePackWeights(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -72,6 +79,8 @@ class DeepCpuLstmOp final : public OpKernel {
                         const Tensor* P,
                         int batch_size) const;
 
+  void PrePackWeights(const OpKernelInfo& info);
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
@@ -81,6 +90,17 @@ class DeepCpuLstmOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W and R for all directions in the layout produced by rnn::detail::PackGateWeights. Packed once here when
+  // they are constant initializers, otherwise packed by each call to Compute.
+  std::vector<float> packed_input_weights_;
+  std::vector<float> packed_recurrent_weights_;
+
+  // With quantize_weights_, the packed W and R of each direction quantized to int8. These replace the fp32 packed
+  // weights when W and R are constant initializers, otherwise they are quantized by each call to Compute.
+  bool quantize_weights_;
+  std::vector<rnn::detail::QuantizedWeights> quantized_input_weights_;
+  std::vector<rnn::detail::QuantizedWeights> quantized_recurrent_weights_;
+
   // Threadpool for operator. If concurrent Compute calls are possible, it will be shared
   // across them. mutable due to this.
   // The alternative would be to create a threadpool in each call to Compute but that would incur thread creation
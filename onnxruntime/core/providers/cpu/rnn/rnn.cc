@@ -7,6 +7,10 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
     RNN,
@@ -130,9 +134,8 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
 
   // X * W^t, each direction has shape of [seq_length, batch_size, hidden_size]
-  auto x_matmul_data = alloc->Alloc(sizeof(float) * seq_length * batch_size * hidden_size_);
+  auto x_matmul_data = alloc->Alloc(sizeof(float) * num_directions * seq_length * batch_size * hidden_size_);
   BufferUniquePtr x_matmul_buffer(x_matmul_data, BufferDeleter(alloc));
-  float* x_matmul_w_buffer_data = static_cast<float*>(x_matmul_buffer.get());
 
   float* Y_buffer_data;
   void* Y_data;
@@ -147,9 +150,36 @@ Status RNN<float>::Compute(OpKernelContext* ctx) const {
 
   int64_t Y_frame_size = batch_size * hidden_size_;
 
+  std::vector<std::function<float(float, float, float)>> activation_funcs;
+  for (int direction = 0; direction < num_directions; direction++) {
+    activation_funcs.push_back(GetFuncByName<float>(activations_[direction], "Tanh"));
+  }
+
+#ifdef USE_OPENMP
+  const int threads = omp_get_max_threads();
+#else
+  const int threads = 1;
+#endif
+
+  // MLAS splits the GEMMs of a direction across the threads, but a direction that runs concurrently with the other
+  // one is inside a parallel region already and its GEMMs run on a single thread
+  const bool concurrent_directions =
+      ChooseRnnParallelism(static_cast<int>(num_directions), static_cast<int>(seq_length),
+                           static_cast<int>(batch_size), static_cast<int>(hidden_size_), 1,
+                           static_cast<int>(batch_size), static_cast<int>(hidden_size_), threads)
+          .concurrent_directions;
+
+  // the directions only share the inputs and write to separate frames of Y and Y_h
+#ifdef USE_OPENMP
+#pragma omp parallel for num_threads(2) if (concurrent_directions)
+#else
+  ORT_UNUSED_PARAMETER(concurrent_directions);
+#endif
   for (int direction = 0; direction < num_directions; direction++) {
-    auto activation_func = GetFuncByName<float>(activations_[direction], "Tanh");
+    const auto& activation_func = activation_funcs[direction];
     bool isReverse = direction_ == "reverse" || direction == 1;
+    float* x_matmul_w_buffer_data = static_cast<float*>(x_matmul_buffer.get()) +
+                                    direction * seq_length * batch_size * hidden_size_;
 
     if (B != nullptr) {
       EigenMatrixMapRowMajor<float>(x_matmul_w_buffer_data, seq_length * batch_size, hidden_size_).rowwise() =
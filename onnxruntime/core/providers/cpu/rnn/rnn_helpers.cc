@@ -13,6 +13,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/rnn/rnn_activation_functors.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
@@ -203,6 +204,189 @@ void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
   std::cout << std::endl;
 }
 
+void PackGateWeights(const float* weights, int num_gates, int hidden_size, int K, int tile_size, float* packed) {
+  const int N = num_gates * hidden_size;
+
+  for (int gate = 0; gate < num_gates; ++gate) {
+    for (int unit = 0; unit < hidden_size; ++unit) {
+      const float* src = weights + (gate * hidden_size + unit) * K;
+      float* dst = packed + PackedGateColumn(gate, unit, num_gates, hidden_size, tile_size);
+
+      for (int k = 0; k < K; ++k) {
+        dst[k * N] = src[k];
+      }
+    }
+  }
+}
+
+void QuantizeWeights(const float* packed, int K, int N, const std::vector<int>& block_columns,
+                     QuantizedWeights& quantized) {
+  ORT_ENFORCE(!block_columns.empty() && block_columns.front() == 0 && block_columns.back() < N,
+              "Invalid column blocks for the quantized weights.");
+
+  std::vector<int8_t> data(static_cast<size_t>(K) * N);
+  quantized.scales.resize(N);
+  quantized.column_sums.resize(N);
+
+  for (int n = 0; n < N; ++n) {
+    float max_abs = 0.f;
+    for (int k = 0; k < K; ++k) {
+      max_abs = std::max(max_abs, std::abs(packed[k * N + n]));
+    }
+
+    // use [-127, 127] so the range is symmetric around 0
+    const float scale = max_abs > 0.f ? max_abs / 127.f : 1.f;
+    int32_t sum = 0;
+    for (int k = 0; k < K; ++k) {
+      const float value = std::nearbyint(packed[k * N + n] / scale);
+      const auto q = static_cast<int8_t>(std::min(127.f, std::max(-127.f, value)));
+      data[k * N + n] = q;
+      sum += q;
+    }
+
+    quantized.scales[n] = scale;
+    quantized.column_sums[n] = sum;
+  }
+
+  quantized.block_columns = block_columns;
+  quantized.block_columns.push_back(N);
+  quantized.packed_blocks.resize(block_columns.size());
+
+  for (size_t block = 0; block < block_columns.size(); ++block) {
+    const int column = quantized.block_columns[block];
+    const int columns = quantized.block_columns[block + 1] - column;
+    ORT_ENFORCE(columns > 0, "Invalid column blocks for the quantized weights.");
+
+    std::vector<uint8_t>& packed_block = quantized.packed_blocks[block];
+    packed_block.resize(MlasQgemmPackBSize(columns, K));
+    MlasQgemmPackB(columns, K, data.data() + column, N, 0, packed_block.data());
+  }
+}
+
+void QuantizeRows(const float* A, int M, int K, int lda, uint8_t* quantized, float* scales, uint8_t* zero_points) {
+  for (int m = 0; m < M; ++m) {
+    const float* row = A + m * lda;
+    uint8_t* quantized_row = quantized + m * K;
+
+    float min_value = 0.f;
+    float max_value = 0.f;
+    for (int k = 0; k < K; ++k) {
+      min_value = std::min(min_value, row[k]);
+      max_value = std::max(max_value, row[k]);
+    }
+
+    float scale = (max_value - min_value) / 255.f;
+    float zero_point = 0.f;
+    if (scale > 0.f) {
+      zero_point = std::min(255.f, std::max(0.f, std::nearbyint(-min_value / scale)));
+    } else {
+      scale = 1.f;
+    }
+
+    for (int k = 0; k < K; ++k) {
+      const float value = std::nearbyint(row[k] / scale) + zero_point;
+      quantized_row[k] = static_cast<uint8_t>(std::min(255.f, std::max(0.f, value)));
+    }
+
+    scales[m] = scale;
+    zero_points[m] = static_cast<uint8_t>(zero_point);
+  }
+}
+
+void QuantizedGemm(int M, int N, int K,
+                   const uint8_t* A, int lda, const float* row_scales, const uint8_t* row_zero_points,
+                   const QuantizedWeights& B, int column, int32_t* products, int ldp,
+                   bool accumulate, float* C, int ldc) {
+  const auto found = std::lower_bound(B.block_columns.cbegin(), B.block_columns.cend(), column);
+  ORT_ENFORCE(found != B.block_columns.cend() - 1 && *found == column && *(found + 1) - column == N,
+              "Columns ", column, " to ", column + N, " are not a packed block of the quantized weights.");
+  const auto block = static_cast<size_t>(found - B.block_columns.cbegin());
+
+  // A is quantized per row, so its zero points are removed below rather than passed to MLAS
+  MlasQgemmPackedB(M, N, K, A, lda, 0, B.packed_blocks[block].data(), products, ldp, nullptr);
+
+  const float* column_scales = B.scales.data() + column;
+  const int32_t* column_sums = B.column_sums.data() + column;
+
+  for (int m = 0; m < M; ++m) {
+    const int32_t* p = products + m * ldp;
+    const float row_scale = row_scales[m];
+    const int32_t row_zero_point = row_zero_points[m];
+    float* c = C + m * ldc;
+
+    // sum((a - zero_point) * b) == sum(a * b) - zero_point * sum(b)
+    for (int n = 0; n < N; ++n) {
+      const int32_t product = p[n] - row_zero_point * column_sums[n];
+      const float value = row_scale * column_scales[n] * static_cast<float>(product);
+      c[n] = accumulate ? c[n] + value : value;
+    }
+  }
+}
+
+// Estimated cost, in multiply-adds, of handing a piece of work to the thread pool and waiting for it.
+static constexpr double kParallelTaskOverhead = 32 * 1024;
+
+RnnParallelism ChooseRnnParallelism(int num_directions, int seq_length, int batch_size, int hidden_size,
+                                    int num_gates, int batch_partitions, int hidden_partitions, int threads) {
+  // the recurrent GEMM dominates the work of a step
+  const double step_cost = static_cast<double>(batch_size) * num_gates * hidden_size * hidden_size;
+  const double steps = std::max(seq_length, 1);
+
+  // fastest way to run one direction when 'workers' threads of the pool are free to take its tasks.
+  // splitting n items into tasks of ceil(n / p) items costs as much as the largest task.
+  auto plan_direction = [&](int workers, RnnParallelism& plan) {
+    double best = step_cost * steps;
+
+    const int batch_tasks = std::min({workers, batch_partitions, batch_size});
+    if (batch_tasks > 1) {
+      const int rows_per_task = (batch_size + batch_tasks - 1) / batch_tasks;
+      const double cost = step_cost * steps * rows_per_task / batch_size + kParallelTaskOverhead;
+      if (cost < best) {
+        best = cost;
+        plan.batch_parallel = true;
+        plan.partitions = batch_tasks;
+      }
+    }
+
+    const int hidden_tasks = std::min(workers, hidden_partitions);
+    if (hidden_tasks > 1) {
+      const int pieces_per_task = (hidden_partitions + hidden_tasks - 1) / hidden_tasks;
+      const double cost = (step_cost * pieces_per_task / hidden_partitions + kParallelTaskOverhead) * steps;
+      if (cost < best) {
+        best = cost;
+        plan.batch_parallel = false;
+        plan.hidden_parallel = true;
+        plan.partitions = hidden_tasks;
+      }
+    }
+
+    return best;
+  };
+
+  // the calling thread waits while the pool runs the tasks
+  threads = std::max(threads, 1);
+  RnnParallelism sequential;
+  const double sequential_cost = num_directions * plan_direction(std::max(threads - 1, 1), sequential);
+  if (num_directions < 2 || threads < 2) {
+    return sequential;
+  }
+
+  // two threads of the pool run the directions. a task of the pool that waited for other tasks of the same pool
+  // could deadlock once all the threads are waiting, e.g. when several Run calls share the kernel, so each
+  // direction runs its steps on its own thread.
+  RnnParallelism concurrent;
+  concurrent.concurrent_directions = true;
+  const double concurrent_cost = plan_direction(1, concurrent) + kParallelTaskOverhead;
+
+  return concurrent_cost < sequential_cost ? concurrent : sequential;
+}
+
+void ComputeQuantizedGemm(int M, int N, int K, const float* A, const QuantizedWeights& B, float* C,
+                          uint8_t* quantized_A, float* row_scales, uint8_t* row_zero_points, int32_t* products) {
+  QuantizeRows(A, M, K, K, quantized_A, row_scales, row_zero_points);
+  QuantizedGemm(M, N, K, quantized_A, K, row_scales, row_zero_points, B, 0, products, N, false, C, N);
+}
+
 namespace deepcpu {
 
 const float alpha_1 = 4.89352455891786e-03f;
@@ -8,6 +8,7 @@
 #endif
 
 #include <algorithm>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <string>
@@ -180,6 +181,89 @@ void ComputeGemm(const int M,
       &*C, ldc, &CPUMathUtil::Instance());
 }
 
+// A has size M x K, B has size K x N (as produced by PackGateWeights), and C has size M x N
+// We check that A, B and C are large enough before calling the lower level GEMM implementation
+template <typename TSpanAIter, typename TSpanBIter, typename TSpanCIter>
+void ComputeGemmPackedB(const int M,
+                        const int N,
+                        const int K,
+                        const float alpha,
+                        TSpanAIter A,
+                        TSpanAIter A_end,
+                        const int lda,
+                        TSpanBIter B,
+                        TSpanBIter B_end,
+                        const int ldb,
+                        const float beta,
+                        TSpanCIter C,
+                        TSpanCIter C_end,
+                        const int ldc) {
+  // validate all the inputs
+  // need to use the lda/ldb/ldc strides which should be >= the columns for the span
+  ORT_ENFORCE(lda >= K && ldb >= N && ldc >= N);
+  ORT_ENFORCE(A + (M * lda - (lda - K)) <= A_end);
+  ORT_ENFORCE(B + (K * ldb - (ldb - N)) <= B_end);
+  ORT_ENFORCE(C + (M * ldc - (ldc - N)) <= C_end);
+
+  ::onnxruntime::math::GemmEx<float, CPUMathUtil>(
+      CblasNoTrans, CblasNoTrans,
+      M, N, K, alpha,
+      &*A, lda,
+      &*B, ldb, beta,
+      &*C, ldc, &CPUMathUtil::Instance());
+}
+
+/// Column of the packed gate weights, and of the GEMM output computed with them, that holds the given hidden
+/// unit of the given gate. The hidden units are split into tiles of tile_size units and each tile stores the
+/// columns of all of its gates next to each other, so the recurrent GEMM and the gate computations of one tile
+/// can run back to back on data that is still in the cache. A tile_size of at least hidden_size keeps the gates
+/// in their original order.
+inline int PackedGateColumn(int gate, int unit, int num_gates, int hidden_size, int tile_size) {
+  const int tile_start = unit - unit % tile_size;
+  const int tile_width = std::min(tile_size, hidden_size - tile_start);
+  return num_gates * tile_start + gate * tile_width + (unit - tile_start);
+}
+
+/// Transpose the weights of one direction, W or R with shape [num_gates * hidden_size, K], into a
+/// [K, num_gates * hidden_size] matrix whose columns are ordered by PackedGateColumn. GEMM reads this layout
+/// without transposing it on every call.
+void PackGateWeights(const float* weights, int num_gates, int hidden_size, int K, int tile_size, float* packed);
+
+/// Packed weights of one direction, [K, N] as produced by PackGateWeights, quantized to int8 for the dynamically
+/// quantized operators. Each column has its own symmetric scale, and column_sums holds the sum of the quantized
+/// values of each column so QuantizedGemm can remove the zero point of its activations after the integer GEMM.
+/// A matrix packed for MlasQgemmPackedB can only be read whole, so each range of columns that a GEMM reads is
+/// packed on its own: packed_blocks[i] holds the columns [block_columns[i], block_columns[i + 1]).
+struct QuantizedWeights {
+  std::vector<float> scales;
+  std::vector<int32_t> column_sums;
+  std::vector<int> block_columns;
+  std::vector<std::vector<uint8_t>> packed_blocks;
+};
+
+/// Quantize the [K, N] packed weights and pack the blocks of columns that start at block_columns, which begins
+/// with 0 and is increasing.
+void QuantizeWeights(const float* packed, int K, int N, const std::vector<int>& block_columns,
+                     QuantizedWeights& quantized);
+
+/// Quantize the M x K activations in A to an M x K uint8 matrix with an asymmetric scale and zero point per row.
+/// The range of each row always includes 0 so that zero padding is represented exactly.
+void QuantizeRows(const float* A, int M, int K, int lda, uint8_t* quantized, float* scales, uint8_t* zero_points);
+
+/// C = A * B[:, column:column + N], or C += A * B[:, column:column + N] when accumulate is true, with A quantized
+/// by QuantizeRows and the columns one of the packed blocks of B. The int32 products are written to the M x N
+/// matrix 'products' by MlasQgemmPackedB and dequantized into C.
+void QuantizedGemm(int M, int N, int K,
+                   const uint8_t* A, int lda, const float* row_scales, const uint8_t* row_zero_points,
+                   const QuantizedWeights& B, int column, int32_t* products, int ldp,
+                   bool accumulate, float* C, int ldc);
+
+/// C = A * B for the M x K activations in A and the int8 weights in B, packed as a single block, as used for the
+/// input projection of the dynamically quantized operators. A is quantized into the M x K buffer quantized_A, with
+/// M row_scales and row_zero_points, and products is the M x N buffer for the int32 results.
+void ComputeQuantizedGemm(int M, int N, int K, const float* A, const QuantizedWeights& B, float* C,
+                          uint8_t* quantized_A, float* row_scales, uint8_t* row_zero_points, int32_t* products);
+
 // helper to convert a span to a raw pointer
 // after validating the memory covered by the span supports the size required
 template <typename T>
@@ -195,7 +279,7 @@ const T* SafeRawConstPointer(typename gsl::span<T>::const_iterator cur,
 template <typename T>
 const T* SafeRawConstPointer(gsl::span<T> span, size_t offset, size_t size) {
   ORT_ENFORCE(offset + size <= size_t(span.size()));
-  return span.data();
+  return span.data() + offset;
 }
 
 // helper to convert a span to a raw pointer
@@ -272,6 +356,24 @@ void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, i
 #endif  // else part of #ifdef NOTHREADS
 }
 
+/// How the work of a recurrent operator is spread across threads. The steps of a direction are sequential, so a
+/// step can only be split by batch rows or by hidden units, and the two directions of a bidirectional operator are
+/// independent and can run at the same time.
+struct RnnParallelism {
+  bool concurrent_directions = false;  ///< run the forward and reverse directions at the same time
+  bool batch_parallel = false;         ///< split the batch rows of a direction into 'partitions' tasks
+  bool hidden_parallel = false;        ///< split the hidden units of each step into 'partitions' tasks
+  int partitions = 1;
+};
+
+/// Estimate the time of the ways to run a recurrent operator on 'threads' threads and return the fastest.
+/// 'batch_partitions' and 'hidden_partitions' are the largest number of pieces the implementation can split
+/// the batch rows and the hidden units of a direction into, with 1 meaning it doesn't split them. Batch rows are
+/// split once for the whole sequence and hidden units once per step. Directions that run concurrently are tasks of
+/// the thread pool and must not wait on it, so they don't split their work any further.
+RnnParallelism ChooseRnnParallelism(int num_directions, int seq_length, int batch_size, int hidden_size,
+                                    int num_gates, int batch_partitions, int hidden_partitions, int threads);
+
 void DumpMatrixImpl(const std::string& name, const float* src, int row, int col,
                     int offset = 0, int col_width = -1);
 
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/strided_copy.h"
 
 namespace onnxruntime {
 
@@ -93,16 +94,17 @@ Status Concat::Compute(OpKernelContext* ctx) const {
 
     // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
     uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
-    for (int idxCopy = 0; idxCopy < input_size / input_axis_pitch; ++idxCopy) {
-      if (is_string_type) {
+    if (is_string_type) {
+      for (int idxCopy = 0; idxCopy < input_size / input_axis_pitch; ++idxCopy) {
         for (int idxItem = 0; idxItem < input_axis_pitch; ++idxItem)
           reinterpret_cast<std::string*>(output)[output_offset + idxCopy * p.output_axis_pitch + idxItem] =
               reinterpret_cast<const std::string*>(input)[idxCopy * input_axis_pitch + idxItem];
-      } else
-        memcpy(
-            output + (output_offset + idxCopy * p.output_axis_pitch) * element_bytes,
-            input + idxCopy * input_axis_pitch * element_bytes,
-            input_axis_pitch * element_bytes);
+      }
+    } else if (input_size > 0) {
+      const int64_t extents[] = {input_size / input_axis_pitch, input_axis_pitch};
+      const int64_t output_pitches[] = {p.output_axis_pitch, 1};
+      const int64_t input_pitches[] = {input_axis_pitch, 1};
+      StridedCopy(output + output_offset * element_bytes, output_pitches, input, input_pitches, extents, element_bytes);
     }
     output_offset += input_axis_pitch;
   }
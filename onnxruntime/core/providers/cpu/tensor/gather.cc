@@ -3,6 +3,7 @@
 
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
+#include "core/providers/cpu/tensor/gather_rows.h"
 #include "core/common/common.h"
 
 namespace onnxruntime {
@@ -38,33 +39,43 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
   // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
-  for (int64_t i = 0; i < N; ++i) {
-    Tin idx = indices_data[i];
-    if (idx < 0 || idx >= input_data_shape[axis]) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=", idx,
-                             " data_dim=", input_data_shape[axis]);
-    }
+  // We can't merge this code in the copy loop below as omp does not allow return in the loop
+  if (!GatherIndicesInRange(indices_data, N, input_data_shape[axis])) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "indices element out of data bounds, idx=",
+                           FindInvalidGatherIndex(indices_data, N, input_data_shape[axis]),
+                           " data_dim=", input_data_shape[axis]);
   }
 
+  if (is_string_type) {
 #ifdef USE_OPENMP
 #pragma omp parallel for
 #endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N, i = index % N;
+    for (int64_t index = 0; index < M * N; ++index) {
+      int64_t batch = index / N, i = index % N;
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
+      const int64_t src_offset_batch = batch * data_batch_bytes;
+      const int64_t dst_offset_batch = batch * gathered_batch_bytes;
+      Tin idx = indices_data[i];
+      const int64_t src_offset = src_offset_batch + idx * block_size;
+      const int64_t dst_offset = dst_offset_batch + i * block_size;
 
-    if (is_string_type) {
       reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
           reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
     }
+    return Status::OK();
+  }
+
+  // The output is M batches of N consecutive blocks, so the destination rows are dense.
+  if (M == 1) {
+    GatherRows(N, static_cast<size_t>(block_size), dst_base,
+               [src_base, indices_data, block_size](int64_t i) {
+                 return src_base + indices_data[i] * block_size;
+               });
+  } else {
+    GatherRows(M * N, static_cast<size_t>(block_size), dst_base,
+               [src_base, indices_data, block_size, data_batch_bytes, N](int64_t index) {
+                 return src_base + (index / N) * data_batch_bytes + indices_data[index % N] * block_size;
+               });
   }
 
   return Status::OK();
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace onnxruntime {
+
+// Helpers shared by the Gather style kernels (Gather, GatherND) to copy fixed size rows selected by an index
+// tensor. Embedding lookups are the typical workload: a large table, thousands of random rows, each a few
+// hundred bytes, so the copy is bound by memory latency rather than bandwidth.
+
+// Number of rows ahead of the current one to prefetch.
+constexpr int64_t kGatherPrefetchDistance = 8;
+// Number of rows copied by a single unit of parallel work.
+constexpr int64_t kGatherRowsPerBlock = 256;
+// Minimum number of output bytes before the copy is spread across threads.
+constexpr int64_t kGatherParallelMinBytes = 256 * 1024;
+
+inline void PrefetchGatherRow(const void* row) {
+#if defined(__GNUC__)
+  __builtin_prefetch(row);
+#elif defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(row), _MM_HINT_T0);
+#else
+  (void)row;
+#endif
+}
+
+// Returns true if every index is in the range [0, limit). The indices are compared as unsigned values so that
+// negative indices fold into the upper bound check and the loop reduces to a single vectorizable max.
+template <typename Tind>
+bool GatherIndicesInRange(const Tind* indices, int64_t count, int64_t limit) {
+  using UTind = typename std::make_unsigned<Tind>::type;
+  if (count == 0) {
+    return true;
+  }
+  if (limit <= 0) {
+    return false;
+  }
+  UTind max_index = 0;
+  for (int64_t i = 0; i < count; ++i) {
+    max_index = std::max(max_index, static_cast<UTind>(indices[i]));
+  }
+  return static_cast<uint64_t>(max_index) < static_cast<uint64_t>(limit);
+}
+
+// Returns the first index outside of [0, limit). Only used to build the error message once
+// GatherIndicesInRange has failed.
+template <typename Tind>
+Tind FindInvalidGatherIndex(const Tind* indices, int64_t count, int64_t limit) {
+  for (int64_t i = 0; i < count; ++i) {
+    if (indices[i] < 0 || indices[i] >= limit) {
+      return indices[i];
+    }
+  }
+  return 0;
+}
+
+// Row size known at compile time, so the copy is inlined as a single load/store.
+template <size_t RowBytes, typename SourceFn>
+void GatherRowsBlockFixed(int64_t begin, int64_t end, uint8_t* dst_base, SourceFn source) {
+  for (int64_t i = begin; i < end; ++i) {
+    if (i + kGatherPrefetchDistance < end) {
+      PrefetchGatherRow(source(i + kGatherPrefetchDistance));
+    }
+    memcpy(dst_base + i * RowBytes, source(i), RowBytes);
+  }
+}
+
+template <typename SourceFn>
+void GatherRowsBlock(int64_t begin, int64_t end, size_t row_bytes, uint8_t* dst_base, SourceFn source) {
+  for (int64_t i = begin; i < end; ++i) {
+    if (i + kGatherPrefetchDistance < end) {
+      PrefetchGatherRow(source(i + kGatherPrefetchDistance));
+    }
+    memcpy(dst_base + i * row_bytes, source(i), row_bytes);
+  }
+}
+
+// Copies 'count' rows of 'row_bytes' each into the contiguous 'dst_base'. 'source(i)' returns the address of
+// the i-th source row. Rows of 4 and 8 bytes are copied as single words; larger outputs are split across
+// threads in blocks of kGatherRowsPerBlock rows.
+template <typename SourceFn>
+void GatherRows(int64_t count, size_t row_bytes, uint8_t* dst_base, SourceFn source) {
+  const bool parallel = count * static_cast<int64_t>(row_bytes) >= kGatherParallelMinBytes;
+  const int64_t rows_per_block = parallel ? kGatherRowsPerBlock : std::max<int64_t>(count, 1);
+  const int64_t blocks = (count + rows_per_block - 1) / rows_per_block;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+  for (int64_t block = 0; block < blocks; ++block) {
+    const int64_t begin = block * rows_per_block;
+    const int64_t end = std::min(count, begin + rows_per_block);
+    switch (row_bytes) {
+      case sizeof(uint32_t):
+        GatherRowsBlockFixed<sizeof(uint32_t)>(begin, end, dst_base, source);
+        break;
+      case sizeof(uint64_t):
+        GatherRowsBlockFixed<sizeof(uint64_t)>(begin, end, dst_base, source);
+        break;
+      default:
+        GatherRowsBlock(begin, end, row_bytes, dst_base, source);
+        break;
+    }
+  }
+}
+
+}  // namespace onnxruntime
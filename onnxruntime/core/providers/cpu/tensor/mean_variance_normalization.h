@@ -6,6 +6,7 @@
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 
 #include "gsl/gsl_util"
 namespace onnxruntime {
@@ -42,21 +43,12 @@ class MeanVarianceNormalization_0 : public OpKernel {
     const int64_t sample_size = H * W;
     Eigen::Array<float, Eigen::Dynamic, 1> mean(C, 1);
     Eigen::Array<float, Eigen::Dynamic, 1> var(C, 1);
-    mean.setZero();
-    var.setZero();
+    MlasComputeChannelMoments(Xdata, static_cast<size_t>(N), static_cast<size_t>(C), static_cast<size_t>(sample_size),
+                              mean.data(), var.data());
 
-    ConstEigenArrayMap<T> X_arr(Xdata, sample_size, N * C);
-    for (int nc = 0; nc < N * C; ++nc) {
-      mean(nc % C) += X_arr.col(nc).sum();
-    }
-    mean /= gsl::narrow_cast<T>(N * sample_size);
-    for (int64_t nc = 0; nc < N * C; ++nc) {
-      var(nc % C) += (X_arr.col(nc) - mean(nc % C)).matrix().squaredNorm();
-    }
-    var /= gsl::narrow_cast<T>(N * sample_size);
-
-    Eigen::Array<T, Eigen::Dynamic, 1> inv_std;
-    EigenArrayMap<T> Y_arr(Ydata, sample_size, N * C);
+    // The normalization is applied as a scale and shift per channel.
+    Eigen::Array<float, Eigen::Dynamic, 1> scale(C, 1);
+    Eigen::Array<float, Eigen::Dynamic, 1> shift(C, 1);
 
     if (across_channels_) {
       // m_c = sum(m_i) / n
@@ -66,29 +58,21 @@ class MeanVarianceNormalization_0 : public OpKernel {
       //       = [sum(var_i) + squared_norm(m_i - m_c)] / n
       float global_var = ((mean - global_mean).matrix().squaredNorm() + var.sum()) / C;
 
-      // For across channels we can directly use eigen because global_mean and global_var
-      // are just scalars.
-      if (!normalize_variance_) {
-        Y_arr = X_arr - global_mean;
-      } else {
-        float inv_std_scalar = 1 / std::sqrt(global_var);
-        Y_arr = (X_arr - global_mean) * inv_std_scalar;
-      }
+      scale.setConstant(normalize_variance_ ? 1 / std::sqrt(global_var) : 1.0f);
+      shift = -global_mean * scale;
     } else {
       if (!normalize_variance_) {
-        // inv_std = 1
-        for (int64_t nc = 0; nc < N * C; ++nc) {
-          // y = (x - mean)
-          Y_arr.col(nc) = (X_arr.col(nc) - mean(nc % C));
-        }
+        // y = (x - mean)
+        scale.setOnes();
       } else {
-        inv_std = var.sqrt().inverse();
-        for (int64_t nc = 0; nc < N * C; ++nc) {
-          // y = (x - mean) * (inv_std)
-          Y_arr.col(nc) = (X_arr.col(nc) - mean(nc % C)) * inv_std(nc % C);
-        }
+        // y = (x - mean) * (inv_std)
+        scale = var.sqrt().inverse();
       }
+      shift = -mean * scale;
     }
+
+    MlasBatchNormalization(Xdata, Ydata, static_cast<size_t>(N), static_cast<size_t>(C),
+                           static_cast<size_t>(sample_size), scale.data(), shift.data());
     return Status::OK();
   }
 
@@ -9,6 +9,7 @@
 #endif
 #include "core/providers/cpu/tensor/pad.h"
 #include "core/providers/cpu/tensor/utils.h"
+#include "core/providers/cpu/tensor/strided_copy.h"
 
 namespace onnxruntime {
 
@@ -91,6 +92,60 @@ static void ReshapePads(const std::vector<int64_t>& src_pad, size_t src_dim_coun
   reshaped_pad[inner_axis + new_dim_count] = src_pad[inner_axis + src_dim_count] * inner_no_pad_size;
 }
 
+// Constant padding has no dependency between the copied data and the padding, so the input block is written with
+// a single strided copy, and only the padding around it is filled with the constant. For each axis, the padding
+// is the part of the output outside of the input extent on that axis, inside it on the outer axes, and covering
+// all of the inner axes, so every padded element is written exactly once.
+template <typename T>
+static void PadConstant(T* output, const T* input, T value,
+                        const std::vector<int64_t>& output_dims, const std::vector<int64_t>& input_dims,
+                        const std::vector<int64_t>& pads, const std::vector<int64_t>& slices,
+                        const std::vector<int64_t>& extents) {
+  const size_t dims_count = output_dims.size();
+  TensorPitches output_pitches(output_dims);
+  TensorPitches input_pitches(input_dims);
+
+  // Negative begin padding skips over the start of the input.
+  ptrdiff_t input_offset = 0;
+  ptrdiff_t output_offset = 0;
+  for (size_t i = 0; i < dims_count; i++) {
+    input_offset -= slices[i] * input_pitches[i];
+    output_offset += pads[i] * output_pitches[i];
+  }
+  StridedCopy(output + output_offset, output_pitches, input + input_offset, input_pitches, extents, sizeof(T));
+
+  std::vector<int64_t> index(dims_count, 0);
+  for (size_t axis = 0; axis < dims_count; axis++) {
+    const int64_t pre_pad = pads[axis] * output_pitches[axis];
+    const int64_t post_pad = pads[axis + dims_count] * output_pitches[axis];
+    if (pre_pad == 0 && post_pad == 0)
+      continue;
+
+    // Visit every position of the input block on the axes outside of 'axis'.
+    int64_t rows = 1;
+    for (size_t i = 0; i < axis; i++)
+      rows *= extents[i];
+    std::fill(index.begin(), index.end(), 0);
+    ptrdiff_t row_offset = 0;
+    for (size_t i = 0; i < axis; i++)
+      row_offset += pads[i] * output_pitches[i];
+
+    for (int64_t row = 0; row < rows; row++) {
+      T* axis_start = output + row_offset;
+      PadAxisConstant(axis_start, value, pre_pad);
+      PadAxisConstant(axis_start + pre_pad + extents[axis] * output_pitches[axis], value, post_pad);
+
+      for (size_t i = axis; i-- > 0;) {
+        row_offset += output_pitches[i];
+        if (++index[i] != extents[i])
+          break;
+        row_offset -= extents[i] * output_pitches[i];
+        index[i] = 0;
+      }
+    }
+  }
+}
+
 template <>
 Status Pad<float>::Compute(OpKernelContext* ctx) const {
   auto& input_tensor = *ctx->Input<Tensor>(0);
@@ -130,13 +185,19 @@ Status Pad<float>::Compute(OpKernelContext* ctx) const {
   }
   TensorShape output_shape(output_dims);
 
-  TensorShape input_shape(reshaped_input_dims);
-  SliceIterator<float> input(input_tensor, input_shape, input_starts, input_extents);
-
   // output_shape need to keep original.
   auto& output_tensor = *ctx->Output(0, output_shape);
   auto* output = output_tensor.template MutableData<float>();
 
+  if (mode_ == Mode::Constant) {
+    PadConstant(output, input_tensor.template Data<float>(), value_, reshaped_output_dims, reshaped_input_dims,
+                reshaped_pad, reshaped_slice, input_extents);
+    return Status::OK();
+  }
+
+  TensorShape input_shape(reshaped_input_dims);
+  SliceIterator<float> input(input_tensor, input_shape, input_starts, input_extents);
+
   TensorPitches output_pitches(reshaped_output_dims);
   size_t alignSkip = 0;  // Amount to skip to align to where the next input tensor data needs to be written
 
@@ -147,37 +208,6 @@ Status Pad<float>::Compute(OpKernelContext* ctx) const {
   ExtentAxisCounters input_counters(input_extents);
 
   switch (mode_) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          float* axisStart = output;
-          output = input.CopyInnermostAxis(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value_, prePad);
-          PadAxisConstant(output, value_, postPad);
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          float* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value_, prePad * inner_pitch);
-          PadAxisConstant(output, value_, postPad * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
-      break;
-
     case Mode::Edge:
       // Loop over the output tensor, writing out padding between the blocks of copied data
       // On loop entry, 'pad' is already set to the first continuous block of padding, and
@@ -239,6 +269,10 @@ Status Pad<float>::Compute(OpKernelContext* ctx) const {
         }
       }
       break;
+
+    case Mode::Constant:
+      // Handled by PadConstant above
+      break;
   }
 
   return Status::OK();
@@ -3,8 +3,7 @@
 
 #include "core/providers/cpu/tensor/split.h"
 #include "core/providers/common.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/tensor/strided_copy.h"
 
 #include "gsl/gsl_util"
 
@@ -31,11 +30,9 @@ Status Split::Compute(OpKernelContext* context) const {
     status = ComputeImpl<float>(*context, input);
   else if (data_type == DataTypeImpl::GetType<int32_t>())
     status = ComputeImpl<int32_t>(*context, input);
-  else if (data_type == DataTypeImpl::GetType<double>()) {
-    /* Need to update CopyMatrix to support double...
-    status = ComputeImpl<double>(*context, input); */
-    ORT_NOT_IMPLEMENTED("Split operator does not support double yet");
-  } else
+  else if (data_type == DataTypeImpl::GetType<double>())
+    status = ComputeImpl<double>(*context, input);
+  else
     ORT_THROW("Invalid data type for Split operator of ", data_type);
 
   return status;
@@ -96,18 +93,13 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          memcpy(dst, src, count * sizeof(T));
-        });
-
-    input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
+    const int64_t output_block_size = static_cast<int64_t>(split_size) * after_dims_excluding_split;
+    const int64_t extents[] = {before_dims, output_block_size};
+    const int64_t output_pitches[] = {output_block_size, 1};
+    const int64_t input_pitches[] = {after_dims_including_split_axis, 1};
+    StridedCopy(output_data, output_pitches, input_data + input_offset, input_pitches, extents, sizeof(T));
+
+    input_offset += output_block_size;  // offset by the N data we used in this iteration
   }
 
   return Status::OK();
@@ -0,0 +1,252 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "gsl/span"
+
+#if defined(__SSE2__) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ORT_STRIDED_COPY_STREAMING_STORES
+#endif
+
+namespace onnxruntime {
+
+// Copy helpers shared by the data movement kernels (Concat, Split, Pad, Tile, Expand). These kernels do no
+// arithmetic, so their cost is set by how well the copies use memory bandwidth: long contiguous runs, several
+// cores for large tensors, and streaming stores once the output no longer fits in the cache.
+
+// Minimum number of bytes copied before the work is spread across threads.
+constexpr int64_t kCopyParallelMinBytes = 512 * 1024;
+// Number of bytes copied by a single unit of parallel work.
+constexpr int64_t kCopyBytesPerWorkItem = 128 * 1024;
+// Minimum number of bytes copied before the destination is written with non-temporal stores. Below this the
+// output is likely to be read back from the cache by the next operator.
+constexpr int64_t kCopyNonTemporalMinBytes = 8 * 1024 * 1024;
+// Minimum length of a contiguous run for non-temporal stores to be worth the alignment prologue.
+constexpr int64_t kCopyNonTemporalMinRunBytes = 256;
+
+// Copies 'bytes' bytes, optionally bypassing the cache for the destination. The caller issues StoreFence once all
+// of the non-temporal copies of a thread are done.
+inline void CopyBytesBlock(uint8_t* dst, const uint8_t* src, size_t bytes, bool non_temporal) {
+#if defined(ORT_STRIDED_COPY_STREAMING_STORES)
+  if (non_temporal) {
+    const size_t head = std::min(bytes, (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15);
+    memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    bytes -= head;
+    for (; bytes >= 64; bytes -= 64, dst += 64, src += 64) {
+      const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+      const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+      const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+      const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst), v0);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), v1);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), v2);
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), v3);
+    }
+  }
+#else
+  (void)non_temporal;
+#endif
+  memcpy(dst, src, bytes);
+}
+
+// Orders non-temporal stores before any later store of the calling thread.
+inline void StoreFence() {
+#if defined(ORT_STRIDED_COPY_STREAMING_STORES)
+  _mm_sfence();
+#endif
+}
+
+// Copies a single contiguous range, split across threads when large.
+inline void CopyBytes(void* dst, const void* src, int64_t bytes) {
+  if (bytes < kCopyParallelMinBytes) {
+    memcpy(dst, src, static_cast<size_t>(bytes));
+    return;
+  }
+
+  const bool non_temporal = bytes >= kCopyNonTemporalMinBytes;
+  const int64_t items = (bytes + kCopyBytesPerWorkItem - 1) / kCopyBytesPerWorkItem;
+  auto* dst_bytes = static_cast<uint8_t*>(dst);
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+
+#ifdef USE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int64_t item = 0; item < items; ++item) {
+    const int64_t begin = item * kCopyBytesPerWorkItem;
+    const int64_t end = std::min(bytes, begin + kCopyBytesPerWorkItem);
+    CopyBytesBlock(dst_bytes + begin, src_bytes + begin, static_cast<size_t>(end - begin), non_temporal);
+    if (non_temporal) {
+      StoreFence();
+    }
+  }
+}
+
+// Copies an N-d block of 'extents' elements of 'element_bytes' each. 'dst_pitches' and 'src_pitches' give the
+// distance, in elements, between consecutive indices of each axis; the innermost axis must be contiguous in both.
+// Inner axes that are contiguous in both source and destination are merged so that every copy covers the
+// longest possible run, and the runs are distributed across threads for large copies.
+inline void StridedCopy(void* dst, gsl::span<const int64_t> dst_pitches,
+                        const void* src, gsl::span<const int64_t> src_pitches,
+                        gsl::span<const int64_t> extents, size_t element_bytes) {
+  const size_t rank = static_cast<size_t>(extents.size());
+  if (rank == 0) {
+    memcpy(dst, src, element_bytes);
+    return;
+  }
+  if (std::find(extents.cbegin(), extents.cend(), 0) != extents.cend()) {
+    return;
+  }
+
+  // Find the largest contiguous run.
+  size_t outer_rank = rank - 1;
+  int64_t run = extents[outer_rank];
+  while (outer_rank > 0 && dst_pitches[outer_rank - 1] == run && src_pitches[outer_rank - 1] == run) {
+    --outer_rank;
+    run *= extents[outer_rank];
+  }
+
+  int64_t runs = 1;
+  for (size_t axis = 0; axis < outer_rank; ++axis) {
+    runs *= extents[axis];
+  }
+
+  const int64_t run_bytes = run * static_cast<int64_t>(element_bytes);
+  auto* dst_bytes = static_cast<uint8_t*>(dst);
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  if (runs == 1) {
+    CopyBytes(dst_bytes, src_bytes, run_bytes);
+    return;
+  }
+
+  const int64_t total_bytes = runs * run_bytes;
+  const bool parallel = total_bytes >= kCopyParallelMinBytes;
+  const bool non_temporal = total_bytes >= kCopyNonTemporalMinBytes && run_bytes >= kCopyNonTemporalMinRunBytes;
+  const int64_t runs_per_item = parallel ? std::max<int64_t>(1, kCopyBytesPerWorkItem / run_bytes) : runs;
+  const int64_t items = (runs + runs_per_item - 1) / runs_per_item;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+  for (int64_t item = 0; item < items; ++item) {
+    const int64_t begin = item * runs_per_item;
+    const int64_t end = std::min(runs, begin + runs_per_item);
+
+    // Position on the first run of this work item.
+    std::vector<int64_t> index(outer_rank);
+    int64_t dst_offset = 0;
+    int64_t src_offset = 0;
+    int64_t remainder = begin;
+    for (size_t axis = outer_rank; axis-- > 0;) {
+      index[axis] = remainder % extents[axis];
+      remainder /= extents[axis];
+      dst_offset += index[axis] * dst_pitches[axis];
+      src_offset += index[axis] * src_pitches[axis];
+    }
+
+    for (int64_t r = begin; r < end; ++r) {
+      CopyBytesBlock(dst_bytes + dst_offset * static_cast<int64_t>(element_bytes),
+                     src_bytes + src_offset * static_cast<int64_t>(element_bytes),
+                     static_cast<size_t>(run_bytes), non_temporal);
+
+      for (size_t axis = outer_rank; axis-- > 0;) {
+        dst_offset += dst_pitches[axis];
+        src_offset += src_pitches[axis];
+        if (++index[axis] != extents[axis]) {
+          break;
+        }
+        dst_offset -= dst_pitches[axis] * extents[axis];
+        src_offset -= src_pitches[axis] * extents[axis];
+        index[axis] = 0;
+      }
+    }
+
+    if (non_temporal) {
+      StoreFence();
+    }
+  }
+}
+
+// Fills 'dst' up to 'total_bytes' by repeating its first 'filled_bytes'. Each copy doubles the filled prefix, so a
+// pattern is expanded with a logarithmic number of increasingly large copies instead of one copy per repeat.
+inline void RepeatBytes(uint8_t* dst, int64_t filled_bytes, int64_t total_bytes) {
+  while (filled_bytes < total_bytes) {
+    const int64_t bytes = std::min(filled_bytes, total_bytes - filled_bytes);
+    CopyBytes(dst + filled_bytes, dst, bytes);
+    filled_bytes += bytes;
+  }
+}
+
+// Writes 'input', with shape 'input_dims', to 'output' with axis i repeated 'repeats[i]' times. This is Tile, and
+// also Expand, where every broadcast axis has an input extent of 1 and a repeat count of its output extent. The
+// output must not be empty.
+inline void TileBytes(const void* input, void* output, const std::vector<int64_t>& input_dims,
+                      const std::vector<int64_t>& repeats, size_t element_bytes) {
+  // Merge adjacent axes that are both copied as-is (contiguous in the input) or both broadcast from a single
+  // element (their repeats multiply), and drop axes that do neither.
+  std::vector<int64_t> dims;
+  std::vector<int64_t> reps;
+  for (size_t axis = 0; axis < input_dims.size(); ++axis) {
+    if (input_dims[axis] == 1 && repeats[axis] == 1) {
+      continue;
+    }
+    if (!dims.empty() && ((repeats[axis] == 1 && reps.back() == 1) || (input_dims[axis] == 1 && dims.back() == 1))) {
+      dims.back() *= input_dims[axis];
+      reps.back() *= repeats[axis];
+      continue;
+    }
+    dims.push_back(input_dims[axis]);
+    reps.push_back(repeats[axis]);
+  }
+
+  const auto* src = static_cast<const uint8_t*>(input);
+  auto* dst = static_cast<uint8_t*>(output);
+  if (dims.empty()) {
+    memcpy(dst, src, element_bytes);
+    return;
+  }
+
+  // Bytes of output covered by one index of each axis.
+  const size_t rank = dims.size();
+  std::vector<int64_t> output_pitches(rank);
+  int64_t pitch = static_cast<int64_t>(element_bytes);
+  for (size_t axis = rank; axis-- > 0;) {
+    output_pitches[axis] = pitch;
+    pitch *= dims[axis] * reps[axis];
+  }
+  const int64_t row_bytes = dims.back() * static_cast<int64_t>(element_bytes);
+  int64_t outer_rows = 1;
+  for (size_t axis = 0; axis + 1 < rank; ++axis) {
+    outer_rows *= dims[axis];
+  }
+
+  // Walk the input rows in order. Once the last row of an axis has been written, the block that holds the whole
+  // axis is complete and is repeated in place, which also repeats the inner axes that are already expanded.
+  std::vector<int64_t> index(rank - 1, 0);
+  for (int64_t row = 0; row < outer_rows; ++row) {
+    memcpy(dst, src, static_cast<size_t>(row_bytes));
+    src += row_bytes;
+    RepeatBytes(dst, row_bytes, row_bytes * reps.back());
+    dst += row_bytes * reps.back();
+
+    for (size_t axis = rank - 1; axis-- > 0;) {
+      if (++index[axis] != dims[axis]) {
+        break;
+      }
+      index[axis] = 0;
+      const int64_t block_bytes = output_pitches[axis] * dims[axis];
+      RepeatBytes(dst - block_bytes, block_bytes, block_bytes * reps[axis]);
+      dst += block_bytes * (reps[axis] - 1);
+    }
+  }
+}
+
+}  // namespace onnxruntime
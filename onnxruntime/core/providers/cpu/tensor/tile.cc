@@ -1,21 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-// there's no way to use a raw pointer as the copy destination with std::copy_n
-// (which gsl::copy uses with span::data() which returns a raw pointer) with the 14.11 toolset
-// without generating a 4996 warning. going through an iterator is way too much overhead so turn off the warning.
-#ifdef _MSC_VER
-#pragma warning(push)
-#pragma warning(disable : 4996)
-#endif
-
-#include "gsl/gsl_algorithm"
 #include "core/providers/cpu/tensor/tile.h"
-#include "core/providers/cpu/tensor/utils.h"
-
-#ifdef _MSC_VER
-#pragma warning(pop)
-#endif
+#include "core/providers/cpu/tensor/strided_copy.h"
 
 using namespace ::onnxruntime::common;
 
@@ -60,32 +47,10 @@ Status Tile<float>::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  auto* output = output_tensor.template MutableData<float>();
-  auto* input = input_tensor.template Data<float>();
-
-  TensorPitches output_pitches(output_tensor);
-  TensorAxisCounters input_counters(input_tensor);
+  std::vector<int64_t> repeats_dims(repeats, repeats + dimension_count);
+  TileBytes(input_tensor.template Data<float>(), output_tensor.template MutableData<float>(),
+            input_tensor.Shape().GetDims(), repeats_dims, sizeof(float));
 
-  while (input_counters) {
-    // Copy the input data over
-    size_t input_pitch = input_tensor.Shape().GetDims().back();
-    for (size_t i = 0; i < input_pitch; i++)
-      *output++ = *input++;
-
-    // Tile it for the innermost axis
-    const auto* copy = output - input_tensor.Shape()[dimension_count - 1];
-    for (int64_t repeat = (repeats[dimension_count - 1] - 1) * input_pitch; repeat-- > 0;)
-      *output++ = *copy++;
-
-    // Tile it in the other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_tensor.Shape()[input_counters.Axis()];
-      copy = output - pitch;
-      for (int64_t repeat = (repeats[input_counters.Axis()] - 1) * pitch; repeat-- > 0;) {
-        *output++ = *copy++;
-      }
-    }
-  }
   return Status::OK();
 }
 }  // namespace onnxruntime
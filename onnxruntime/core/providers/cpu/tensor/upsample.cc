@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 #include <math.h>  //for fabs
+#include "core/util/math_cpuonly.h"
 
 using namespace ::onnxruntime::common;
 using namespace std;
@@ -29,6 +30,30 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
     Upsample<uint8_t>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Resize,
+    10,
+    float,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    Upsample<float>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Resize,
+    10,
+    int32_t,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<int32_t>()),
+    Upsample<int32_t>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    Resize,
+    10,
+    uint8_t,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<uint8_t>()),
+    Upsample<uint8_t>);
+
+// Minimum number of output elements before the work is spread across threads.
+constexpr int64_t kUpsampleParallelMinOutputSize = 64 * 1024;
+
 template <typename T>
 void UpsampleNearest2x(
     int64_t batch_size,
@@ -39,19 +64,24 @@ void UpsampleNearest2x(
     T* output) {
   const int64_t output_height = input_height * 2;
   const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
+  const int64_t planes = batch_size * num_channels;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (planes * output_height * output_width >= kUpsampleParallelMinOutputSize)
+#endif
+  for (int64_t plane = 0; plane < planes; ++plane) {
+    const T* Xdata = input + plane * input_height * input_width;
+    T* Ydata = output + plane * output_height * output_width;
+    for (int64_t y = 0; y < input_height; ++y) {
+      for (int64_t x = 0; x < input_width; ++x) {
+        const T v = Xdata[x];
+        Ydata[x * 2 + 0] = v;
+        Ydata[x * 2 + 1] = v;
       }
-      input += input_height * input_width;
-      output += output_height * output_width;
+      // Both output rows read the same input row.
+      memcpy(Ydata + output_width, Ydata, output_width * sizeof(T));
+      Xdata += input_width;
+      Ydata += output_width * 2;
     }
   }
 }
@@ -61,28 +91,51 @@ Status UpsampleNearest(const T* input,
                        T* output,
                        const TensorShape& input_shape,
                        const TensorShape& output_shape,
-                       const vector<float>& scales) {
+                       const vector<float>& scales,
+                       const UpsampleTables& tables) {
   if (!input || !output)
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value is nullptr");
   if (input_shape.NumDimensions() != output_shape.NumDimensions())
     return Status(ONNXRUNTIME, FAIL, "Upsample: input/output value's dimension mismatch");
+  if (output_shape.Size() == 0)
+    return Status::OK();
+
   auto n_dim = input_shape.NumDimensions();
+  if (n_dim == 0) {
+    output[0] = input[0];
+    return Status::OK();
+  }
   if (scales.size() == 4 && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
     UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
-  } else {
-    for (size_t i = 0, size = output_shape.Size(); i < size; i++) {
-      size_t old_idx = 0;
-      size_t cur_idx = i;
+    return Status::OK();
+  }
 
-      int64_t base = 1;
-      for (int64_t j = static_cast<int64_t>(n_dim - 1); j >= 0; j--) {
-        auto tmp = cur_idx % output_shape[j];
-        old_idx += (std::min(static_cast<int64_t>(tmp / scales[j]), input_shape[j] - 1)) * base;
-        base *= input_shape[j];
-        cur_idx /= output_shape[j];
-      }
+  // Every output row along the innermost axis gathers from a single input row, whose offset is the sum of the
+  // table entries of the outer axes.
+  const int64_t output_width = output_shape[n_dim - 1];
+  const int64_t output_rows = output_shape.Size() / output_width;
+  const int64_t* col_offsets = tables.nearest_offsets[n_dim - 1].data();
+  const bool copy_rows = scales[n_dim - 1] == 1;
 
-      output[i] = input[old_idx];
+#ifdef USE_OPENMP
+#pragma omp parallel for if (output_shape.Size() >= kUpsampleParallelMinOutputSize)
+#endif
+  for (int64_t row = 0; row < output_rows; ++row) {
+    int64_t input_offset = 0;
+    int64_t remainder = row;
+    for (size_t j = n_dim - 1; j-- > 0;) {
+      input_offset += tables.nearest_offsets[j][remainder % output_shape[j]];
+      remainder /= output_shape[j];
+    }
+
+    const T* Xdata = input + input_offset;
+    T* Ydata = output + row * output_width;
+    if (copy_rows) {
+      memcpy(Ydata, Xdata, output_width * sizeof(T));
+    } else {
+      for (int64_t x = 0; x < output_width; ++x) {
+        Ydata[x] = Xdata[col_offsets[x]];
+      }
     }
   }
   return Status::OK();
@@ -144,62 +197,193 @@ Status upsampleLiner(const T* input,
   return Status::OK();
 }
 
+// Interpolates one input row along the width for every output column.
+static void InterpolateRow(const float* Xrow, float* out, int64_t output_width, const UpsampleTables& tables) {
+  const int64_t* col1 = tables.col1.data();
+  const int64_t* col2 = tables.col2.data();
+  const float* weight1 = tables.col_weight1.data();
+  const float* weight2 = tables.col_weight2.data();
+  for (int64_t x = 0; x < output_width; ++x) {
+    out[x] = weight1[x] * Xrow[col1[x]] + weight2[x] * Xrow[col2[x]];
+  }
+}
+
+// InterpolateRow for a width scale of 2: even columns copy an input column, odd columns average two neighbours.
+static void InterpolateRow2x(const float* Xrow, float* out, int64_t input_width) {
+  for (int64_t x = 0; x + 1 < input_width; ++x) {
+    out[2 * x] = Xrow[x];
+    out[2 * x + 1] = 0.5f * (Xrow[x] + Xrow[x + 1]);
+  }
+  out[2 * input_width - 2] = Xrow[input_width - 1];
+  out[2 * input_width - 1] = Xrow[input_width - 1];
+}
+
+// Bilinear upsampling of float data, separated into two passes. Each input row used by the plane is interpolated
+// along the width once, and kept while consecutive output rows read it. Every output row is then a blend of two
+// contiguous interpolated rows, which vectorizes.
+static void UpsampleBilinearFloat(
+    int64_t batch_size,
+    int64_t num_channels,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    float width_scale,
+    const UpsampleTables& tables,
+    const float* Xdata,
+    float* Ydata) {
+  const int64_t planes = batch_size * num_channels;
+  const bool width_2x = width_scale == 2 && output_width == 2 * input_width;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (planes * output_height * output_width >= kUpsampleParallelMinOutputSize)
+#endif
+  for (int64_t plane = 0; plane < planes; ++plane) {
+    const float* X = Xdata + plane * input_height * input_width;
+    float* Y = Ydata + plane * output_height * output_width;
+
+    // The interpolated rows of the two input rows read most recently. Output rows move down the input
+    // monotonically, so the older one is replaced when a new input row is needed.
+    std::vector<float> buffer(2 * output_width);
+    float* rows[2] = {buffer.data(), buffer.data() + output_width};
+    int64_t row_index[2] = {-1, -1};
+    int last = 0;
+    auto interpolated_row = [&](int64_t input_row) -> const float* {
+      int slot = row_index[0] == input_row ? 0 : (row_index[1] == input_row ? 1 : -1);
+      if (slot < 0) {
+        slot = 1 - last;
+        if (width_2x)
+          InterpolateRow2x(X + input_row * input_width, rows[slot], input_width);
+        else
+          InterpolateRow(X + input_row * input_width, rows[slot], output_width, tables);
+        row_index[slot] = input_row;
+      }
+      last = slot;
+      return rows[slot];
+    };
+
+    for (int64_t y = 0; y < output_height; ++y) {
+      const float* top = interpolated_row(tables.row1[y]);
+      EigenVectorArrayMap<float> out(Y + y * output_width, output_width);
+      if (tables.row1[y] == tables.row2[y] || tables.row_weight2[y] == 0.0f) {
+        out = ConstEigenVectorArrayMap<float>(top, output_width);
+      } else {
+        const float* bottom = interpolated_row(tables.row2[y]);
+        out = ConstEigenVectorArrayMap<float>(top, output_width) * tables.row_weight1[y] +
+              ConstEigenVectorArrayMap<float>(bottom, output_width) * tables.row_weight2[y];
+      }
+    }
+  }
+}
+
 template <typename T>
 void upsampleBilinear(
     int64_t batch_size,
     int64_t num_channels,
     int64_t input_height,
     int64_t input_width,
-    float height_scale,
-    float width_scale,
+    int64_t output_height,
+    int64_t output_width,
+    float /*width_scale*/,
+    const UpsampleTables& tables,
     const T* Xdata,
     T* Ydata) {
-  int64_t output_width = static_cast<int64_t>(input_width * width_scale);
-  int64_t output_height = static_cast<int64_t>(input_height * height_scale);
-
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        float in_y = std::min(y / height_scale, static_cast<float>(input_height - 1));
-        const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
-        const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-        float dy1 = fabs(in_y - in_y1);
-        float dy2 = fabs(in_y - in_y2);
-        if (in_y1 == in_y2) {
-          dy1 = 0.5f;
-          dy2 = 0.5f;
-        }
-
-        const int64_t input_width_mul_y1 = input_width * in_y1;
-        const int64_t input_width_mul_y2 = input_width * in_y2;
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          float in_x = std::min(x / width_scale, static_cast<float>(input_width - 1));
-          const int64_t in_x1 = std::min(static_cast<int64_t>(in_x), input_width - 1);
-          const int64_t in_x2 = std::min(in_x1 + 1, input_width - 1);
-
-          float dx1 = std::abs(in_x - in_x1);
-          float dx2 = std::abs(in_x - in_x2);
-          if (in_x1 == in_x2) {
-            dx1 = 0.5f;
-            dx2 = 0.5f;
-          }
-
-          T X11 = Xdata[input_width_mul_y1 + in_x1];
-          T X21 = Xdata[input_width_mul_y1 + in_x2];
-          T X12 = Xdata[input_width_mul_y2 + in_x1];
-          T X22 = Xdata[input_width_mul_y2 + in_x2];
-
-          Ydata[output_width * y + x] = static_cast<T>(dx2 * dy2 * X11 +
-                                                       dx1 * dy2 * X21 +
-                                                       dx2 * dy1 * X12 +
-                                                       dx1 * dy1 * X22);
-        }
+  const int64_t planes = batch_size * num_channels;
+
+#ifdef USE_OPENMP
+#pragma omp parallel for if (planes * output_height * output_width >= kUpsampleParallelMinOutputSize)
+#endif
+  for (int64_t plane = 0; plane < planes; ++plane) {
+    const T* X = Xdata + plane * input_height * input_width;
+    T* Y = Ydata + plane * output_height * output_width;
+    for (int64_t y = 0; y < output_height; ++y) {
+      const T* X1 = X + tables.row1[y] * input_width;
+      const T* X2 = X + tables.row2[y] * input_width;
+      const float dy1 = tables.row_weight2[y];
+      const float dy2 = tables.row_weight1[y];
+      for (int64_t x = 0; x < output_width; ++x) {
+        const float dx1 = tables.col_weight2[x];
+        const float dx2 = tables.col_weight1[x];
+        const int64_t in_x1 = tables.col1[x];
+        const int64_t in_x2 = tables.col2[x];
+        Y[output_width * y + x] = static_cast<T>(dx2 * dy2 * X1[in_x1] +
+                                                 dx1 * dy2 * X1[in_x2] +
+                                                 dx2 * dy1 * X2[in_x1] +
+                                                 dx1 * dy1 * X2[in_x2]);
+      }
+    }
+  }
+}
+
+template <>
+void upsampleBilinear<float>(
+    int64_t batch_size,
+    int64_t num_channels,
+    int64_t input_height,
+    int64_t input_width,
+    int64_t output_height,
+    int64_t output_width,
+    float width_scale,
+    const UpsampleTables& tables,
+    const float* Xdata,
+    float* Ydata) {
+  UpsampleBilinearFloat(batch_size, num_channels, input_height, input_width, output_height, output_width,
+                        width_scale, tables, Xdata, Ydata);
+}
+
+// Source indices and weights along one axis for linear mode. At the last input index both source indices are the
+// same, and each gets a weight of 0.5.
+static void BuildLinearTable(int64_t input_size, int64_t output_size, float scale,
+                             std::vector<int64_t>& index1, std::vector<int64_t>& index2,
+                             std::vector<float>& weight1, std::vector<float>& weight2) {
+  index1.resize(output_size);
+  index2.resize(output_size);
+  weight1.resize(output_size);
+  weight2.resize(output_size);
+  for (int64_t o = 0; o < output_size; ++o) {
+    const float in = std::min(o / scale, static_cast<float>(input_size - 1));
+    const int64_t in1 = std::min(static_cast<int64_t>(in), input_size - 1);
+    const int64_t in2 = std::min(in1 + 1, input_size - 1);
+    index1[o] = in1;
+    index2[o] = in2;
+    weight1[o] = in1 == in2 ? 0.5f : fabs(in - in2);
+    weight2[o] = in1 == in2 ? 0.5f : fabs(in - in1);
+  }
+}
+
+template <typename T>
+std::shared_ptr<const UpsampleTables> Upsample<T>::GetTables(const std::vector<int64_t>& input_dims,
+                                                             const std::vector<int64_t>& output_dims,
+                                                             const std::vector<float>& scales) const {
+  std::lock_guard<OrtMutex> lock(tables_mutex_);
+  if (tables_ && tables_input_dims_ == input_dims && tables_scales_ == scales) {
+    return tables_;
+  }
+
+  auto tables = std::make_shared<UpsampleTables>();
+  const size_t n_dim = input_dims.size();
+  if (mode_ == UpsampleMode::NN) {
+    tables->nearest_offsets.resize(n_dim);
+    int64_t input_pitch = 1;
+    for (size_t j = n_dim; j-- > 0;) {
+      auto& offsets = tables->nearest_offsets[j];
+      offsets.resize(output_dims[j]);
+      for (int64_t o = 0; o < output_dims[j]; ++o) {
+        offsets[o] = std::min(static_cast<int64_t>(o / scales[j]), input_dims[j] - 1) * input_pitch;
       }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
+      input_pitch *= input_dims[j];
     }
+  } else {
+    BuildLinearTable(input_dims[n_dim - 2], output_dims[n_dim - 2], scales[n_dim - 2],
+                     tables->row1, tables->row2, tables->row_weight1, tables->row_weight2);
+    BuildLinearTable(input_dims[n_dim - 1], output_dims[n_dim - 1], scales[n_dim - 1],
+                     tables->col1, tables->col2, tables->col_weight1, tables->col_weight2);
   }
+
+  tables_input_dims_ = input_dims;
+  tables_scales_ = scales;
+  tables_ = tables;
+  return tables_;
 }
 
 template <typename T>
@@ -219,19 +403,27 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context, const std::vector<floa
   Tensor* Y = context->Output(0, Y_dims);
 
   switch (mode_) {
-    case UpsampleMode::NN:
-      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales);
+    case UpsampleMode::NN: {
+      if (Y->Shape().Size() == 0)
+        return Status::OK();
+      auto tables = GetTables(dims, Y_dims, scales);
+      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales,
+                                *tables);
+    }
     case UpsampleMode::LINEAR: {
       //What's the correct behavior of linear mode is not clear right now,
       //Only support bilinear with 4D tensor to keep consistent with previous behavior
       if (dims.size() != 4)
         return Status(ONNXRUNTIME, FAIL, "Upsample: linear mode upsample only support 4-D tensor with NCHW layout");
+      if (Y->Shape().Size() == 0)
+        return Status::OK();
 
       const int64_t batch_size = dims[0], num_channels = dims[1];
       const int64_t input_height = dims[2], input_width = dims[3];
 
-      upsampleBilinear(batch_size, num_channels, input_height, input_width,
-                       scales[2], scales[3], X->template Data<T>(), Y->template MutableData<T>());
+      auto tables = GetTables(dims, Y_dims, scales);
+      upsampleBilinear(batch_size, num_channels, input_height, input_width, Y_dims[2], Y_dims[3],
+                       scales[3], *tables, X->template Data<T>(), Y->template MutableData<T>());
       return Status::OK();
     }
     default:
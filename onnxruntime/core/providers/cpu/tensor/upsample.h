@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <memory>
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -15,9 +17,23 @@ enum UpsampleMode {
   LINEAR = 1,  // linear interpolation
 };
 
+// Source offsets and weights for each output index, derived from the input shape and the scales only. They are
+// built once per input shape instead of being recomputed for every output element.
+struct UpsampleTables {
+  // Nearest mode: for each axis, the input offset (input index * input pitch) read by every output index.
+  std::vector<std::vector<int64_t>> nearest_offsets;
+
+  // Linear mode (bilinear over the last two axes): for every output row and column, the two input rows and
+  // columns it is interpolated from and their weights.
+  std::vector<int64_t> row1, row2, col1, col2;
+  std::vector<float> row_weight1, row_weight2, col_weight1, col_weight2;
+};
+
 class UpsampleBase {
  protected:
   UpsampleBase(OpKernelInfo info) : scales_cached_(false) {
+    is_resize_ = info.node().OpType() == "Resize";
+
     std::string mode;
     ORT_ENFORCE(info.GetAttr<std::string>("mode", &mode).IsOK());
     mode_ = StringToUpsampleMode(mode);
@@ -43,6 +59,8 @@ class UpsampleBase {
   UpsampleMode mode_;
   std::vector<float> scales_;
   bool scales_cached_;
+  // Resize (opset 10) shares the Upsample implementation but also allows downsampling.
+  bool is_resize_;
 
   UpsampleMode StringToUpsampleMode(const std::string& mode) {
     if (strcmp(mode.c_str(), UpsampleModeNN) == 0) {
@@ -57,7 +75,11 @@ class UpsampleBase {
 
   void ScalesValidation(const std::vector<float>& scales, const UpsampleMode mode) const {
     for (auto& scale : scales) {
-      ORT_ENFORCE(scale >= 1, "Scale value should be greater than or equal to 1.");
+      if (is_resize_) {
+        ORT_ENFORCE(scale > 0, "Scale value should be greater than 0.");
+      } else {
+        ORT_ENFORCE(scale >= 1, "Scale value should be greater than or equal to 1.");
+      }
     }
 
     if (UpsampleMode::LINEAR == mode) {
@@ -88,6 +110,17 @@ class Upsample : public UpsampleBase, public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& scales) const;
+
+ private:
+  std::shared_ptr<const UpsampleTables> GetTables(const std::vector<int64_t>& input_dims,
+                                                  const std::vector<int64_t>& output_dims,
+                                                  const std::vector<float>& scales) const;
+
+  // Tables for the most recent input shape and scales.
+  mutable OrtMutex tables_mutex_;
+  mutable std::vector<int64_t> tables_input_dims_;
+  mutable std::vector<float> tables_scales_;
+  mutable std::shared_ptr<const UpsampleTables> tables_;
 };
 
 }  // namespace onnxruntime
@@ -20,6 +20,7 @@
 #include "core/graph/graph_utils.h"
 #include "core/graph/model.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/calibration_recorder.h"
 #include "core/framework/customregistry.h"
 #include "core/framework/environment.h"
 #include "core/framework/error_code_helper.h"
@@ -50,6 +51,8 @@
 #include "core/session/IOBinding.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/graph_transformer_utils.h"
+#include "core/optimizer/weight_compression.h"
+#include "core/optimizer/dynamic_quantization.h"
 
 #ifdef USE_EIGEN_THREADPOOL
 #include <unsupported/Eigen/CXX11/ThreadPool>
@@ -173,6 +176,10 @@ class InferenceSession::Impl {
     session_state_.SetThreadPool(thread_pool_.get());
     session_profiler_.Initialize(session_logger_);
     session_state_.SetProfiler(session_profiler_);
+    if (session_options.enable_calibration) {
+      calibration_recorder_ = std::make_unique<CalibrationRecorder>();
+      session_state_.SetCalibrationRecorder(calibration_recorder_.get());
+    }
     if (session_options.enable_profiling) {
       StartProfiling(session_options.profile_file_prefix);
     }
@@ -492,6 +499,9 @@ class InferenceSession::Impl {
       if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
         LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
         CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+        epi.enable_winograd_conv = session_options_.enable_winograd_conv;
+        epi.enable_conv_autotuning = session_options_.enable_conv_autotuning;
+        epi.conv_tuning_file = session_options_.conv_tuning_filepath;
         ORT_RETURN_IF_ERROR(execution_providers_.Add(onnxruntime::kCpuExecutionProvider,
                                                      std::make_unique<CPUExecutionProvider>(epi)));
       }
@@ -499,6 +509,22 @@ class InferenceSession::Impl {
       // add predefined transformers
       AddPredefinedTransformers(graph_transformation_mgr_, session_options_.graph_optimization_level, transformers_to_enable_);
 
+      // quantizing the weights changes the numerics of the model, so it only runs when asked for by name
+      if (std::find(transformers_to_enable_.begin(), transformers_to_enable_.end(), "DynamicQuantization") !=
+          transformers_to_enable_.end()) {
+        ORT_RETURN_IF_ERROR(graph_transformation_mgr_.Register(
+            std::make_unique<DynamicQuantization>(session_options_.dynamic_quantization_excluded_op_types,
+                                                  session_options_.dynamic_quantization_excluded_node_names),
+            TransformerLevel::Level2, {onnxruntime::kCpuExecutionProvider}));
+      }
+
+      // compressing the weights changes the numerics of the model, so it only runs when asked for
+      if (session_options_.weight_compression != WeightCompressionFormat::None) {
+        ORT_RETURN_IF_ERROR(graph_transformation_mgr_.Register(
+            std::make_unique<WeightCompression>(session_options_.weight_compression), TransformerLevel::Level2,
+            {onnxruntime::kCpuExecutionProvider}));
+      }
+
       onnxruntime::Graph& graph = model_->MainGraph();
 
       // Collect the kernel registries from execution provider instances;
@@ -526,6 +552,10 @@ class InferenceSession::Impl {
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR(graph.Resolve());
 
+      if (!session_options_.optimized_model_filepath.empty()) {
+        ORT_RETURN_IF_ERROR(Model::Save(*model_, session_options_.optimized_model_filepath));
+      }
+
       ORT_RETURN_IF_ERROR(session_initializer.CreatePlan(nullptr, {}, session_options_.enable_sequential_execution));
       ORT_RETURN_IF_ERROR(session_initializer.InitializeAndSave(nullptr));
 
@@ -534,6 +564,8 @@ class InferenceSession::Impl {
 
       session_state_.CalculateNodeIndexInfo();
 
+      ORT_RETURN_IF_ERROR(InitializeStateBindings());
+
       is_inited_ = true;
 
       LOGS(*session_logger_, INFO) << "Session successfully initialized.";
@@ -688,6 +720,14 @@ class InferenceSession::Impl {
     auto tp = session_profiler_.StartTime();
     Status retval = Status::OK();
 
+    // Copies of the feeds and fetches extended with the persistent state of the stream, if there is any.
+    std::vector<std::string> stream_feed_names;
+    std::vector<MLValue> stream_feeds;
+    std::vector<std::string> stream_output_names;
+    std::vector<MLValue> stream_fetches;
+    std::vector<size_t> state_fetch_idxs;
+    const bool has_state = !state_bindings_.empty() && p_fetches != nullptr;
+
     try {
       {
         std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
@@ -697,12 +737,32 @@ class InferenceSession::Impl {
         }
       }
 
-      ORT_RETURN_IF_ERROR(ValidateInputs(feed_names, feeds));
+      if (has_state) {
+        stream_feed_names = feed_names;
+        stream_feeds = feeds;
+        stream_output_names = output_names;
+        stream_fetches = *p_fetches;
+        AddStateFeedsAndFetches(run_options.stream_id, stream_feed_names, stream_feeds,
+                                stream_output_names, stream_fetches, state_fetch_idxs);
+      }
+
+      const auto& state_feed_names = has_state ? stream_feed_names : feed_names;
+      const auto& state_feeds = has_state ? stream_feeds : feeds;
+      const auto& state_output_names = has_state ? stream_output_names : output_names;
+      auto* p_state_fetches = has_state ? &stream_fetches : p_fetches;
+
+      ORT_RETURN_IF_ERROR(ValidateInputs(state_feed_names, state_feeds));
 
       // if the output vector is non-empty, ensure that its the same size as the output_names
-      ORT_RETURN_IF_ERROR(ValidateOutputs(output_names, p_fetches));
+      ORT_RETURN_IF_ERROR(ValidateOutputs(state_output_names, p_state_fetches));
 
-      FeedsFetchesInfo info(feed_names, output_names);
+      if (calibration_recorder_ != nullptr) {
+        for (size_t i = 0; i < state_feeds.size(); ++i) {
+          calibration_recorder_->Record(state_feed_names[i], state_feeds[i]);
+        }
+      }
+
+      FeedsFetchesInfo info(state_feed_names, state_output_names);
       ORT_RETURN_IF_ERROR(info.SetMLValueIdxs(session_state_.GetMLValueNameIdxMap()));
       FeedsFetchesManager feeds_fetches_manager{std::move(info)};
 
@@ -727,10 +787,16 @@ class InferenceSession::Impl {
 
       // execute the graph
       ORT_CHECK_AND_SET_RETVAL(
-          utils::ExecuteGraph(session_state_, feeds_fetches_manager, feeds, *p_fetches, {},
+          utils::ExecuteGraph(session_state_, feeds_fetches_manager, state_feeds, *p_state_fetches, {},
                               session_options_.enable_sequential_execution, run_options.terminate, run_logger,
                               false));
 
+      if (has_state && retval.IsOK()) {
+        StoreState(run_options.stream_id, output_names, stream_fetches, state_fetch_idxs);
+        stream_fetches.resize(output_names.size());
+        *p_fetches = std::move(stream_fetches);
+      }
+
     } catch (const std::exception& e) {
       retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
     } catch (...) {
@@ -750,6 +816,199 @@ class InferenceSession::Impl {
     return retval;
   }
 
+  // Collects the state bindings of SessionOptions and of the model metadata, and checks that they name model
+  // inputs and outputs.
+  common::Status InitializeStateBindings() {
+    state_bindings_ = session_options_.state_bindings;
+
+    auto entry = model_metadata_.custom_metadata_map.find(kStateBindingsMetadataKey);
+    if (entry != model_metadata_.custom_metadata_map.end()) {
+      std::istringstream bindings{entry->second};
+      std::string binding;
+      while (std::getline(bindings, binding, ';')) {
+        if (binding.empty()) {
+          continue;
+        }
+        auto separator = binding.find(':');
+        if (separator == std::string::npos) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid state binding '", binding,
+                                 "' in model metadata. Expected 'output:input'.");
+        }
+        state_bindings_.emplace_back(binding.substr(0, separator), binding.substr(separator + 1));
+      }
+    }
+
+    for (const auto& binding : state_bindings_) {
+      if (model_output_names_.find(binding.first) == model_output_names_.end()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State binding output '", binding.first,
+                               "' is not an output of the model.");
+      }
+      if (model_input_names_.find(binding.second) == model_input_names_.end()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "State binding input '", binding.second,
+                               "' is not an input of the model.");
+      }
+    }
+
+    return Status::OK();
+  }
+
+  // Feeds the state of 'stream_id' to the bound inputs the caller doesn't feed, and requests the bound outputs.
+  // Where possible the output is written to the buffer of the state before the current one, so that a stream
+  // alternates between two buffers per binding instead of allocating one per Run. 'state_fetch_idxs' receives the
+  // index of each bound output in the fetches.
+  void AddStateFeedsAndFetches(const std::string& stream_id,
+                               std::vector<std::string>& feed_names, std::vector<MLValue>& feeds,
+                               std::vector<std::string>& output_names, std::vector<MLValue>& fetches,
+                               std::vector<size_t>& state_fetch_idxs) {
+    std::lock_guard<onnxruntime::OrtMutex> l(stream_states_mutex_);
+    auto& state = stream_states_[stream_id];
+    state.values.resize(state_bindings_.size());
+
+    const size_t num_caller_outputs = output_names.size();
+    state_fetch_idxs.reserve(state_bindings_.size());
+    for (size_t i = 0; i < state_bindings_.size(); ++i) {
+      const auto& binding = state_bindings_[i];
+      auto& value = state.values[i];
+
+      const bool fed_by_caller = std::find(feed_names.cbegin(), feed_names.cend(), binding.second) != feed_names.cend();
+      if (!fed_by_caller && value.current.IsAllocated()) {
+        feed_names.push_back(binding.second);
+        feeds.push_back(value.current);
+      }
+
+      auto output = std::find(output_names.cbegin(), output_names.cbegin() + num_caller_outputs, binding.first);
+      if (output != output_names.cbegin() + num_caller_outputs) {
+        // the caller owns the buffer of this fetch
+        state_fetch_idxs.push_back(static_cast<size_t>(output - output_names.cbegin()));
+        continue;
+      }
+
+      // fetches may be empty, in which case every output is allocated by the execution frame
+      if (fetches.size() < output_names.size()) {
+        fetches.resize(output_names.size());
+      }
+      state_fetch_idxs.push_back(output_names.size());
+      output_names.push_back(binding.first);
+      fetches.emplace_back();
+
+      // a bound output has the shape of its state, which is only known to be the case for the spare buffer if the
+      // state is fed from the same stream.
+      if (!fed_by_caller && value.spare.IsAllocated() && value.current.IsTensor() &&
+          value.spare.Get<Tensor>().Shape() == value.current.Get<Tensor>().Shape()) {
+        fetches.back() = std::move(value.spare);
+      }
+      value.spare = MLValue();
+    }
+  }
+
+  // Keeps the bound outputs of a successful Run as the state of 'stream_id'.
+  void StoreState(const std::string& stream_id, const std::vector<std::string>& caller_output_names,
+                  const std::vector<MLValue>& fetches, const std::vector<size_t>& state_fetch_idxs) {
+    std::lock_guard<onnxruntime::OrtMutex> l(stream_states_mutex_);
+    auto& state = stream_states_[stream_id];
+    state.values.resize(state_bindings_.size());
+
+    for (size_t i = 0; i < state_bindings_.size(); ++i) {
+      const auto& output = fetches[state_fetch_idxs[i]];
+      if (!output.IsAllocated()) {
+        continue;
+      }
+
+      auto& value = state.values[i];
+      // a buffer that was handed out to the caller must not be written by later Runs
+      if (!value.shared) {
+        value.spare = std::move(value.current);
+      }
+      value.current = output;
+      value.shared = state_fetch_idxs[i] < caller_output_names.size();
+    }
+  }
+
+  common::Status ResetState(const std::string& stream_id) {
+    std::lock_guard<onnxruntime::OrtMutex> l(stream_states_mutex_);
+    stream_states_.erase(stream_id);
+    return Status::OK();
+  }
+
+  // Copies a state tensor into a new buffer on the same device.
+  common::Status CopyStateValue(const MLValue& source, MLValue& copy) const {
+    ORT_RETURN_IF_NOT(source.IsTensor(), "Only tensor state values are supported.");
+    const auto& source_tensor = source.Get<Tensor>();
+    const auto& location = source_tensor.Location();
+    const auto* provider = execution_providers_.Get(location);
+    ORT_RETURN_IF_NOT(provider, "No execution provider for the state location ", location.name);
+    ORT_RETURN_IF_ERROR(utils::AllocateHelper(*provider, location.id, source_tensor, copy));
+
+    auto* copy_tensor = copy.GetMutable<Tensor>();
+    if (strcmp(location.name, CPU) != 0) {
+      return provider->CopyTensor(source_tensor, *copy_tensor);
+    }
+
+    if (source_tensor.DataType() == DataTypeImpl::GetType<std::string>()) {
+      std::copy(source_tensor.Data<std::string>(),
+                source_tensor.Data<std::string>() + source_tensor.Shape().Size(),
+                copy_tensor->MutableData<std::string>());
+    } else {
+      memcpy(copy_tensor->MutableDataRaw(), source_tensor.DataRaw(), source_tensor.Size());
+    }
+    return Status::OK();
+  }
+
+  common::Status GetState(const std::string& stream_id, NameMLValMap& state) const {
+    std::lock_guard<onnxruntime::OrtMutex> l(stream_states_mutex_);
+    state.clear();
+    auto entry = stream_states_.find(stream_id);
+    if (entry == stream_states_.end()) {
+      return Status::OK();
+    }
+
+    const auto& values = entry->second.values;
+    for (size_t i = 0; i < values.size(); ++i) {
+      if (values[i].current.IsAllocated()) {
+        ORT_RETURN_IF_ERROR(CopyStateValue(values[i].current, state[state_bindings_[i].second]));
+      }
+    }
+    return Status::OK();
+  }
+
+  common::Status SetState(const std::string& stream_id, const NameMLValMap& state) {
+    std::lock_guard<onnxruntime::OrtMutex> l(stream_states_mutex_);
+    auto& values = stream_states_[stream_id].values;
+    values.clear();
+    values.resize(state_bindings_.size());
+
+    for (const auto& entry : state) {
+      auto binding = std::find_if(state_bindings_.cbegin(), state_bindings_.cend(),
+                                  [&entry](const std::pair<std::string, std::string>& b) {
+                                    return b.second == entry.first;
+                                  });
+      if (binding == state_bindings_.cend()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "'", entry.first, "' is not a bound state input.");
+      }
+
+      auto& value = values[binding - state_bindings_.cbegin()];
+      value.current = entry.second;
+      value.shared = true;
+    }
+    return Status::OK();
+  }
+
+  common::Status GetCalibrationRanges(TensorRangeMap& ranges) const {
+    if (calibration_recorder_ == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Calibration is not enabled for this session.");
+    }
+    ranges = calibration_recorder_->GetRanges();
+    return Status::OK();
+  }
+
+  common::Status ResetCalibrationRanges() {
+    if (calibration_recorder_ == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Calibration is not enabled for this session.");
+    }
+    calibration_recorder_->Reset();
+    return Status::OK();
+  }
+
   std::pair<common::Status, const ModelMetadata*> GetModelMetadata() const {
     {
       std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
@@ -1018,6 +1277,9 @@ class InferenceSession::Impl {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
+  // Ranges of the tensors seen by Run when SessionOptions::enable_calibration is set, else nullptr.
+  std::unique_ptr<CalibrationRecorder> calibration_recorder_;
+
   ExecutionProviders execution_providers_;
 
   KernelRegistryManager kernel_registry_manager_;
@@ -1066,6 +1328,23 @@ class InferenceSession::Impl {
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
 
+  // Persistent state of one stream. For every state binding, 'current' is fed to the bound input on the next Run
+  // and 'spare' is the buffer the bound output is written to, so that the two alternate from one Run to the next.
+  // A 'current' value that was also returned to the caller, or set by it, is 'shared' and never reused as 'spare'.
+  struct StateValue {
+    MLValue current;
+    MLValue spare;
+    bool shared = false;
+  };
+  struct StreamState {
+    std::vector<StateValue> values;  // one per state binding
+  };
+
+  // (output name, input name) pairs from SessionOptions and the model metadata.
+  std::vector<std::pair<std::string, std::string>> state_bindings_;
+  std::unordered_map<std::string, StreamState> stream_states_;  // GUARDED_BY(stream_states_mutex_)
+  mutable onnxruntime::OrtMutex stream_states_mutex_;
+
   InsertCastTransformer insert_cast_transformer_;
   // The file path of where the model was loaded. e.g. /tmp/test_squeezenet/model.onnx
   std::basic_string<PATH_CHAR_TYPE> model_location_;
@@ -1130,6 +1409,26 @@ common::Status InferenceSession::Run(const RunOptions& run_options,
   return Run(run_options, feed_names, feeds, output_names, p_fetches);
 }
 
+common::Status InferenceSession::ResetState(const std::string& stream_id) {
+  return impl_->ResetState(stream_id);
+}
+
+common::Status InferenceSession::GetState(const std::string& stream_id, NameMLValMap& state) const {
+  return impl_->GetState(stream_id, state);
+}
+
+common::Status InferenceSession::SetState(const std::string& stream_id, const NameMLValMap& state) {
+  return impl_->SetState(stream_id, state);
+}
+
+common::Status InferenceSession::GetCalibrationRanges(TensorRangeMap& ranges) const {
+  return impl_->GetCalibrationRanges(ranges);
+}
+
+common::Status InferenceSession::ResetCalibrationRanges() {
+  return impl_->ResetCalibrationRanges();
+}
+
 std::pair<common::Status, const ModelMetadata*> InferenceSession::GetModelMetadata() const {
   return impl_->GetModelMetadata();
 }
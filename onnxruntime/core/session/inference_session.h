@@ -5,6 +5,9 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/status.h"
@@ -67,8 +70,50 @@ struct SessionOptions {
 
   // How many threads in the session thread pool.
   int session_thread_pool_size = 0;
+
+  // Persistent state for streaming models, as (output name, input name) pairs. After every Run the value of each
+  // bound output is kept for the stream named by RunOptions::stream_id, and is fed to the bound input on the next
+  // Run of that stream unless the caller feeds that input itself. Runs of the same stream must not overlap.
+  // Bindings can also be declared by the model, see kStateBindingsMetadataKey.
+  std::vector<std::pair<std::string, std::string>> state_bindings;
+
+  // Record the range of every float tensor computed by Run, e.g. to calibrate static quantization.
+  // The ranges are read with InferenceSession::GetCalibrationRanges. Calibrate without graph optimizations
+  // (graph_optimization_level 0) so that the recorded tensors are the ones of the original model.
+  bool enable_calibration = false;
+
+  // If set, the model is saved to this file once the graph transformations are done, e.g. to keep a
+  // statically quantized model for reuse. The saved model may contain operators of the contrib domain.
+  std::basic_string<ORTCHAR_T> optimized_model_filepath;
+
+  // Keep the constant weights of MatMul, Gemm and Conv on the CPU provider in a compressed format, which cuts their
+  // memory by 2x (Float16) or 4x (Int8). The weights are expanded to float tile by tile inside the GEMM, so the
+  // results are those of the rounded weights. Applies regardless of graph_optimization_level.
+  WeightCompressionFormat weight_compression = WeightCompressionFormat::None;
+
+  // Operator types and node names that DynamicQuantization keeps in float. DynamicQuantization changes the numerics
+  // of the model, so it only runs when enabled with InferenceSession::AddCustomTransformerList.
+  std::unordered_set<std::string> dynamic_quantization_excluded_op_types;
+  std::unordered_set<std::string> dynamic_quantization_excluded_node_names;
+
+  // Allow Conv on the default CPU provider to use the Winograd algorithm for 3x3 convolutions with unit stride.
+  // It is faster for most channel counts but its results differ from the direct convolution by rounding, so
+  // disable it to reproduce those results exactly.
+  bool enable_winograd_conv = true;
+
+  // Let Conv on the default CPU provider time its algorithms and thread counts the first time a convolution shape
+  // is seen, and use the fastest from then on. The first Run with a new shape is slower.
+  bool enable_conv_autotuning = false;
+
+  // If set with enable_conv_autotuning, the tuning results are read from and appended to this file, so that later
+  // sessions and processes skip the timing of the shapes already tuned on this machine.
+  std::basic_string<ORTCHAR_T> conv_tuning_filepath;
 };
 
+// Model metadata key declaring state bindings in addition to SessionOptions::state_bindings.
+// The value is a ';' separated list of "output:input" pairs, e.g. "Y_h:initial_h;Y_c:initial_c".
+constexpr const char* kStateBindingsMetadataKey = "onnxruntime.state_bindings";
+
 /**
   * Pre-defined and custom metadata about the model.
   */
@@ -250,6 +295,42 @@ class InferenceSession {
     */
   int GetCurrentNumRuns();
 
+  /**
+    * Drop the persistent state of a stream. The next Run of the stream starts from the model's initial state.
+    * @return OK if success.
+    */
+  common::Status ResetState(const std::string& stream_id);
+
+  /**
+    * Take a snapshot of the persistent state of a stream.
+    * @param state receives a copy of the state keyed by the bound input names. Later Runs don't modify it.
+    *        Inputs that have no state yet are not included.
+    * @return OK if success.
+    */
+  common::Status GetState(const std::string& stream_id, NameMLValMap& state) const;
+
+  /**
+    * Replace the persistent state of a stream, e.g. with a snapshot returned by GetState.
+    * @param state values keyed by the bound input names. The values are fed as-is and never written to.
+    * @return OK if success.
+    */
+  common::Status SetState(const std::string& stream_id, const NameMLValMap& state);
+
+  /**
+    * Get the (min, max) of every float tensor seen by Run since the session was created or the ranges were
+    * reset. This includes the model inputs and the outputs of every node of the main graph.
+    * Requires SessionOptions::enable_calibration.
+    * @param ranges receives the ranges keyed by tensor name.
+    * @return OK if success.
+    */
+  common::Status GetCalibrationRanges(TensorRangeMap& ranges) const;
+
+  /**
+    * Drop the ranges recorded so far. Requires SessionOptions::enable_calibration.
+    * @return OK if success.
+    */
+  common::Status ResetCalibrationRanges();
+
   /**
     * Start profiling on this inference session. This simply turns on profiling events to be 
     * recorded. A corresponding EndProfiling has to follow to write profiling data to a file.
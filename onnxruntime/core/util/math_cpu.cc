@@ -39,10 +39,7 @@
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "Eigen/src/Core/arch/CUDA/Half.h"
-
-#if defined(USE_MLAS)
 #include "core/mlas/inc/mlas.h"
-#endif
 
 #ifdef USE_MKLDNN
 #include "mkldnn.h"
@@ -1093,49 +1090,6 @@ void Col2imNd<float, CPUMathUtil, StorageOrder::NCHW>(
       true);
 }
 
-static void Im2colWithEqualPadding(int64_t output_h, int64_t output_w, const float* data_im,
-                                   const int64_t channels,
-                                   const int64_t height,
-                                   const int64_t width,
-                                   const int64_t kernel_h,
-                                   const int64_t kernel_w,
-                                   const int64_t dilation_h,
-                                   const int64_t dilation_w,
-                                   const int64_t pad_t,
-                                   const int64_t pad_l,
-                                   const int64_t stride_h,
-                                   const int64_t stride_w,
-                                   float* data_col) {
-  // From Intel, https://github.com/BVLC/caffe/pull/3536
-  const int64_t pad_h = pad_t;
-  const int64_t pad_w = pad_l;
-  const int64_t channel_size = height * width;
-  for (int64_t channel = channels; channel--; data_im += channel_size) {
-    for (int64_t kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
-      for (int64_t kernel_col = 0; kernel_col < kernel_w; kernel_col++) {
-        int64_t input_row = -pad_h + kernel_row * dilation_h;
-        for (int64_t output_rows = output_h; output_rows; output_rows--) {
-          if (!is_a_ge_zero_and_a_lt_b(input_row, height)) {
-            memset(data_col, 0, output_w * sizeof(float));
-            data_col += output_w;
-          } else {
-            int64_t input_col = -pad_w + kernel_col * dilation_w;
-            const float* rdptr = data_im + input_row * width + input_col;
-            for (int64_t i = 0; i != output_w; ++i) {
-              if (is_a_ge_zero_and_a_lt_b(input_col, width)) {
-                *(data_col++) = rdptr[i * stride_w];
-              } else {
-                *(data_col++) = 0;
-              }
-              input_col += stride_w;
-            }
-          }
-          input_row += stride_h;
-        }
-      }
-    }
-  }
-}
 template <>
 void Im2col<float, CPUMathUtil, StorageOrder::NCHW>(
     const float* data_im,
@@ -1154,76 +1108,17 @@ void Im2col<float, CPUMathUtil, StorageOrder::NCHW>(
     const int64_t stride_w,
     float* data_col,
     CPUMathUtil* /*context*/) {
-  const int64_t output_h =
-      (height + pad_b + pad_t - (dilation_h * (kernel_h - 1) + 1)) / stride_h +
-      1;
-  const int64_t output_w =
-      (width + pad_l + pad_r - (dilation_w * (kernel_w - 1) + 1)) / stride_w +
-      1;
-
-  // Fast path for zero padding and no dilation
-  // From Torch, THNN_(unfolded_copy)
-  if (dilation_h == 1 && dilation_w == 1 && pad_l == 0 && pad_r == 0 &&
-      pad_t == 0 && pad_b == 0) {
-    for (auto k = 0; k < channels * kernel_h * kernel_w; k++) {
-      const auto nip = k / (kernel_h * kernel_w);
-      const auto rest = k % (kernel_h * kernel_w);
-      const auto kh = rest / kernel_w;
-      const auto kw = rest % kernel_w;
-      auto* dst = data_col + nip * (kernel_h * kernel_w * output_h * output_w) +
-                  kh * (kernel_w * output_h * output_w) + kw * (output_h * output_w);
-      const auto* src = data_im + nip * (height * width);
-      for (auto y = 0; y < output_h; y++) {
-        const auto iy = y * stride_h + kh;
-        const auto ix = kw;
-        if (stride_w == 1) {
-          memcpy(
-              dst + (y * output_w),
-              src + (iy * width + ix),
-              sizeof(float) * output_w);
-        } else {
-          for (auto x = 0; x < output_w; x++) {
-            memcpy(
-                dst + (y * output_w + x),
-                src + (iy * width + ix + x * stride_w),
-                sizeof(float));
-          }
-        }
-      }
-    }
-    return;
-  }
-
-  // Fast path for equal padding
-  if (pad_l == pad_r && pad_t == pad_b) {
-    Im2colWithEqualPadding(output_h, output_w, data_im, channels, height, width, kernel_h, kernel_w, dilation_h, dilation_w, pad_t, pad_l, stride_h, stride_w, data_col);
-    return;
-  }
-
-  // Baseline
-  const int64_t dkernel_h = dilation_h * (kernel_h - 1) + 1;
-  const int64_t dkernel_w = dilation_w * (kernel_w - 1) + 1;
-
-  int64_t height_col = (height + pad_t + pad_b - dkernel_h) / stride_h + 1;
-  int64_t width_col = (width + pad_l + pad_r - dkernel_w) / stride_w + 1;
-
-  int64_t channels_col = channels * kernel_h * kernel_w;
-  for (int64_t c = 0; c < channels_col; ++c) {
-    int64_t w_offset = c % kernel_w;
-    int64_t h_offset = (c / kernel_w) % kernel_h;
-    int64_t c_im = c / kernel_h / kernel_w;
-    for (int64_t h = 0; h < height_col; ++h) {
-      for (int64_t w = 0; w < width_col; ++w) {
-        int64_t h_pad = h * stride_h - pad_t + h_offset * dilation_h;
-        int64_t w_pad = w * stride_w - pad_l + w_offset * dilation_w;
-        if (h_pad >= 0 && h_pad < height && w_pad >= 0 && w_pad < width)
-          data_col[(c * height_col + h) * width_col + w] =
-              data_im[(c_im * height + h_pad) * width + w_pad];
-        else
-          data_col[(c * height_col + h) * width_col + w] = 0;
-      }
-    }
-  }
+  const int64_t input_shape[] = {height, width};
+  const int64_t kernel_shape[] = {kernel_h, kernel_w};
+  const int64_t dilations[] = {dilation_h, dilation_w};
+  const int64_t pads[] = {pad_t, pad_l, pad_b, pad_r};
+  const int64_t strides[] = {stride_h, stride_w};
+  const int64_t output_shape[] = {
+      (height + pad_t + pad_b - (dilation_h * (kernel_h - 1) + 1)) / stride_h + 1,
+      (width + pad_l + pad_r - (dilation_w * (kernel_w - 1) + 1)) / stride_w + 1};
+
+  MlasIm2col(data_im, data_col, 2, static_cast<size_t>(channels), input_shape, kernel_shape, dilations, pads,
+             strides, output_shape, 0.0f);
 }
 
 template <>
@@ -1244,32 +1139,17 @@ void Im2col<float, CPUMathUtil, StorageOrder::NHWC>(
     const int64_t stride_w,
     float* data_col,
     CPUMathUtil* /*context*/) {
-  const int64_t dkernel_h = dilation_h * (kernel_h - 1) + 1;
-  const int64_t dkernel_w = dilation_w * (kernel_w - 1) + 1;
-
-  int64_t height_col = (height + pad_t + pad_b - dkernel_h) / stride_h + 1;
-  int64_t width_col = (width + pad_l + pad_r - dkernel_w) / stride_w + 1;
-
-  int64_t h_pad = -pad_t;
-  for (int64_t h = 0; h < height_col; ++h) {
-    int64_t w_pad = -pad_l;
-    for (int64_t w = 0; w < width_col; ++w) {
-      for (int64_t ih = h_pad; ih < h_pad + dkernel_h; ih += dilation_h) {
-        for (int64_t iw = w_pad; iw < w_pad + dkernel_w; iw += dilation_w) {
-          if (ih >= 0 && ih < height && iw >= 0 && iw < width) {
-            memcpy(data_col, data_im + (ih * width + iw) * channels,
-                   sizeof(float) * channels);
-          } else {
-            // This should be simply padded with zero.
-            memset(data_col, 0, sizeof(float) * channels);
-          }
-          data_col += channels;
-        }
-      }
-      w_pad += stride_w;
-    }
-    h_pad += stride_h;
-  }
+  const int64_t input_shape[] = {height, width};
+  const int64_t kernel_shape[] = {kernel_h, kernel_w};
+  const int64_t dilations[] = {dilation_h, dilation_w};
+  const int64_t pads[] = {pad_t, pad_l, pad_b, pad_r};
+  const int64_t strides[] = {stride_h, stride_w};
+  const int64_t output_shape[] = {
+      (height + pad_t + pad_b - (dilation_h * (kernel_h - 1) + 1)) / stride_h + 1,
+      (width + pad_l + pad_r - (dilation_w * (kernel_w - 1) + 1)) / stride_w + 1};
+
+  MlasIm2colNhwc(data_im, data_col, 2, static_cast<size_t>(channels), input_shape, kernel_shape, dilations, pads,
+                 strides, output_shape, 0.0f);
 }
 
 template <>
@@ -244,6 +244,15 @@ void addObjectMethods(py::module& m) {
 Set this option to false if you don't want it. Default is True.)pbdoc")
       .def_readwrite("enable_profiling", &SessionOptions::enable_profiling,
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
+      .def_readwrite("enable_winograd_conv", &SessionOptions::enable_winograd_conv,
+                     R"pbdoc(Allows Conv on CPU to use the Winograd algorithm for 3x3 convolutions. Its results differ
+from the direct convolution by rounding. Default is True.)pbdoc")
+      .def_readwrite("enable_conv_autotuning", &SessionOptions::enable_conv_autotuning,
+                     R"pbdoc(Lets Conv on CPU time its algorithms the first time a convolution shape is seen and use
+the fastest. Default is False.)pbdoc")
+      .def_readwrite("conv_tuning_filepath", &SessionOptions::conv_tuning_filepath,
+                     R"pbdoc(File the Conv tuning results are read from and appended to when enable_conv_autotuning
+is set. Default is empty, which keeps the results in memory.)pbdoc")
       .def_readwrite("enable_sequential_execution", &SessionOptions::enable_sequential_execution,
                      R"pbdoc(Enables sequential execution, disables parallel execution. Default is true.)pbdoc")
       .def_readwrite("max_num_graph_transformation_steps", &SessionOptions::max_num_graph_transformation_steps,
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Computes the attention of each head the way the unfused subgraph does. The mask has mask_rows rows of
+// sequence_length elements for each of its mask_batch batch items, where mask_rows is 1 or sequence_length.
+static std::vector<float> ReferenceAttention(const std::vector<float>& input, const std::vector<float>& weight,
+                                             const std::vector<float>& bias, const std::vector<float>& mask,
+                                             int64_t batch_size, int64_t sequence_length, int64_t hidden_size,
+                                             int64_t num_heads, int64_t mask_batch, int64_t mask_rows) {
+  const int64_t head_size = hidden_size / num_heads;
+
+  // [batch_size * sequence_length, 3 * hidden_size]
+  std::vector<double> qkv(static_cast<size_t>(batch_size * sequence_length * 3 * hidden_size));
+  for (int64_t m = 0; m < batch_size * sequence_length; m++) {
+    for (int64_t n = 0; n < 3 * hidden_size; n++) {
+      double sum = bias[n];
+      for (int64_t k = 0; k < hidden_size; k++) {
+        sum += static_cast<double>(input[m * hidden_size + k]) * weight[k * 3 * hidden_size + n];
+      }
+      qkv[m * 3 * hidden_size + n] = sum;
+    }
+  }
+
+  std::vector<float> output(static_cast<size_t>(batch_size * sequence_length * hidden_size));
+  std::vector<double> scores(static_cast<size_t>(sequence_length));
+  for (int64_t b = 0; b < batch_size; b++) {
+    for (int64_t head = 0; head < num_heads; head++) {
+      for (int64_t i = 0; i < sequence_length; i++) {
+        const double* q = &qkv[(b * sequence_length + i) * 3 * hidden_size + head * head_size];
+        double max_score = -INFINITY;
+        for (int64_t j = 0; j < sequence_length; j++) {
+          const double* k = &qkv[(b * sequence_length + j) * 3 * hidden_size + hidden_size + head * head_size];
+          double dot = 0.0;
+          for (int64_t d = 0; d < head_size; d++) {
+            dot += q[d] * k[d];
+          }
+          scores[j] = dot / std::sqrt(static_cast<double>(head_size));
+          if (!mask.empty()) {
+            const int64_t mask_row = (mask_batch == 1 ? 0 : b) * mask_rows + (mask_rows == 1 ? 0 : i);
+            scores[j] += mask[mask_row * sequence_length + j];
+          }
+          max_score = std::max(max_score, scores[j]);
+        }
+
+        double sum = 0.0;
+        for (int64_t j = 0; j < sequence_length; j++) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+
+        for (int64_t d = 0; d < head_size; d++) {
+          double value = 0.0;
+          for (int64_t j = 0; j < sequence_length; j++) {
+            value += scores[j] / sum *
+                     qkv[(b * sequence_length + j) * 3 * hidden_size + 2 * hidden_size + head * head_size + d];
+          }
+          output[(b * sequence_length + i) * hidden_size + head * head_size + d] = static_cast<float>(value);
+        }
+      }
+    }
+  }
+  return output;
+}
+
+static std::vector<float> MakeValues(size_t size, float frequency, float amplitude) {
+  std::vector<float> values(size);
+  for (size_t i = 0; i < size; i++) {
+    values[i] = std::sin(static_cast<float>(i) * frequency) * amplitude;
+  }
+  return values;
+}
+
+TEST(AttentionTest, KeyMask) {
+  const int64_t batch_size = 2;
+  const int64_t sequence_length = 5;
+  const int64_t hidden_size = 8;
+  const int64_t num_heads = 2;
+
+  const auto input = MakeValues(batch_size * sequence_length * hidden_size, 0.7f, 1.0f);
+  const auto weight = MakeValues(hidden_size * 3 * hidden_size, 0.3f, 0.5f);
+  const auto bias = MakeValues(3 * hidden_size, 1.1f, 0.2f);
+  const std::vector<float> mask = {0.0f, 0.0f, 0.0f, 0.0f, -10000.0f,
+                                   0.0f, 0.0f, -10000.0f, -10000.0f, -10000.0f};
+
+  OpTester test("Attention", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("num_heads", num_heads);
+  test.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input);
+  test.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight);
+  test.AddInput<float>("bias", {3 * hidden_size}, bias);
+  test.AddInput<float>("mask", {batch_size, 1, 1, sequence_length}, mask);
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size},
+                        ReferenceAttention(input, weight, bias, mask, batch_size, sequence_length, hidden_size,
+                                           num_heads, batch_size, 1));
+  test.Run();
+}
+
+TEST(AttentionTest, NoMask) {
+  const int64_t batch_size = 1;
+  const int64_t sequence_length = 7;
+  const int64_t hidden_size = 12;
+  const int64_t num_heads = 3;
+
+  const auto input = MakeValues(batch_size * sequence_length * hidden_size, 0.9f, 1.5f);
+  const auto weight = MakeValues(hidden_size * 3 * hidden_size, 0.13f, 0.4f);
+  const auto bias = MakeValues(3 * hidden_size, 0.5f, 0.1f);
+
+  OpTester test("Attention", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("num_heads", num_heads);
+  test.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input);
+  test.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight);
+  test.AddInput<float>("bias", {3 * hidden_size}, bias);
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size},
+                        ReferenceAttention(input, weight, bias, {}, batch_size, sequence_length, hidden_size,
+                                           num_heads, 1, 1));
+  test.Run();
+}
+
+// A causal mask shared by the batch, as used by transformer decoders.
+TEST(AttentionTest, SharedCausalMask) {
+  const int64_t batch_size = 3;
+  const int64_t sequence_length = 4;
+  const int64_t hidden_size = 4;
+  const int64_t num_heads = 1;
+
+  const auto input = MakeValues(batch_size * sequence_length * hidden_size, 0.4f, 1.0f);
+  const auto weight = MakeValues(hidden_size * 3 * hidden_size, 0.7f, 0.6f);
+  const auto bias = MakeValues(3 * hidden_size, 0.2f, 0.3f);
+  std::vector<float> mask(static_cast<size_t>(sequence_length * sequence_length));
+  for (int64_t i = 0; i < sequence_length; i++) {
+    for (int64_t j = 0; j < sequence_length; j++) {
+      mask[i * sequence_length + j] = j > i ? -10000.0f : 0.0f;
+    }
+  }
+
+  OpTester test("Attention", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("num_heads", num_heads);
+  test.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input);
+  test.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight);
+  test.AddInput<float>("bias", {3 * hidden_size}, bias);
+  test.AddInput<float>("mask", {sequence_length, sequence_length}, mask);
+  test.AddOutput<float>("output", {batch_size, sequence_length, hidden_size},
+                        ReferenceAttention(input, weight, bias, mask, batch_size, sequence_length, hidden_size,
+                                           num_heads, 1, sequence_length));
+  test.Run();
+}
+
+TEST(AttentionTest, InvalidNumHeads) {
+  OpTester test("Attention", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("num_heads", static_cast<int64_t>(3));
+  test.AddInput<float>("input", {1, 1, 4}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("weight", {4, 12}, std::vector<float>(48, 1.0f));
+  test.AddInput<float>("bias", {12}, std::vector<float>(12, 0.0f));
+  test.AddOutput<float>("output", {1, 1, 4}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "hidden_size 4 must be a multiple of num_heads 3");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,53 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(CompressedConvOpTest, Float16PointwiseWithBias) {
+  OpTester test("CompressedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{1, 1});
+  test.AddInput<float>("X", {1, 2, 2, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+  test.AddInput<MLFloat16>("W", {2, 2, 1, 1}, ToFloat16({0.5f, 1.0f, -1.0f, 2.0f}), true);
+  test.AddMissingOptionalInput<float>();
+  test.AddInput<float>("B", {2}, {1.0f, -1.0f}, true);
+  test.AddOutput<float>("Y", {1, 2, 2, 2}, {6.5f, 8.0f, 9.5f, 11.0f, 8.0f, 9.0f, 10.0f, 11.0f});
+  test.Run();
+}
+
+TEST(CompressedConvOpTest, Int8Padded) {
+  OpTester test("CompressedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{3, 3});
+  test.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", {1, 1, 3, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f});
+  test.AddInput<int8_t>("W", {1, 1, 3, 3}, {1, 1, 1, 1, 1, 1, 1, 1, 1}, true);
+  test.AddInput<float>("w_scale", {1}, {0.5f}, true);
+  test.AddOutput<float>("Y", {1, 1, 3, 3}, {6.0f, 10.5f, 8.0f, 13.5f, 22.5f, 16.5f, 12.0f, 19.5f, 14.0f});
+  test.Run();
+}
+
+TEST(CompressedConvOpTest, Int8Grouped) {
+  OpTester test("CompressedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{1, 1});
+  test.AddAttribute("group", static_cast<int64_t>(2));
+  test.AddInput<float>("X", {1, 2, 2, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f});
+  test.AddInput<int8_t>("W", {2, 1, 1, 1}, {2, -3}, true);
+  test.AddInput<float>("w_scale", {2}, {0.5f, 1.0f}, true);
+  test.AddOutput<float>("Y", {1, 2, 2, 2}, {1.0f, 2.0f, 3.0f, 4.0f, -15.0f, -18.0f, -21.0f, -24.0f});
+  test.Run();
+}
+
+TEST(CompressedConvOpTest, Int8WithoutScale) {
+  OpTester test("CompressedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{1, 1});
+  test.AddInput<float>("X", {1, 1, 2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<int8_t>("W", {1, 1, 1, 1}, {1});
+  test.AddOutput<float>("Y", {1, 1, 2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "w_scale is required if W is int8");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
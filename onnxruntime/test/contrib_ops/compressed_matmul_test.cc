@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(CompressedMatMulOpTest, Float16B) {
+  OpTester test("CompressedMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<MLFloat16>("B", {3, 2}, ToFloat16({0.5f, -1.0f, 2.0f, 0.25f, -1.5f, 3.0f}), true);
+  test.AddOutput<float>("Y", {2, 2}, {0.0f, 8.5f, 3.0f, 15.25f});
+  test.Run();
+}
+
+TEST(CompressedMatMulOpTest, Float16BWithScaleAndBias) {
+  OpTester test("CompressedMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<MLFloat16>("B", {3, 2}, ToFloat16({0.5f, -1.0f, 2.0f, 0.25f, -1.5f, 3.0f}), true);
+  test.AddInput<float>("b_scale", {2}, {2.0f, 0.5f}, true);
+  test.AddInput<float>("bias", {2}, {1.0f, -1.0f}, true);
+  test.AddOutput<float>("Y", {2, 2}, {1.0f, 3.25f, 7.0f, 6.625f});
+  test.Run();
+}
+
+TEST(CompressedMatMulOpTest, Int8BWithScaleAndBias) {
+  OpTester test("CompressedMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2, 3, 4, -5, 6}, true);
+  test.AddInput<float>("b_scale", {2}, {0.5f, 0.25f}, true);
+  test.AddInput<float>("bias", {2}, {1.0f, -1.0f}, true);
+  test.AddOutput<float>("Y", {2, 2}, {-3.0f, 5.0f, -4.5f, 11.0f});
+  test.Run();
+}
+
+TEST(CompressedMatMulOpTest, BatchedA) {
+  OpTester test("CompressedMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 1, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<MLFloat16>("B", {3, 2}, ToFloat16({0.5f, -1.0f, 2.0f, 0.25f, -1.5f, 3.0f}), true);
+  test.AddOutput<float>("Y", {2, 1, 2}, {0.0f, 8.5f, 3.0f, 15.25f});
+  test.Run();
+}
+
+TEST(CompressedMatMulOpTest, Int8BWithoutScale) {
+  OpTester test("CompressedMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2, 3, 4, -5, 6});
+  test.AddOutput<float>("Y", {2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "b_scale is required if B is int8");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
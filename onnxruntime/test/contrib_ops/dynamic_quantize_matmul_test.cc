@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// The range of A is [-64, 191], so it quantizes exactly with a scale of 1 and a zero point of 64 and the
+// expected outputs are exact.
+
+TEST(DynamicQuantizeMatMulOpTest, Int8B) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {-64.0f, 10.0f, 191.0f, 3.0f, -5.0f, 0.0f});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2, 3, 4, -5, 6});
+  test.AddInput<float>("b_scale", {}, {0.5f});
+  test.AddOutput<float>("Y", {2, 2}, {-494.5f, 657.0f, -6.0f, -13.0f});
+  test.Run();
+}
+
+TEST(DynamicQuantizeMatMulOpTest, Uint8BWithZeroPoint) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {-64.0f, 10.0f, 191.0f, 3.0f, -5.0f, 0.0f});
+  test.AddInput<uint8_t>("B", {3, 2}, {129, 126, 131, 132, 123, 134});
+  test.AddInput<float>("b_scale", {}, {0.5f});
+  test.AddInput<uint8_t>("b_zero_point", {}, {128});
+  test.AddOutput<float>("Y", {2, 2}, {-494.5f, 657.0f, -6.0f, -13.0f});
+  test.Run();
+}
+
+TEST(DynamicQuantizeMatMulOpTest, PerColumnScaleAndBias) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 3}, {-64.0f, 10.0f, 191.0f, 3.0f, -5.0f, 0.0f});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2, 3, 4, -5, 6}, true);
+  test.AddInput<float>("b_scale", {2}, {0.5f, 0.25f}, true);
+  test.AddMissingOptionalInput<int8_t>();
+  test.AddInput<float>("bias", {2}, {1.0f, -1.0f}, true);
+  test.AddOutput<float>("Y", {2, 2}, {-493.5f, 327.5f, -5.0f, -7.5f});
+  test.Run();
+}
+
+TEST(DynamicQuantizeMatMulOpTest, BatchedA) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {2, 1, 3}, {-64.0f, 10.0f, 191.0f, 3.0f, -5.0f, 0.0f});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2, 3, 4, -5, 6}, true);
+  test.AddInput<float>("b_scale", {}, {0.5f}, true);
+  test.AddOutput<float>("Y", {2, 1, 2}, {-494.5f, 657.0f, -6.0f, -13.0f});
+  test.Run();
+}
+
+TEST(DynamicQuantizeMatMulOpTest, ZeroA) {
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("A", {1, 3}, {0.0f, 0.0f, 0.0f});
+  test.AddInput<int8_t>("B", {3, 2}, {1, -2, 3, 4, -5, 6});
+  test.AddInput<float>("b_scale", {}, {0.5f});
+  test.AddMissingOptionalInput<int8_t>();
+  test.AddInput<float>("bias", {2}, {1.0f, -1.0f});
+  test.AddOutput<float>("Y", {1, 2}, {1.0f, -1.0f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,234 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// The quantized operators are checked against fp32 LSTM and GRU implementations that follow the ONNX spec with
+// the default activations. The error from quantizing the weights and activations to 8 bits stays well below
+// kQuantizedRnnTolerance for values of the ranges used here.
+static const float kQuantizedRnnTolerance = 0.01f;
+
+static std::vector<float> RandomValues(size_t count, float range, std::mt19937& generator) {
+  std::uniform_real_distribution<float> distribution(-range, range);
+  std::vector<float> values(count);
+  for (auto& value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
+
+static float Sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+// out = bias + weights * in, for the N x K row major weights
+static void MultiplyAdd(const float* in, const float* weights, const float* bias, int N, int K, float* out) {
+  for (int n = 0; n < N; ++n) {
+    float sum = bias[n];
+    for (int k = 0; k < K; ++k) {
+      sum += in[k] * weights[n * K + k];
+    }
+    out[n] = sum;
+  }
+}
+
+static void ReferenceLstm(const std::vector<float>& X, const std::vector<float>& W, const std::vector<float>& R,
+                          const std::vector<float>& B, int num_directions, int seq_length, int batch_size,
+                          int input_size, int hidden_size,
+                          std::vector<float>& Y, std::vector<float>& Y_h, std::vector<float>& Y_c) {
+  const int H = hidden_size;
+  Y.assign(seq_length * num_directions * batch_size * H, 0.f);
+  Y_h.assign(num_directions * batch_size * H, 0.f);
+  Y_c.assign(num_directions * batch_size * H, 0.f);
+
+  std::vector<float> x_gates(4 * H), h_gates(4 * H);
+  for (int direction = 0; direction < num_directions; ++direction) {
+    const float* w = W.data() + direction * 4 * H * input_size;
+    const float* r = R.data() + direction * 4 * H * H;
+    const float* b = B.data() + direction * 8 * H;
+
+    for (int row = 0; row < batch_size; ++row) {
+      float* h = Y_h.data() + (direction * batch_size + row) * H;
+      float* c = Y_c.data() + (direction * batch_size + row) * H;
+
+      for (int step = 0; step < seq_length; ++step) {
+        const int t = direction == 0 ? step : seq_length - 1 - step;
+        MultiplyAdd(X.data() + (t * batch_size + row) * input_size, w, b, 4 * H, input_size, x_gates.data());
+        MultiplyAdd(h, r, b + 4 * H, 4 * H, H, h_gates.data());
+
+        // gates are in the order i, o, f, c
+        for (int j = 0; j < H; ++j) {
+          const float i = Sigmoid(x_gates[j] + h_gates[j]);
+          const float o = Sigmoid(x_gates[H + j] + h_gates[H + j]);
+          const float f = Sigmoid(x_gates[2 * H + j] + h_gates[2 * H + j]);
+          const float g = std::tanh(x_gates[3 * H + j] + h_gates[3 * H + j]);
+          c[j] = f * c[j] + i * g;
+          h[j] = o * std::tanh(c[j]);
+        }
+
+        std::copy_n(h, H, Y.data() + ((t * num_directions + direction) * batch_size + row) * H);
+      }
+    }
+  }
+}
+
+static void ReferenceGru(const std::vector<float>& X, const std::vector<float>& W, const std::vector<float>& R,
+                         const std::vector<float>& B, bool linear_before_reset, int num_directions,
+                         int seq_length, int batch_size, int input_size, int hidden_size,
+                         std::vector<float>& Y, std::vector<float>& Y_h) {
+  const int H = hidden_size;
+  Y.assign(seq_length * num_directions * batch_size * H, 0.f);
+  Y_h.assign(num_directions * batch_size * H, 0.f);
+
+  std::vector<float> x_gates(3 * H), h_gates(2 * H), z(H), r_t(H), reset_h(H), h_linear(H);
+  for (int direction = 0; direction < num_directions; ++direction) {
+    const float* w = W.data() + direction * 3 * H * input_size;
+    const float* r = R.data() + direction * 3 * H * H;
+    const float* b = B.data() + direction * 6 * H;
+
+    for (int row = 0; row < batch_size; ++row) {
+      float* h = Y_h.data() + (direction * batch_size + row) * H;
+
+      for (int step = 0; step < seq_length; ++step) {
+        const int t = direction == 0 ? step : seq_length - 1 - step;
+        MultiplyAdd(X.data() + (t * batch_size + row) * input_size, w, b, 3 * H, input_size, x_gates.data());
+        MultiplyAdd(h, r, b + 3 * H, 2 * H, H, h_gates.data());
+
+        // gates are in the order z, r, h
+        for (int j = 0; j < H; ++j) {
+          z[j] = Sigmoid(x_gates[j] + h_gates[j]);
+          r_t[j] = Sigmoid(x_gates[H + j] + h_gates[H + j]);
+        }
+
+        if (linear_before_reset) {
+          MultiplyAdd(h, r + 2 * H * H, b + 5 * H, H, H, h_linear.data());
+          for (int j = 0; j < H; ++j) {
+            h_linear[j] *= r_t[j];
+          }
+        } else {
+          for (int j = 0; j < H; ++j) {
+            reset_h[j] = r_t[j] * h[j];
+          }
+          MultiplyAdd(reset_h.data(), r + 2 * H * H, b + 5 * H, H, H, h_linear.data());
+        }
+
+        for (int j = 0; j < H; ++j) {
+          const float h_candidate = std::tanh(x_gates[2 * H + j] + h_linear[j]);
+          h[j] = (1.f - z[j]) * h_candidate + z[j] * h[j];
+        }
+
+        std::copy_n(h, H, Y.data() + ((t * num_directions + direction) * batch_size + row) * H);
+      }
+    }
+  }
+}
+
+// the reference implementations run the first direction forward and the second in reverse, so direction is
+// "forward" or "bidirectional". hidden_size of 70 covers a partial tile of the packed LSTM weights.
+static void RunDynamicQuantizeLSTM(const std::string& direction, int batch_size, bool weights_are_initializers,
+                                   int seq_length = 5, int input_size = 16, int hidden_size = 70) {
+  const int num_directions = direction == "bidirectional" ? 2 : 1;
+  std::mt19937 generator(1234);
+  const auto X = RandomValues(seq_length * batch_size * input_size, 1.f, generator);
+  const auto W = RandomValues(num_directions * 4 * hidden_size * input_size, 0.25f, generator);
+  const auto R = RandomValues(num_directions * 4 * hidden_size * hidden_size, 0.1f, generator);
+  const auto B = RandomValues(num_directions * 8 * hidden_size, 0.1f, generator);
+
+  std::vector<float> Y, Y_h, Y_c;
+  ReferenceLstm(X, W, R, B, num_directions, seq_length, batch_size, input_size, hidden_size, Y, Y_h, Y_c);
+
+  OpTester test("DynamicQuantizeLSTM", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("direction", direction);
+  test.AddAttribute<int64_t>("hidden_size", hidden_size);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X);
+  test.AddInput<float>("W", {num_directions, 4 * hidden_size, input_size}, W, weights_are_initializers);
+  test.AddInput<float>("R", {num_directions, 4 * hidden_size, hidden_size}, R, weights_are_initializers);
+  test.AddInput<float>("B", {num_directions, 8 * hidden_size}, B);
+
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size}, Y);
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h);
+  test.AddOutput<float>("Y_c", {num_directions, batch_size, hidden_size}, Y_c);
+  test.SetOutputAbsErr("Y", kQuantizedRnnTolerance);
+  test.SetOutputAbsErr("Y_h", kQuantizedRnnTolerance);
+  test.SetOutputAbsErr("Y_c", kQuantizedRnnTolerance);
+
+  test.Run();
+}
+
+static void RunDynamicQuantizeGRU(const std::string& direction, int batch_size, bool weights_are_initializers,
+                                  bool linear_before_reset, int seq_length = 5, int input_size = 16,
+                                  int hidden_size = 70) {
+  const int num_directions = direction == "bidirectional" ? 2 : 1;
+  std::mt19937 generator(5678);
+  const auto X = RandomValues(seq_length * batch_size * input_size, 1.f, generator);
+  const auto W = RandomValues(num_directions * 3 * hidden_size * input_size, 0.25f, generator);
+  const auto R = RandomValues(num_directions * 3 * hidden_size * hidden_size, 0.1f, generator);
+  const auto B = RandomValues(num_directions * 6 * hidden_size, 0.1f, generator);
+
+  std::vector<float> Y, Y_h;
+  ReferenceGru(X, W, R, B, linear_before_reset, num_directions, seq_length, batch_size, input_size, hidden_size,
+               Y, Y_h);
+
+  OpTester test("DynamicQuantizeGRU", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("direction", direction);
+  test.AddAttribute<int64_t>("hidden_size", hidden_size);
+  test.AddAttribute<int64_t>("linear_before_reset", linear_before_reset ? 1 : 0);
+
+  test.AddInput<float>("X", {seq_length, batch_size, input_size}, X);
+  test.AddInput<float>("W", {num_directions, 3 * hidden_size, input_size}, W, weights_are_initializers);
+  test.AddInput<float>("R", {num_directions, 3 * hidden_size, hidden_size}, R, weights_are_initializers);
+  test.AddInput<float>("B", {num_directions, 6 * hidden_size}, B);
+
+  test.AddOutput<float>("Y", {seq_length, num_directions, batch_size, hidden_size}, Y);
+  test.AddOutput<float>("Y_h", {num_directions, batch_size, hidden_size}, Y_h);
+  test.SetOutputAbsErr("Y", kQuantizedRnnTolerance);
+  test.SetOutputAbsErr("Y_h", kQuantizedRnnTolerance);
+
+  test.Run();
+}
+
+TEST(DynamicQuantizeLSTMTest, ForwardConstantWeights) {
+  RunDynamicQuantizeLSTM("forward", 3, true);
+}
+
+TEST(DynamicQuantizeLSTMTest, BidirectionalConstantWeights) {
+  RunDynamicQuantizeLSTM("bidirectional", 3, true);
+}
+
+TEST(DynamicQuantizeLSTMTest, BidirectionalWeightsQuantizedPerCall) {
+  RunDynamicQuantizeLSTM("bidirectional", 3, false);
+}
+
+TEST(DynamicQuantizeLSTMTest, LargeBatch) {
+  RunDynamicQuantizeLSTM("bidirectional", 64, true, 3);
+}
+
+TEST(DynamicQuantizeGRUTest, ForwardConstantWeights) {
+  RunDynamicQuantizeGRU("forward", 3, true, false);
+}
+
+TEST(DynamicQuantizeGRUTest, BidirectionalConstantWeights) {
+  RunDynamicQuantizeGRU("bidirectional", 3, true, false);
+}
+
+TEST(DynamicQuantizeGRUTest, BidirectionalLinearBeforeReset) {
+  RunDynamicQuantizeGRU("bidirectional", 3, true, true);
+}
+
+TEST(DynamicQuantizeGRUTest, WeightsQuantizedPerCall) {
+  RunDynamicQuantizeGRU("forward", 3, false, true);
+}
+
+TEST(DynamicQuantizeGRUTest, LargeBatch) {
+  RunDynamicQuantizeGRU("bidirectional", 64, true, false, 3);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
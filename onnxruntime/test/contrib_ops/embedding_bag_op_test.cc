@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::vector<float> kEmbeddingTable = {1.0f, 1.5f,
+                                                   2.0f, 2.5f,
+                                                   3.0f, 3.5f,
+                                                   4.0f, 4.5f};
+
+TEST(EmbeddingBagOpTest, Sum_Offsets) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 2}, kEmbeddingTable);
+  test.AddInput<int64_t>("indices", {5}, {0, 2, 1, 1, 3});
+  test.AddInput<int64_t>("offsets", {3}, {0, 2, 2});
+  test.AddOutput<float>("output", {3, 2}, {4.0f, 5.0f,
+                                           0.0f, 0.0f,
+                                           8.0f, 9.5f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Mean_2DIndices_Int32) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("mode", std::string("mean"));
+  test.AddInput<float>("weight", {4, 2}, kEmbeddingTable);
+  test.AddInput<int32_t>("indices", {2, 3}, {0, 1, 2, 3, 3, 1});
+  test.AddOutput<float>("output", {2, 2}, {2.0f, 2.5f,
+                                           10.0f / 3.0f, 11.5f / 3.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, Sum_PerSampleWeights) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 2}, kEmbeddingTable);
+  test.AddInput<int64_t>("indices", {4}, {3, 0, 1, 2});
+  test.AddInput<int64_t>("offsets", {2}, {0, 1});
+  test.AddInput<float>("per_sample_weights", {4}, {0.5f, 1.0f, -1.0f, 2.0f});
+  test.AddOutput<float>("output", {2, 2}, {2.0f, 2.25f,
+                                           5.0f, 6.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagOpTest, InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {4, 2}, kEmbeddingTable);
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 4, 1, 2});
+  test.AddOutput<float>("output", {2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds, idx=4");
+}
+
+TEST(EmbeddingBagOpTest, MatchesGatherReduceSum) {
+  constexpr int64_t vocab = 97;
+  constexpr int64_t dim = 33;
+  constexpr int64_t bags = 64;
+  constexpr int64_t bag_size = 20;
+
+  std::vector<float> table(vocab * dim);
+  for (int64_t i = 0; i < vocab * dim; ++i) {
+    table[i] = static_cast<float>((i * 37) % 101) / 16.0f;
+  }
+  std::vector<int64_t> indices(bags * bag_size);
+  std::vector<float> expected(bags * dim, 0.0f);
+  for (int64_t b = 0; b < bags; ++b) {
+    for (int64_t l = 0; l < bag_size; ++l) {
+      const int64_t index = (b * 13 + l * 7) % vocab;
+      indices[b * bag_size + l] = index;
+      for (int64_t j = 0; j < dim; ++j) {
+        expected[b * dim + j] += table[index * dim + j];
+      }
+    }
+  }
+
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("weight", {vocab, dim}, table);
+  test.AddInput<int64_t>("indices", {bags, bag_size}, indices);
+  test.AddOutput<float>("output", {bags, dim}, expected);
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FusedConvOpTest, ResidualWithBiasAndRelu) {
+  OpTester test("FusedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{1, 1});
+  test.AddAttribute("activation", "Relu");
+  test.AddInput<float>("X", {1, 1, 2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("W", {2, 1, 1, 1}, {1.0f, -1.0f});
+  test.AddInput<float>("B", {2}, {0.5f, 0.0f});
+  test.AddInput<float>("Z", {1, 2, 2, 2}, {1.0f, 1.0f, 1.0f, 1.0f, 10.0f, 0.0f, -10.0f, 0.0f});
+  test.AddOutput<float>("Y", {1, 2, 2, 2}, {2.5f, 3.5f, 4.5f, 5.5f, 9.0f, 0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
+TEST(FusedConvOpTest, Residual1D) {
+  OpTester test("FusedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{1});
+  test.AddInput<float>("X", {1, 1, 3}, {1.0f, 2.0f, 3.0f});
+  test.AddInput<float>("W", {1, 1, 1}, {2.0f});
+  test.AddMissingOptionalInput<float>();
+  test.AddInput<float>("Z", {1, 1, 3}, {1.0f, -10.0f, 1.0f});
+  test.AddOutput<float>("Y", {1, 1, 3}, {3.0f, -6.0f, 7.0f});
+  test.Run();
+}
+
+TEST(FusedConvOpTest, ResidualShapeMismatch) {
+  OpTester test("FusedConv", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("kernel_shape", std::vector<int64_t>{1, 1});
+  test.AddInput<float>("X", {1, 1, 2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("W", {1, 1, 1, 1}, {1.0f});
+  test.AddMissingOptionalInput<float>();
+  test.AddInput<float>("Z", {1, 1, 1, 2}, {1.0f, 1.0f});
+  test.AddOutput<float>("Y", {1, 1, 2, 2}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Z must have the same shape as the output");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
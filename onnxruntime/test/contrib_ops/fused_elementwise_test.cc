@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static std::vector<float> MakeValues(size_t size, float frequency, float amplitude) {
+  std::vector<float> values(size);
+  for (size_t i = 0; i < size; i++) {
+    values[i] = std::sin(static_cast<float>(i) * frequency) * amplitude;
+  }
+  return values;
+}
+
+// Swish(X * scale + bias) with a scalar scale and a bias broadcast from the last dimension. The output is larger than
+// a block, so the bias wraps around the end of a block.
+TEST(FusedElementwiseTest, SwishWithBias) {
+  const int64_t batch_size = 3;
+  const int64_t sequence_length = 50;
+  const int64_t hidden_size = 7;
+  const float scale = 0.8f;
+
+  const auto x = MakeValues(batch_size * sequence_length * hidden_size, 0.37f, 2.0f);
+  const auto bias = MakeValues(hidden_size, 1.3f, 0.5f);
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    const float biased = x[i] * scale + bias[i % hidden_size];
+    y[i] = biased / (1.0f + std::exp(-biased));
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Add", "Sigmoid", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 3, 2, 4, -1, 4, 5});
+  test.AddInput<float>("X", {batch_size, sequence_length, hidden_size}, x);
+  test.AddInput<float>("scale", {}, {scale});
+  test.AddInput<float>("bias", {hidden_size}, bias);
+  test.AddOutput<float>("Y", {batch_size, sequence_length, hidden_size}, y);
+  test.Run();
+}
+
+// The attributes of Clip and LeakyRelu are passed in alphas and betas.
+TEST(FusedElementwiseTest, ClipAndLeakyRelu) {
+  const std::vector<float> x = {-3.0f, -1.0f, -0.25f, 0.0f, 0.5f, 1.0f, 2.5f, 4.0f};
+  const std::vector<float> z = {1.0f, -1.0f, 0.5f, 2.0f, -0.5f, 0.0f, 1.0f, 1.5f};
+  std::vector<float> y(x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    const float diff = std::min(std::max(x[i] - z[i], -2.0f), 2.0f);
+    y[i] = diff >= 0.0f ? diff : 0.1f * diff;
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Sub", "Clip", "LeakyRelu"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1, 3, -1});
+  test.AddAttribute("alphas", std::vector<float>{0.0f, -2.0f, 0.1f});
+  test.AddAttribute("betas", std::vector<float>{0.0f, 2.0f, 0.0f});
+  test.AddInput<float>("X", {2, 4}, x);
+  test.AddInput<float>("Z", {2, 4}, z);
+  test.AddOutput<float>("Y", {2, 4}, y);
+  test.Run();
+}
+
+// An input that isn't broadcast from the trailing dimensions of the output can't be read with the period of its size.
+TEST(FusedElementwiseTest, UnsupportedBroadcast) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Relu"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, 1, 2, -1});
+  test.AddInput<float>("X", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("column", {2, 1}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2, 3}, {2.0f, 3.0f, 4.0f, 6.0f, 7.0f, 8.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "is not broadcast from the trailing dimensions of the output shape");
+}
+
+TEST(FusedElementwiseTest, InvalidOperand) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Exp", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, -1, 1, 2});
+  test.AddInput<float>("X", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2}, {0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure,
+           "Operand 1 of instruction 1 must refer to an input or an earlier instruction, got 2");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(GeluTest, Basic) {
+  std::vector<float> x;
+  for (int i = -20; i <= 20; i++) {
+    x.push_back(0.37f * static_cast<float>(i));
+  }
+
+  std::vector<float> y;
+  for (float value : x) {
+    y.push_back(static_cast<float>(0.5 * value * (1.0 + std::erf(value / std::sqrt(2.0)))));
+  }
+
+  OpTester test("Gelu", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {41}, x);
+  test.AddOutput<float>("Y", {41}, y);
+  test.Run();
+}
+
+TEST(GeluTest, Shape3D) {
+  OpTester test("Gelu", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {1, 2, 3}, {-3.0f, -1.0f, -0.5f, 0.0f, 0.5f, 1.0f});
+  test.AddOutput<float>("Y", {1, 2, 3}, {-0.00404969f, -0.15865525f, -0.15426877f, 0.0f, 0.34573123f, 0.84134475f});
+  test.Run();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Normalizes each row of size row_size of x and applies the affine.
+static std::vector<float> ReferenceLayerNorm(const std::vector<float>& x, const std::vector<float>& scale,
+                                             const std::vector<float>& bias, size_t row_size, float epsilon) {
+  std::vector<float> y(x.size());
+  for (size_t row = 0; row < x.size() / row_size; row++) {
+    const float* row_x = x.data() + row * row_size;
+    double mean = 0.0;
+    double variance = 0.0;
+    for (size_t i = 0; i < row_size; i++) {
+      mean += row_x[i];
+    }
+    mean /= row_size;
+    for (size_t i = 0; i < row_size; i++) {
+      variance += (row_x[i] - mean) * (row_x[i] - mean);
+    }
+    variance /= row_size;
+    for (size_t i = 0; i < row_size; i++) {
+      const double normalized = (row_x[i] - mean) / std::sqrt(variance + epsilon);
+      y[row * row_size + i] = static_cast<float>(normalized * scale[i] + (bias.empty() ? 0.0f : bias[i]));
+    }
+  }
+  return y;
+}
+
+TEST(LayerNormTest, LastAxis) {
+  const std::vector<float> x = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f,
+                                -1.0f, 0.5f, 0.0f, 2.0f, -3.0f,
+                                7.0f, 7.0f, 7.0f, 7.0f, 7.0f};
+  const std::vector<float> scale = {1.0f, 0.5f, -2.0f, 1.5f, 1.0f};
+  const std::vector<float> bias = {0.0f, 1.0f, 0.5f, -1.0f, 2.0f};
+
+  OpTester test("LayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("epsilon", 1e-5f);
+  test.AddInput<float>("X", {3, 5}, x);
+  test.AddInput<float>("scale", {5}, scale);
+  test.AddInput<float>("B", {5}, bias);
+  test.AddOutput<float>("Y", {3, 5}, ReferenceLayerNorm(x, scale, bias, 5, 1e-5f));
+  test.Run();
+}
+
+TEST(LayerNormTest, TrailingAxesNoBias) {
+  std::vector<float> x(2 * 3 * 4);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = std::sin(static_cast<float>(i)) * 3.0f + 100.0f;
+  }
+  std::vector<float> scale(3 * 4);
+  for (size_t i = 0; i < scale.size(); i++) {
+    scale[i] = 0.25f * static_cast<float>(i) - 1.0f;
+  }
+
+  OpTester test("LayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("axis", static_cast<int64_t>(1));
+  test.AddAttribute("epsilon", 1e-3f);
+  test.AddInput<float>("X", {2, 3, 4}, x);
+  test.AddInput<float>("scale", {3, 4}, scale);
+  test.AddOutput<float>("Y", {2, 3, 4}, ReferenceLayerNorm(x, scale, {}, 12, 1e-3f));
+  test.Run();
+}
+
+TEST(LayerNormTest, InvalidScaleSize) {
+  OpTester test("LayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("X", {2, 3}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("scale", {2}, {1.0f, 1.0f});
+  test.AddOutput<float>("Y", {2, 3}, {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "scale must have 3 elements");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -30,5 +30,25 @@ TEST(MatmulIntegerOpTest, MatMulInteger) {
   test.AddOutput<int32_t>("T3", {1, 1}, {-1});
   test.Run();
 }
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_B) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<int8_t>("T2", {3, 2}, {1, -4, 2, 5, -3, 6});
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<int8_t>("b_zero_point", {}, {-1});
+  test.AddOutput<int32_t>("T3", {4, 2}, {1, -90, -2, -100, -5, -110, -8, -120});
+  test.Run();
+}
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_B_Initializer) {
+  OpTester test("MatMulInteger", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<int8_t>("T2", {3, 2}, {1, -4, 2, 5, -3, 6}, true);
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<int8_t>("b_zero_point", {}, {-1}, true);
+  test.AddOutput<int32_t>("T3", {4, 2}, {1, -90, -2, -100, -5, -110, -8, -120});
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
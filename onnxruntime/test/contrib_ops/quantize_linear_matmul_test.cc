@@ -58,5 +58,19 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul) {
   test.AddOutput<uint8_t>("T3", {2, 3}, {168, 115, 255, 1, 66, 151});
   test.Run();
 }
+
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMul_Int8_B_Initializer) {
+  OpTester test("QLinearMatMul", 1, onnxruntime::kMSDomain);
+  test.AddInput<uint8_t>("T1", {2, 4}, {208, 236, 0, 238, 3, 214, 255, 29});
+  test.AddInput<float>("a_scale", {}, {0.0066f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {113});
+  test.AddInput<int8_t>("T2", {4, 3}, {24, -77, 116, -68, -102, 127, -128, -1, 118, -1, 126, 119}, true);
+  test.AddInput<float>("b_scale", {}, {0.00705f});
+  test.AddInput<int8_t>("b_zero_point", {}, {-14}, true);
+  test.AddInput<float>("y_scale", {}, {0.0107f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {118});
+  test.AddOutput<uint8_t>("T3", {2, 3}, {168, 115, 255, 1, 66, 151});
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -152,6 +152,34 @@ TEST(QuantizeLinearOpTest, QuantizeLinear_0) {
   test.Run();
 }
 
+TEST(QuantizeLinearOpTest, QuantizeLinear_Int8) {
+  OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{6};
+  test.AddInput<float>("x", dims, {0, 2, 5, 1000, -254, -1000});
+  test.AddInput<float>("y_scale", {}, {2.0f});
+  test.AddInput<int8_t>("y_zero_point", {}, {-10});
+  test.AddOutput<int8_t>("y", dims, {-10, -9, -8, 127, -128, -128});
+  test.Run();
+}
+
+// quantize a tensor large enough to use the vectorized path, with values that
+// land on halfway cases to check rounding to even
+TEST(QuantizeLinearOpTest, QuantizeLinear_RoundToEven) {
+  OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{20};
+  std::vector<float> x(20);
+  std::vector<uint8_t> y(20);
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = static_cast<float>(i) + 0.5f;
+    y[i] = static_cast<uint8_t>(100 + ((i + 1) & ~size_t(1)));
+  }
+  test.AddInput<float>("x", dims, x);
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {100});
+  test.AddOutput<uint8_t>("y", dims, y);
+  test.Run();
+}
+
 // quantize with broadcasting
 TEST(QuantizeLinearOpTest, QuantizeLinear_1) {
   OpTester test("QuantizeLinear", 1, onnxruntime::kMSDomain);
@@ -166,7 +194,7 @@ TEST(QuantizeLinearOpTest, QuantizeLinear_1) {
   test.AddOutput<uint8_t>("Y", dims,
                           {0, 2, 3, 255,
                            0, 1, 2, 255,
-                           0, 1, 1, 250});
+                           0, 0, 1, 250});
   test.Run();
 }
 
@@ -184,7 +212,7 @@ TEST(QuantizeLinearOpTest, QuantizeLinear_2) {
   test.AddOutput<uint8_t>("Y", dims,
                           {0, 2, 3, 255,
                            0, 1, 2, 255,
-                           0, 1, 1, 250});
+                           0, 0, 1, 250});
   test.Run();
 }
 
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <cmath>
 #include <functional>
 #include <iterator>
 #include <thread>
@@ -1133,13 +1134,16 @@ TEST(ExecutionProviderTest, FunctionInlineTest) {
   VerifyOutputs(fetches, expected_dims_mul_m, expected_values_mul_m);
 }
 
-TEST(InferenceSessionTests, TestTruncatedSequence) {
+static const std::string kScanLstmModelUri = "testdata/scan_1.pb";
+
+// Loads the Scan LSTM model of the truncated sequence tests, and maps each output state to the input of its
+// initial value.
+static void LoadScanLstmModel(ONNX_NAMESPACE::ModelProto& model_proto,
+                              std::unordered_map<std::string, std::string>& init_state_map) {
   // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
-  static const std::string LSTM_MODEL_URI = "testdata/scan_1.pb";
   // This model is a 4x forward LSTM. Parse it to find out mapping between init_state input/output
-  ONNX_NAMESPACE::ModelProto model_proto;
   int model_fd;
-  auto status = Env::Default().FileOpenRd(LSTM_MODEL_URI, model_fd);
+  auto status = Env::Default().FileOpenRd(kScanLstmModelUri, model_fd);
   ASSERT_TRUE(status.IsOK());
   google::protobuf::io::FileInputStream f(model_fd);
   f.SetCloseOnDelete(true);
@@ -1155,7 +1159,6 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
     return nullptr;
   };
 
-  std::unordered_map<std::string, std::string> init_state_map;
   for (int i_node = 0; i_node < graph_proto.node_size(); ++i_node) {
     auto& node = *graph_proto.mutable_node(i_node);
     if (node.op_type() == "Scan") {
@@ -1180,11 +1183,18 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
       }
     }
   }
+}
+
+TEST(InferenceSessionTests, TestTruncatedSequence) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  std::unordered_map<std::string, std::string> init_state_map;
+  ASSERT_NO_FATAL_FAILURE(LoadScanLstmModel(model_proto, init_state_map));
+  const GraphProto& graph_proto = model_proto.graph();
 
   // now run the truncated model
   SessionOptions so;
   InferenceSession session_object(so);
-  ASSERT_TRUE(session_object.Load(LSTM_MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Load(kScanLstmModelUri).IsOK());
   ASSERT_TRUE(session_object.Initialize().IsOK());
 
   RunOptions run_options;
@@ -1286,6 +1296,218 @@ TEST(InferenceSessionTests, TestTruncatedSequence) {
   }
 }
 
+TEST(InferenceSessionTests, TestTruncatedSequenceWithStateBindings) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  std::unordered_map<std::string, std::string> init_state_map;
+  ASSERT_NO_FATAL_FAILURE(LoadScanLstmModel(model_proto, init_state_map));
+  ASSERT_FALSE(init_state_map.empty());
+
+  // keep the LSTM states in the session instead of passing them back and forth
+  SessionOptions so;
+  for (const auto& entry : init_state_map) {
+    so.state_bindings.push_back(entry);
+  }
+  InferenceSession session_object(so);
+  ASSERT_TRUE(session_object.Load(kScanLstmModelUri).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<int64_t> X_dims = {5, 1, 3};
+  std::vector<float> X = {0.5488135f, 0.71518934f, 0.60276335f,
+                          0.5448832f, 0.4236548f, 0.6458941f,
+                          0.4375872f, 0.891773f, 0.96366274f,
+                          0.3834415f, 0.79172504f, 0.5288949f,
+                          0.56804454f, 0.92559665f, 0.07103606f};
+
+  std::vector<int64_t> Y_dims = {5, 1, 2};
+  std::vector<float> Y_data = {-1.1730184e-04f, -3.1204990e-04f,
+                               -2.9978977e-04f, -1.0602647e-03f,
+                               -3.8115133e-04f, -2.0684483e-03f,
+                               -2.5120965e-04f, -2.9920202e-03f,
+                               3.0980256e-05f, -3.5933927e-03f};
+
+  std::string input_name = "Input13165";
+  std::string final_output_name;
+  for (const auto& output : model_proto.graph().output()) {
+    if (init_state_map.find(output.name()) == init_state_map.end()) {
+      final_output_name = output.name();
+    }
+  }
+  std::vector<std::string> output_names = {final_output_name};
+
+  auto seq_stride = TensorShape(X_dims).SizeFromDimension(1);
+  auto run_chunk = [&](const std::string& stream_id, int seq_start, int seq_len) {
+    RunOptions run_options;
+    run_options.stream_id = stream_id;
+
+    std::vector<int64_t> chunk_dims = X_dims;
+    chunk_dims[0] = seq_len;
+    std::vector<float> chunk(X.begin() + seq_start * seq_stride, X.begin() + (seq_start + seq_len) * seq_stride);
+    MLValue chunk_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), chunk_dims, chunk,
+                         &chunk_value);
+    NameMLValMap feeds = {{input_name, chunk_value}};
+
+    std::vector<MLValue> fetches;
+    auto st = session_object.Run(run_options, feeds, output_names, &fetches);
+    ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+    ASSERT_EQ(1, fetches.size());
+
+    auto& rtensor = fetches.front().Get<Tensor>();
+    std::vector<int64_t> output_dims = Y_dims;
+    output_dims[0] = seq_len;
+    TensorShape output_shape(output_dims);
+    ASSERT_EQ(output_shape, rtensor.Shape());
+    auto seq_output_stride = output_shape.SizeFromDimension(1);
+    for (int i = 0; i < output_shape.Size(); ++i)
+      EXPECT_NEAR(Y_data[i + seq_start * seq_output_stride], rtensor.Data<float>()[i], FLT_EPSILON);
+  };
+
+  // two interleaved streams, each continuing from its own state. the third chunk reuses the buffers of the first.
+  run_chunk("a", 0, 1);
+  run_chunk("b", 0, 2);
+  run_chunk("a", 1, 1);
+  run_chunk("b", 2, 2);
+
+  NameMLValMap snapshot;
+  ASSERT_TRUE(session_object.GetState("a", snapshot).IsOK());
+  ASSERT_EQ(init_state_map.size(), snapshot.size());
+
+  run_chunk("a", 2, 1);
+  run_chunk("a", 3, 2);
+  run_chunk("b", 4, 1);
+
+  // restoring the snapshot rewinds the stream, and resetting it starts from the initial state again
+  ASSERT_TRUE(session_object.SetState("a", snapshot).IsOK());
+  run_chunk("a", 2, 3);
+  ASSERT_TRUE(session_object.ResetState("a").IsOK());
+  run_chunk("a", 0, 5);
+
+  NameMLValMap invalid_state = {{input_name, snapshot.begin()->second}};
+  ASSERT_FALSE(session_object.SetState("a", invalid_state).IsOK());
+}
+
+// Creates a model with a bidirectional LSTM and a bidirectional GRU on the same input. With a single sequence
+// the directions are the only work worth splitting, so the kernels run them concurrently on their thread pools.
+static ONNX_NAMESPACE::ModelProto CreateBidirectionalRnnModel(int64_t seq_length, int64_t input_size,
+                                                              int64_t hidden_size) {
+  Model model("BidirectionalRnn");
+  auto& graph = model.MainGraph();
+
+  auto add_weights = [&graph](const std::string& name, const std::vector<int64_t>& dims) -> NodeArg* {
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(TensorProto_DataType_FLOAT);
+    int64_t size = 1;
+    for (auto dim : dims) {
+      tensor_proto.add_dims(dim);
+      size *= dim;
+    }
+    for (int64_t i = 0; i < size; i++) {
+      tensor_proto.add_float_data(0.2f * std::sin(0.37f * static_cast<float>(i)));
+    }
+    graph.AddInitializedTensor(tensor_proto);
+    return &graph.GetOrCreateNodeArg(name, nullptr);
+  };
+
+  TypeProto input_type;
+  input_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  for (auto dim : {seq_length, static_cast<int64_t>(1), input_size}) {
+    input_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+  TypeProto output_type;
+  output_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input = graph.GetOrCreateNodeArg("X", &input_type);
+  auto& lstm_output = graph.GetOrCreateNodeArg("lstm_Y", &output_type);
+  auto& gru_output = graph.GetOrCreateNodeArg("gru_Y", &output_type);
+
+  auto& lstm = graph.AddNode("lstm", "LSTM", "bidirectional LSTM",
+                             {&input, add_weights("lstm_W", {2, 4 * hidden_size, input_size}),
+                              add_weights("lstm_R", {2, 4 * hidden_size, hidden_size})},
+                             {&lstm_output});
+  lstm.AddAttribute("hidden_size", hidden_size);
+  lstm.AddAttribute("direction", std::string("bidirectional"));
+
+  auto& gru = graph.AddNode("gru", "GRU", "bidirectional GRU",
+                            {&input, add_weights("gru_W", {2, 3 * hidden_size, input_size}),
+                             add_weights("gru_R", {2, 3 * hidden_size, hidden_size})},
+                            {&gru_output});
+  gru.AddAttribute("hidden_size", hidden_size);
+  gru.AddAttribute("direction", std::string("bidirectional"));
+
+  auto status = graph.Resolve();
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  return model.ToProto();
+}
+
+// Runs from more threads than the RNN kernels have in their thread pools, so the tasks of the concurrent directions
+// of several Run calls fill the pools at the same time.
+TEST(InferenceSessionTests, ConcurrentBidirectionalRnnRuns) {
+  const int64_t seq_length = 5;
+  const int64_t input_size = 16;
+  const int64_t hidden_size = 64;
+
+  auto model_proto = CreateBidirectionalRnnModel(seq_length, input_size, hidden_size);
+
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ConcurrentBidirectionalRnnRuns";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  std::stringstream s1;
+  model_proto.SerializeToOstream(&s1);
+  ASSERT_TRUE(session_object.Load(s1).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::vector<float> x(static_cast<size_t>(seq_length * input_size));
+  for (size_t i = 0; i < x.size(); i++) {
+    x[i] = std::sin(0.11f * static_cast<float>(i));
+  }
+
+  const std::vector<int64_t> x_dims = {seq_length, 1, input_size};
+  auto run = [&session_object, &x, &x_dims](std::vector<std::vector<float>>& outputs) {
+    MLValue x_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), x_dims, x, &x_value);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", x_value));
+
+    std::vector<MLValue> fetches;
+    RunOptions run_options;
+    auto status = session_object.Run(run_options, feeds, {"lstm_Y", "gru_Y"}, &fetches);
+    EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+    outputs.clear();
+    for (const auto& fetch : fetches) {
+      const auto& y = fetch.Get<Tensor>();
+      outputs.emplace_back(y.Data<float>(), y.Data<float>() + y.Shape().Size());
+    }
+  };
+
+  std::vector<std::vector<float>> expected;
+  run(expected);
+  ASSERT_EQ(expected.size(), 2u);
+
+  const int num_threads = std::max(4, 2 * static_cast<int>(std::thread::hardware_concurrency()));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.emplace_back([&run, &expected]() {
+      for (int i = 0; i < 3; i++) {
+        std::vector<std::vector<float>> actual;
+        run(actual);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t j = 0; j < expected.size(); j++) {
+          ASSERT_EQ(expected[j].size(), actual[j].size());
+          for (size_t k = 0; k < expected[j].size(); k++) {
+            EXPECT_NEAR(expected[j][k], actual[j][k], 1e-6f);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
 // create the feeds and fetches using the dummy allocator so that we have to copy to CPU to execute, and from
 // CPU to return in utils::ExecuteGraph. Call InferenceSession::Run twice to test the caching of the copy logic.
 TEST(InferenceSessionTests, TestCopyToFromDevices) {
@@ -1343,6 +1565,54 @@ TEST(InferenceSessionTests, TestCopyToFromDevices) {
   run_test(run_number++);
 }
 
+TEST(InferenceSessionTests, CalibrationRanges) {
+  for (bool sequential : {true, false}) {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.CalibrationRanges";
+    so.enable_sequential_execution = sequential;
+    so.enable_calibration = true;
+    InferenceSession session_object{so, &DefaultLoggingManager()};
+    ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+    ASSERT_TRUE(session_object.Initialize().IsOK());
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+
+    // the input and the node output are recorded, the initializer is not
+    TensorRangeMap ranges;
+    ASSERT_TRUE(session_object.GetCalibrationRanges(ranges).IsOK());
+    ASSERT_EQ(2u, ranges.size());
+    EXPECT_EQ(std::make_pair(1.0f, 6.0f), ranges["X"]);
+    EXPECT_EQ(std::make_pair(1.0f, 36.0f), ranges["Y"]);
+
+    // the ranges are widened by later runs
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {3, 2},
+                         {-2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 7.0f}, &ml_value);
+    NameMLValMap feeds;
+    feeds.insert(std::make_pair("X", ml_value));
+    std::vector<MLValue> fetches;
+    ASSERT_TRUE(session_object.Run(run_options, feeds, {"Y"}, &fetches).IsOK());
+
+    ASSERT_TRUE(session_object.GetCalibrationRanges(ranges).IsOK());
+    EXPECT_EQ(std::make_pair(-2.0f, 7.0f), ranges["X"]);
+    EXPECT_EQ(std::make_pair(-2.0f, 42.0f), ranges["Y"]);
+
+    ASSERT_TRUE(session_object.ResetCalibrationRanges().IsOK());
+    ASSERT_TRUE(session_object.GetCalibrationRanges(ranges).IsOK());
+    EXPECT_TRUE(ranges.empty());
+  }
+
+  // the ranges are only available in calibration mode
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CalibrationRanges";
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.Load(MODEL_URI).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+  TensorRangeMap ranges;
+  ASSERT_FALSE(session_object.GetCalibrationRanges(ranges).IsOK());
+}
+
 TEST(InferenceSessionTests, TestL1Transformers) {
   string model_uri = "testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx";  
 
@@ -607,6 +607,45 @@ TEST(ResolvingGraphTest, UnusedInitializerIsIgnored) {
   ASSERT_TRUE(graph.GetAllInitializedTensors().empty());
 }
 
+// Validate that removing many unused initializers keeps the used one, both in the graph and in the GraphProto.
+TEST(ResolvingGraphTest, UnusedInitializersAreRemovedFromGraphProto) {
+  ASSERT_TRUE(kSchemasRegistered);
+
+  Model model("UnusedInitializersAreRemovedFromGraphProto");
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_int32;
+  tensor_int32.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+  tensor_int32.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto& input_arg_a = graph.GetOrCreateNodeArg("node_a_in_1", &tensor_int32);
+  auto& output_arg_a = graph.GetOrCreateNodeArg("node_a_out_1", &tensor_int32);
+  graph.AddNode("a", "Identity_Fake", "a", {&input_arg_a}, {&output_arg_a});
+
+  // the used initializer is in the middle of the unused ones
+  for (int i = 0; i < 100; ++i) {
+    TensorProto initializer_tensor;
+    initializer_tensor.set_name(i == 50 ? "node_a_in_1" : "unused_" + std::to_string(i));
+    initializer_tensor.add_dims(1);
+    initializer_tensor.add_int32_data(i);
+    initializer_tensor.set_data_type(TensorProto_DataType_INT32);
+    graph.AddInitializedTensor(initializer_tensor);
+  }
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_EQ(graph.GetAllInitializedTensors().size(), 1u);
+
+  const auto& graph_proto = graph.ToGraphProto();
+  ASSERT_EQ(graph_proto.initializer_size(), 1);
+  EXPECT_EQ(graph_proto.initializer(0).name(), "node_a_in_1");
+  EXPECT_EQ(graph_proto.initializer(0).int32_data(0), 50);
+
+  const TensorProto* initializer = nullptr;
+  ASSERT_TRUE(graph.GetInitializedTensor("node_a_in_1", initializer));
+  EXPECT_EQ(initializer, &graph_proto.initializer(0));
+}
+
 TEST(ResolvingGraphTest, GraphConstruction_CheckIsNotAcyclic) {
   // A cyclic graph
   //                 SouceNode
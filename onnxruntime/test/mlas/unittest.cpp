@@ -17,7 +17,10 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
+#include <random>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -367,6 +370,522 @@ ExecuteSgemmTests(
     }
 }
 
+void
+TrialSgemmEpilogue(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float beta,
+    MLAS_SGEMM_BIAS_KIND BiasKind,
+    const MLAS_ACTIVATION* Activation,
+    MatrixGuardBuffer& BufferA,
+    MatrixGuardBuffer& BufferB,
+    MatrixGuardBuffer& BufferBias,
+    MatrixGuardBuffer& BufferC,
+    MatrixGuardBuffer& BufferCReference
+    )
+{
+    const float* A = BufferA.GetBuffer(K * M);
+    const float* B = BufferB.GetBuffer(N * K);
+    const float* Bias = BufferBias.GetBuffer(N * M);
+    float* C = BufferC.GetBuffer(N * M);
+    float* CReference = BufferCReference.GetBuffer(N * M);
+
+    size_t lda = (TransA == CblasNoTrans) ? K : M;
+    size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+    for (size_t f = 0; f < M * N; f++) {
+        C[f] = float(int(f % 7) - 3);
+        CReference[f] = C[f];
+    }
+
+    MLAS_SGEMM_EPILOGUE Epilogue;
+    Epilogue.BiasKind = BiasKind;
+    Epilogue.Bias = Bias;
+    Epilogue.ldbias = N;
+    Epilogue.Activation = Activation;
+
+    MlasSgemm(TransA, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, C, N, &Epilogue);
+    ReferenceSgemm(TransA, TransB, M, N, K, 1.0f, A, lda, B, ldb, beta, CReference, N);
+
+    for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+
+            float& c = CReference[m * N + n];
+
+            switch (BiasKind) {
+                case MlasSgemmNoBias: break;
+                case MlasSgemmScalarBias: c += Bias[0]; break;
+                case MlasSgemmRowBias: c += Bias[m]; break;
+                case MlasSgemmColumnBias: c += Bias[n]; break;
+                case MlasSgemmMatrixBias: c += Bias[m * N + n]; break;
+            }
+
+            if (Activation != nullptr) {
+                if (Activation->ActivationKind == MlasReluActivation) {
+                    c = std::max(c, 0.0f);
+                } else if (Activation->ActivationKind == MlasLeakyReluActivation && c < 0.0f) {
+                    c *= Activation->alpha;
+                }
+            }
+        }
+    }
+
+    for (size_t f = 0; f < M * N; f++) {
+        if (C[f] != CReference[f]) {
+            printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, beta=%f, BiasKind=%d, Activation=%d!\n",
+                TransA, TransB, M, N, K, beta, int(BiasKind), (Activation != nullptr) ? int(Activation->ActivationKind) : -1);
+            return;
+        }
+    }
+}
+
+void
+ExecuteSgemmEpilogueTests(
+    void
+    )
+{
+    constexpr size_t MaximumDimension = 320;
+
+    MatrixGuardBuffer BufferA(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer BufferB(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer BufferBias(MaximumDimension * MaximumDimension, true);
+    MatrixGuardBuffer BufferC(MaximumDimension * MaximumDimension, false);
+    MatrixGuardBuffer BufferCReference(MaximumDimension * MaximumDimension, false);
+
+    static const MLAS_SGEMM_BIAS_KIND BiasKinds[] = {
+        MlasSgemmNoBias, MlasSgemmScalarBias, MlasSgemmRowBias, MlasSgemmColumnBias, MlasSgemmMatrixBias
+    };
+
+    static const MLAS_ACTIVATION Activations[] = {
+        { MlasReluActivation, 0.0f },
+        { MlasLeakyReluActivation, 0.5f },
+    };
+
+    static const size_t ks[] = { 0, 1, 3, 16, 129, 300 };
+
+    for (size_t b = 0; b < _countof(BiasKinds); b++) {
+        for (size_t M = 1; M < 300; M += 29) {
+            for (size_t N = 1; N < 300; N += 37) {
+                for (size_t k = 0; k < _countof(ks); k++) {
+                    size_t K = ks[k];
+
+                    TrialSgemmEpilogue(CblasNoTrans, CblasNoTrans, M, N, K, 0.0f, BiasKinds[b], nullptr,
+                        BufferA, BufferB, BufferBias, BufferC, BufferCReference);
+                    TrialSgemmEpilogue(CblasNoTrans, CblasTrans, M, N, K, 1.0f, BiasKinds[b], &Activations[0],
+                        BufferA, BufferB, BufferBias, BufferC, BufferCReference);
+                    TrialSgemmEpilogue(CblasTrans, CblasNoTrans, M, N, K, 0.0f, BiasKinds[b], &Activations[1],
+                        BufferA, BufferB, BufferBias, BufferC, BufferCReference);
+                    TrialSgemmEpilogue(CblasTrans, CblasTrans, M, N, K, 0.5f, BiasKinds[b], &Activations[0],
+                        BufferA, BufferB, BufferBias, BufferC, BufferCReference);
+                }
+            }
+        }
+        printf("BiasKind %zd\n", b);
+    }
+}
+
+float
+ReferenceHalfToFloat(
+    uint16_t Value
+    )
+{
+    int Exponent = (Value >> 10) & 0x1F;
+    int Mantissa = Value & 0x3FF;
+    float Magnitude;
+
+    if (Exponent == 0) {
+        Magnitude = std::ldexp(float(Mantissa), -24);
+    } else if (Exponent == 0x1F) {
+        Magnitude = (Mantissa == 0) ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    } else {
+        Magnitude = std::ldexp(float(Mantissa | 0x400), Exponent - 25);
+    }
+
+    return (Value & 0x8000) ? -Magnitude : Magnitude;
+}
+
+void
+TrialCompressedSgemm(
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float beta,
+    MLAS_COMPRESSED_FORMAT Format,
+    bool CompressA,
+    bool HasScale,
+    std::mt19937& Generator
+    )
+{
+    std::uniform_real_distribution<float> FloatDistribution(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> ScaleDistribution(0.01f, 0.1f);
+    std::uniform_int_distribution<int> Int8Distribution(-128, 127);
+    std::uniform_int_distribution<int> Float16Distribution(0, 0xFFFF);
+
+    //
+    // The compressed matrix is either A (M x K) or B (K x N, or N x K when
+    // transposed). The channels are the rows of A or the columns of B.
+    //
+
+    const size_t Channels = CompressA ? M : N;
+    const size_t ldCompressed = (CompressA || TransB != CblasNoTrans) ? K : N;
+    const size_t ldUncompressed = (TransB == CblasNoTrans) ? N : K;
+
+    std::vector<uint16_t> Float16Data(Channels * K);
+    std::vector<int8_t> Int8Data(Channels * K);
+    std::vector<float> Expanded(Channels * K);
+    std::vector<float> Scale(Channels);
+    std::vector<float> Uncompressed(CompressA ? K * N : M * K);
+
+    for (auto& s : Scale) {
+        s = ScaleDistribution(Generator);
+    }
+
+    for (size_t f = 0; f < Expanded.size(); f++) {
+        size_t Channel = CompressA ? (f / ldCompressed) : ((TransB == CblasNoTrans) ? (f % ldCompressed) : (f / ldCompressed));
+        float ChannelScale = HasScale ? Scale[Channel] : 1.0f;
+
+        if (Format == MlasCompressedFloat16) {
+            //
+            // Keep the exponent small enough that the products can't overflow,
+            // which still covers denormals and zeros.
+            //
+            uint16_t Value = uint16_t(Float16Distribution(Generator) & 0xC7FF);
+            Float16Data[f] = Value;
+            Expanded[f] = ReferenceHalfToFloat(Value) * ChannelScale;
+        } else {
+            int8_t Value = int8_t(Int8Distribution(Generator));
+            Int8Data[f] = Value;
+            Expanded[f] = float(Value) * ChannelScale;
+        }
+    }
+
+    for (auto& u : Uncompressed) {
+        u = FloatDistribution(Generator);
+    }
+
+    MLAS_COMPRESSED_MATRIX Compressed;
+    Compressed.Format = Format;
+    Compressed.Data = (Format == MlasCompressedFloat16) ? (const void*)Float16Data.data() : (const void*)Int8Data.data();
+    Compressed.ld = ldCompressed;
+    Compressed.Scale = HasScale ? Scale.data() : nullptr;
+
+    std::vector<float> C(M * N, 0.5f);
+    std::vector<float> CReference(M * N, 0.5f);
+    std::vector<float> CBound(M * N, 0.0f);
+
+    if (CompressA) {
+        MlasSgemm(TransB, M, N, K, 1.0f, &Compressed, Uncompressed.data(), ldUncompressed, beta, C.data(), N);
+        ReferenceSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, Expanded.data(), K, Uncompressed.data(), ldUncompressed, beta, CReference.data(), N);
+    } else {
+        MlasSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, Uncompressed.data(), K, &Compressed, beta, C.data(), N);
+        ReferenceSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, Uncompressed.data(), K, Expanded.data(), ldCompressed, beta, CReference.data(), N);
+    }
+
+    //
+    // The kernels may accumulate in a different order than the reference, so
+    // bound the error by the sum of the magnitudes of the products.
+    //
+
+    for (auto& e : Expanded) {
+        e = std::abs(e);
+    }
+    for (auto& u : Uncompressed) {
+        u = std::abs(u);
+    }
+
+    if (CompressA) {
+        ReferenceSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, Expanded.data(), K, Uncompressed.data(), ldUncompressed, 0.0f, CBound.data(), N);
+    } else {
+        ReferenceSgemm(CblasNoTrans, TransB, M, N, K, 1.0f, Uncompressed.data(), K, Expanded.data(), ldCompressed, 0.0f, CBound.data(), N);
+    }
+
+    for (size_t f = 0; f < M * N; f++) {
+        if (std::abs(C[f] - CReference[f]) > (CBound[f] + 1.0f) * 1e-5f) {
+            printf("mismatch TransB=%d, M=%zd, N=%zd, K=%zd, beta=%f, Format=%d, CompressA=%d, HasScale=%d!\n",
+                TransB, M, N, K, beta, int(Format), int(CompressA), int(HasScale));
+            return;
+        }
+    }
+}
+
+void
+ExecuteCompressedSgemmTests(
+    void
+    )
+{
+    std::mt19937 Generator(4321);
+
+    static const size_t ks[] = { 1, 3, 16, 17, 127, 128, 129, 300 };
+    static const MLAS_COMPRESSED_FORMAT Formats[] = { MlasCompressedFloat16, MlasCompressedInt8 };
+
+    for (size_t f = 0; f < _countof(Formats); f++) {
+        for (size_t M = 1; M < 40; M += 9) {
+            for (size_t N = 1; N < 300; N += 37) {
+                for (size_t k = 0; k < _countof(ks); k++) {
+                    size_t K = ks[k];
+
+                    TrialCompressedSgemm(CblasNoTrans, M, N, K, 0.0f, Formats[f], false, true, Generator);
+                    TrialCompressedSgemm(CblasTrans, M, N, K, 1.0f, Formats[f], false, false, Generator);
+                    TrialCompressedSgemm(CblasNoTrans, M, N, K, 0.5f, Formats[f], true, true, Generator);
+                    TrialCompressedSgemm(CblasTrans, M, N, K, 0.0f, Formats[f], true, false, Generator);
+                }
+            }
+            printf("Format %zd M %zd\n", f, M);
+        }
+
+        //
+        // Sizes large enough to run across multiple threads.
+        //
+
+        TrialCompressedSgemm(CblasNoTrans, 256, 512, 320, 0.0f, Formats[f], false, true, Generator);
+        TrialCompressedSgemm(CblasTrans, 512, 96, 320, 0.0f, Formats[f], false, true, Generator);
+        TrialCompressedSgemm(CblasNoTrans, 96, 1024, 288, 0.0f, Formats[f], true, true, Generator);
+        TrialCompressedSgemm(CblasNoTrans, 512, 64, 288, 0.0f, Formats[f], true, true, Generator);
+    }
+}
+
+template<typename BType>
+void
+ReferenceQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t offa,
+    const BType* B,
+    size_t ldb,
+    BType offb,
+    int32_t* C,
+    size_t ldc
+    )
+{
+    for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+            int32_t sum = 0;
+            for (size_t k = 0; k < K; k++) {
+                sum += (int32_t(A[m * lda + k]) - int32_t(offa)) * (int32_t(B[k * ldb + n]) - int32_t(offb));
+            }
+            C[m * ldc + n] = sum;
+        }
+    }
+}
+
+uint8_t
+ReferenceRequantize(
+    int32_t Value,
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS& Requantize
+    )
+{
+    //
+    // Compute the result using 64-bit arithmetic and round to nearest with
+    // ties away from zero, which is equivalent to the fixed point rounding
+    // steps used by the library.
+    //
+
+    int64_t Product = int64_t(Value) * int64_t(Requantize.Multiplier);
+    int64_t Nudge = (Product >= 0) ? (int64_t(1) << 30) : (1 - (int64_t(1) << 30));
+    int32_t High = int32_t((Product + Nudge) / (int64_t(1) << 31));
+
+    int32_t Mask = int32_t((int64_t(1) << Requantize.Shift) - 1);
+    int32_t Threshold = (Mask >> 1) + ((High < 0) ? 1 : 0);
+    int32_t Result = (High >> Requantize.Shift) + (((High & Mask) > Threshold) ? 1 : 0) + Requantize.ZeroPoint;
+
+    return uint8_t(std::min(std::max(Result, 0), 255));
+}
+
+template<typename BType>
+void
+TrialQgemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    uint8_t offa,
+    BType offb,
+    bool PackB,
+    bool Requantize,
+    std::mt19937& Generator
+    )
+{
+    std::uniform_int_distribution<int> Distribution(std::numeric_limits<BType>::min(), std::numeric_limits<BType>::max());
+
+    std::vector<uint8_t> A(M * K);
+    std::vector<BType> B(K * N);
+    std::vector<int32_t> Bias(M);
+    std::vector<int32_t> C(M * N, -1);
+    std::vector<int32_t> CReference(M * N);
+    std::vector<uint8_t> Output(M * N, 0);
+
+    for (auto& a : A) {
+        a = uint8_t(Distribution(Generator) - std::numeric_limits<BType>::min());
+    }
+    for (auto& b : B) {
+        b = BType(Distribution(Generator));
+    }
+    for (auto& bias : Bias) {
+        bias = Distribution(Generator) * 64;
+    }
+
+    MLAS_QGEMM_REQUANTIZE_PARAMETERS RequantizeParameters;
+    RequantizeParameters.Bias = Bias.data();
+    RequantizeParameters.Multiplier = 1300000000;
+    RequantizeParameters.Shift = 12;
+    RequantizeParameters.ZeroPoint = 120;
+    RequantizeParameters.Output = Output.data();
+    RequantizeParameters.ldo = N;
+
+    const MLAS_QGEMM_REQUANTIZE_PARAMETERS* RequantizeArgument = Requantize ? &RequantizeParameters : nullptr;
+
+    if (PackB) {
+        std::vector<uint8_t> PackedB(MlasQgemmPackBSize(N, K));
+        MlasQgemmPackB(N, K, B.data(), N, offb, PackedB.data());
+        MlasQgemmPackedB(M, N, K, A.data(), K, offa, PackedB.data(), C.data(), N, RequantizeArgument);
+    } else {
+        MlasQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, C.data(), N, RequantizeArgument);
+    }
+
+    ReferenceQgemm(M, N, K, A.data(), K, offa, B.data(), N, offb, CReference.data(), N);
+
+    for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+            size_t f = m * N + n;
+            if (C[f] != CReference[f]) {
+                printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, PackB=%d!\n", M, N, K, int(offa), int(offb), int(PackB));
+                return;
+            }
+            if (Requantize && Output[f] != ReferenceRequantize(CReference[f] + Bias[m], RequantizeParameters)) {
+                printf("requantize mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, PackB=%d!\n", M, N, K, int(offa), int(offb), int(PackB));
+                return;
+            }
+        }
+    }
+}
+
+void
+ExecuteQgemmTests(
+    void
+    )
+{
+    std::mt19937 Generator(1234);
+
+    for (size_t b = 1; b < 20; b++) {
+        TrialQgemm<uint8_t>(b, b, b, 3, 251, false, false, Generator);
+        TrialQgemm<int8_t>(b, b, b, 200, -5, false, false, Generator);
+    }
+
+    static const size_t ks[] = { 1, 2, 3, 16, 17, 31, 127, 128, 129, 300 };
+
+    for (size_t M = 1; M < 40; M += 7) {
+        for (size_t N = 1; N < 300; N += 29) {
+            for (size_t k = 0; k < _countof(ks); k++) {
+                size_t K = ks[k];
+
+                TrialQgemm<uint8_t>(M, N, K, 128, 0, false, false, Generator);
+                TrialQgemm<uint8_t>(M, N, K, 17, 140, true, false, Generator);
+                TrialQgemm<uint8_t>(M, N, K, 99, 12, false, true, Generator);
+                TrialQgemm<int8_t>(M, N, K, 0, 0, false, false, Generator);
+                TrialQgemm<int8_t>(M, N, K, 255, 127, true, true, Generator);
+            }
+        }
+        printf("M %zd\n", M);
+    }
+
+    for (size_t b = 256; b <= 512; b += 128) {
+        TrialQgemm<uint8_t>(b, b, b, 1, 2, false, true, Generator);
+        TrialQgemm<int8_t>(b, b, b, 3, -4, true, false, Generator);
+    }
+}
+
+template<typename QuantType>
+void
+TrialQuantizeLinear(
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t BlockSize,
+    bool HasZeroPoint,
+    std::mt19937& Generator
+    )
+{
+    std::uniform_real_distribution<float> ScaleDistribution(0.01f, 0.5f);
+    std::uniform_int_distribution<int> Distribution(std::numeric_limits<QuantType>::min(), std::numeric_limits<QuantType>::max());
+
+    const size_t TotalElements = BatchCount * ChannelCount * BlockSize;
+
+    std::vector<float> Scale(ChannelCount);
+    std::vector<QuantType> ZeroPoint(ChannelCount, QuantType(0));
+    std::vector<float> Input(TotalElements);
+    std::vector<QuantType> Output(TotalElements);
+    std::vector<float> Dequantized(TotalElements);
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+        Scale[c] = ScaleDistribution(Generator);
+        if (HasZeroPoint) {
+            ZeroPoint[c] = QuantType(Distribution(Generator));
+        }
+    }
+
+    //
+    // Generate values that cover saturation on both ends of the output range
+    // and values that land exactly on halfway cases.
+    //
+
+    for (size_t f = 0; f < TotalElements; f++) {
+        float Scaled = float(Distribution(Generator) * 2) + ((f % 3 == 0) ? 0.5f : 0.25f);
+        Input[f] = Scaled * Scale[(f / BlockSize) % ChannelCount];
+    }
+
+    MlasQuantizeLinear(Input.data(), Output.data(), BatchCount, ChannelCount, BlockSize,
+        Scale.data(), HasZeroPoint ? ZeroPoint.data() : nullptr);
+
+    for (size_t f = 0; f < TotalElements; f++) {
+        size_t c = (f / BlockSize) % ChannelCount;
+        float Value = std::nearbyint(Input[f] / Scale[c]) + float(ZeroPoint[c]);
+        Value = std::min(std::max(Value, float(std::numeric_limits<QuantType>::min())), float(std::numeric_limits<QuantType>::max()));
+        if (Output[f] != QuantType(Value)) {
+            printf("quantize mismatch Batch=%zd, Channel=%zd, Block=%zd, f=%zd!\n", BatchCount, ChannelCount, BlockSize, f);
+            return;
+        }
+    }
+
+    MlasDequantizeLinear(Output.data(), Dequantized.data(), BatchCount, ChannelCount, BlockSize,
+        Scale.data(), HasZeroPoint ? ZeroPoint.data() : nullptr);
+
+    for (size_t f = 0; f < TotalElements; f++) {
+        size_t c = (f / BlockSize) % ChannelCount;
+        float Value = float(int32_t(Output[f]) - int32_t(ZeroPoint[c])) * Scale[c];
+        if (Dequantized[f] != Value) {
+            printf("dequantize mismatch Batch=%zd, Channel=%zd, Block=%zd, f=%zd!\n", BatchCount, ChannelCount, BlockSize, f);
+            return;
+        }
+    }
+}
+
+void
+ExecuteQuantizeTests(
+    void
+    )
+{
+    std::mt19937 Generator(5678);
+
+    for (size_t n = 1; n < 80; n++) {
+        TrialQuantizeLinear<uint8_t>(1, 1, n, true, Generator);
+        TrialQuantizeLinear<int8_t>(1, 1, n, false, Generator);
+    }
+
+    for (size_t BlockSize = 1; BlockSize < 40; BlockSize += 3) {
+        TrialQuantizeLinear<uint8_t>(3, 5, BlockSize, true, Generator);
+        TrialQuantizeLinear<int8_t>(2, 7, BlockSize, true, Generator);
+    }
+
+    TrialQuantizeLinear<uint8_t>(1, 1, 1000003, true, Generator);
+    TrialQuantizeLinear<int8_t>(4, 3, 100001, true, Generator);
+    TrialQuantizeLinear<uint8_t>(1000, 64, 17, false, Generator);
+}
+
 void
 ReferenceConv2D(
     size_t BatchCount,
@@ -388,6 +907,7 @@ ReferenceConv2D(
     const float* Input,
     const float* Filter,
     const float* Bias,
+    float Beta,
     float* Output
     )
 {
@@ -439,7 +959,7 @@ ReferenceConv2D(
             }
 
             MlasSgemm(CblasNoTrans, CblasNoTrans, FilterCount, OutputSize, K, 1.0f,
-                filter, K, Im2Col, OutputSize, 0.0f, Output, OutputSize);
+                filter, K, Im2Col, OutputSize, Beta, Output, OutputSize);
 
             //
             // Apply the bias.
@@ -476,7 +996,11 @@ TrialConv2D(
     size_t DilationHeight,
     size_t DilationWidth,
     size_t StrideHeight,
-    size_t StrideWidth
+    size_t StrideWidth,
+    float Beta = 0.0f,
+    bool AllowWinograd = false,
+    const MLAS_CONV_ALGORITHM* Algorithm = nullptr,
+    size_t ThreadCount = 0
     )
 {
     int64_t OutputHeight64 =
@@ -516,8 +1040,15 @@ TrialConv2D(
                     OutputShape,
                     FilterCount,
                     &Activation,
+                    Beta,
+                    AllowWinograd,
                     &WorkingBufferSize);
 
+    if (Algorithm != nullptr &&
+        !MlasConvSelectAlgorithm(&Parameters, *Algorithm, ThreadCount, &WorkingBufferSize)) {
+        return;
+    }
+
     size_t OutputHeight = size_t(OutputHeight64);
     size_t OutputWidth = size_t(OutputWidth64);
 
@@ -544,9 +1075,28 @@ TrialConv2D(
 
     MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
 
+    //
+    // The output buffers are filled with the same values, which are
+    // accumulated as the residual if Beta is nonzero.
+    //
+
+    memcpy(OutputReference, Output, OutputBufferElements * sizeof(float));
+
+    //
+    // The Winograd algorithm computes with the transformed filter.
+    //
+
+    const bool UseWinograd = (Parameters.Algorithm == MlasConvAlgorithmWinograd);
+    std::vector<float> TransformedFilter;
+
+    if (UseWinograd) {
+        TransformedFilter.resize(MlasConvWinogradFilterSize(&Parameters));
+        MlasConvWinogradTransformFilter(&Parameters, Filter, TransformedFilter.data());
+    }
+
     MlasConv(&Parameters,
              Input,
-             Filter,
+             UseWinograd ? TransformedFilter.data() : Filter,
              Bias,
              BufferWorking.GetBuffer(WorkingBufferSize),
              Output);
@@ -564,12 +1114,39 @@ TrialConv2D(
                     Input,
                     Filter,
                     Bias,
+                    Beta,
                     OutputReference);
 
-    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
-        printf("mismatch: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd)!!!\n",
+    if (UseWinograd) {
+
+        //
+        // The Winograd transforms don't preserve the exactness of the integer
+        // inputs, so bound the error by the magnitude of the output of each
+        // image and channel.
+        //
+
+        for (size_t f = 0; f < OutputBufferElements; f += OutputSize) {
+
+            float Magnitude = 1.0f;
+
+            for (size_t n = f; n < f + OutputSize; n++) {
+                Magnitude = (std::max)(Magnitude, std::abs(OutputReference[n]));
+            }
+
+            for (size_t n = f; n < f + OutputSize; n++) {
+                if (std::abs(Output[n] - OutputReference[n]) > Magnitude * 1e-5f) {
+                    printf("mismatch winograd: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,tile=%zd,beta=%f!!!\n",
+                        BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
+                        Parameters.u.Winograd.TileSize, Beta);
+                    return;
+                }
+            }
+        }
+
+    } else if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch: batch=%zd,group=%zd,input(%zd,%zd,%zd),filter=%zd,kernel(%zd,%zd),beta=%f!!!\n",
             BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount,
-            KernelHeight, KernelWidth);
+            KernelHeight, KernelWidth, Beta);
     }
 }
 
@@ -601,6 +1178,55 @@ ExecuteConvTests(
         TrialConv2D(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
     }
 
+    //
+    // Accumulate a residual into the output for each algorithm.
+    //
+
+    for (unsigned i = 1; i < 256; i <<= 1) {
+        TrialConv2D(1, 1, 16, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(1, 1, 16, i, i, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(4, 2, 16, i, i, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(1, 1, 16, i, i, 256, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1.0f);
+        TrialConv2D(2, 1, 8, i, i, 16, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 2.0f);
+    }
+
+    //
+    // Select the Winograd algorithm for 3x3 convolutions with either tile size
+    // and partial tiles at the edges of the output.
+    //
+
+    static const unsigned ws[] = { 6, 7, 8, 9, 13, 16, 17, 31, 56 };
+
+    for (unsigned iw = 0; iw < _countof(ws); iw++) {
+        unsigned i = ws[iw];
+        TrialConv2D(1, 1, 32, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 0.0f, true);
+        TrialConv2D(1, 1, 32, i + 2, i + 7, 48, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1, 0.0f, true);
+        TrialConv2D(2, 3, 32, i, i + 1, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 0.0f, true);
+        TrialConv2D(1, 1, 33, i, i, 40, 3, 3, 1, 0, 2, 1, 1, 1, 1, 1, 1.0f, true);
+        TrialConv2D(1, 1, 64, i, i, 128, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 2.0f, true);
+    }
+
+    //
+    // Force each algorithm and thread count that can compute the convolution
+    // instead of the algorithm selected by the heuristics.
+    //
+
+    static const MLAS_CONV_ALGORITHM as[] = {
+        MlasConvAlgorithmGemmDirect,
+        MlasConvAlgorithmExpandThenGemm,
+        MlasConvAlgorithmExpandThenGemmSegmented,
+        MlasConvAlgorithmWinograd,
+    };
+
+    for (unsigned ia = 0; ia < _countof(as); ia++) {
+        for (size_t t = 0; t <= 5; t++) {
+            TrialConv2D(1, 1, 16, 11, 11, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 0.0f, false, &as[ia], t);
+            TrialConv2D(2, 2, 8, 13, 9, 24, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1.0f, true, &as[ia], t);
+            TrialConv2D(1, 1, 4, 6, 6, 4, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1, 0.0f, true, &as[ia], t);
+            TrialConv2D(1, 1, 16, 40, 40, 8, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 0.0f, true, &as[ia], t);
+        }
+    }
+
     for (unsigned ic = 0; ic < _countof(cs); ic++) {
         for (unsigned ih = 0; ih < _countof(is); ih++) {
             for (unsigned iw = 0; iw < _countof(is); iw++) {
@@ -635,6 +1261,776 @@ ExecuteConvTests(
     }
 }
 
+void
+ReferenceConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t OutputChannels,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingTop,
+    size_t PaddingLeft,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth,
+    size_t OutputHeight,
+    size_t OutputWidth,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output
+    )
+{
+    size_t InputSize = InputHeight * InputWidth;
+    size_t OutputSize = OutputHeight * OutputWidth;
+    size_t KernelSize = KernelHeight * KernelWidth;
+
+    for (size_t b = 0; b < BatchCount; b++) {
+
+        for (size_t g = 0; g < GroupCount; g++) {
+
+            const float* filter = Filter + g * InputChannels * OutputChannels * KernelSize;
+            const float* bias = Bias + g * OutputChannels;
+
+            for (size_t oc = 0; oc < OutputChannels; oc++) {
+                for (size_t o = 0; o < OutputSize; o++) {
+                    Output[oc * OutputSize + o] = bias[oc];
+                }
+            }
+
+            //
+            // Scatter each input element multiplied by the kernel.
+            //
+
+            for (size_t ic = 0; ic < InputChannels; ic++) {
+
+                for (size_t ih = 0; ih < InputHeight; ih++) {
+
+                    for (size_t iw = 0; iw < InputWidth; iw++) {
+
+                        float value = Input[ic * InputSize + ih * InputWidth + iw];
+
+                        for (size_t oc = 0; oc < OutputChannels; oc++) {
+
+                            for (size_t ky = 0; ky < KernelHeight; ky++) {
+
+                                size_t oh = ih * StrideHeight + ky * DilationHeight - PaddingTop;
+
+                                for (size_t kx = 0; kx < KernelWidth; kx++) {
+
+                                    size_t ow = iw * StrideWidth + kx * DilationWidth - PaddingLeft;
+
+                                    if (oh < OutputHeight && ow < OutputWidth) {
+                                        Output[oc * OutputSize + oh * OutputWidth + ow] += value *
+                                            filter[((ic * OutputChannels + oc) * KernelHeight + ky) * KernelWidth + kx];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            Input += InputChannels * InputSize;
+            Output += OutputChannels * OutputSize;
+        }
+    }
+}
+
+void
+TrialConvTranspose2D(
+    size_t BatchCount,
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t InputHeight,
+    size_t InputWidth,
+    size_t OutputChannels,
+    size_t KernelHeight,
+    size_t KernelWidth,
+    size_t PaddingTop,
+    size_t PaddingLeft,
+    size_t PaddingBottom,
+    size_t PaddingRight,
+    size_t DilationHeight,
+    size_t DilationWidth,
+    size_t StrideHeight,
+    size_t StrideWidth,
+    size_t OutputPaddingHeight = 0,
+    size_t OutputPaddingWidth = 0
+    )
+{
+    int64_t OutputHeight64 = int64_t((InputHeight - 1) * StrideHeight + DilationHeight * (KernelHeight - 1) + 1 +
+        OutputPaddingHeight) - int64_t(PaddingTop + PaddingBottom);
+    int64_t OutputWidth64 = int64_t((InputWidth - 1) * StrideWidth + DilationWidth * (KernelWidth - 1) + 1 +
+        OutputPaddingWidth) - int64_t(PaddingLeft + PaddingRight);
+
+    if (OutputHeight64 <= 0 || OutputWidth64 <= 0) {
+        return;
+    }
+
+    int64_t InputShape[] = { int64_t(InputHeight), int64_t(InputWidth) };
+    int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+    int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+    int64_t Padding[] = { int64_t(PaddingTop), int64_t(PaddingLeft), int64_t(PaddingBottom), int64_t(PaddingRight) };
+    int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+    int64_t OutputShape[] = { OutputHeight64, OutputWidth64 };
+
+    MLAS_CONV_TRANSPOSE_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvTransposePrepare(&Parameters,
+                             BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputShape,
+                             KernelShape,
+                             DilationShape,
+                             Padding,
+                             StrideShape,
+                             OutputShape,
+                             OutputChannels,
+                             &WorkingBufferSize);
+
+    size_t OutputHeight = size_t(OutputHeight64);
+    size_t OutputWidth = size_t(OutputWidth64);
+
+    size_t InputBufferElements = BatchCount * GroupCount * InputChannels * InputHeight * InputWidth;
+    size_t FilterBufferElements = GroupCount * InputChannels * OutputChannels * KernelHeight * KernelWidth;
+    size_t BiasBufferElements = GroupCount * OutputChannels;
+    size_t OutputBufferElements = BatchCount * GroupCount * OutputChannels * OutputHeight * OutputWidth;
+
+    MatrixGuardBuffer BufferInput(InputBufferElements, true);
+    MatrixGuardBuffer BufferFilter(FilterBufferElements, true);
+    MatrixGuardBuffer BufferPackedFilter(FilterBufferElements, false);
+    MatrixGuardBuffer BufferBias(BiasBufferElements, true);
+    MatrixGuardBuffer BufferWorking(WorkingBufferSize, false);
+    MatrixGuardBuffer BufferOutput(OutputBufferElements, false);
+    MatrixGuardBuffer BufferOutputReference(OutputBufferElements, false);
+
+    const float* Input = BufferInput.GetBuffer(InputBufferElements);
+    const float* Filter = BufferFilter.GetBuffer(FilterBufferElements);
+    float* PackedFilter = BufferPackedFilter.GetBuffer(FilterBufferElements);
+    const float* Bias = BufferBias.GetBuffer(BiasBufferElements);
+    float* Output = BufferOutput.GetBuffer(OutputBufferElements);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputBufferElements);
+
+    MlasConvTransposePackFilter(&Parameters, Filter, PackedFilter);
+
+    MlasConvTranspose(&Parameters,
+                      Input,
+                      PackedFilter,
+                      Bias,
+                      BufferWorking.GetBuffer(WorkingBufferSize),
+                      Output);
+
+    ReferenceConvTranspose2D(BatchCount,
+                             GroupCount,
+                             InputChannels,
+                             InputHeight, InputWidth,
+                             OutputChannels,
+                             KernelHeight, KernelWidth,
+                             PaddingTop, PaddingLeft,
+                             DilationHeight, DilationWidth,
+                             StrideHeight, StrideWidth,
+                             OutputHeight, OutputWidth,
+                             Input,
+                             Filter,
+                             Bias,
+                             OutputReference);
+
+    if (memcmp(Output, OutputReference, OutputBufferElements * sizeof(float)) != 0) {
+        printf("mismatch convtranspose: batch=%zd,group=%zd,input(%zd,%zd,%zd),output=%zd,kernel(%zd,%zd),stride(%zd,%zd)!!!\n",
+            BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, OutputChannels,
+            KernelHeight, KernelWidth, StrideHeight, StrideWidth);
+    }
+}
+
+void
+ExecuteConvTransposeTests(
+    void
+    )
+{
+    static const unsigned is[] = { 1, 2, 5, 7, 16, 33 };
+
+    for (unsigned ih = 0; ih < _countof(is); ih++) {
+        for (unsigned iw = 0; iw < _countof(is); iw++) {
+            unsigned h = is[ih];
+            unsigned w = is[iw];
+
+            //
+            // The 2x2 upsampling, including an odd output that falls back
+            // to the general path.
+            //
+
+            TrialConvTranspose2D(1, 1, 16, h, w, 8, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2);
+            TrialConvTranspose2D(2, 2, 3, h, w, 5, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2);
+            TrialConvTranspose2D(1, 1, 16, h, w, 8, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2, 1, 1);
+
+            //
+            // Overlapping kernels with padding, dilation and strides.
+            //
+
+            TrialConvTranspose2D(1, 1, 8, h, w, 16, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+            TrialConvTranspose2D(1, 1, 8, h, w, 4, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1);
+            TrialConvTranspose2D(2, 3, 4, h, w, 2, 4, 4, 1, 2, 1, 0, 1, 1, 2, 2);
+            TrialConvTranspose2D(1, 1, 5, h, w, 3, 3, 2, 0, 1, 2, 0, 2, 1, 1, 3);
+        }
+    }
+
+    //
+    // Output channel blocks and input column segments larger than a single
+    // block or segment.
+    //
+
+    TrialConvTranspose2D(1, 1, 64, 32, 32, 128, 3, 3, 1, 1, 1, 1, 1, 1, 2, 2, 1, 1);
+    TrialConvTranspose2D(2, 1, 32, 45, 29, 96, 2, 2, 0, 0, 0, 0, 1, 1, 2, 2);
+    TrialConvTranspose2D(1, 1, 16, 130, 7, 300, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+}
+
+template<typename T>
+void
+ReferenceIm2col(
+    const std::vector<int64_t>& InputShape,
+    const std::vector<int64_t>& KernelShape,
+    const std::vector<int64_t>& DilationShape,
+    const std::vector<int64_t>& Padding,
+    const std::vector<int64_t>& StrideShape,
+    const std::vector<int64_t>& OutputShape,
+    size_t Channels,
+    bool IsNhwc,
+    const T* Input,
+    T* Output,
+    T PaddingValue
+    )
+{
+    const size_t Dimensions = InputShape.size();
+
+    size_t InputSize = 1;
+    size_t KernelSize = 1;
+    size_t OutputSize = 1;
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        InputSize *= size_t(InputShape[dim]);
+        KernelSize *= size_t(KernelShape[dim]);
+        OutputSize *= size_t(OutputShape[dim]);
+    }
+
+    for (size_t c = 0; c < Channels; c++) {
+        for (size_t k = 0; k < KernelSize; k++) {
+            for (size_t o = 0; o < OutputSize; o++) {
+
+                size_t KernelIndex = k;
+                size_t OutputIndex = o;
+                size_t InputIndex = 0;
+                size_t InputStride = 1;
+                bool IsPadding = false;
+
+                for (size_t dim = Dimensions; dim-- > 0;) {
+                    int64_t kd = int64_t(KernelIndex % size_t(KernelShape[dim]));
+                    int64_t od = int64_t(OutputIndex % size_t(OutputShape[dim]));
+                    KernelIndex /= size_t(KernelShape[dim]);
+                    OutputIndex /= size_t(OutputShape[dim]);
+
+                    int64_t id = od * StrideShape[dim] - Padding[dim] + kd * DilationShape[dim];
+                    if (id < 0 || id >= InputShape[dim]) {
+                        IsPadding = true;
+                    } else {
+                        InputIndex += size_t(id) * InputStride;
+                    }
+                    InputStride *= size_t(InputShape[dim]);
+                }
+
+                T Value;
+
+                if (IsNhwc) {
+                    Value = IsPadding ? PaddingValue : Input[InputIndex * Channels + c];
+                    Output[(o * KernelSize + k) * Channels + c] = Value;
+                } else {
+                    Value = IsPadding ? PaddingValue : Input[c * InputSize + InputIndex];
+                    Output[(c * KernelSize + k) * OutputSize + o] = Value;
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void
+TrialIm2col(
+    size_t Channels,
+    const std::vector<int64_t>& InputShape,
+    const std::vector<int64_t>& KernelShape,
+    const std::vector<int64_t>& DilationShape,
+    const std::vector<int64_t>& Padding,
+    const std::vector<int64_t>& StrideShape,
+    bool IsNhwc,
+    std::mt19937& Generator
+    )
+{
+    const size_t Dimensions = InputShape.size();
+
+    std::vector<int64_t> OutputShape(Dimensions);
+
+    size_t InputSize = 1;
+    size_t KernelSize = 1;
+    size_t OutputSize = 1;
+
+    for (size_t dim = 0; dim < Dimensions; dim++) {
+        int64_t OutputExtent = (InputShape[dim] + Padding[dim] + Padding[dim + Dimensions] -
+            DilationShape[dim] * (KernelShape[dim] - 1) - 1) / StrideShape[dim] + 1;
+        if (OutputExtent <= 0) {
+            return;
+        }
+        OutputShape[dim] = OutputExtent;
+        InputSize *= size_t(InputShape[dim]);
+        KernelSize *= size_t(KernelShape[dim]);
+        OutputSize *= size_t(OutputExtent);
+    }
+
+    std::uniform_int_distribution<int> Distribution(0, 255);
+
+    std::vector<T> Input(Channels * InputSize);
+    std::vector<T> Output(Channels * KernelSize * OutputSize);
+    std::vector<T> OutputReference(Output.size());
+
+    for (auto& Value : Input) {
+        Value = T(Distribution(Generator));
+    }
+
+    const T PaddingValue = T(Distribution(Generator));
+
+    if (IsNhwc) {
+        MlasIm2colNhwc(Input.data(), Output.data(), Dimensions, Channels, InputShape.data(),
+            KernelShape.data(), DilationShape.data(), Padding.data(), StrideShape.data(),
+            OutputShape.data(), PaddingValue);
+    } else {
+        MlasIm2col(Input.data(), Output.data(), Dimensions, Channels, InputShape.data(),
+            KernelShape.data(), DilationShape.data(), Padding.data(), StrideShape.data(),
+            OutputShape.data(), PaddingValue);
+    }
+
+    ReferenceIm2col(InputShape, KernelShape, DilationShape, Padding, StrideShape, OutputShape,
+        Channels, IsNhwc, Input.data(), OutputReference.data(), PaddingValue);
+
+    if (memcmp(Output.data(), OutputReference.data(), Output.size() * sizeof(T)) != 0) {
+        printf("mismatch im2col: nhwc=%d,dimensions=%zd,channels=%zd,input=%lld,kernel=%lld,stride=%lld!!!\n",
+            int(IsNhwc), Dimensions, Channels, (long long)InputShape.back(), (long long)KernelShape.back(),
+            (long long)StrideShape.back());
+    }
+}
+
+void
+ExecuteIm2colTests(
+    void
+    )
+{
+    std::mt19937 Generator(1234);
+
+    static const int64_t is[] = { 1, 2, 5, 11, 32 };
+
+    for (bool IsNhwc : { false, true }) {
+        for (int64_t h : is) {
+            for (int64_t w : is) {
+
+                //
+                // Unit strides with padding, which copy contiguous runs, and
+                // strided or dilated kernels with asymmetric padding.
+                //
+
+                TrialIm2col<float>(3, { h, w }, { 3, 3 }, { 1, 1 }, { 1, 1, 1, 1 }, { 1, 1 }, IsNhwc, Generator);
+                TrialIm2col<uint8_t>(3, { h, w }, { 3, 3 }, { 1, 1 }, { 1, 1, 1, 1 }, { 1, 1 }, IsNhwc, Generator);
+                TrialIm2col<float>(4, { h, w }, { 2, 3 }, { 1, 2 }, { 0, 2, 1, 0 }, { 2, 3 }, IsNhwc, Generator);
+                TrialIm2col<uint8_t>(4, { h, w }, { 2, 3 }, { 2, 1 }, { 2, 0, 0, 1 }, { 2, 2 }, IsNhwc, Generator);
+                TrialIm2col<uint8_t>(2, { h, w }, { 5, 5 }, { 1, 1 }, { 3, 3, 3, 3 }, { 1, 1 }, IsNhwc, Generator);
+            }
+
+            TrialIm2col<float>(5, { h }, { 3 }, { 2 }, { 1, 2 }, { 2 }, IsNhwc, Generator);
+            TrialIm2col<uint8_t>(5, { h, 6, h }, { 3, 2, 3 }, { 1, 1, 2 }, { 1, 0, 1, 1, 1, 1 }, { 1, 2, 1 },
+                IsNhwc, Generator);
+        }
+
+        //
+        // Column matrices large enough to be partitioned across threads.
+        //
+
+        TrialIm2col<float>(64, { 56, 56 }, { 3, 3 }, { 1, 1 }, { 1, 1, 1, 1 }, { 1, 1 }, IsNhwc, Generator);
+        TrialIm2col<uint8_t>(32, { 75, 41 }, { 3, 3 }, { 1, 1 }, { 1, 1, 1, 1 }, { 2, 2 }, IsNhwc, Generator);
+    }
+}
+
+bool
+CloseEnough(
+    float Value,
+    double Reference,
+    double Magnitude = 1.0
+    )
+{
+    return std::fabs(double(Value) - Reference) <= 1e-4 * std::max(Magnitude, std::fabs(Reference));
+}
+
+void
+TrialNormalization(
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    float Offset,
+    std::mt19937& Generator
+    )
+{
+    std::uniform_real_distribution<float> Distribution(-2.0f, 2.0f);
+    std::uniform_int_distribution<int> IntegerDistribution(-23, 23);
+
+    const size_t TotalElements = BatchCount * ChannelCount * PlaneSize;
+
+    std::vector<float> Input(TotalElements);
+    std::vector<float> Output(TotalElements);
+    std::vector<float> Scale(ChannelCount);
+    std::vector<float> Shift(ChannelCount);
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+        Scale[c] = float(IntegerDistribution(Generator));
+        Shift[c] = float(IntegerDistribution(Generator));
+    }
+
+    //
+    // Batch normalization of integers is exact.
+    //
+
+    for (auto& Value : Input) {
+        Value = float(IntegerDistribution(Generator));
+    }
+
+    MlasBatchNormalization(Input.data(), Output.data(), BatchCount, ChannelCount, PlaneSize,
+        Scale.data(), Shift.data());
+
+    for (size_t f = 0; f < TotalElements; f++) {
+        size_t c = (f / PlaneSize) % ChannelCount;
+        if (Output[f] != Input[f] * Scale[c] + Shift[c]) {
+            printf("mismatch batchnorm: batch=%zd,channels=%zd,plane=%zd,f=%zd!!!\n", BatchCount, ChannelCount, PlaneSize, f);
+            break;
+        }
+    }
+
+    //
+    // The moments are checked against double precision references with data
+    // offset from zero to check the accuracy for large means.
+    //
+
+    for (auto& Value : Input) {
+        Value = Offset + Distribution(Generator);
+    }
+
+    MlasInstanceNormalization(Input.data(), Output.data(), BatchCount, ChannelCount, PlaneSize,
+        Scale.data(), Shift.data(), 1e-5f);
+
+    for (size_t Plane = 0; Plane < BatchCount * ChannelCount; Plane++) {
+        const float* PlaneInput = Input.data() + Plane * PlaneSize;
+        size_t c = Plane % ChannelCount;
+        double Mean = 0.0;
+        double Variance = 0.0;
+        for (size_t i = 0; i < PlaneSize; i++) {
+            Mean += PlaneInput[i];
+        }
+        Mean /= PlaneSize;
+        for (size_t i = 0; i < PlaneSize; i++) {
+            Variance += (PlaneInput[i] - Mean) * (PlaneInput[i] - Mean);
+        }
+        Variance /= PlaneSize;
+        //
+        // The rounding of the input is magnified by the ratio of the mean to
+        // the standard deviation.
+        //
+        const double InverseStdDev = 1.0 / std::sqrt(Variance + 1e-5);
+        const double Magnitude = 1.0 + std::fabs(Scale[c] * Mean * InverseStdDev);
+        for (size_t i = 0; i < PlaneSize; i++) {
+            double Reference = (PlaneInput[i] - Mean) * InverseStdDev * Scale[c] + Shift[c];
+            if (!CloseEnough(Output[Plane * PlaneSize + i], Reference, Magnitude)) {
+                printf("mismatch instancenorm: batch=%zd,channels=%zd,plane=%zd,offset=%f!!!\n", BatchCount, ChannelCount, PlaneSize, Offset);
+                Plane = BatchCount * ChannelCount;
+                break;
+            }
+        }
+    }
+
+    std::vector<float> Mean(ChannelCount);
+    std::vector<float> Variance(ChannelCount);
+
+    MlasComputeChannelMoments(Input.data(), BatchCount, ChannelCount, PlaneSize, Mean.data(), Variance.data());
+
+    for (size_t c = 0; c < ChannelCount; c++) {
+        double ReferenceMean = 0.0;
+        double ReferenceVariance = 0.0;
+        for (size_t n = 0; n < BatchCount; n++) {
+            for (size_t i = 0; i < PlaneSize; i++) {
+                ReferenceMean += Input[(n * ChannelCount + c) * PlaneSize + i];
+            }
+        }
+        ReferenceMean /= BatchCount * PlaneSize;
+        for (size_t n = 0; n < BatchCount; n++) {
+            for (size_t i = 0; i < PlaneSize; i++) {
+                double Value = Input[(n * ChannelCount + c) * PlaneSize + i] - ReferenceMean;
+                ReferenceVariance += Value * Value;
+            }
+        }
+        ReferenceVariance /= BatchCount * PlaneSize;
+        if (!CloseEnough(Mean[c], ReferenceMean) || !CloseEnough(Variance[c], ReferenceVariance)) {
+            printf("mismatch moments: batch=%zd,channels=%zd,plane=%zd,offset=%f!!!\n", BatchCount, ChannelCount, PlaneSize, Offset);
+            break;
+        }
+    }
+}
+
+void
+TrialLayerNormalization(
+    size_t RowCount,
+    size_t RowSize,
+    float Offset,
+    bool HasBias,
+    std::mt19937& Generator
+    )
+{
+    std::uniform_real_distribution<float> Distribution(-2.0f, 2.0f);
+
+    std::vector<float> Input(RowCount * RowSize);
+    std::vector<float> Output(RowCount * RowSize);
+    std::vector<float> Scale(RowSize);
+    std::vector<float> Bias(RowSize);
+
+    for (auto& Value : Input) {
+        Value = Offset + Distribution(Generator);
+    }
+
+    for (size_t i = 0; i < RowSize; i++) {
+        Scale[i] = Distribution(Generator);
+        Bias[i] = Distribution(Generator);
+    }
+
+    MlasLayerNormalization(Input.data(), Output.data(), RowCount, RowSize, Scale.data(),
+        HasBias ? Bias.data() : nullptr, 1e-5f);
+
+    for (size_t Row = 0; Row < RowCount; Row++) {
+        const float* RowInput = Input.data() + Row * RowSize;
+        double Mean = 0.0;
+        double Variance = 0.0;
+        for (size_t i = 0; i < RowSize; i++) {
+            Mean += RowInput[i];
+        }
+        Mean /= RowSize;
+        for (size_t i = 0; i < RowSize; i++) {
+            Variance += (RowInput[i] - Mean) * (RowInput[i] - Mean);
+        }
+        Variance /= RowSize;
+        const double InverseStdDev = 1.0 / std::sqrt(Variance + 1e-5);
+        const double Magnitude = 1.0 + std::fabs(Mean * InverseStdDev);
+        for (size_t i = 0; i < RowSize; i++) {
+            double Reference = (RowInput[i] - Mean) * InverseStdDev * Scale[i] + (HasBias ? Bias[i] : 0.0f);
+            if (!CloseEnough(Output[Row * RowSize + i], Reference, Magnitude)) {
+                printf("mismatch layernorm: rows=%zd,size=%zd,offset=%f,bias=%d!!!\n", RowCount, RowSize, Offset, int(HasBias));
+                Row = RowCount;
+                break;
+            }
+        }
+    }
+}
+
+void
+TrialLocalResponseNormalization(
+    size_t BatchCount,
+    size_t ChannelCount,
+    size_t PlaneSize,
+    size_t Size,
+    float Beta,
+    std::mt19937& Generator
+    )
+{
+    std::uniform_real_distribution<float> Distribution(-2.0f, 2.0f);
+
+    const size_t TotalElements = BatchCount * ChannelCount * PlaneSize;
+    const float Alpha = 0.0001f * 10;
+    const float Bias = 1.5f;
+
+    std::vector<float> Input(TotalElements);
+    std::vector<float> Output(TotalElements);
+
+    for (auto& Value : Input) {
+        Value = Distribution(Generator);
+    }
+
+    MlasLocalResponseNormalization(Input.data(), Output.data(), BatchCount, ChannelCount, PlaneSize,
+        Size, Alpha, Beta, Bias);
+
+    const int64_t PrePad = int64_t(Size - 1) / 2;
+
+    for (size_t f = 0; f < TotalElements; f++) {
+        size_t n = f / (ChannelCount * PlaneSize);
+        int64_t c = int64_t((f / PlaneSize) % ChannelCount);
+        size_t i = f % PlaneSize;
+        double SquareSum = 0.0;
+        for (int64_t w = c - PrePad; w < c - PrePad + int64_t(Size); w++) {
+            if (w >= 0 && w < int64_t(ChannelCount)) {
+                double Value = Input[(n * ChannelCount + w) * PlaneSize + i];
+                SquareSum += Value * Value;
+            }
+        }
+        double Reference = Input[f] * std::pow(Bias + Alpha / Size * SquareSum, -double(Beta));
+        if (!CloseEnough(Output[f], Reference)) {
+            printf("mismatch lrn: batch=%zd,channels=%zd,plane=%zd,size=%zd,beta=%f!!!\n", BatchCount, ChannelCount, PlaneSize, Size, Beta);
+            break;
+        }
+    }
+}
+
+void
+ExecuteNormalizationTests(
+    void
+    )
+{
+    std::mt19937 Generator(4321);
+
+    for (size_t PlaneSize : { 1, 3, 8, 15, 49, 1025, 3000 }) {
+        TrialNormalization(1, 3, PlaneSize, 0.0f, Generator);
+        TrialNormalization(2, 5, PlaneSize, 1000.0f, Generator);
+        TrialLayerNormalization(3, PlaneSize, 0.0f, true, Generator);
+        TrialLayerNormalization(2, PlaneSize, 1000.0f, false, Generator);
+
+        for (size_t Size : { 1, 3, 5 }) {
+            TrialLocalResponseNormalization(2, 7, PlaneSize, Size, 0.75f, Generator);
+            TrialLocalResponseNormalization(1, 4, PlaneSize, Size, 0.6f, Generator);
+        }
+    }
+
+    //
+    // Tensors large enough to be partitioned across threads.
+    //
+
+    TrialNormalization(4, 64, 56 * 56, 10.0f, Generator);
+    TrialLayerNormalization(128, 768, 10.0f, true, Generator);
+    TrialLocalResponseNormalization(2, 64, 27 * 27, 5, 0.75f, Generator);
+}
+
+void
+ExecuteErfTests(
+    void
+    )
+{
+    //
+    // Sweep the range of the approximations including the boundary of the
+    // small and large input polynomials, the clamping of large inputs and the
+    // non-multiple of the vector width tails.
+    //
+
+    std::vector<float> Input;
+
+    for (int i = -80000; i <= 80000; i++) {
+        Input.push_back(float(i) * 0.0001f);
+    }
+
+    Input.push_back(0.921875f);
+    Input.push_back(-0.921875f);
+    Input.push_back(std::nextafter(0.921875f, 1.0f));
+    Input.push_back(1e-20f);
+    Input.push_back(-1e-30f);
+    Input.push_back(100.0f);
+    Input.push_back(-1000.0f);
+
+    std::vector<float> Output(Input.size());
+
+    MlasComputeErf(Input.data(), Output.data(), Input.size());
+
+    for (size_t i = 0; i < Input.size(); i++) {
+        double Reference = std::erf(double(Input[i]));
+        if (std::fabs(double(Output[i]) - Reference) > 4e-7 * std::fabs(Reference)) {
+            printf("mismatch erf: x=%.9g, erf=%.9g, reference=%.9g!!!\n", Input[i], Output[i], Reference);
+            break;
+        }
+    }
+
+    MlasComputeGelu(Input.data(), Output.data(), Input.size());
+
+    for (size_t i = 0; i < Input.size(); i++) {
+        double Value = double(Input[i]);
+        double Reference = 0.5 * Value * (1.0 + std::erf(Value * 0.70710678118654752));
+        //
+        // The relative error is magnified where 1 + erf cancels for negative
+        // inputs.
+        //
+        if (std::fabs(double(Output[i]) - Reference) > 4e-7 * (std::fabs(Reference) + std::fabs(Value))) {
+            printf("mismatch gelu: x=%.9g, gelu=%.9g, reference=%.9g!!!\n", Input[i], Output[i], Reference);
+            break;
+        }
+    }
+}
+
+void
+ExecuteSoftmaxTests(
+    void
+    )
+{
+    //
+    // Include rows that are not a multiple of the vector width, large
+    // negative values such as those of an additive attention mask and rows
+    // whose exponentials underflow.
+    //
+
+    for (size_t D : {1, 3, 4, 7, 16, 33, 128}) {
+
+        const size_t N = 5;
+
+        std::vector<float> Input(N * D);
+
+        for (size_t i = 0; i < Input.size(); i++) {
+            Input[i] = std::sin(float(i) * 0.37f) * float(i % 13);
+        }
+
+        Input[D / 2] = -10000.0f;
+        Input[D + D / 3] = 90.0f;
+
+        std::vector<float> Output(N * D);
+
+        MlasComputeSoftmax(Input.data(), Output.data(), N, D);
+
+        for (size_t n = 0; n < N; n++) {
+
+            const float* Row = Input.data() + n * D;
+            double Maximum = *std::max_element(Row, Row + D);
+            double Sum = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                Sum += std::exp(double(Row[d]) - Maximum);
+            }
+
+            for (size_t d = 0; d < D; d++) {
+                double Argument = double(Row[d]) - Maximum;
+                double Reference = std::exp(Argument) / Sum;
+                //
+                // The rounding of the shifted input to single precision
+                // magnifies the relative error for large arguments.
+                //
+                if (std::fabs(double(Output[n * D + d]) - Reference) >
+                    1e-6 * (1.0 + std::fabs(Argument)) * Reference + 1e-30) {
+                    printf("mismatch softmax: D=%zd, n=%zd, d=%zd, softmax=%.9g, reference=%.9g!!!\n",
+                        D, n, d, Output[n * D + d], Reference);
+                    break;
+                }
+            }
+        }
+
+        //
+        // The softmax may be computed in place.
+        //
+
+        MlasComputeSoftmax(Input.data(), Input.data(), N, D);
+
+        if (memcmp(Input.data(), Output.data(), Input.size() * sizeof(float)) != 0) {
+            printf("mismatch softmax: D=%zd in place!!!\n", D);
+        }
+    }
+}
+
 void
 ReferenceMaximumPool2D(
     const int64_t* InputShape,
@@ -1239,6 +2635,15 @@ main(
     )
 {
 //    ExecuteSgemmTests();
+    ExecuteSgemmEpilogueTests();
+    ExecuteCompressedSgemmTests();
+    ExecuteQgemmTests();
+    ExecuteQuantizeTests();
+    ExecuteConvTransposeTests();
+    ExecuteIm2colTests();
+    ExecuteNormalizationTests();
+    ExecuteErfTests();
+    ExecuteSoftmaxTests();
     ExecuteConvTests();
 //    ExecutePool2DTests();
 //    ExecutePool3DTests();
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Throughput of the dynamically quantized int8 recurrent operators against the fp32 ONNX LSTM and GRU.
+// Each benchmark runs a single layer over kSequenceLength steps, with input_size equal to hidden_size, and
+// takes the batch size and the hidden size as arguments.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/constants.h>
+#include <core/graph/model.h>
+#include <core/session/onnxruntime_c_api.h>
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+
+#define ORT_BREAK_ON_ERROR(expr)                            \
+  do {                                                      \
+    OrtStatus* onnx_status = (expr);                        \
+    if (onnx_status != NULL) {                              \
+      state.SkipWithError(OrtGetErrorMessage(onnx_status)); \
+      OrtReleaseStatus(onnx_status);                        \
+    }                                                       \
+  } while (0);
+
+static const int64_t kSequenceLength = 32;
+
+// Each benchmark writes its model here before creating the session.
+static const ORTCHAR_T* kRnnModelPath = ORT_TSTR("rnn_benchmark.onnx");
+
+static void AddRandomInitializer(onnxruntime::Graph& graph, const std::string& name, const std::vector<int64_t>& dims,
+                                 float range, std::mt19937& generator) {
+  ONNX_NAMESPACE::TensorProto tensor_proto;
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  int64_t size = 1;
+  for (auto dim : dims) {
+    tensor_proto.add_dims(dim);
+    size *= dim;
+  }
+  std::uniform_real_distribution<float> distribution(-range, range);
+  for (int64_t i = 0; i < size; ++i) {
+    tensor_proto.add_float_data(distribution(generator));
+  }
+  graph.AddInitializedTensor(tensor_proto);
+}
+
+// Writes a single layer model of 'op_type' with constant weights. 'num_gates' is 4 for LSTM and 3 for GRU.
+static onnxruntime::common::Status SaveRnnModel(const std::string& op_type, const std::string& domain,
+                                                int64_t num_gates, int64_t batch_size, int64_t hidden_size) {
+  onnxruntime::Model model(op_type);
+  auto& graph = model.MainGraph();
+
+  std::mt19937 generator(1234);
+  AddRandomInitializer(graph, "W", {1, num_gates * hidden_size, hidden_size}, 0.1f, generator);
+  AddRandomInitializer(graph, "R", {1, num_gates * hidden_size, hidden_size}, 0.1f, generator);
+  AddRandomInitializer(graph, "B", {1, 2 * num_gates * hidden_size}, 0.1f, generator);
+
+  ONNX_NAMESPACE::TypeProto x_type;
+  x_type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  for (auto dim : {kSequenceLength, batch_size, hidden_size}) {
+    x_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& w = graph.GetOrCreateNodeArg("W", nullptr);
+  auto& r = graph.GetOrCreateNodeArg("R", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("B", nullptr);
+  auto& y = graph.GetOrCreateNodeArg("Y", nullptr);
+  auto& node = graph.AddNode("rnn", op_type, "", {&x, &w, &r, &b}, {&y}, nullptr, domain);
+  node.AddAttribute("hidden_size", hidden_size);
+
+  ORT_RETURN_IF_ERROR(graph.Resolve());
+  return onnxruntime::Model::Save(model, std::basic_string<ORTCHAR_T>(kRnnModelPath));
+}
+
+static void RunRnn(benchmark::State& state, const std::string& op_type, const std::string& domain,
+                   int64_t num_gates) {
+  const int64_t batch_size = state.range(0);
+  const int64_t hidden_size = state.range(1);
+  auto st = SaveRnnModel(op_type, domain, num_gates, batch_size, hidden_size);
+  if (!st.IsOK()) {
+    state.SkipWithError(st.ErrorMessage().c_str());
+    return;
+  }
+
+  OrtSessionOptions* session_option = OrtCreateSessionOptions();
+  OrtSession* session = nullptr;
+  ORT_BREAK_ON_ERROR(OrtCreateSession(env, kRnnModelPath, session_option, &session));
+  OrtReleaseSessionOptions(session_option);
+  if (session == nullptr) return;
+
+  std::vector<float> x_data(kSequenceLength * batch_size * hidden_size, 0.5f);
+  const size_t x_shape[] = {static_cast<size_t>(kSequenceLength), static_cast<size_t>(batch_size),
+                            static_cast<size_t>(hidden_size)};
+  OrtAllocatorInfo* allocator_info = nullptr;
+  OrtValue* x = nullptr;
+  ORT_BREAK_ON_ERROR(OrtCreateCpuAllocatorInfo(OrtArenaAllocator, OrtMemTypeDefault, &allocator_info));
+  ORT_BREAK_ON_ERROR(OrtCreateTensorWithDataAsOrtValue(allocator_info, x_data.data(), x_data.size() * sizeof(float),
+                                                      x_shape, 3, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &x));
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* y = nullptr;
+    ORT_BREAK_ON_ERROR(OrtRun(session, nullptr, input_names, &x, 1, output_names, 1, &y));
+    OrtReleaseValue(y);
+  }
+  state.SetItemsProcessed(state.iterations() * kSequenceLength * batch_size);
+
+  OrtReleaseValue(x);
+  OrtReleaseAllocatorInfo(allocator_info);
+  OrtReleaseSession(session);
+}
+
+static void BM_LSTM(benchmark::State& state) {
+  RunRnn(state, "LSTM", onnxruntime::kOnnxDomain, 4);
+}
+
+static void BM_DynamicQuantizeLSTM(benchmark::State& state) {
+  RunRnn(state, "DynamicQuantizeLSTM", onnxruntime::kMSDomain, 4);
+}
+
+static void BM_GRU(benchmark::State& state) {
+  RunRnn(state, "GRU", onnxruntime::kOnnxDomain, 3);
+}
+
+static void BM_DynamicQuantizeGRU(benchmark::State& state) {
+  RunRnn(state, "DynamicQuantizeGRU", onnxruntime::kMSDomain, 3);
+}
+
+static void RnnArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"batch", "hidden"});
+  b->Args({1, 256})->Args({1, 512})->Args({16, 512})->Args({64, 1024});
+}
+
+BENCHMARK(BM_LSTM)->Apply(RnnArgs);
+BENCHMARK(BM_DynamicQuantizeLSTM)->Apply(RnnArgs);
+BENCHMARK(BM_GRU)->Apply(RnnArgs);
+BENCHMARK(BM_DynamicQuantizeGRU)->Apply(RnnArgs);
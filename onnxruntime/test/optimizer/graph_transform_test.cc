@@ -13,8 +13,17 @@
 #include "core/optimizer/conv_mul_fusion.h"
 #include "core/optimizer/conv_add_fusion.h"
 #include "core/optimizer/conv_activation_fusion.h"
+#include "core/optimizer/conv_residual_add_fusion.h"
 #include "core/optimizer/matmul_add_fusion.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
+#include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/gelu_fusion.h"
+#include "core/optimizer/attention_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
+#include "core/optimizer/dynamic_quantization.h"
+#include "core/optimizer/static_quantization.h"
+#include "core/optimizer/weight_compression.h"
 #include "core/framework/data_types.h"
 #include "core/framework/ml_value.h"
 #include "core/util/math.h"
@@ -23,6 +32,8 @@
 #include "test/capturing_sink.h"
 #include "test/test_environment.h"
 #include "gtest/gtest.h"
+#include <cstdio>
+#include <random>
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 
@@ -44,6 +55,103 @@ std::map<std::string, int> CountOpsInGraph(const Graph& graph) {
   }
   return op_to_count;
 }
+
+// The Level2 fusions run after partitioning and only fuse nodes assigned to the CPU execution provider, so the
+// nodes of a model loaded by a test are assigned to it as the partitioner would.
+static void AssignNodesToCpu(Graph& graph) {
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// A named float input of a model.
+struct FloatInput {
+  std::string name;
+  std::vector<int64_t> dims;
+  std::vector<float> values;
+};
+
+static std::vector<float> RandomValues(size_t count, float min_value, float max_value,
+                                       std::default_random_engine& generator) {
+  std::uniform_real_distribution<float> distribution(min_value, max_value);
+  std::vector<float> values(count);
+  for (auto& value : values) {
+    value = distribution(generator);
+  }
+  return values;
+}
+
+// Runs the session with the inputs and returns the float outputs with the given names.
+static void RunSession(InferenceSession& session_object,
+                       const std::vector<FloatInput>& inputs,
+                       const std::vector<std::string>& output_names,
+                       std::vector<std::vector<float>>& outputs) {
+  NameMLValMap feeds;
+  for (const auto& input : inputs) {
+    MLValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), input.dims, input.values,
+                         &ml_value);
+    feeds.insert(std::make_pair(input.name, ml_value));
+  }
+
+  std::vector<MLValue> fetches;
+  RunOptions run_options;
+  ASSERT_TRUE(session_object.Run(run_options, feeds, output_names, &fetches).IsOK());
+
+  outputs.clear();
+  for (const auto& fetch : fetches) {
+    auto& y = fetch.Get<Tensor>();
+    outputs.emplace_back(y.template Data<float>(), y.template Data<float>() + y.Shape().Size());
+  }
+}
+
+// Loads the model with the graph optimization level and weight compression, runs it with the inputs and returns the
+// float outputs with the given names. If transformers is not empty, only these transformers are applied.
+static void RunModel(const std::string& model_uri,
+                     uint32_t graph_optimization_level,
+                     const std::vector<std::string>& transformers,
+                     const std::vector<FloatInput>& inputs,
+                     const std::vector<std::string>& output_names,
+                     std::vector<std::vector<float>>& outputs,
+                     WeightCompressionFormat weight_compression = WeightCompressionFormat::None) {
+  SessionOptions so;
+  so.session_logid = std::string("GraphTransformationTests.") +
+                     ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  so.graph_optimization_level = graph_optimization_level;
+  so.weight_compression = weight_compression;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  if (!transformers.empty()) {
+    ASSERT_TRUE(session_object.AddCustomTransformerList(transformers).IsOK());
+  }
+  ASSERT_TRUE(session_object.Load(model_uri).IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  RunSession(session_object, inputs, output_names, outputs);
+}
+
+static void ExpectOutputsNear(const std::vector<std::vector<float>>& expected,
+                              const std::vector<std::vector<float>>& actual,
+                              float tolerance) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i].size(), actual[i].size());
+    for (size_t j = 0; j < expected[i].size(); j++) {
+      EXPECT_NEAR(expected[i][j], actual[i][j], tolerance) << "output " << i << " index " << j;
+    }
+  }
+}
+
+// Returns the largest absolute value of the outputs, which bounds the error of quantized weights.
+static float MaxAbsOutput(const std::vector<std::vector<float>>& outputs) {
+  float max_abs = 0.0f;
+  for (const auto& output : outputs) {
+    for (float value : output) {
+      max_abs = std::max(max_abs, std::abs(value));
+    }
+  }
+  return max_abs;
+}
+
 TEST(GraphTransformationTests, IdentityElimination) {
   string model_uri = MODEL_FOLDER + "abs-id-max.onnx";
   std::shared_ptr<Model> model;
@@ -361,5 +469,716 @@ TEST(GraphTransformationTests, FuseConvBnAddMulFloat16) {
   ASSERT_EQ(expected_values_prod, found);
 }
 
+TEST(GraphTransformationTests, EmbeddingBagFusion) {
+  for (std::string mode : {"sum", "mean"}) {
+    string model_uri = MODEL_FOLDER + "fusion/embedding_bag_" + mode + ".onnx";
+    std::shared_ptr<Model> p_model;
+    ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+    Graph& graph = p_model->MainGraph();
+    AssignNodesToCpu(graph);
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.Register(std::make_unique<EmbeddingBagFusion>(), TransformerLevel::Level2,
+                                      {onnxruntime::kCpuExecutionProvider});
+    ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["Gather"] == 0);
+    ASSERT_TRUE(op_to_count["ReduceSum"] == 0);
+    ASSERT_TRUE(op_to_count["ReduceMean"] == 0);
+    ASSERT_TRUE(op_to_count["EmbeddingBag"] == 1);
+
+    for (const Node& node : graph.Nodes()) {
+      ASSERT_TRUE(node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider);
+    }
+  }
+}
+
+TEST(GraphTransformationTests, LayerNormFusion) {
+  string model_uri = MODEL_FOLDER + "fusion/layer_norm.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<LayerNormFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["ReduceMean"] == 0);
+  ASSERT_TRUE(op_to_count["Sub"] == 0);
+  ASSERT_TRUE(op_to_count["Pow"] == 0);
+  ASSERT_TRUE(op_to_count["Add"] == 0);
+  ASSERT_TRUE(op_to_count["Sqrt"] == 0);
+  ASSERT_TRUE(op_to_count["Div"] == 0);
+  ASSERT_TRUE(op_to_count["Mul"] == 0);
+  ASSERT_TRUE(op_to_count["LayerNormalization"] == 1);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "LayerNormalization") {
+      const auto& attributes = node.GetAttributes();
+      ASSERT_TRUE(attributes.at("axis").i() == -1);
+      ASSERT_TRUE(attributes.at("epsilon").f() == 1e-5f);
+    }
+    ASSERT_TRUE(node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// The scale has one element per normalized element, but with shape [8, 1] it scales each row of the input instead.
+TEST(GraphTransformationTests, LayerNormFusionScalePerRow) {
+  string model_uri = MODEL_FOLDER + "fusion/layer_norm_scale_per_row.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<LayerNormFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["ReduceMean"] == 2);
+  ASSERT_TRUE(op_to_count["Mul"] == 1);
+  ASSERT_TRUE(op_to_count["LayerNormalization"] == 0);
+}
+
+TEST(GraphTransformationTests, LayerNormFusionAccuracy) {
+  std::default_random_engine generator(1234);
+  const std::vector<FloatInput> inputs{{"X", {2, 3, 8}, RandomValues(2 * 3 * 8, -2.0f, 2.0f, generator)}};
+
+  std::vector<std::vector<float>> expected;
+  std::vector<std::vector<float>> actual;
+  RunModel(MODEL_FOLDER + "fusion/layer_norm.onnx", 0, {}, inputs, {"Y"}, expected);
+  RunModel(MODEL_FOLDER + "fusion/layer_norm.onnx", 2, {}, inputs, {"Y"}, actual);
+  ExpectOutputsNear(expected, actual, 1e-4f);
+}
+
+TEST(GraphTransformationTests, GeluFusion) {
+  string model_uri = MODEL_FOLDER + "fusion/gelu.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<GeluFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Div"] == 0);
+  ASSERT_TRUE(op_to_count["Erf"] == 0);
+  ASSERT_TRUE(op_to_count["Add"] == 0);
+  ASSERT_TRUE(op_to_count["Mul"] == 0);
+  ASSERT_TRUE(op_to_count["Gelu"] == 1);
+}
+
+// The MatMul and the Add of the bias that compute the input of the GELU are fused into a FusedGemm.
+TEST(GraphTransformationTests, GeluFusionIntoGemm) {
+  string model_uri = MODEL_FOLDER + "fusion/gelu_gemm.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<GeluFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["Erf"] == 0);
+  ASSERT_TRUE(op_to_count["Add"] == 0);
+  ASSERT_TRUE(op_to_count["Mul"] == 0);
+  ASSERT_TRUE(op_to_count["Gelu"] == 0);
+  ASSERT_TRUE(op_to_count["FusedGemm"] == 1);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "FusedGemm") {
+      ASSERT_TRUE(node.GetAttributes().at("activation").s() == "Gelu");
+    }
+    ASSERT_TRUE(node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// The GELU is still fused when the MatMul and the Add of the bias run on another execution provider, but they are
+// left out of it.
+TEST(GraphTransformationTests, GeluFusionGemmOnOtherProvider) {
+  string model_uri = MODEL_FOLDER + "fusion/gelu_gemm.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "MatMul" || (node.OpType() == "Add" && node.InputEdgesBegin() != node.InputEdgesEnd() &&
+                                      node.InputEdgesBegin()->GetNode().OpType() == "MatMul")) {
+      node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+    }
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<GeluFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMul"] == 1);
+  ASSERT_TRUE(op_to_count["Add"] == 1);
+  ASSERT_TRUE(op_to_count["Erf"] == 0);
+  ASSERT_TRUE(op_to_count["Gelu"] == 1);
+  ASSERT_TRUE(op_to_count["FusedGemm"] == 0);
+}
+
+TEST(GraphTransformationTests, GeluFusionIntoGemmAccuracy) {
+  std::default_random_engine generator(1234);
+  const std::vector<FloatInput> inputs{{"A", {4, 8}, RandomValues(4 * 8, -1.0f, 1.0f, generator)}};
+
+  std::vector<std::vector<float>> expected;
+  std::vector<std::vector<float>> actual;
+  RunModel(MODEL_FOLDER + "fusion/gelu_gemm.onnx", 0, {}, inputs, {"Y"}, expected);
+  RunModel(MODEL_FOLDER + "fusion/gelu_gemm.onnx", 2, {}, inputs, {"Y"}, actual);
+  ExpectOutputsNear(expected, actual, 1e-5f);
+}
+
+TEST(GraphTransformationTests, AttentionFusion) {
+  string model_uri = MODEL_FOLDER + "fusion/attention.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<AttentionFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["Add"] == 0);
+  ASSERT_TRUE(op_to_count["Reshape"] == 0);
+  ASSERT_TRUE(op_to_count["Transpose"] == 0);
+  ASSERT_TRUE(op_to_count["Div"] == 0);
+  ASSERT_TRUE(op_to_count["Softmax"] == 0);
+  ASSERT_TRUE(op_to_count["Attention"] == 1);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "Attention") {
+      ASSERT_TRUE(node.GetAttributes().at("num_heads").i() == 2);
+      ASSERT_TRUE(node.InputDefs().size() == 4);
+    }
+    ASSERT_TRUE(node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+TEST(GraphTransformationTests, AttentionFusionAccuracy) {
+  std::default_random_engine generator(1234);
+  // the last key of the first sequence and the first key of the second are masked out
+  const std::vector<FloatInput> inputs{
+      {"X", {2, 4, 8}, RandomValues(2 * 4 * 8, -1.0f, 1.0f, generator)},
+      {"mask", {2, 1, 1, 4}, {0.0f, 0.0f, 0.0f, -10000.0f, -10000.0f, 0.0f, 0.0f, 0.0f}}};
+
+  std::vector<std::vector<float>> expected;
+  std::vector<std::vector<float>> actual;
+  RunModel(MODEL_FOLDER + "fusion/attention.onnx", 0, {}, inputs, {"Y"}, expected);
+  RunModel(MODEL_FOLDER + "fusion/attention.onnx", 2, {}, inputs, {"Y"}, actual);
+  ExpectOutputsNear(expected, actual, 1e-5f);
+}
+
+TEST(GraphTransformationTests, ElementwiseFusion) {
+  string model_uri = MODEL_FOLDER + "fusion/elementwise.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<ElementwiseFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  // The Tanh is a graph output and the Add of the column isn't broadcast from the trailing dimensions, so they and
+  // the Exp consuming the Add are not fused.
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Mul"] == 0);
+  ASSERT_TRUE(op_to_count["Sigmoid"] == 0);
+  ASSERT_TRUE(op_to_count["Sub"] == 0);
+  ASSERT_TRUE(op_to_count["Abs"] == 0);
+  ASSERT_TRUE(op_to_count["Clip"] == 0);
+  ASSERT_TRUE(op_to_count["Relu"] == 0);
+  ASSERT_TRUE(op_to_count["Add"] == 1);
+  ASSERT_TRUE(op_to_count["Tanh"] == 1);
+  ASSERT_TRUE(op_to_count["Exp"] == 1);
+  ASSERT_TRUE(op_to_count["FusedElementwise"] == 3);
+
+  for (const Node& node : graph.Nodes()) {
+    if (node.OpType() == "FusedElementwise" && node.OutputDefs()[0]->Name() == "Y1") {
+      const auto& attributes = node.GetAttributes();
+      const auto& ops = attributes.at("ops").strings();
+      ASSERT_TRUE(std::vector<std::string>(ops.begin(), ops.end()) ==
+                  std::vector<std::string>({"Mul", "Add", "Sigmoid", "Mul"}));
+      const auto& operands = attributes.at("operands").ints();
+      ASSERT_TRUE(std::vector<int64_t>(operands.begin(), operands.end()) ==
+                  std::vector<int64_t>({0, 1, 3, 2, 4, -1, 4, 5}));
+      ASSERT_TRUE(node.InputDefs().size() == 3);
+    }
+    ASSERT_TRUE(node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+TEST(GraphTransformationTests, ElementwiseFusionAccuracy) {
+  std::default_random_engine generator(1234);
+  const std::vector<FloatInput> inputs{{"X", {2, 4, 8}, RandomValues(2 * 4 * 8, -2.0f, 2.0f, generator)},
+                                       {"Z", {2, 4, 8}, RandomValues(2 * 4 * 8, -2.0f, 2.0f, generator)}};
+  const std::vector<std::string> output_names{"Y1", "Y2", "T", "Y3", "W"};
+
+  std::vector<std::vector<float>> expected;
+  std::vector<std::vector<float>> actual;
+  RunModel(MODEL_FOLDER + "fusion/elementwise.onnx", 0, {}, inputs, output_names, expected);
+  RunModel(MODEL_FOLDER + "fusion/elementwise.onnx", 2, {}, inputs, output_names, actual);
+  ExpectOutputsNear(expected, actual, 1e-5f);
+}
+
+TEST(GraphTransformationTests, FuseConvResidualAdd) {
+  string model_uri = MODEL_FOLDER + "fusion/conv_residual_add.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<ConvResidualAddFusion>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  // conv2 is fused with the Add of X and the following Relu, conv3 with the Add of its own input. conv1 has no Add.
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Conv"] == 1);
+  ASSERT_TRUE(op_to_count["Relu"] == 1);
+  ASSERT_TRUE(op_to_count["Add"] == 0);
+  ASSERT_TRUE(op_to_count["FusedConv"] == 2);
+
+  for (const Node& node : graph.Nodes()) {
+    ASSERT_TRUE(node.GetExecutionProviderType() == onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// The fused model only differs from the unfused model in the order of the additions.
+TEST(GraphTransformationTests, FuseConvResidualAddAccuracy) {
+  std::default_random_engine generator(1234);
+  const std::vector<FloatInput> inputs{{"X", {1, 4, 8, 8}, RandomValues(4 * 8 * 8, -1.0f, 1.0f, generator)}};
+
+  std::vector<std::vector<float>> expected;
+  std::vector<std::vector<float>> actual;
+  RunModel(MODEL_FOLDER + "fusion/conv_residual_add.onnx", 0, {}, inputs, {"Y"}, expected);
+  RunModel(MODEL_FOLDER + "fusion/conv_residual_add.onnx", 2, {}, inputs, {"Y"}, actual);
+  ExpectOutputsNear(expected, actual, 1e-5f);
+}
+
+TEST(GraphTransformationTests, DynamicQuantization) {
+  string model_uri = MODEL_FOLDER + "fusion/dynamic_quantization.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<DynamicQuantization>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["Gemm"] == 0);
+  ASSERT_TRUE(op_to_count["DynamicQuantizeMatMul"] == 2);
+}
+
+TEST(GraphTransformationTests, DynamicQuantizationExclusions) {
+  string model_uri = MODEL_FOLDER + "fusion/dynamic_quantization.onnx";
+
+  // exclude by operator type
+  {
+    std::shared_ptr<Model> p_model;
+    ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+    Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+    AssignNodesToCpu(graph);
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.Register(std::make_unique<DynamicQuantization>(std::unordered_set<std::string>{"Gemm"}),
+                                      TransformerLevel::Level2, {onnxruntime::kCpuExecutionProvider});
+    ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["MatMul"] == 0);
+    ASSERT_TRUE(op_to_count["Gemm"] == 1);
+    ASSERT_TRUE(op_to_count["DynamicQuantizeMatMul"] == 1);
+  }
+
+  // exclude by node name
+  {
+    std::shared_ptr<Model> p_model;
+    ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+    Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+    AssignNodesToCpu(graph);
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.Register(std::make_unique<DynamicQuantization>(std::unordered_set<std::string>{},
+                                                                            std::unordered_set<std::string>{"matmul1"}),
+                                      TransformerLevel::Level2, {onnxruntime::kCpuExecutionProvider});
+    ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["MatMul"] == 1);
+    ASSERT_TRUE(op_to_count["Gemm"] == 0);
+    ASSERT_TRUE(op_to_count["DynamicQuantizeMatMul"] == 1);
+  }
+}
+
+// C of the Gemm is a graph input, which doesn't matter because beta is 0.
+TEST(GraphTransformationTests, DynamicQuantizationZeroBeta) {
+  string model_uri = MODEL_FOLDER + "fusion/dynamic_quantization_zero_beta.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<DynamicQuantization>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Gemm"] == 0);
+  ASSERT_TRUE(op_to_count["DynamicQuantizeMatMul"] == 1);
+  for (auto& node : graph.Nodes()) {
+    ASSERT_EQ(node.InputDefs().size(), 3u);
+  }
+}
+
+// DynamicQuantizeMatMul only has a CPU kernel, so the Gemm on another execution provider is left in float.
+TEST(GraphTransformationTests, DynamicQuantizationOnOtherProvider) {
+  string model_uri = MODEL_FOLDER + "fusion/dynamic_quantization.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "Gemm") {
+      node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+    }
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<DynamicQuantization>(), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["Gemm"] == 1);
+  ASSERT_TRUE(op_to_count["DynamicQuantizeMatMul"] == 1);
+  for (auto& node : graph.Nodes()) {
+    ASSERT_EQ(node.GetExecutionProviderType(), node.OpType() == "Gemm" ? onnxruntime::kCudaExecutionProvider
+                                                                       : onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// The exclusion lists of the session options reach the DynamicQuantization enabled by name. The transformed model is
+// saved so that its operators can be counted.
+TEST(GraphTransformationTests, DynamicQuantizationSessionExclusions) {
+  SessionOptions so;
+  so.session_logid = "GraphTransformationTests.DynamicQuantizationSessionExclusions";
+  so.optimized_model_filepath = ORT_TSTR("dynamic_quantization_excluded.onnx");
+  so.dynamic_quantization_excluded_op_types = {"Gemm"};
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(session_object.AddCustomTransformerList({"DynamicQuantization"}).IsOK());
+  ASSERT_TRUE(session_object.Load(MODEL_FOLDER + "fusion/dynamic_quantization.onnx").IsOK());
+  ASSERT_TRUE(session_object.Initialize().IsOK());
+
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load("dynamic_quantization_excluded.onnx", p_model).IsOK());
+  std::map<std::string, int> op_to_count = CountOpsInGraph(p_model->MainGraph());
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["Gemm"] == 1);
+  ASSERT_TRUE(op_to_count["DynamicQuantizeMatMul"] == 1);
+}
+
+// Accuracy check for the dynamically quantized model against the float model. The error of each output is
+// bounded relative to the largest output, which is what the int8 weights and uint8 activations can represent.
+TEST(GraphTransformationTests, DynamicQuantizationAccuracy) {
+  std::default_random_engine generator(1234);
+
+  for (int trial = 0; trial < 4; trial++) {
+    const std::vector<FloatInput> inputs{{"X", {4, 64}, RandomValues(4 * 64, -2.0f, 2.0f, generator)}};
+
+    std::vector<std::vector<float>> expected;
+    std::vector<std::vector<float>> actual;
+    RunModel(MODEL_FOLDER + "fusion/dynamic_quantization.onnx", 2, {}, inputs, {"Y"}, expected);
+    RunModel(MODEL_FOLDER + "fusion/dynamic_quantization.onnx", 2, {"DynamicQuantization"}, inputs, {"Y"}, actual);
+    SCOPED_TRACE("trial " + std::to_string(trial));
+    ExpectOutputsNear(expected, actual, 0.02f * MaxAbsOutput(expected));
+  }
+}
+
+TEST(GraphTransformationTests, StaticQuantization) {
+  string model_uri = MODEL_FOLDER + "fusion/static_quantization.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  // X -> conv1 -> relu1 -> conv2 -> add(+relu1) -> pool -> flatten -> matmul -> Y
+  // c1 has no range of its own as it is folded with relu1; s and p are not quantized.
+  TensorRangeMap ranges{{"X", {-1.0f, 1.0f}}, {"r1", {0.0f, 2.0f}}, {"c2", {-3.0f, 3.0f}},
+                        {"f", {-1.0f, 4.0f}}, {"Y", {-5.0f, 5.0f}}};
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<StaticQuantization>(ranges), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Conv"] == 0);
+  ASSERT_TRUE(op_to_count["Relu"] == 0);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["QLinearConv"] == 2);
+  ASSERT_TRUE(op_to_count["QLinearMatMul"] == 1);
+  // X and f enter the quantized nodes; relu1 feeds conv2 in uint8 and is only dequantized for the float Add
+  ASSERT_TRUE(op_to_count["QuantizeLinear"] == 2);
+  ASSERT_TRUE(op_to_count["DequantizeLinear"] == 3);
+  ASSERT_TRUE(op_to_count["Add"] == 1);
+  ASSERT_TRUE(op_to_count["MaxPool"] == 1);
+}
+
+TEST(GraphTransformationTests, StaticQuantizationMissingRanges) {
+  string model_uri = MODEL_FOLDER + "fusion/static_quantization.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+
+  // conv1 is quantized but relu1 can't be folded without the range of r1; conv2 and matmul have no ranges
+  TensorRangeMap ranges{{"X", {-1.0f, 1.0f}}, {"c1", {-2.0f, 2.0f}}};
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<StaticQuantization>(ranges), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Conv"] == 1);
+  ASSERT_TRUE(op_to_count["Relu"] == 1);
+  ASSERT_TRUE(op_to_count["MatMul"] == 1);
+  ASSERT_TRUE(op_to_count["QLinearConv"] == 1);
+  ASSERT_TRUE(op_to_count["QuantizeLinear"] == 1);
+  ASSERT_TRUE(op_to_count["DequantizeLinear"] == 1);
+}
+
+// The quantized operators only have CPU kernels, so the MatMul on another execution provider is left in float.
+TEST(GraphTransformationTests, StaticQuantizationOnOtherProvider) {
+  string model_uri = MODEL_FOLDER + "fusion/static_quantization.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(model_uri, p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "MatMul") {
+      node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+    }
+  }
+
+  TensorRangeMap ranges{{"X", {-1.0f, 1.0f}}, {"r1", {0.0f, 2.0f}}, {"c2", {-3.0f, 3.0f}},
+                        {"f", {-1.0f, 4.0f}}, {"Y", {-5.0f, 5.0f}}};
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<StaticQuantization>(ranges), TransformerLevel::Level2,
+                                    {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Conv"] == 0);
+  ASSERT_TRUE(op_to_count["QLinearConv"] == 2);
+  ASSERT_TRUE(op_to_count["MatMul"] == 1);
+  ASSERT_TRUE(op_to_count["QLinearMatMul"] == 0);
+  for (auto& node : graph.Nodes()) {
+    ASSERT_EQ(node.GetExecutionProviderType(), node.OpType() == "MatMul" ? onnxruntime::kCudaExecutionProvider
+                                                                         : onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// Calibrates the float model, quantizes it with the recorded ranges and saves it, then checks the accuracy of the
+// quantized model and that the saved model reproduces it. The error of each output is bounded relative to the
+// calibrated range of the output, which is what its uint8 values can represent.
+TEST(GraphTransformationTests, StaticQuantizationAccuracy) {
+  const string model_uri = MODEL_FOLDER + "fusion/static_quantization.onnx";
+  const string quantized_model_uri = "static_quantization_quantized.onnx";
+
+  std::default_random_engine generator(1234);
+  std::vector<std::vector<FloatInput>> inputs;
+  for (int i = 0; i < 8; i++) {
+    inputs.push_back({{"X", {1, 2, 8, 8}, RandomValues(2 * 8 * 8, -1.0f, 1.0f, generator)}});
+  }
+
+  SessionOptions so;
+  so.session_logid = "GraphTransformationTests.StaticQuantizationAccuracy";
+  so.enable_calibration = true;
+  InferenceSession calibration_session{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(calibration_session.Load(model_uri).IsOK());
+  ASSERT_TRUE(calibration_session.Initialize().IsOK());
+
+  std::vector<std::vector<std::vector<float>>> expected(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    RunSession(calibration_session, inputs[i], {"Y"}, expected[i]);
+  }
+
+  TensorRangeMap ranges;
+  ASSERT_TRUE(calibration_session.GetCalibrationRanges(ranges).IsOK());
+  ASSERT_TRUE(ranges.count("Y") != 0);
+  const float tolerance = 0.03f * (ranges["Y"].second - ranges["Y"].first);
+
+  so.enable_calibration = false;
+  so.optimized_model_filepath = ORT_TSTR("static_quantization_quantized.onnx");
+  InferenceSession quantized_session{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(quantized_session.RegisterGraphTransformer(std::make_unique<StaticQuantization>(ranges),
+                                                         {onnxruntime::kCpuExecutionProvider})
+                  .IsOK());
+  ASSERT_TRUE(quantized_session.Load(model_uri).IsOK());
+  ASSERT_TRUE(quantized_session.Initialize().IsOK());
+
+  so.optimized_model_filepath.clear();
+  InferenceSession saved_session{so, &DefaultLoggingManager()};
+  ASSERT_TRUE(saved_session.Load(quantized_model_uri).IsOK());
+  ASSERT_TRUE(saved_session.Initialize().IsOK());
+
+  for (size_t i = 0; i < inputs.size(); i++) {
+    SCOPED_TRACE("input " + std::to_string(i));
+    std::vector<std::vector<float>> actual;
+    RunSession(quantized_session, inputs[i], {"Y"}, actual);
+    ExpectOutputsNear(expected[i], actual, tolerance);
+
+    std::vector<std::vector<float>> saved_actual;
+    RunSession(saved_session, inputs[i], {"Y"}, saved_actual);
+    EXPECT_EQ(actual, saved_actual);
+  }
+
+  // the saved model is quantized and no longer holds the float weights
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(quantized_model_uri, p_model).IsOK());
+  std::map<std::string, int> op_to_count = CountOpsInGraph(p_model->MainGraph());
+  ASSERT_TRUE(op_to_count["Conv"] == 0);
+  ASSERT_TRUE(op_to_count["QLinearConv"] == 2);
+  ASSERT_TRUE(op_to_count["QLinearMatMul"] == 1);
+  const TensorProto* tensor_proto = nullptr;
+  ASSERT_FALSE(p_model->MainGraph().GetInitializedTensor("W1", tensor_proto));
+
+  std::remove(quantized_model_uri.c_str());
+}
+
+TEST(GraphTransformationTests, WeightCompression) {
+  for (auto format : {WeightCompressionFormat::Float16, WeightCompressionFormat::Int8}) {
+    {
+      std::shared_ptr<Model> p_model;
+      ASSERT_TRUE(Model::Load(MODEL_FOLDER + "fusion/dynamic_quantization.onnx", p_model).IsOK());
+      Graph& graph = p_model->MainGraph();
+      AssignNodesToCpu(graph);
+
+      onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+      graph_transformation_mgr.Register(std::make_unique<WeightCompression>(format), TransformerLevel::Level2,
+                                        {onnxruntime::kCpuExecutionProvider});
+      ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+      std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+      ASSERT_TRUE(op_to_count["MatMul"] == 0);
+      ASSERT_TRUE(op_to_count["Gemm"] == 0);
+      ASSERT_TRUE(op_to_count["CompressedMatMul"] == 2);
+    }
+
+    {
+      std::shared_ptr<Model> p_model;
+      ASSERT_TRUE(Model::Load(MODEL_FOLDER + "fusion/static_quantization.onnx", p_model).IsOK());
+      Graph& graph = p_model->MainGraph();
+      AssignNodesToCpu(graph);
+
+      onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+      graph_transformation_mgr.Register(std::make_unique<WeightCompression>(format, std::unordered_set<std::string>{"MatMul"}),
+                                        TransformerLevel::Level2, {onnxruntime::kCpuExecutionProvider});
+      ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+      std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+      ASSERT_TRUE(op_to_count["Conv"] == 0);
+      ASSERT_TRUE(op_to_count["CompressedConv"] == 2);
+      ASSERT_TRUE(op_to_count["MatMul"] == 1);
+      ASSERT_TRUE(op_to_count["CompressedMatMul"] == 0);
+
+      // the float weights are dropped once nothing consumes them
+      const TensorProto* tensor_proto = nullptr;
+      ASSERT_FALSE(graph.GetInitializedTensor("W1", tensor_proto));
+    }
+  }
+}
+
+// The compressed operators only have CPU kernels, so the Gemm on another execution provider keeps its float weights.
+TEST(GraphTransformationTests, WeightCompressionOnOtherProvider) {
+  std::shared_ptr<Model> p_model;
+  ASSERT_TRUE(Model::Load(MODEL_FOLDER + "fusion/dynamic_quantization.onnx", p_model).IsOK());
+  Graph& graph = p_model->MainGraph();
+  AssignNodesToCpu(graph);
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "Gemm") {
+      node.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+    }
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(std::make_unique<WeightCompression>(WeightCompressionFormat::Float16),
+                                    TransformerLevel::Level2, {onnxruntime::kCpuExecutionProvider});
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2).IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["MatMul"] == 0);
+  ASSERT_TRUE(op_to_count["Gemm"] == 1);
+  ASSERT_TRUE(op_to_count["CompressedMatMul"] == 1);
+  for (auto& node : graph.Nodes()) {
+    ASSERT_EQ(node.GetExecutionProviderType(), node.OpType() == "Gemm" ? onnxruntime::kCudaExecutionProvider
+                                                                       : onnxruntime::kCpuExecutionProvider);
+  }
+}
+
+// Accuracy check for the compressed weights against the float weights. The error of each output is bounded
+// relative to the largest output: float16 keeps 11 significant bits and int8 about 7 per output channel.
+TEST(GraphTransformationTests, WeightCompressionAccuracy) {
+  struct TestModel {
+    std::string uri;
+    std::vector<int64_t> input_dims;
+  };
+  const std::vector<TestModel> models{{MODEL_FOLDER + "fusion/dynamic_quantization.onnx", {4, 64}},
+                                      {MODEL_FOLDER + "fusion/static_quantization.onnx", {1, 2, 8, 8}}};
+
+  std::default_random_engine generator(1234);
+
+  for (const auto& model : models) {
+    SCOPED_TRACE(model.uri);
+    const auto input_size = static_cast<size_t>(TensorShape(model.input_dims).Size());
+    const std::vector<FloatInput> inputs{{"X", model.input_dims, RandomValues(input_size, -1.0f, 1.0f, generator)}};
+
+    std::vector<std::vector<float>> expected;
+    RunModel(model.uri, 0, {}, inputs, {"Y"}, expected);
+    const float max_abs = MaxAbsOutput(expected);
+
+    for (auto format : {WeightCompressionFormat::Float16, WeightCompressionFormat::Int8}) {
+      const float tolerance = (format == WeightCompressionFormat::Float16 ? 0.002f : 0.02f) * max_abs;
+
+      std::vector<std::vector<float>> actual;
+      RunModel(model.uri, 0, {}, inputs, {"Y"}, actual, format);
+      ExpectOutputsNear(expected, actual, tolerance);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -977,6 +977,29 @@ TEST(MathOpTest, Expand_8_1x3_float16) {
   test.Run();
 }
 
+TEST(MathOpTest, Expand_8_2x3x2_from_3x1) {
+  OpTester test("Expand", 8);
+  test.AddInput<int32_t>("data_0", {3, 1}, {1, 2, 3});
+  test.AddInput<int64_t>("data_1", {3}, {2, 1, 2});
+  test.AddOutput<int32_t>("result", {2, 3, 2},
+                          {1, 1,
+                           2, 2,
+                           3, 3,
+
+                           1, 1,
+                           2, 2,
+                           3, 3});
+  test.Run();
+}
+
+TEST(MathOpTest, Expand_8_incompatible_shape) {
+  OpTester test("Expand", 8);
+  test.AddInput<float>("data_0", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddInput<int64_t>("data_1", {2}, {2, 2});
+  test.AddOutput<float>("result", {2, 3}, {1.0f, 2.0f, 3.0f, 1.0f, 2.0f, 3.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "can not be broadcast", {kCudaExecutionProvider});
+}
+
 TEST(MathOpTest, Scale) {
   OpTester test("Scale");
   std::vector<int64_t> dims{2, 2};
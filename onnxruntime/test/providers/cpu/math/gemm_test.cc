@@ -212,5 +212,23 @@ TEST(GemmOpTest, GemmEmptyTensor) {
   test.Run();
 }
 
+TEST(GemmOpTest, GemmZeroK) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", static_cast<int64_t>(0));
+  test.AddAttribute("transB", static_cast<int64_t>(0));
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {2, 0},
+                       {});
+  test.AddInput<float>("B", {0, 3}, {});
+  test.AddInput<float>("C", {3}, std::vector<float>{1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {2, 3},
+                        {1.0f, 2.0f, 3.0f,
+                         1.0f, 2.0f, 3.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
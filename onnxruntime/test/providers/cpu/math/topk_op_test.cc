@@ -4,6 +4,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "core/framework/customregistry.h"
 
 namespace onnxruntime {
 namespace test {
@@ -249,6 +250,83 @@ TEST(TopKOperator, Top1ExplicitAxisMultiDInputOpset10) {
   RunTest(10, 1, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, axis);
 }
 
+TEST(TopKOperator, Top2ExplicitAxisMultiDInputOpset10) {
+  std::vector<float> input_vals = {1.0f, 8.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 2.0f, 2.0f, 1.0f, 4.0f, 3.0f};
+  std::vector<int64_t> input_dimensions = {1, 3, 4};
+  std::vector<float> expected_vals = {5.0f, 8.0f, 7.0f, 4.0f, 2.0f, 6.0f, 4.0f, 3.0f};
+  std::vector<int64_t> expected_indices = {1, 0, 1, 0, 2, 1, 2, 2};
+  std::vector<int64_t> expected_dimensions = {1, 2, 4};
+  int64_t axis = 1;
+  RunTest(10, 2, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, axis);
+}
+
+TEST(TopKOperator, Top1LargeRowWithTiesOpset10) {
+  constexpr int64_t cols = 4099;
+  std::vector<float> input_vals(2 * cols);
+  for (int64_t i = 0; i < cols; ++i) {
+    input_vals[i] = static_cast<float>(i % 97);
+    input_vals[cols + i] = -static_cast<float>(i);
+  }
+  std::vector<int64_t> input_dimensions = {2, cols};
+  std::vector<float> expected_vals = {96.0f, 0.0f};
+  std::vector<int64_t> expected_indices = {96, 0};
+  std::vector<int64_t> expected_dimensions = {2, 1};
+  RunTest(10, 1, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions);
+}
+
+TEST(TopKOperator, Top3DoubleOpset10) {
+  OpTester test("TopK", 10);
+  test.AddAttribute("axis", int64_t{-1});
+  test.AddInput<double>("X", {2, 4}, {0.1, 0.3, 0.2, 0.4, 0.1, 0.3, 0.4, 0.2});
+  test.AddInput<int64_t>("K", {1}, {3});
+  test.AddOutput<double>("Values", {2, 3}, {0.4, 0.3, 0.2, 0.4, 0.3, 0.2});
+  test.AddOutput<int64_t>("Indices", {2, 3}, {3, 1, 2, 2, 1, 3});
+  test.Run();
+}
+
+// The ONNX schemas in this tree only allow integer inputs from TopK opset 11, which they do not define yet.
+// Registers the opset 11 signature so the integer paths of the opset 10 kernel can be exercised.
+static std::shared_ptr<CustomRegistry> TopKOpset11Registry() {
+  ONNX_NAMESPACE::OpSchema schema("TopK", __FILE__, __LINE__);
+  schema.Input(0, "X", "Tensor of shape [a_1, a_2, ..., a_n, r]", "T");
+  schema.Input(1, "K", "A 1-D tensor containing a single positive value corresponding to the number of top elements to retrieve", "tensor(int64)");
+  schema.Output(0, "Values", "Tensor containing top K values from the input tensor", "T");
+  schema.Output(1, "Indices", "Tensor containing the corresponding input tensor indices for the top K values.", "I");
+  schema.TypeConstraint("T", ONNX_NAMESPACE::OpSchema::all_numeric_types(), "Constrain input and output types to numeric tensors.");
+  schema.TypeConstraint("I", {"tensor(int64)"}, "Constrain index tensor to int64");
+  schema.Attr("axis", "Dimension on which to do the sort.", ONNX_NAMESPACE::AttributeProto::INT, static_cast<int64_t>(-1));
+  schema.Attr("largest", "Whether to return the top-K largest or smallest elements.", ONNX_NAMESPACE::AttributeProto::INT, static_cast<int64_t>(1));
+  schema.Attr("sorted", "Whether to return the elements in sorted order.", ONNX_NAMESPACE::AttributeProto::INT, static_cast<int64_t>(1));
+  schema.SinceVersion(11);
+
+  auto registry = std::make_shared<CustomRegistry>();
+  std::vector<ONNX_NAMESPACE::OpSchema> schemas = {schema};
+  EXPECT_TRUE(registry->RegisterOpSet(schemas, onnxruntime::kOnnxDomain, 10, 11).IsOK());
+  return registry;
+}
+
+TEST(TopKOperator, Top2Int32Opset11) {
+  OpTester test("TopK", 11);
+  test.AddCustomOpRegistry(TopKOpset11Registry());
+  test.AddInput<int32_t>("X", {2, 4}, {1, 3, 2, 4, -5, 7, 7, 0});
+  test.AddInput<int64_t>("K", {1}, {2});
+  test.AddOutput<int32_t>("Values", {2, 2}, {4, 3, 7, 7});
+  test.AddOutput<int64_t>("Indices", {2, 2}, {3, 1, 1, 2});
+  test.Run();
+}
+
+TEST(TopKOperator, Top1SmallestInt64Opset11) {
+  OpTester test("TopK", 11);
+  test.AddCustomOpRegistry(TopKOpset11Registry());
+  test.AddAttribute("axis", int64_t{0});
+  test.AddAttribute("largest", int64_t{0});
+  test.AddInput<int64_t>("X", {3, 2}, {4000000000, -2, -4000000000, 5, 7, -2});
+  test.AddInput<int64_t>("K", {1}, {1});
+  test.AddOutput<int64_t>("Values", {1, 2}, {-4000000000, -2});
+  test.AddOutput<int64_t>("Indices", {1, 2}, {1, 0});
+  test.Run();
+}
+
 TEST(TopKOperator, InvalidKOpset10) {
   std::vector<float> input_vals = {0.1f, 0.3f, 0.2f, 0.4f, 0.1f, 0.3f, 0.3f, 0.2f};
   std::vector<int64_t> input_dimensions = {2, 4};
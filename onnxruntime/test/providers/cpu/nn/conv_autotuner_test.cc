@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/nn/conv_autotuner.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "file_util.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+void PrepareConv(MLAS_CONV_PARAMETERS& parameters, int64_t input_size, size_t* working_buffer_size) {
+  const int64_t input_shape[] = {input_size, input_size};
+  const int64_t kernel_shape[] = {3, 3};
+  const int64_t dilations[] = {1, 1};
+  const int64_t pads[] = {1, 1, 1, 1};
+  const int64_t strides[] = {1, 1};
+  const int64_t output_shape[] = {input_size, input_size};
+
+  static MLAS_ACTIVATION activation{MlasIdentityActivation, 0.0f};
+  MlasConvPrepare(&parameters, 2, 1, 1, 16, input_shape, kernel_shape, dilations, pads, strides, output_shape, 32,
+                  &activation, 0.0f, true, working_buffer_size);
+}
+}  // namespace
+
+TEST(ConvAutotunerTest, KeyDependsOnShape) {
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+
+  PrepareConv(parameters, 12, &working_buffer_size);
+  const std::string key = ConvTuningCache::MakeKey(parameters, true);
+  EXPECT_EQ(key, ConvTuningCache::MakeKey(parameters, true));
+  EXPECT_NE(key, ConvTuningCache::MakeKey(parameters, false));
+
+  PrepareConv(parameters, 13, &working_buffer_size);
+  EXPECT_NE(key, ConvTuningCache::MakeKey(parameters, true));
+}
+
+TEST(ConvAutotunerTest, TuneAndReloadFromFile) {
+  FILE* fp;
+  std::basic_string<ORTCHAR_T> filename(ORT_TSTR("conv_tuning_XXXXXX"));
+  CreateTestFile(fp, filename);
+  std::unique_ptr<ORTCHAR_T, decltype(&DeleteFileFromDisk)> file_deleter(const_cast<ORTCHAR_T*>(filename.c_str()),
+                                                                         DeleteFileFromDisk);
+  ASSERT_EQ(0, fclose(fp));
+
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+  PrepareConv(parameters, 12, &working_buffer_size);
+
+  std::vector<float> input(16 * 12 * 12, 1.0f);
+  std::vector<float> filter(32 * 16 * 3 * 3, 0.5f);
+  std::vector<float> bias(32, 0.25f);
+  const ConvAlgorithmChoice choice = TuneConvAlgorithm(parameters, true, input.data(), filter.data(), bias.data(),
+                                                       std::make_shared<CPUAllocator>());
+
+  MLAS_CONV_PARAMETERS selected_parameters = parameters;
+  EXPECT_TRUE(MlasConvSelectAlgorithm(&selected_parameters, choice.algorithm, choice.thread_count,
+                                      &working_buffer_size));
+
+  const std::string key = ConvTuningCache::MakeKey(parameters, true);
+  {
+    ConvTuningCache cache(filename);
+    ConvAlgorithmChoice found;
+    EXPECT_FALSE(cache.Find(key, found));
+    cache.Insert(key, choice);
+    ASSERT_TRUE(cache.Find(key, found));
+    EXPECT_EQ(found.algorithm, choice.algorithm);
+  }
+
+  // A new cache starts with the choices saved to the file.
+  ConvTuningCache reloaded_cache(filename);
+  ConvAlgorithmChoice found;
+  ASSERT_TRUE(reloaded_cache.Find(key, found));
+  EXPECT_EQ(found.algorithm, choice.algorithm);
+  EXPECT_EQ(found.thread_count, choice.thread_count);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -542,5 +542,52 @@ TEST(ConvTest, Conv2D_group) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// The shape is large enough for the CPU provider to use the Winograd algorithm with a cached transformed filter.
+TEST(ConvTest, Conv2D_Winograd) {
+  const int64_t N = 1, C = 32, H = 8, W = 8, M = 32;
+  vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); i++) {
+    X[i] = static_cast<float>(static_cast<int>(i * 7 % 11) - 5) * 0.125f;
+  }
+  vector<float> Wdata(M * C * 3 * 3);
+  for (size_t i = 0; i < Wdata.size(); i++) {
+    Wdata[i] = static_cast<float>(static_cast<int>(i * 5 % 13) - 6) * 0.0625f;
+  }
+  vector<float> B(M);
+  for (size_t i = 0; i < B.size(); i++) {
+    B[i] = static_cast<float>(i) * 0.5f - 8.0f;
+  }
+
+  vector<float> Y(N * M * H * W);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W; ow++) {
+        float sum = B[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              const int64_t ih = oh + kh - 1;
+              const int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                sum += X[(c * H + ih) * W + iw] * Wdata[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        Y[(m * H + oh) * W + ow] = sum;
+      }
+    }
+  }
+
+  OpTester test("Conv");
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("W", {M, C, 3, 3}, Wdata, true);
+  test.AddInput<float>("B", {M}, B, true);
+  test.AddOutput<float>("Y", {N, M, H, W}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -3,10 +3,12 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
 #include <iterator>
 #include <vector>
 
 #include "core/providers/cpu/rnn/deep_cpu_lstm.h"
+#include "core/providers/cpu/rnn/rnn_helpers.h"
 #include "test/providers/provider_test_utils.h"
 using namespace std;
 namespace onnxruntime {
@@ -367,6 +369,87 @@ TEST(LSTMTest, BatchParallelFalseSeqLengthGreaterThanOne) {
               input_size, batch_size, hidden_size, seq_length);
 }
 
+// hidden_size spans more than one tile of the gate computations, and W and R are initializers so they are packed
+// when the kernel is created. Y is left out of the first run to cover only producing the final state.
+TEST(LSTMTest, MultipleGateTilesConstantWeights) {
+  const int64_t seq_length = 2;
+  const int64_t batch_size = 1;
+  const int64_t input_size = 2;
+  const int64_t hidden_size = 66;
+
+  std::vector<float> X_data{0.5f, -1.0f, 0.25f, 0.75f};
+
+  std::vector<float> W_data(4 * hidden_size * input_size);
+  for (int64_t r = 0; r < 4 * hidden_size; ++r)
+    for (int64_t k = 0; k < input_size; ++k)
+      W_data[r * input_size + k] = 0.5f * std::sin(0.37f * r + 1.3f * k);
+
+  std::vector<float> R_data(4 * hidden_size * hidden_size);
+  for (int64_t r = 0; r < 4 * hidden_size; ++r)
+    for (int64_t k = 0; k < hidden_size; ++k)
+      R_data[r * hidden_size + k] = 0.1f * std::cos(0.11f * r + 0.7f * k);
+
+  std::vector<float> Y_data{
+      0.023825716f, -0.0029534676f, -0.032045434f, -0.06300297f, -0.093733706f, -0.119628f,
+      -0.13304633f, -0.12459989f, -0.087698043f, -0.026412248f, 0.040488946f, 0.09028913f,
+      0.11246256f, 0.11074881f, 0.09469409f, 0.072503453f, 0.048436488f, 0.023350835f,
+      -0.0034678225f, -0.03260223f, -0.063580744f, -0.094273226f, -0.12001567f, -0.13311693f,
+      -0.12418651f, -0.086753221f, -0.025155555f, 0.041618491f, 0.090953491f, 0.11262067f,
+      0.11055262f, 0.094321416f, 0.072070294f, 0.047984703f, 0.02287536f, -0.0039829942f,
+      -0.033159697f, -0.064158493f, -0.094811159f, -0.12039911f, -0.13317999f, -0.12376314f,
+      -0.085799714f, -0.023896974f, 0.042741692f, 0.091608025f, 0.11277059f, 0.11035169f,
+      0.093946823f, 0.071636613f, 0.047532613f, 0.022399282f, -0.0044989838f, -0.033717826f,
+      -0.064736198f, -0.095347466f, -0.12077827f, -0.13323545f, -0.12332977f, -0.084837599f,
+      -0.022636664f, 0.043858428f, 0.092252725f, 0.11291236f, 0.11014608f, 0.09357035f};
+
+  std::vector<float> Y_h_data{
+      -0.12687907f, -0.12668549f, -0.110149f, -0.080575106f, -0.046931467f, -0.018106716f,
+      0.0034322952f, 0.020421625f, 0.034748316f, 0.044307805f, 0.045347094f, 0.036408285f,
+      0.019167927f, -0.0032991421f, -0.027810936f, -0.051023706f, -0.068918505f, -0.076999145f,
+      -0.071785991f, -0.053388661f, -0.027547294f, -0.0033392977f, 0.013721914f, 0.025339613f,
+      0.036427028f, 0.048819993f, 0.059078924f, 0.061701444f, 0.053722808f, 0.035889281f,
+      0.010982972f, -0.017549552f, -0.045812834f, -0.069300181f, -0.083281881f, -0.084102856f,
+      -0.071188988f, -0.048862044f, -0.025009009f, -0.0054519244f, 0.0099291256f, 0.024366775f,
+      0.038476432f, 0.048008473f, 0.047166432f, 0.033470608f, 0.0088619934f, -0.022521494f,
+      -0.056387759f, -0.088711541f, -0.11524846f, -0.13140254f, -0.13300502f, -0.11815616f,
+      -0.089926475f, -0.056790145f, -0.027332256f, -0.0043133382f, 0.014264283f, 0.029503303f,
+      0.038789086f, 0.038344105f, 0.027125963f, 0.0073779762f, -0.017376877f, -0.043740203f};
+  Y_data.insert(Y_data.end(), Y_h_data.cbegin(), Y_h_data.cend());
+
+  std::vector<float> Y_c_data{
+      -0.24299011f, -0.22849233f, -0.19004067f, -0.13582482f, -0.079238397f, -0.03141436f,
+      0.0062671758f, 0.040045452f, 0.074176975f, 0.10324267f, 0.11397498f, 0.09617101f,
+      0.05141257f, -0.008674123f, -0.069541252f, -0.11879077f, -0.1478994f, -0.15252043f,
+      -0.13273782f, -0.093903869f, -0.047185651f, -0.0057121559f, 0.024016867f, 0.046397112f,
+      0.071090138f, 0.10280435f, 0.13446942f, 0.14989387f, 0.13564693f, 0.091012811f,
+      0.027045907f, -0.040841377f, -0.099018875f, -0.13820637f, -0.15382789f, -0.14562252f,
+      -0.11764474f, -0.078758799f, -0.040245835f, -0.0089633847f, 0.017038936f, 0.044456824f,
+      0.075588513f, 0.10184496f, 0.10690425f, 0.079176011f, 0.021228767f, -0.053019733f,
+      -0.12722169f, -0.18850085f, -0.22876381f, -0.24395896f, -0.23311317f, -0.19855486f,
+      -0.14788889f, -0.093614532f, -0.046300937f, -0.0076873193f, 0.027285862f, 0.061395118f,
+      0.088047557f, 0.093842784f, 0.069799448f, 0.01931353f, -0.044740237f, -0.10758504f};
+
+  for (bool output_sequence : {false, true}) {
+    OpTester test("LSTM");
+    test.AddAttribute<std::vector<string>>("activations", {"sigmoid", "tanh", "tanh"});
+    test.AddAttribute("direction", "forward");
+    test.AddAttribute("hidden_size", hidden_size);
+
+    test.AddInput<float>("X", {seq_length, batch_size, input_size}, X_data);
+    test.AddInput<float>("W", {1, 4 * hidden_size, input_size}, W_data, true);
+    test.AddInput<float>("R", {1, 4 * hidden_size, hidden_size}, R_data, true);
+
+    if (output_sequence)
+      test.AddOutput<float>("Y", {seq_length, 1, batch_size, hidden_size}, Y_data);
+    else
+      test.AddMissingOptionalOutput<float>();
+    test.AddOutput<float>("Y_h", {1, batch_size, hidden_size}, Y_h_data);
+    test.AddOutput<float>("Y_c", {1, batch_size, hidden_size}, Y_c_data);
+
+    test.Run();
+  }
+}
+
 // make sure GateComputations works correctly if batch_parallel_ is true due to large batch size
 static void LargeBatchWithClip(const std::vector<float>& Y_h_data, float clip = 9999.0) {
   int64_t seq_length = 2;
@@ -969,5 +1052,35 @@ TEST(LSTMTest, ONNXRuntime_TestLSTMOutputWrite) {
                   nullptr, use_bias, use_peepholes);
 }
 
+TEST(LSTMTest, ChooseRnnParallelism) {
+  using rnn::detail::ChooseRnnParallelism;
+
+  // a single thread runs everything in order
+  auto plan = ChooseRnnParallelism(2, 20, 16, 256, 4, 16, 4, 1);
+  EXPECT_FALSE(plan.concurrent_directions || plan.batch_parallel || plan.hidden_parallel);
+
+  // a single sequence with a small hidden size has nothing to split but the directions
+  plan = ChooseRnnParallelism(2, 20, 1, 128, 4, 1, 2, 8);
+  EXPECT_TRUE(plan.concurrent_directions);
+  EXPECT_FALSE(plan.batch_parallel || plan.hidden_parallel);
+
+  // a large batch is split by rows, and the directions run one after the other with all the threads
+  plan = ChooseRnnParallelism(2, 20, 64, 512, 4, 64, 8, 8);
+  EXPECT_FALSE(plan.concurrent_directions);
+  EXPECT_TRUE(plan.batch_parallel);
+  EXPECT_EQ(plan.partitions, 7);
+
+  // a single sequence with a large hidden size is split by hidden units
+  plan = ChooseRnnParallelism(1, 20, 1, 1024, 4, 1, 16, 8);
+  EXPECT_TRUE(plan.hidden_parallel);
+  EXPECT_FALSE(plan.batch_parallel);
+
+  // a concurrent direction runs on a task of the thread pool and isn't split further
+  plan = ChooseRnnParallelism(2, 20, 1, 128, 1, 1, 128, 8);
+  EXPECT_TRUE(!plan.concurrent_directions || (!plan.batch_parallel && !plan.hidden_parallel));
+  plan = ChooseRnnParallelism(2, 200, 64, 128, 4, 64, 8, 64);
+  EXPECT_TRUE(!plan.concurrent_directions || (!plan.batch_parallel && !plan.hidden_parallel));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -208,5 +208,33 @@ TEST(MathOpTest, Concat3D_3) {
   test.Run();
 }
 
+TEST(MathOpTest, Concat3D_large) {
+  // Large enough for the copy to be split across threads.
+  constexpr int64_t outer = 8;
+  constexpr int64_t rows1 = 96;
+  constexpr int64_t rows2 = 160;
+  constexpr int64_t cols = 200;
+
+  std::vector<float> input1(outer * rows1 * cols);
+  std::vector<float> input2(outer * rows2 * cols);
+  std::vector<float> expected;
+  expected.reserve(input1.size() + input2.size());
+  for (size_t i = 0; i < input1.size(); ++i)
+    input1[i] = static_cast<float>(i);
+  for (size_t i = 0; i < input2.size(); ++i)
+    input2[i] = -static_cast<float>(i);
+  for (int64_t o = 0; o < outer; ++o) {
+    expected.insert(expected.end(), input1.begin() + o * rows1 * cols, input1.begin() + (o + 1) * rows1 * cols);
+    expected.insert(expected.end(), input2.begin() + o * rows2 * cols, input2.begin() + (o + 1) * rows2 * cols);
+  }
+
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+  test.AddInput<float>("input1", {outer, rows1, cols}, input1);
+  test.AddInput<float>("input2", {outer, rows2, cols}, input2);
+  test.AddOutput<float>("concat_result", {outer, rows1 + rows2, cols}, expected);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -288,6 +288,58 @@ TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_negative_index_cpu) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {3, 4},
+                       {0.0f, 1.0f, 2.0f, 3.0f,
+                        4.0f, 5.0f, 6.0f, 7.0f,
+                        8.0f, 9.0f, 10.0f, 11.0f});
+  test.AddInput<int64_t>("indices", {3}, {0LL, -1LL, 1LL});
+  test.AddOutput<float>("output", {3, 4}, std::vector<float>(12, 0.0f));
+
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds, idx=-1",
+           {kCudaExecutionProvider});
+}
+
+TEST(GatherOpTest, Gather_axis1_int64_elements) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 1LL);
+  test.AddInput<int64_t>("data", {2, 3},
+                         {0LL, 1LL, 2LL,
+                          10LL, 11LL, 12LL});
+  test.AddInput<int32_t>("indices", {4}, {2, 0, 2, 1});
+  test.AddOutput<int64_t>("output", {2, 4},
+                          {2LL, 0LL, 2LL, 1LL,
+                           12LL, 10LL, 12LL, 11LL});
+  test.Run();
+}
+
+TEST(GatherOpTest, Gather_embedding_lookup) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  constexpr int64_t vocab = 1000;
+  constexpr int64_t dim = 64;
+  constexpr int64_t num_indices = 2000;
+  std::vector<float> table(vocab * dim);
+  for (int64_t i = 0; i < vocab * dim; ++i) {
+    table[i] = static_cast<float>(i);
+  }
+  std::vector<int64_t> indices(num_indices);
+  std::vector<float> output(num_indices * dim);
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 7919) % vocab;
+    for (int64_t j = 0; j < dim; ++j) {
+      output[i * dim + j] = table[indices[i] * dim + j];
+    }
+  }
+
+  test.AddInput<float>("data", {vocab, dim}, table);
+  test.AddInput<int64_t>("indices", {num_indices}, indices);
+  test.AddOutput<float>("output", {num_indices, dim}, output);
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_perf) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 0LL);
@@ -89,6 +89,26 @@ TEST(TensorOpTest, Pad_3D_complex) {
   test.Run();
 }
 
+TEST(TensorOpTest, Pad_Constant_3D_negative_begin) {
+  OpTester test("Pad");
+
+  test.AddAttribute("pads", std::vector<int64_t>{0, -1, 1, 0, 1, 0});
+  test.AddAttribute("value", 0.0f);
+  test.AddInput<float>("data", {2, 2, 2},
+                       {111.0f, 112.0f,
+                        121.0f, 122.0f,
+
+                        211.0f, 212.0f,
+                        221.0f, 222.0f});
+  test.AddOutput<float>("output", {2, 2, 3},
+                        {0.0f, 121.0f, 122.0f,
+                         0.0f, 0.0f, 0.0f,
+
+                         0.0f, 221.0f, 222.0f,
+                         0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
 TEST(TensorOpTest, Pad_Edge_2D) {
   OpTester test("Pad");
 
@@ -84,5 +84,25 @@ TEST(TensorOpTest, Tile3D) {
   test.Run();
 }
 
+TEST(TensorOpTest, Tile3D_AllAxes) {
+  OpTester test("Tile");
+
+  test.AddInput<float>("input", {1, 2, 2},
+                       {11.0f, 12.0f,
+                        21.0f, 22.0f});
+  test.AddInput<int64_t>("repeats", {3}, {2, 2, 3});
+  test.AddOutput<float>("output", {2, 4, 6},
+                        {11.0f, 12.0f, 11.0f, 12.0f, 11.0f, 12.0f,
+                         21.0f, 22.0f, 21.0f, 22.0f, 21.0f, 22.0f,
+                         11.0f, 12.0f, 11.0f, 12.0f, 11.0f, 12.0f,
+                         21.0f, 22.0f, 21.0f, 22.0f, 21.0f, 22.0f,
+
+                         11.0f, 12.0f, 11.0f, 12.0f, 11.0f, 12.0f,
+                         21.0f, 22.0f, 21.0f, 22.0f, 21.0f, 22.0f,
+                         11.0f, 12.0f, 11.0f, 12.0f, 11.0f, 12.0f,
+                         21.0f, 22.0f, 21.0f, 22.0f, 21.0f, 22.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
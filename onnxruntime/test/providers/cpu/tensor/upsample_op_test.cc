@@ -381,5 +381,55 @@ TEST(UpsampleOpTest, UpsampleOpNearest2XTest_opset9) {
   test.AddOutput<int32_t>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
   test.Run();
 }
+
+TEST(UpsampleOpTest, UpsampleOpBilinear2XTest) {
+  OpTester test("Upsample");
+
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  test.AddAttribute("mode", "linear");
+  test.AddAttribute("scales", scales);
+
+  const int64_t N = 1, C = 2, H = 2, W = 3;
+  std::vector<float> X = {1.0f, 3.0f, 5.0f,
+                          7.0f, 9.0f, 11.0f,
+
+                          2.0f, 4.0f, 8.0f,
+                          0.0f, 6.0f, 2.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+
+  std::vector<float> Y = {
+      1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 5.0f,
+      4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 8.0f,
+      7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 11.0f,
+      7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 11.0f,
+
+      2.0f, 3.0f, 4.0f, 6.0f, 8.0f, 8.0f,
+      1.0f, 3.0f, 5.0f, 5.0f, 5.0f, 5.0f,
+      0.0f, 3.0f, 6.0f, 4.0f, 2.0f, 2.0f,
+      0.0f, 3.0f, 6.0f, 4.0f, 2.0f, 2.0f};
+
+  test.AddOutput<float>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
+  test.Run();
+}
+
+TEST(UpsampleOpTest, ResizeOpNearestDownsampleTest) {
+  OpTester test("Resize", 10);
+
+  std::vector<float> scales{1.0f, 1.0f, 0.5f, 0.5f};
+  test.AddAttribute("mode", "nearest");
+
+  const int64_t N = 1, C = 1, H = 2, W = 4;
+  std::vector<float> X = {1.0f, 2.0f, 3.0f, 4.0f,
+                          5.0f, 6.0f, 7.0f, 8.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {1.0f, 3.0f};
+
+  test.AddOutput<float>("Y", {N, C, (int64_t)(H * scales[2]), (int64_t)(W * scales[3])}, Y);
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
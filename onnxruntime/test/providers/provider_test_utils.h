@@ -20,6 +20,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include <gsl/gsl_byte>
+#include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -361,5 +362,15 @@ inline void ConvertMLFloat16ToFloat(const MLFloat16* h_data, float* f_data, int
   output_vector = in_vector.template cast<float>();
 }
 
+// Expected outputs computed from float values stay exact only if the values are representable in float16.
+inline std::vector<MLFloat16> ToFloat16(const std::vector<float>& values) {
+  std::vector<MLFloat16> result;
+  result.reserve(values.size());
+  for (float value : values) {
+    result.push_back(MLFloat16(math::floatToHalf(value)));
+  }
+  return result;
+}
+
 }  // namespace test
 }  // namespace onnxruntime